@@ -165,6 +165,17 @@ To do this you need several steps:
 Sounds a little complicated, but you'll see it isn't:
 */
 
+	//The cameras and viewports of the four quarters
+	//(left top, right top, left bottom, right bottom)
+	array<ICameraSceneNode*> cameras;
+	array<rect<s32> > viewPorts;
+	for (s32 i=0; i<4; ++i)
+		cameras.push_back(camera[i]);
+	viewPorts.push_back(rect<s32>(0,0,ResX/2,ResY/2));
+	viewPorts.push_back(rect<s32>(ResX/2,0,ResX,ResY/2));
+	viewPorts.push_back(rect<s32>(0,ResY/2,ResX/2,ResY));
+	viewPorts.push_back(rect<s32>(ResX/2,ResY/2,ResX,ResY));
+
 	while(device->run())
 	{
 		//Set the viewpoint to the whole screen and begin scene
@@ -173,36 +184,24 @@ Sounds a little complicated, but you'll see it isn't:
 		//If SplitScreen is used
 		if (SplitScreen)
 		{
-			//Activate camera1
-			smgr->setActiveCamera(camera[0]);
-			//Set viewpoint to the first quarter (left top)
-			driver->setViewPort(rect<s32>(0,0,ResX/2,ResY/2));
-			//Draw scene
-			smgr->drawAll();
-			//Activate camera2
-			smgr->setActiveCamera(camera[1]);
-			//Set viewpoint to the second quarter (right top)
-			driver->setViewPort(rect<s32>(ResX/2,0,ResX,ResY/2));
-			//Draw scene
-			smgr->drawAll();
-			//Activate camera3
-			smgr->setActiveCamera(camera[2]);
-			//Set viewpoint to the third quarter (left bottom)
-			driver->setViewPort(rect<s32>(0,ResY/2,ResX/2,ResY));
+			//Draw the scene once for each camera, each into its quarter
+			smgr->drawAllViews(cameras, viewPorts);
+		}
+		else
+		{
+			//Activate camera4
+			smgr->setActiveCamera(camera[3]);
 			//Draw scene
 			smgr->drawAll();
-			//Set viewport the last quarter (right bottom)
-			driver->setViewPort(rect<s32>(ResX/2,ResY/2,ResX,ResY));
 		}
-		//Activate camera4
-		smgr->setActiveCamera(camera[3]);
-		//Draw scene
-		smgr->drawAll();
 		driver->endScene();
 
 		/*
 		As you can probably see, the image is rendered for every
-		viewport separately. That means, that you'll loose much performance.
+		viewport separately. drawAllViews() animates the scene and
+		decides which nodes each camera can see in one go, but the
+		nodes are still drawn once per viewport, so you'll loose
+		some performance.
 		Ok, if you're asking "How do I have to set the viewport
 		to get this or that screen?", don't panic. It's really
 		easy: In the rect-function you define 4 coordinates:
@@ -310,10 +310,13 @@ namespace scene
 		//! Append the vertices and indices to the current buffer
 		/** Only works for compatible types, i.e. either the same type
 		or the main buffer is of standard type. Otherwise, behavior is
-		undefined.
+		undefined. The appended indices are moved behind the vertices
+		which were in the buffer before.
 		*/
 		virtual void append(IVertexBuffer* vertexBuffer, u32 vertexBufferID, IIndexBuffer* indexBuffer)
 		{
+			const u32 firstVertex = (vertexBufferID < VertexBuffer.size()) ? VertexBuffer[vertexBufferID]->getVertexCount() : 0;
+
 			if (vertexBufferID < VertexBuffer.size() && VertexDescriptor && vertexBuffer &&
 				vertexBuffer->getVertexSize() == VertexDescriptor->getVertexSize(vertexBufferID) &&
 				vertexBuffer->getVertexSize() == VertexBuffer[vertexBufferID]->getVertexSize())
@@ -353,7 +356,7 @@ namespace scene
 				IndexBuffer->reallocate(IndexBuffer->getIndexCount() + indexCount);
 
 				for (u32 i = 0; i < indexCount; ++i)
-					IndexBuffer->addIndex(indexBuffer->getIndex(i));
+					IndexBuffer->addIndex(indexBuffer->getIndex(i) + firstVertex);
 			}
 		}
 
@@ -19,7 +19,15 @@ namespace scene
 		EAC_BOX = 1,
 		EAC_FRUSTUM_BOX = 2,
 		EAC_FRUSTUM_SPHERE = 4,
-		EAC_OCC_QUERY = 8
+		EAC_OCC_QUERY = 8,
+
+		//! Culls each mesh buffer of mesh scene nodes by its own bounding box
+		/** Combined with the tests for the whole node, e.g. EAC_BOX, each
+		visible buffer is then tested against the camera pyramid planes like
+		with EAC_FRUSTUM_BOX. Useful for large meshes with many buffers, like
+		levels, of which often only a part is visible. The bounding boxes of
+		the buffers have to be up to date. */
+		EAC_MESH_BUFFERS = 16
 	};
 
 	//! Names for culling type
@@ -31,7 +31,10 @@ namespace scene
 		EMWT_OBJ          = MAKE_IRR_ID('o','b','j',0),
 
 		//! PLY mesh writer for .ply files
-		EMWT_PLY          = MAKE_IRR_ID('p','l','y',0)
+		EMWT_PLY          = MAKE_IRR_ID('p','l','y',0),
+
+		//! Irrlicht native binary mesh writer for .irrbmesh files
+		EMWT_BINARY_MESH  = MAKE_IRR_ID('i','r','b','m')
 	};
 
 
@@ -36,6 +36,9 @@ namespace scene
 		//! Terrain Scene Node
 		ESNT_TERRAIN        = MAKE_IRR_ID('t','e','r','r'),
 
+		//! Paged Terrain Scene Node
+		ESNT_PAGED_TERRAIN  = MAKE_IRR_ID('p','t','e','r'),
+
 		//! Sky Box Scene Node
 		ESNT_SKY_BOX        = MAKE_IRR_ID('s','k','y','_'),
 
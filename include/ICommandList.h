@@ -0,0 +1,68 @@
+// Copyright (C) 2002-2012 Nikolaus Gebhardt
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#ifndef __I_COMMAND_LIST_H_INCLUDED__
+#define __I_COMMAND_LIST_H_INCLUDED__
+
+#include "IReferenceCounted.h"
+#include "IVideoDriver.h"
+
+namespace irr
+{
+namespace video
+{
+
+	//! A list of drawing commands which is recorded now and drawn later
+	/** A command list records the same calls as IVideoDriver::setTransform(),
+	IVideoDriver::setMaterial() and IVideoDriver::drawMeshBuffer(), without
+	touching the state of the driver. IVideoDriver::submit() replays the
+	commands in the order in which they were recorded. A list can be submitted
+	any number of times, until it is cleared.
+
+	As recording only writes to the list itself, several lists can be recorded
+	at the same time from different threads, as long as each list is only used
+	by one thread at a time and the lists are submitted from the thread which
+	renders. Mesh buffers are not grabbed by the list, they have to be kept
+	alive until the list is cleared or dropped.
+
+	Command lists are created by IVideoDriver::createCommandList(). Other
+	implementations can be submitted as well, the driver only calls replay(). */
+	class ICommandList : public virtual IReferenceCounted
+	{
+	public:
+
+		//! Records setting a transformation
+		/** \param state Transformation type to be set.
+		\param mat Matrix describing the transformation. */
+		virtual void setTransform(E_TRANSFORMATION_STATE state, const core::matrix4& mat) = 0;
+
+		//! Records setting a material
+		/** Setting the same material as the previous one isn't recorded.
+		\param material Material to be used from now on. */
+		virtual void setMaterial(const SMaterial& material) = 0;
+
+		//! Records drawing a mesh buffer
+		/** \param mb Buffer to draw, it is not grabbed. */
+		virtual void drawMeshBuffer(const scene::IMeshBuffer* mb) = 0;
+
+		//! Removes all commands
+		/** The memory of the list is kept for recording the next commands. */
+		virtual void clear() = 0;
+
+		//! Returns the number of recorded commands
+		virtual u32 getCommandCount() const = 0;
+
+		//! Executes the recorded commands on a driver
+		/** Called by IVideoDriver::submit(), which should be used
+		instead of calling this directly.
+		\param driver Driver the commands are executed on, through its
+		setTransform(), setMaterial() and drawMeshBuffer() methods. */
+		virtual void replay(IVideoDriver* driver) const = 0;
+	};
+
+} // end namespace video
+} // end namespace irr
+
+#endif
+
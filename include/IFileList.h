@@ -74,6 +74,15 @@ public:
 	//! Returns the base path of the file list
 	virtual const io::path& getPath() const = 0;
 
+	//! Returns true if files are searched by their name only
+	/** This is the case for file lists created with the ignorePaths flag,
+	findFile() removes the path of the searched name then. */
+	virtual bool isIgnoringPaths() const { return false; }
+
+	//! Returns true if the names of the file list are lower case
+	/** This is the case for file lists created with the ignoreCase flag. */
+	virtual bool isIgnoringCase() const { return true; }
+
 	//! Add as a file or folder to the list
 	/** \param fullPath The file name including path, from the root of the file list.
 	\param isDirectory True if this is a directory rather than a file.
@@ -152,7 +152,11 @@ public:
 			IFileArchive** retArchive=0) =0;
 
 	//! Adds an archive to the file system.
-	/** \param archive: The archive to add to the file system.
+	/** The file system indexes the file list of the archive when it is
+	added. Entries which are added to or removed from the list afterwards
+	are not seen by createAndOpenFile() and existFile(). To update the
+	index, grab the archive, remove it and add it again.
+	\param archive: The archive to add to the file system.
 	\return True if the archive was added successfully, false if not. */
 	virtual bool addFileArchive(IFileArchive* archive) =0;
 
@@ -212,6 +216,35 @@ public:
 	\return A pointer to the specified loader, 0 if the index is incorrect. */
 	virtual IArchiveLoader* getArchiveLoader(u32 index) const = 0;
 
+	//! Sets the size of the cache for the contents of archive entries
+	/** The zip, pak and npk archives keep the decompressed content of the
+	entries opened last in a shared cache, so opening an entry again doesn't
+	read and inflate it once more. Entries which weren't opened for the
+	longest time are removed when the cache is full. Entries larger than the
+	cache are always read from the archive. Deflated zip entries which aren't
+	cached are inflated while they are read, so large archives can be used
+	with little memory.
+	\param bytes Maximum number of bytes kept, 0 disables the cache, which is
+	the default. */
+	virtual void setArchiveCacheSize(u32 bytes) =0;
+
+	//! Gets the size of the cache for the contents of archive entries
+	/** \return Maximum number of bytes kept, 0 if the cache is disabled. */
+	virtual u32 getArchiveCacheSize() const =0;
+
+	//! Sets a directory in which the file lists of zip archives are kept
+	/** When a zip archive is added, its file list is written into this
+	directory. Adding the archive again reads the list from there instead
+	of scanning the archive, as long as size and modification time of the
+	archive didn't change. The directory has to exist.
+	\param directory Directory of the cache files, an empty path disables
+	the cache, which is the default. */
+	virtual void setArchiveIndexCacheDirectory(const path& directory) =0;
+
+	//! Gets the directory in which the file lists of zip archives are kept
+	/** \return Directory of the cache files, empty if the cache is disabled. */
+	virtual const path& getArchiveIndexCacheDirectory() const =0;
+
 	//! Adds a zip archive to the file system.
 	/** \deprecated This function is provided for compatibility
 	with older versions of Irrlicht and may be removed in Irrlicht 1.9,
@@ -314,7 +347,8 @@ public:
 	virtual EFileSystemType setFileListSystem(EFileSystemType listType) =0;
 
 	//! Determines if a file exists and could be opened.
-	/** \param filename is the string identifying the file which should be tested for existence.
+	/** Directories in archives are found when the name ends with a slash.
+	\param filename is the string identifying the file which should be tested for existence.
 	\return True if file exists, and false if it does not exist or an error occured. */
 	virtual bool existFile(const path& filename) const =0;
 
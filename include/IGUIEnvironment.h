@@ -76,6 +76,29 @@ public:
 	//! Draws all gui elements by traversing the GUI environment starting at the root node.
 	virtual void drawAll() = 0;
 
+	//! Enables drawing only the parts of the screen in which the GUI changed
+	/** In retained mode drawAll() compares position, visibility, enabled
+	state and text of the elements with the last frame, and takes the
+	hovered and focused elements as changed when they get input. Only the
+	areas of the changed elements are cleared with the background color and
+	drawn again, the software drivers then present only these areas.
+	The back buffer has to keep its content between frames for this, so
+	beginScene() must not clear it and the GUI has to be the only thing
+	drawn. The built-in elements report changes of their state, like a
+	checked check box or a new image, by themselves. Changes the
+	environment can't see, like new skin colors or state of user elements,
+	have to be reported with invalidate().
+	\param retained True to draw only changed areas, false to draw
+	everything in every frame, which is the default.
+	\param background Color of the screen behind the GUI. */
+	virtual void setRetainedMode(bool retained, video::SColor background=video::SColor(255,0,0,0)) = 0;
+
+	//! Returns true if drawAll() only draws the changed parts of the GUI
+	virtual bool isRetainedMode() const = 0;
+
+	//! Marks an area of the screen as changed, so retained mode draws it again
+	virtual void invalidate(const core::rect<s32>& area) = 0;
+
 	//! Sets the focus to an element.
 	/** Causes a EGET_ELEMENT_FOCUS_LOST event followed by a
 	EGET_ELEMENT_FOCUSED event. If someone absorbed either of the events,
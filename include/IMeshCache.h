@@ -167,6 +167,19 @@ namespace scene
 		/** Warning: If you have pointers to meshes that were loaded with ISceneManager::getMesh()
 		and you did not grab them, then they may become invalid. */
 		virtual void clearUnusedMeshes() = 0;
+
+		//! Enables the binary mesh cache on disk.
+		/** When enabled, ISceneManager::getMesh() stores each mesh loaded
+		from a file as a binary .irrbmesh file next to its source, e.g.
+		"dwarf.x.irrbmesh". Further loads of the same source read this file
+		instead of parsing the source again, as long as the size and hash of
+		the source file match the ones stored in the binary file. Only static
+		and skinned meshes are cached. Disabled by default.
+		\param enable True to enable the binary cache. */
+		virtual void setBinaryCacheEnabled(bool enable) = 0;
+
+		//! Check if the binary mesh cache on disk is enabled.
+		virtual bool isBinaryCacheEnabled() const = 0;
 	};
 
 
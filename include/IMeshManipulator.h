@@ -109,7 +109,9 @@ namespace scene
 		}
 
 		//! Applies a transformation to a meshbuffer
-		/** \param buffer Meshbuffer on which the operation is performed.
+		/** Normals, tangents and binormals are transformed as well
+		and normalized again.
+		\param buffer Meshbuffer on which the operation is performed.
 		\param m transformation matrix. */
 		virtual void transform(IMeshBuffer* meshBuffer, const core::matrix4& mat) const = 0;
 
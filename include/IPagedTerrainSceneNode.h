@@ -0,0 +1,101 @@
+// Copyright (C) 2002-2012 Nikolaus Gebhardt
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#ifndef __I_PAGED_TERRAIN_SCENE_NODE_H_INCLUDED__
+#define __I_PAGED_TERRAIN_SCENE_NODE_H_INCLUDED__
+
+#include "ISceneNode.h"
+
+namespace irr
+{
+namespace scene
+{
+	class ITerrainSceneNode;
+
+	//! A scene node for terrains which are too large to be loaded at once.
+	/** The terrain is split into square tiles of the same size, each one
+	stored in its own heightmap file. The names of the files are made from a
+	pattern in which "{x}" and "{z}" are replaced by the column and the row of
+	the tile, for example "terrain/tile_{x}_{z}.png". Files ending with .raw
+	are read as 16 bit RAW heightmaps, all other files like the heightmap of
+	ISceneManager::addTerrainSceneNode(). The files are opened through the file
+	system, so tiles can also be stored in a mounted archive.
+
+	Tile (0,0) starts at the position of the node, neighbouring tiles share
+	their border vertices. Each loaded tile is an ITerrainSceneNode child of
+	this node with its own geo mip map levels of detail, the borders of visible
+	neighbours are stitched like the patches inside a terrain. Tiles within the view
+	radius around the active camera are shown, the others are hidden but kept
+	in a cache, from which the least recently used ones are removed once more
+	than getMaxCachedTiles() tiles are loaded. Missing tiles are loaded a few
+	per frame, nearest first, so that walking over the terrain doesn't stall
+	the application. Tiles without a file are looked for again after
+	getRetryDelay(), or as soon as an archive is added to the file system.
+
+	Rotating the node is not supported. */
+	class IPagedTerrainSceneNode : public ISceneNode
+	{
+	public:
+
+		//! Constructor
+		IPagedTerrainSceneNode(ISceneNode* parent, ISceneManager* mgr, s32 id,
+			const core::vector3df& position = core::vector3df(0.0f, 0.0f, 0.0f),
+			const core::vector3df& scale = core::vector3df(1.0f, 1.0f, 1.0f))
+			: ISceneNode(parent, mgr, id, position, core::vector3df(0.0f, 0.0f, 0.0f), scale) {}
+
+		//! Sets the number of tiles around the camera tile which are shown
+		/** \param radius 0 shows only the tile below the camera, 1 the
+		3x3 tiles around it and so on. */
+		virtual void setViewRadius(u32 radius) = 0;
+
+		//! Returns the number of tiles around the camera tile which are shown
+		virtual u32 getViewRadius() const = 0;
+
+		//! Sets the maximum number of tiles kept in memory
+		/** Hidden tiles are removed least recently used first. Tiles
+		within the view radius are never removed, so the cache can
+		grow larger than this if it is smaller than the visible area. */
+		virtual void setMaxCachedTiles(u32 count) = 0;
+
+		//! Returns the maximum number of tiles kept in memory
+		virtual u32 getMaxCachedTiles() const = 0;
+
+		//! Sets how many tiles are loaded at most per frame
+		virtual void setTilesPerFrame(u32 count) = 0;
+
+		//! Sets the time after which tiles without a file are looked for again
+		/** \param milliseconds Delay, 1000 by default. */
+		virtual void setRetryDelay(u32 milliseconds) = 0;
+
+		//! Returns the time after which tiles without a file are looked for again
+		virtual u32 getRetryDelay() const = 0;
+
+		//! Returns the size of a tile in world units
+		virtual core::vector3df getTileExtent() const = 0;
+
+		//! Returns the number of tiles in the cache
+		virtual u32 getCachedTileCount() const = 0;
+
+		//! Returns the terrain of a tile, or 0 if the tile is not loaded
+		virtual ITerrainSceneNode* getTile(s32 x, s32 z) const = 0;
+
+		//! Loads all tiles within the view radius around a position at once
+		/** Useful before the first frame or after a teleport, to
+		avoid showing the terrain being built tile by tile.
+		\param position Position in world coordinates. */
+		virtual void loadTilesAround(const core::vector3df& position) = 0;
+
+		//! Returns the height of the terrain at a position
+		/** \param x X coordinate in world space.
+		\param z Z coordinate in world space.
+		\return Height of the terrain, or -FLT_MAX if the tile at this
+		position is not loaded. */
+		virtual f32 getHeight(f32 x, f32 z) const = 0;
+	};
+
+} // end namespace scene
+} // end namespace irr
+
+#endif
+
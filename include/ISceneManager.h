@@ -121,6 +121,7 @@ namespace scene
 	class ISceneNodeFactory;
 	class ISceneUserDataSerializer;
 	class ITerrainSceneNode;
+	class IPagedTerrainSceneNode;
 	class ITextSceneNode;
 	class ITriangleSelector;
 	class IVolumeLightSceneNode;
@@ -933,6 +934,36 @@ namespace scene
 			s32 maxLOD=5, E_TERRAIN_PATCH_SIZE patchSize=ETPS_17, s32 smoothFactor=0,
 			bool addAlsoIfHeightmapEmpty = false) = 0;
 
+		//! Adds a terrain scene node which loads heightmap tiles around the camera.
+		/** Terrains larger than what fits into a single heightmap or
+		into memory can be split into tiles of the same size, which
+		are loaded when the camera comes near them and removed when
+		it has moved away. See IPagedTerrainSceneNode for details.
+		\param tileFileName: Pattern of the names of the tile files,
+		in which "{x}" and "{z}" are replaced by the column and the
+		row of the tile, e.g. "terrain/tile_{x}_{z}.png".
+		\param tileSize: Number of vertices along each side of a tile,
+		which is the width of the tile heightmaps. Neighbouring tiles
+		share their border vertices, so a tile spans tileSize-1 cells.
+		\param parent: Parent of the scene node. Can be 0 if no parent.
+		\param id: Id of the node. This id can be used to identify the scene node.
+		\param position: The absolute position of the corner of tile (0,0).
+		\param scale: The scale factor of the tiles.
+		\param vertexColor: The default color of all the vertices.
+		\param maxLOD: The maximum LOD (level of detail) of the tiles.
+		\param patchSize: patch size of the tiles.
+		\param smoothFactor: The number of times the vertices of a tile are smoothed.
+		\return Pointer to the created scene node. This pointer
+		should not be dropped. See IReferenceCounted::drop() for
+		more information. */
+		virtual IPagedTerrainSceneNode* addPagedTerrainSceneNode(
+			const io::path& tileFileName, s32 tileSize,
+			ISceneNode* parent=0, s32 id=-1,
+			const core::vector3df& position = core::vector3df(0.0f,0.0f,0.0f),
+			const core::vector3df& scale = core::vector3df(1.0f,1.0f,1.0f),
+			video::SColor vertexColor = video::SColor(255,255,255,255),
+			s32 maxLOD=5, E_TERRAIN_PATCH_SIZE patchSize=ETPS_17, s32 smoothFactor=0) = 0;
+
 		//! Adds a quake3 scene node to the scene graph.
 		/** A Quake3 Scene renders multiple meshes for a specific HighLanguage Shader (Quake3 Style )
 		\return Pointer to the quake3 scene node if successful, otherwise NULL.
@@ -949,6 +980,32 @@ namespace scene
 		This pointer should not be dropped. See IReferenceCounted::drop() for more information. */
 		virtual ISceneNode* addEmptySceneNode(ISceneNode* parent=0, s32 id=-1) = 0;
 
+		//! Merges the static mesh scene nodes of a subtree into a few large mesh buffers.
+		/** Scenes made of many small static meshes, like those
+		loaded from .irr files, are limited by the number of draw
+		calls. This method transforms the mesh buffers of the mesh
+		scene nodes below root into world space and appends those
+		with the same material and vertex descriptor to each other,
+		up to 65536 vertices per buffer. The merged nodes are made
+		invisible and the batches are added as mesh scene nodes,
+		one for each cell of a grid, so that they are still culled
+		by their bounding boxes. As the batches are in world space,
+		their parent is always the root scene node.
+		Only visible mesh scene nodes without animators, with opaque
+		materials and the built-in vertex types are merged. A node
+		with children is only merged if all its visible children
+		were merged, too. The meshes of the nodes are not changed.
+		\param root Node whose subtree is merged, including itself.
+		\param cellSize Edge length of the grid cells in world
+		units. Use 0 to merge the whole subtree into one mesh.
+		\param id Id of the node which is the parent of the batches.
+		\return Pointer to the node which is the parent of the
+		batches, or 0 if no node could be merged. This pointer
+		should not be dropped. See IReferenceCounted::drop() for
+		more information. */
+		virtual ISceneNode* addStaticBatchSceneNode(ISceneNode* root, f32 cellSize=0.f,
+			s32 id=-1) = 0;
+
 		//! Adds a dummy transformation scene node to the scene graph.
 		/** This scene node does not render itself, and does not respond to set/getPosition,
 		set/getRotation and set/getScale. Its just a simple scene node that takes a
@@ -1174,6 +1231,25 @@ namespace scene
 		by existing scene node animators, culling of scene nodes is done, etc. */
 		virtual void drawAll() = 0;
 
+		//! Draws the scene once for each of several cameras, e.g. for split screens.
+		/** This can only be invoked between IVideoDriver::beginScene() and
+		IVideoDriver::endScene(). Unlike calling setActiveCamera() and drawAll()
+		for each view, the scene is animated and traversed only once. Each
+		registered node is tested against the frusta of all cameras, and each
+		view renders the nodes its camera can see, sorted for that camera.
+		The active camera and the viewport are restored afterwards.
+		While the nodes register in OnRegisterSceneNode(), the first camera is
+		the active one, so nodes which do camera dependent work there do it
+		for the first view only. Such nodes have to repeat the work in
+		render(), where the camera of the view is active, as the terrain
+		scene node does for its LODs.
+		\param cameras Cameras of the views, at most 32. The aspect ratio of
+		each camera should match its viewport.
+		\param viewPorts Viewport of each view. Views without a viewport are
+		drawn into the current one. */
+		virtual void drawAllViews(const core::array<ICameraSceneNode*>& cameras,
+			const core::array<core::rect<s32> >& viewPorts = core::array<core::rect<s32> >()) = 0;
+
 		//! Creates a rotation animator, which rotates the attached scene node around itself.
 		/** \param rotationSpeed Specifies the speed of the animation in degree per 10 milliseconds.
 		\return The animator. Attach it to a scene node with ISceneNode::addAnimator()
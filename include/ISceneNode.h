@@ -16,6 +16,8 @@
 #include "aabbox3d.h"
 #include "matrix4.h"
 #include "irrList.h"
+#include "irrArray.h"
+#include "irrMemoryPool.h"
 #include "IAttributes.h"
 
 namespace irr
@@ -25,6 +27,8 @@ namespace scene
 	class ISceneManager;
 
 	//! Typedef for list of scene nodes
+	/** Only used for ISceneNode::getChildren(), the children themselves are
+	stored in an array. */
 	typedef core::list<ISceneNode*> ISceneNodeList;
 	//! Typedef for list of scene node animators
 	typedef core::list<ISceneNodeAnimator*> ISceneNodeAnimatorList;
@@ -37,7 +41,8 @@ namespace scene
 	example easily possible to attach a light to a moving car, or to place
 	a walking character on a moving platform on a moving ship.
 	*/
-	class ISceneNode : virtual public io::IAttributeExchangingObject
+	class ISceneNode : virtual public io::IAttributeExchangingObject,
+		public core::pooledObject<core::EOP_SCENE_NODE>
 	{
 	public:
 
@@ -49,7 +54,7 @@ namespace scene
 			: RelativeTranslation(position), RelativeRotation(rotation), RelativeScale(scale),
 				Parent(0), SceneManager(mgr), TriangleSelector(0), ID(id),
 				AutomaticCullingState(EAC_BOX), DebugDataVisible(EDS_OFF),
-				IsVisible(true), IsDebugObject(false)
+				IsVisible(true), IsDebugObject(false), ChildListChanged(false)
 		{
 			if (parent)
 				parent->addChild(this);
@@ -92,9 +97,8 @@ namespace scene
 		{
 			if (IsVisible)
 			{
-				ISceneNodeList::Iterator it = Children.begin();
-				for (; it != Children.end(); ++it)
-					(*it)->OnRegisterSceneNode();
+				for (u32 i=0; i<Children.size(); ++i)
+					Children[i]->OnRegisterSceneNode();
 			}
 		}
 
@@ -130,9 +134,8 @@ namespace scene
 
 				// perform the post render process on all children
 
-				ISceneNodeList::Iterator it = Children.begin();
-				for (; it != Children.end(); ++it)
-					(*it)->OnAnimate(timeMs);
+				for (u32 i=0; i<Children.size(); ++i)
+					Children[i]->OnAnimate(timeMs);
 			}
 		}
 
@@ -306,6 +309,7 @@ namespace scene
 				child->remove(); // remove from old parent
 				Children.push_back(child);
 				child->Parent = this;
+				ChildListChanged = true;
 			}
 		}
 
@@ -318,13 +322,14 @@ namespace scene
 		e.g. because it couldn't be found in the children list. */
 		virtual bool removeChild(ISceneNode* child)
 		{
-			ISceneNodeList::Iterator it = Children.begin();
-			for (; it != Children.end(); ++it)
-				if ((*it) == child)
+			// searched from the back, as the last added nodes are often removed first
+			for (s32 i=(s32)Children.size()-1; i>=0; --i)
+				if (Children[i] == child)
 				{
-					(*it)->Parent = 0;
-					(*it)->drop();
-					Children.erase(it);
+					Children.erase(i);
+					ChildListChanged = true;
+					child->Parent = 0;
+					child->drop();
 					return true;
 				}
 
@@ -339,14 +344,15 @@ namespace scene
 		*/
 		virtual void removeAll()
 		{
-			ISceneNodeList::Iterator it = Children.begin();
-			for (; it != Children.end(); ++it)
+			for (u32 i=0; i<Children.size(); ++i)
 			{
-				(*it)->Parent = 0;
-				(*it)->drop();
+				Children[i]->Parent = 0;
+				Children[i]->drop();
 			}
 
 			Children.clear();
+			ChildList.clear();
+			ChildListChanged = false;
 		}
 
 
@@ -600,11 +606,41 @@ namespace scene
 		}
 
 
+		//! Returns the number of children of this node.
+		u32 getChildCount() const
+		{
+			return Children.size();
+		}
+
+
+		//! Returns a child of this node.
+		/** Children are kept in the order in which they were added.
+		Iterating with getChildCount() and getChild() is faster than
+		iterating getChildren(), which needs a copy of the children.
+		\param index Number of the child, smaller than getChildCount().
+		\return The child at the given index. */
+		ISceneNode* getChild(u32 index) const
+		{
+			return Children[index];
+		}
+
+
 		//! Returns a const reference to the list of all children.
-		/** \return The list of all children of this node. */
+		/** The children are stored in an array, this list is a copy which
+		is updated on the first call after the children changed, which
+		invalidates the iterators into it.
+		\return The list of all children of this node. */
 		const core::list<ISceneNode*>& getChildren() const
 		{
-			return Children;
+			if (ChildListChanged)
+			{
+				ChildList.clear();
+				for (u32 i=0; i<Children.size(); ++i)
+					ChildList.push_back(Children[i]);
+				ChildListChanged = false;
+			}
+
+			return ChildList;
 		}
 
 
@@ -795,9 +831,8 @@ namespace scene
 
 			// clone children
 
-			ISceneNodeList::Iterator it = toCopyFrom->Children.begin();
-			for (; it != toCopyFrom->Children.end(); ++it)
-				(*it)->clone(this, newManager);
+			for (u32 i=0; i<toCopyFrom->Children.size(); ++i)
+				toCopyFrom->Children[i]->clone(this, newManager);
 
 			// clone animators
 
@@ -819,9 +854,8 @@ namespace scene
 		{
 			SceneManager = newManager;
 
-			ISceneNodeList::Iterator it = Children.begin();
-			for (; it != Children.end(); ++it)
-				(*it)->setSceneManager(newManager);
+			for (u32 i=0; i<Children.size(); ++i)
+				Children[i]->setSceneManager(newManager);
 		}
 
 		//! Name of the scene node.
@@ -842,8 +876,8 @@ namespace scene
 		//! Pointer to the parent
 		ISceneNode* Parent;
 
-		//! List of all children of this node
-		core::list<ISceneNode*> Children;
+		//! All children of this node, in the order in which they were added
+		core::array<ISceneNode*> Children;
 
 		//! List of all animator nodes
 		core::list<ISceneNodeAnimator*> Animators;
@@ -868,6 +902,14 @@ namespace scene
 
 		//! Is debug object?
 		bool IsDebugObject;
+
+	private:
+
+		//! Copy of the children for getChildren()
+		mutable core::list<ISceneNode*> ChildList;
+
+		//! Children were added or removed since ChildList was updated
+		mutable bool ChildListChanged;
 	};
 
 
@@ -11,6 +11,7 @@
 #include "IAttributeExchangingObject.h"
 #include "IAttributes.h"
 #include "IEventReceiver.h"
+#include "irrMemoryPool.h"
 
 namespace irr
 {
@@ -28,7 +29,8 @@ namespace scene
 	change its position, rotation, scale and/or material. There are lots of animators
 	to choose from. You can create scene node animators with the ISceneManager interface.
 	*/
-	class ISceneNodeAnimator : public io::IAttributeExchangingObject, public IEventReceiver
+	class ISceneNodeAnimator : public io::IAttributeExchangingObject, public IEventReceiver,
+		public core::pooledObject<core::EOP_SCENE_NODE_ANIMATOR>
 	{
 	public:
 		ISceneNodeAnimator() : IsEnabled(true), PauseTimeSum(0), PauseTimeStart(0), StartTime(0)
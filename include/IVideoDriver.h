@@ -41,6 +41,7 @@ namespace scene
 
 namespace video
 {
+	class ICommandList;
 	class IVertexDescriptor;
 	struct S3DVertex;
 	struct S3DVertex2TCoords;
@@ -388,6 +389,16 @@ namespace video
 		\return False if failed and true if succeeded. */
 		virtual bool endScene() =0;
 
+		//! Sets the part of the screen which changed in the current frame
+		/** The software drivers present only this part of the back
+		buffer in endScene() where the device supports it, unchanged
+		pixels are not copied to the window again. An empty area presents
+		nothing, but the whole back buffer is still presented after the
+		window was exposed or resized. beginScene() resets the area to the
+		whole screen. Other drivers ignore it.
+		\param area Changed part of the screen. */
+		virtual void setPresentArea(const core::rect<s32>& area) =0;
+
 		//! Queries the features of the driver.
 		/** Returns true if a feature is available
 		\param feature Feature to query.
@@ -1034,6 +1045,21 @@ namespace video
 		*/
 		virtual void drawMeshBufferNormals(const scene::IMeshBuffer* mb, f32 length=10.f, SColor color=0xffffffff) =0;
 
+		//! Creates an empty command list
+		/** Command lists record transformations, materials and mesh
+		buffers to be drawn later with submit().
+		\return The command list. This pointer should be dropped. See
+		IReferenceCounted::drop() for more information. */
+		virtual ICommandList* createCommandList() =0;
+
+		//! Draws the commands of a command list
+		/** The commands are executed like the calls they were
+		recorded from, so the transformations and the material of
+		the driver are those of the last commands afterwards.
+		\param list Command list created by createCommandList(), or
+		another implementation of ICommandList. */
+		virtual void submit(const ICommandList* list) =0;
+
 		//! Sets the fog mode.
 		/** These are global values attached to each 3d object rendered,
 		which has the fog flag enabled in its material.
@@ -1091,6 +1117,12 @@ namespace video
 		\return Amount of primitives drawn in the last frame. */
 		virtual u32 getPrimitiveCountDrawn( u32 mode =0 ) const =0;
 
+		//! Returns amount of draw calls in the last frame.
+		/** Every mesh buffer or primitive list drawn is one call
+		into the graphics API or the rasterizer.
+		\return Amount of draw calls in the last frame. */
+		virtual u32 getDrawCallCount() const =0;
+
 		//! Deletes all dynamic lights which were previously added with addDynamicLight().
 		virtual void deleteAllDynamicLights() =0;
 
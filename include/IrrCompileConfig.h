@@ -144,6 +144,28 @@ while it runs and enabling it will slow down the engine. */
 #undef _IRR_COMPILE_WITH_PROFILING_
 #endif
 
+//! Define _IRR_USE_SSE_ to use SSE intrinsics in the f32 matrix4 operations
+/** Speeds up the multiplication, inversion and the transformation of vectors
+and boxes, which are used for culling, skinning and the software renderers.
+This is opt-in, as the inverse rounds slightly differently, and it is
+ignored for targets without SSE. Define it for the engine and the
+application alike, e.g. on the command line of the compiler. */
+//#define _IRR_USE_SSE_
+#if defined(_IRR_USE_SSE_) && !(defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1))
+#undef _IRR_USE_SSE_
+#endif
+
+//! Define _IRR_USE_OBJECT_POOLS_ to allocate scene nodes and animators from pools
+/** Objects of the same size share fixed size blocks and freed blocks are
+reused, which makes creating and removing many nodes cheaper than the heap.
+This is opt-in, as the pools are shared by all devices of the process and are
+not locked: scene nodes and animators must then only be created and deleted
+by one thread at a time. */
+//#define _IRR_USE_OBJECT_POOLS_
+#ifdef NO_IRR_USE_OBJECT_POOLS_
+#undef _IRR_USE_OBJECT_POOLS_
+#endif
+
 //! Define _IRR_COMPILE_WITH_DIRECT3D_8_ and _IRR_COMPILE_WITH_DIRECT3D_9_ to
 //! compile the Irrlicht engine with Direct3D8 and/or DIRECT3D9.
 /** If you only want to use the software device or opengl you can disable those defines.
@@ -411,6 +433,11 @@ B3D, MS3D or X meshes */
 #ifdef NO_IRR_COMPILE_WITH_IRR_MESH_LOADER_
 #undef _IRR_COMPILE_WITH_IRR_MESH_LOADER_
 #endif
+//! Define _IRR_COMPILE_WITH_BINARY_MESH_LOADER_ if you want to load binary Irrlicht Engine .irrbmesh files
+#define _IRR_COMPILE_WITH_BINARY_MESH_LOADER_
+#ifdef NO_IRR_COMPILE_WITH_BINARY_MESH_LOADER_
+#undef _IRR_COMPILE_WITH_BINARY_MESH_LOADER_
+#endif
 //! Define _IRR_COMPILE_WITH_HALFLIFE_LOADER_ if you want to load Halflife animated files
 #define _IRR_COMPILE_WITH_HALFLIFE_LOADER_
 #ifdef NO_IRR_COMPILE_WITH_HALFLIFE_LOADER_
@@ -497,6 +524,11 @@ B3D, MS3D or X meshes */
 #ifdef NO_IRR_COMPILE_WITH_IRR_WRITER_
 #undef _IRR_COMPILE_WITH_IRR_WRITER_
 #endif
+//! Define _IRR_COMPILE_WITH_BINARY_MESH_WRITER_ if you want to write binary .irrbmesh files
+#define _IRR_COMPILE_WITH_BINARY_MESH_WRITER_
+#ifdef NO_IRR_COMPILE_WITH_BINARY_MESH_WRITER_
+#undef _IRR_COMPILE_WITH_BINARY_MESH_WRITER_
+#endif
 //! Define _IRR_COMPILE_WITH_COLLADA_WRITER_ if you want to write Collada files
 #define _IRR_COMPILE_WITH_COLLADA_WRITER_
 #ifdef NO_IRR_COMPILE_WITH_COLLADA_WRITER_
@@ -0,0 +1,655 @@
+// Copyright (C) 2002-2012 Nikolaus Gebhardt
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#ifndef __IRR_HASH_MAP_H_INCLUDED__
+#define __IRR_HASH_MAP_H_INCLUDED__
+
+#include "irrTypes.h"
+#include "irrMath.h"
+#include "irrAllocator.h"
+#include "irrString.h"
+#include "vector2d.h"
+#include "vector3d.h"
+#include "S3DVertex.h"
+
+namespace irr
+{
+namespace core
+{
+
+//! Mixes the bits of a 32 bit value, so that all input bits affect the low bits
+inline u32 hashMix(u32 h)
+{
+	h ^= h >> 16;
+	h *= 0x7feb352d;
+	h ^= h >> 15;
+	h *= 0x846ca68b;
+	h ^= h >> 16;
+	return h;
+}
+
+//! Combines a hash value with the hash of the next member of a key
+inline u32 hashCombine(u32 seed, u32 h)
+{
+	return seed ^ (h + 0x9e3779b9 + (seed << 6) + (seed >> 2));
+}
+
+//! Hash of a float value, 0 and -0 compare equal and so get the same hash
+inline u32 hashFloat(f32 f)
+{
+	return (f == 0.f) ? 0 : IR(f);
+}
+
+//! Hash function and key comparison used by hash_map and hash_set
+/** The default works for all integral types. Specialize it or pass an own
+traits class for other key types. equals() has to be consistent with hash(),
+so the specializations for vectors and vertices compare exactly instead of
+using the tolerance of their operator==. */
+template <class T>
+struct hash_traits
+{
+	static u32 hash(const T& key)
+	{
+		return hashMix((u32)key);
+	}
+
+	static bool equals(const T& a, const T& b)
+	{
+		return a == b;
+	}
+};
+
+template <class T>
+struct hash_traits<T*>
+{
+	static u32 hash(T* key)
+	{
+		const size_t v = (size_t)key;
+		return hashMix((u32)v ^ (u32)((v >> 16) >> 16));
+	}
+
+	static bool equals(T* a, T* b)
+	{
+		return a == b;
+	}
+};
+
+template <>
+struct hash_traits<s64>
+{
+	static u32 hash(s64 key) { return hashMix((u32)key ^ (u32)(key >> 32)); }
+	static bool equals(s64 a, s64 b) { return a == b; }
+};
+
+template <>
+struct hash_traits<u64>
+{
+	static u32 hash(u64 key) { return hashMix((u32)key ^ (u32)(key >> 32)); }
+	static bool equals(u64 a, u64 b) { return a == b; }
+};
+
+template <>
+struct hash_traits<f32>
+{
+	static u32 hash(f32 key) { return hashMix(hashFloat(key)); }
+	static bool equals(f32 a, f32 b) { return a == b; }
+};
+
+//! FNV-1a hash over the characters of a string
+template <class T, typename TAlloc>
+struct hash_traits< string<T, TAlloc> >
+{
+	static u32 hash(const string<T, TAlloc>& key)
+	{
+		u32 h = 2166136261u;
+		const T* c = key.c_str();
+		for (u32 i=0; i<key.size(); ++i)
+		{
+			h ^= (u32)c[i];
+			h *= 16777619u;
+		}
+		return h;
+	}
+
+	static bool equals(const string<T, TAlloc>& a, const string<T, TAlloc>& b)
+	{
+		return a == b;
+	}
+};
+
+template <class T>
+struct hash_traits< vector2d<T> >
+{
+	static u32 hash(const vector2d<T>& key)
+	{
+		return hashCombine(hash_traits<T>::hash(key.X), hash_traits<T>::hash(key.Y));
+	}
+
+	static bool equals(const vector2d<T>& a, const vector2d<T>& b)
+	{
+		return a.X == b.X && a.Y == b.Y;
+	}
+};
+
+template <class T>
+struct hash_traits< vector3d<T> >
+{
+	static u32 hash(const vector3d<T>& key)
+	{
+		return hashCombine(hashCombine(hash_traits<T>::hash(key.X),
+			hash_traits<T>::hash(key.Y)), hash_traits<T>::hash(key.Z));
+	}
+
+	static bool equals(const vector3d<T>& a, const vector3d<T>& b)
+	{
+		return a.X == b.X && a.Y == b.Y && a.Z == b.Z;
+	}
+};
+
+template <>
+struct hash_traits<video::S3DVertex>
+{
+	static u32 hash(const video::S3DVertex& key)
+	{
+		u32 h = hash_traits<vector3df>::hash(key.Pos);
+		h = hashCombine(h, hash_traits<vector3df>::hash(key.Normal));
+		h = hashCombine(h, key.Color.color);
+		return hashCombine(h, hash_traits<vector2df>::hash(key.TCoords));
+	}
+
+	static bool equals(const video::S3DVertex& a, const video::S3DVertex& b)
+	{
+		return hash_traits<vector3df>::equals(a.Pos, b.Pos) &&
+			hash_traits<vector3df>::equals(a.Normal, b.Normal) &&
+			a.Color == b.Color &&
+			hash_traits<vector2df>::equals(a.TCoords, b.TCoords);
+	}
+};
+
+template <>
+struct hash_traits<video::S3DVertex2TCoords>
+{
+	static u32 hash(const video::S3DVertex2TCoords& key)
+	{
+		return hashCombine(hash_traits<video::S3DVertex>::hash(key),
+			hash_traits<vector2df>::hash(key.TCoords2));
+	}
+
+	static bool equals(const video::S3DVertex2TCoords& a, const video::S3DVertex2TCoords& b)
+	{
+		return hash_traits<video::S3DVertex>::equals(a, b) &&
+			hash_traits<vector2df>::equals(a.TCoords2, b.TCoords2);
+	}
+};
+
+template <>
+struct hash_traits<video::S3DVertexTangents>
+{
+	static u32 hash(const video::S3DVertexTangents& key)
+	{
+		const u32 h = hashCombine(hash_traits<video::S3DVertex>::hash(key),
+			hash_traits<vector3df>::hash(key.Tangent));
+		return hashCombine(h, hash_traits<vector3df>::hash(key.Binormal));
+	}
+
+	static bool equals(const video::S3DVertexTangents& a, const video::S3DVertexTangents& b)
+	{
+		return hash_traits<video::S3DVertex>::equals(a, b) &&
+			hash_traits<vector3df>::equals(a.Tangent, b.Tangent) &&
+			hash_traits<vector3df>::equals(a.Binormal, b.Binormal);
+	}
+};
+
+
+//! Open addressing hash table, the common implementation of hash_map and hash_set
+/** Elements are stored in one flat array with linear probing. A second array
+holds the hashes of the used slots, so probing mostly scans a few adjacent
+integers and only compares keys when the hashes match. The capacity is always
+a power of two and kept at most 3/4 full. Inserting or removing elements
+invalidates all node pointers and iterators. */
+template <class KeyType, class NodeType, class Traits>
+class hash_table
+{
+public:
+
+	class ConstIterator;
+
+	//! Iterator over all elements, in no particular order
+	class Iterator
+	{
+	public:
+		Iterator() : Table(0), Slot(0) {}
+
+		bool atEnd() const { return !Table || Slot >= Table->Capacity; }
+
+		Iterator& operator++() { Slot = Table->nextSlot(Slot+1); return *this; }
+		Iterator operator++(s32) { Iterator tmp(*this); ++(*this); return tmp; }
+
+		NodeType& operator*() { return Table->Nodes[Slot]; }
+		NodeType* operator->() { return Table->Nodes + Slot; }
+		NodeType* getNode() { return Table->Nodes + Slot; }
+
+	private:
+		friend class hash_table;
+		friend class ConstIterator;
+		Iterator(hash_table* table, u32 slot) : Table(table), Slot(slot) {}
+
+		hash_table* Table;
+		u32 Slot;
+	};
+
+	//! Const iterator over all elements, in no particular order
+	class ConstIterator
+	{
+	public:
+		ConstIterator() : Table(0), Slot(0) {}
+		ConstIterator(const Iterator& src) : Table(src.Table), Slot(src.Slot) {}
+
+		bool atEnd() const { return !Table || Slot >= Table->Capacity; }
+
+		ConstIterator& operator++() { Slot = Table->nextSlot(Slot+1); return *this; }
+		ConstIterator operator++(s32) { ConstIterator tmp(*this); ++(*this); return tmp; }
+
+		const NodeType& operator*() const { return Table->Nodes[Slot]; }
+		const NodeType* operator->() const { return Table->Nodes + Slot; }
+		const NodeType* getNode() const { return Table->Nodes + Slot; }
+
+	private:
+		friend class hash_table;
+		ConstIterator(const hash_table* table, u32 slot) : Table(table), Slot(slot) {}
+
+		const hash_table* Table;
+		u32 Slot;
+	};
+
+	hash_table() : Nodes(0), Hashes(0), Capacity(0), Size(0) {}
+
+	hash_table(const hash_table& other) : Nodes(0), Hashes(0), Capacity(0), Size(0)
+	{
+		*this = other;
+	}
+
+	~hash_table()
+	{
+		clear();
+	}
+
+	hash_table& operator=(const hash_table& other)
+	{
+		if (this == &other)
+			return *this;
+
+		clear();
+		if (other.Size)
+		{
+			allocate(other.Capacity);
+			for (u32 i=0; i<Capacity; ++i)
+			{
+				if (other.Hashes[i])
+				{
+					Hashes[i] = other.Hashes[i];
+					NodeAllocator.construct(Nodes+i, other.Nodes[i]);
+				}
+			}
+			Size = other.Size;
+		}
+		return *this;
+	}
+
+	//! Returns the number of elements
+	u32 size() const
+	{
+		return Size;
+	}
+
+	//! Returns true if there are no elements
+	bool empty() const
+	{
+		return Size == 0;
+	}
+
+	//! Removes all elements and frees the memory
+	void clear()
+	{
+		for (u32 i=0; i<Capacity; ++i)
+		{
+			if (Hashes[i])
+				NodeAllocator.destruct(Nodes+i);
+		}
+		NodeAllocator.deallocate(Nodes);
+		HashAllocator.deallocate(Hashes);
+		Nodes = 0;
+		Hashes = 0;
+		Capacity = 0;
+		Size = 0;
+	}
+
+	//! Reserves space, so that count elements can be added without rehashing
+	void reallocate(u32 count)
+	{
+		u32 newCapacity = 16;
+		while (newCapacity - newCapacity/4 < count)
+			newCapacity <<= 1;
+
+		if (newCapacity > Capacity)
+			rehash(newCapacity);
+	}
+
+	//! Swaps the content of two tables in constant time
+	void swap(hash_table& other)
+	{
+		core::swap(Nodes, other.Nodes);
+		core::swap(Hashes, other.Hashes);
+		core::swap(Capacity, other.Capacity);
+		core::swap(Size, other.Size);
+	}
+
+	//! Returns an iterator to the first element
+	Iterator getIterator()
+	{
+		return Iterator(this, nextSlot(0));
+	}
+
+	//! Returns a const iterator to the first element
+	ConstIterator getConstIterator() const
+	{
+		return ConstIterator(this, nextSlot(0));
+	}
+
+protected:
+
+	//! Hash of a key as stored in the table, the high bit marks used slots
+	static u32 hashKey(const KeyType& key)
+	{
+		return Traits::hash(key) | 0x80000000;
+	}
+
+	//! Returns the slot of a key or -1 if it is not in the table
+	s32 findSlot(const KeyType& key, u32 hash) const
+	{
+		if (!Size)
+			return -1;
+
+		const u32 mask = Capacity-1;
+		for (u32 i=hash & mask; Hashes[i]; i=(i+1) & mask)
+		{
+			if (Hashes[i] == hash && Traits::equals(Nodes[i].getKey(), key))
+				return (s32)i;
+		}
+		return -1;
+	}
+
+	//! Reserves a slot for a key which is not in the table yet
+	/** The caller has to construct the node in the returned slot. */
+	u32 addSlot(u32 hash)
+	{
+		if ((Size+1)*4 > Capacity*3)
+			rehash(Capacity ? Capacity*2 : 16);
+
+		const u32 mask = Capacity-1;
+		u32 i = hash & mask;
+		while (Hashes[i])
+			i = (i+1) & mask;
+
+		Hashes[i] = hash;
+		++Size;
+		return i;
+	}
+
+	//! Removes the element in a slot
+	/** Instead of leaving a tombstone, following elements of the same probe
+	sequence are moved back, so lookups never get slower by removing. */
+	void removeSlot(u32 slot)
+	{
+		NodeAllocator.destruct(Nodes+slot);
+		Hashes[slot] = 0;
+		--Size;
+
+		const u32 mask = Capacity-1;
+		u32 hole = slot;
+		for (u32 i=(slot+1) & mask; Hashes[i]; i=(i+1) & mask)
+		{
+			// the element may move if the hole lies between its home slot and its slot
+			const u32 home = Hashes[i] & mask;
+			if (((i - home) & mask) >= ((i - hole) & mask))
+			{
+				Hashes[hole] = Hashes[i];
+				NodeAllocator.construct(Nodes+hole, Nodes[i]);
+				NodeAllocator.destruct(Nodes+i);
+				Hashes[i] = 0;
+				hole = i;
+			}
+		}
+	}
+
+	//! Returns the first used slot starting at slot, or Capacity
+	u32 nextSlot(u32 slot) const
+	{
+		while (slot < Capacity && !Hashes[slot])
+			++slot;
+		return slot;
+	}
+
+	NodeType* Nodes;
+
+private:
+
+	void allocate(u32 capacity)
+	{
+		Nodes = NodeAllocator.allocate(capacity);
+		Hashes = HashAllocator.allocate(capacity);
+		memset(Hashes, 0, capacity*sizeof(u32));
+		Capacity = capacity;
+	}
+
+	void rehash(u32 newCapacity)
+	{
+		NodeType* oldNodes = Nodes;
+		u32* oldHashes = Hashes;
+		const u32 oldCapacity = Capacity;
+
+		allocate(newCapacity);
+
+		const u32 mask = Capacity-1;
+		for (u32 i=0; i<oldCapacity; ++i)
+		{
+			if (!oldHashes[i])
+				continue;
+
+			u32 j = oldHashes[i] & mask;
+			while (Hashes[j])
+				j = (j+1) & mask;
+
+			Hashes[j] = oldHashes[i];
+			NodeAllocator.construct(Nodes+j, oldNodes[i]);
+			NodeAllocator.destruct(oldNodes+i);
+		}
+
+		NodeAllocator.deallocate(oldNodes);
+		HashAllocator.deallocate(oldHashes);
+	}
+
+	u32* Hashes;
+	u32 Capacity;
+	u32 Size;
+	irrAllocator<NodeType> NodeAllocator;
+	irrAllocator<u32> HashAllocator;
+};
+
+
+//! Key/value pair stored in a hash_map
+template <class KeyType, class ValueType>
+class hash_map_node
+{
+public:
+
+	hash_map_node(const KeyType& key, const ValueType& value)
+		: Key(key), Value(value) {}
+
+	const KeyType& getKey() const
+	{
+		return Key;
+	}
+
+	ValueType& getValue()
+	{
+		return Value;
+	}
+
+	const ValueType& getValue() const
+	{
+		return Value;
+	}
+
+	void setValue(const ValueType& value)
+	{
+		Value = value;
+	}
+
+private:
+
+	KeyType Key;
+	ValueType Value;
+};
+
+
+//! Hash map template for associative arrays with fast lookups
+/** Has the interface of core::map, but keeps the elements unsorted in a flat
+open addressing table, so finding an element costs a hash and usually one or
+two key compares instead of walking a tree of separately allocated nodes.
+Keys need a hash_traits specialization or an own traits class. */
+template <class KeyType, class ValueType, class Traits = hash_traits<KeyType> >
+class hash_map : public hash_table<KeyType, hash_map_node<KeyType, ValueType>, Traits>
+{
+public:
+
+	typedef hash_map_node<KeyType, ValueType> Node;
+
+	//! Inserts a new element
+	/** \return False if the key is already in the map, the map is not changed then. */
+	bool insert(const KeyType& key, const ValueType& value)
+	{
+		const u32 hash = this->hashKey(key);
+		if (this->findSlot(key, hash) >= 0)
+			return false;
+
+		const u32 slot = this->addSlot(hash);
+		new ((void*)(this->Nodes+slot)) Node(key, value);
+		return true;
+	}
+
+	//! Replaces the value of an element or inserts a new one
+	void set(const KeyType& key, const ValueType& value)
+	{
+		const u32 hash = this->hashKey(key);
+		const s32 slot = this->findSlot(key, hash);
+		if (slot >= 0)
+			this->Nodes[slot].setValue(value);
+		else
+		{
+			// addSlot may move the nodes, so it has to be called first
+			const u32 newSlot = this->addSlot(hash);
+			new ((void*)(this->Nodes+newSlot)) Node(key, value);
+		}
+	}
+
+	//! Returns the element with the key or 0 if there is none
+	/** The pointer becomes invalid with the next insertion or removal. */
+	Node* find(const KeyType& key) const
+	{
+		const s32 slot = this->findSlot(key, this->hashKey(key));
+		return (slot >= 0) ? this->Nodes + slot : 0;
+	}
+
+	//! Removes the element with the key
+	/** \return False if there was no such element. */
+	bool remove(const KeyType& key)
+	{
+		const s32 slot = this->findSlot(key, this->hashKey(key));
+		if (slot < 0)
+			return false;
+
+		this->removeSlot((u32)slot);
+		return true;
+	}
+
+	//! Returns the value of the key, a default constructed value is inserted if it is missing
+	ValueType& operator[](const KeyType& key)
+	{
+		const u32 hash = this->hashKey(key);
+		s32 slot = this->findSlot(key, hash);
+		if (slot < 0)
+		{
+			slot = (s32)this->addSlot(hash);
+			new ((void*)(this->Nodes+slot)) Node(key, ValueType());
+		}
+		return this->Nodes[slot].getValue();
+	}
+};
+
+
+//! Key stored in a hash_set
+template <class KeyType>
+class hash_set_node
+{
+public:
+
+	hash_set_node(const KeyType& key) : Key(key) {}
+
+	const KeyType& getKey() const
+	{
+		return Key;
+	}
+
+private:
+
+	KeyType Key;
+};
+
+
+//! Hash set template, an unsorted collection of unique keys
+template <class KeyType, class Traits = hash_traits<KeyType> >
+class hash_set : public hash_table<KeyType, hash_set_node<KeyType>, Traits>
+{
+public:
+
+	typedef hash_set_node<KeyType> Node;
+
+	//! Inserts a key
+	/** \return False if the key was already in the set. */
+	bool insert(const KeyType& key)
+	{
+		const u32 hash = this->hashKey(key);
+		if (this->findSlot(key, hash) >= 0)
+			return false;
+
+		const u32 slot = this->addSlot(hash);
+		new ((void*)(this->Nodes+slot)) Node(key);
+		return true;
+	}
+
+	//! Returns true if the key is in the set
+	bool contains(const KeyType& key) const
+	{
+		return this->findSlot(key, this->hashKey(key)) >= 0;
+	}
+
+	//! Removes a key
+	/** \return False if the key was not in the set. */
+	bool remove(const KeyType& key)
+	{
+		const s32 slot = this->findSlot(key, this->hashKey(key));
+		if (slot < 0)
+			return false;
+
+		this->removeSlot((u32)slot);
+		return true;
+	}
+};
+
+} // end namespace core
+} // end namespace irr
+
+#endif
+
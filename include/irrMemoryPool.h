@@ -0,0 +1,235 @@
+// Copyright (C) 2002-2012 Nikolaus Gebhardt
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#ifndef __IRR_MEMORY_POOL_H_INCLUDED__
+#define __IRR_MEMORY_POOL_H_INCLUDED__
+
+#include "IrrCompileConfig.h"
+#include "irrTypes.h"
+#include "irrArray.h"
+
+namespace irr
+{
+namespace core
+{
+
+#ifdef DEBUG_CLIENTBLOCK
+#undef DEBUG_CLIENTBLOCK
+#define DEBUG_CLIENTBLOCK new
+#endif
+
+//! Hands out blocks of one fixed size from larger chunks
+/** Freed blocks are kept in a free list and reused by the next allocations,
+the chunks are only released when the pool is destroyed. This avoids the
+heap for many small objects of the same size which are created and destroyed
+often. The pool is not thread safe. */
+class memoryPool
+{
+public:
+
+	//! Constructor
+	/** \param blockSize Size of each block in bytes, it is rounded up to a
+	multiple of the pointer size.
+	\param blocksPerChunk Number of blocks allocated at once when the pool
+	runs out of free blocks. */
+	memoryPool(size_t blockSize, u32 blocksPerChunk=64)
+		: FreeList(0), BlocksPerChunk(blocksPerChunk ? blocksPerChunk : 1), Allocated(0)
+	{
+		BlockSize = (blockSize + sizeof(SFreeBlock) - 1) / sizeof(SFreeBlock) * sizeof(SFreeBlock);
+		if (!BlockSize)
+			BlockSize = sizeof(SFreeBlock);
+	}
+
+	//! Destructor, releases all chunks
+	/** Blocks which are still allocated become invalid. */
+	~memoryPool()
+	{
+		for (u32 i=0; i<Chunks.size(); ++i)
+			delete [] Chunks[i];
+	}
+
+	//! Returns a block of getBlockSize() bytes
+	void* allocate()
+	{
+		if (!FreeList)
+			grow();
+
+		SFreeBlock* block = FreeList;
+		FreeList = block->Next;
+		++Allocated;
+		return block;
+	}
+
+	//! Returns a block to the pool
+	/** \param ptr Block returned by allocate() of this pool, or 0. */
+	void deallocate(void* ptr)
+	{
+		if (!ptr)
+			return;
+
+		SFreeBlock* block = (SFreeBlock*)ptr;
+		block->Next = FreeList;
+		FreeList = block;
+		--Allocated;
+	}
+
+	//! Returns the size of the blocks in bytes
+	size_t getBlockSize() const
+	{
+		return BlockSize;
+	}
+
+	//! Returns the number of blocks which are currently allocated
+	u32 getAllocatedCount() const
+	{
+		return Allocated;
+	}
+
+	//! Returns the memory reserved by all chunks in bytes
+	size_t getReservedSize() const
+	{
+		return Chunks.size() * BlocksPerChunk * BlockSize;
+	}
+
+private:
+
+	struct SFreeBlock
+	{
+		SFreeBlock* Next;
+	};
+
+	// no copies, the free list points into the chunks
+	memoryPool(const memoryPool& other);
+	memoryPool& operator=(const memoryPool& other);
+
+	//! adds a chunk and links its blocks into the free list
+	void grow()
+	{
+		u8* chunk = new u8[BlocksPerChunk * BlockSize];
+		Chunks.push_back(chunk);
+
+		// in address order, so that consecutive allocations are close together
+		for (u32 i=BlocksPerChunk; i>0; --i)
+		{
+			SFreeBlock* block = (SFreeBlock*)(chunk + (i-1) * BlockSize);
+			block->Next = FreeList;
+			FreeList = block;
+		}
+	}
+
+	array<u8*> Chunks;
+	SFreeBlock* FreeList;
+	size_t BlockSize;
+	u32 BlocksPerChunk;
+	u32 Allocated;
+};
+
+
+//! Types of objects which the engine allocates from its own pools
+enum E_OBJECT_POOL
+{
+	//! Scene nodes, all classes derived from scene::ISceneNode
+	EOP_SCENE_NODE = 0,
+
+	//! Scene node animators, all classes derived from scene::ISceneNodeAnimator
+	EOP_SCENE_NODE_ANIMATOR,
+
+	//! Not used, counts the number of pools
+	EOP_COUNT
+};
+
+//! Allocation statistics of one type of pooled objects
+struct SObjectPoolStatistics
+{
+	SObjectPoolStatistics() : Allocations(0), Deallocations(0), ReservedBytes(0) {}
+
+	//! Number of objects allocated since the start
+	u32 Allocations;
+
+	//! Number of objects released since the start
+	u32 Deallocations;
+
+	//! Memory held by the pools of this type in bytes, including free blocks
+	u32 ReservedBytes;
+};
+
+//! Allocates an object from the engine pools
+/** Objects of the same size share a pool. Large objects, and all objects
+when the engine is compiled without _IRR_USE_OBJECT_POOLS_, come from the
+heap. The memory always belongs to the engine, so objects can be created and
+destroyed on different sides of a dll boundary.
+
+The pools and the statistics are global to the process and not locked.
+allocateObject() and deallocateObject() must not be called by several threads
+at the same time, which means that scene nodes and animators, also of
+different devices, are only created and deleted by one thread at a time.
+\param size Size of the object in bytes.
+\param type Type of the object, each type has its own pools.
+\return Memory for the object. */
+IRRLICHT_API void* IRRCALLCONV allocateObject(size_t size, E_OBJECT_POOL type);
+
+//! Returns an object to the engine pools
+/** \param ptr Memory returned by allocateObject, or 0.
+\param size Same size as passed to allocateObject.
+\param type Same type as passed to allocateObject. */
+IRRLICHT_API void IRRCALLCONV deallocateObject(void* ptr, size_t size, E_OBJECT_POOL type);
+
+//! Returns the allocation statistics of one type of pooled objects
+IRRLICHT_API SObjectPoolStatistics IRRCALLCONV getObjectPoolStatistics(E_OBJECT_POOL type);
+
+
+//! Base class for objects which are allocated from the engine pools
+/** Deleting an object through a pointer to a base class passes the size of
+the most derived class, so all classes deriving from a pooled class need a
+virtual destructor, as IReferenceCounted has. */
+template<E_OBJECT_POOL Type>
+class pooledObject
+{
+public:
+
+	static void* operator new(size_t size)
+	{
+		return allocateObject(size, Type);
+	}
+
+	static void operator delete(void* ptr, size_t size)
+	{
+		deallocateObject(ptr, size, Type);
+	}
+
+	//! Placement new, the class specific new hides the global one
+	static void* operator new(size_t size, void* place)
+	{
+		return place;
+	}
+
+	static void operator delete(void* ptr, void* place)
+	{
+	}
+
+#if defined(_CRTDBG_MAP_ALLOC)
+	//! Used by the memory debugging of the debug engine with Visual Studio
+	static void* operator new(size_t size, int blockType, const char* file, int line)
+	{
+		return allocateObject(size, Type);
+	}
+
+	//! Only called when a constructor throws, which the engine never does
+	static void operator delete(void* ptr, int blockType, const char* file, int line)
+	{
+	}
+#endif
+};
+
+
+#ifdef DEBUG_CLIENTBLOCK
+#undef DEBUG_CLIENTBLOCK
+#define DEBUG_CLIENTBLOCK new( _CLIENT_BLOCK, __FILE__, __LINE__)
+#endif
+
+} // end namespace core
+} // end namespace irr
+
+#endif
+
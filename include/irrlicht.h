@@ -65,6 +65,7 @@
 #include "IBillboardTextSceneNode.h"
 #include "IBoneSceneNode.h"
 #include "ICameraSceneNode.h"
+#include "ICommandList.h"
 #include "ICursorControl.h"
 #include "IDummyTransformationSceneNode.h"
 #include "IMeshBuffer.h"
@@ -124,10 +125,12 @@
 #include "IReadFile.h"
 #include "IReferenceCounted.h"
 #include "irrArray.h"
+#include "irrMemoryPool.h"
 #include "IRandomizer.h"
 #include "IrrlichtDevice.h"
 #include "irrList.h"
 #include "irrMap.h"
+#include "irrHashMap.h"
 #include "irrMath.h"
 #include "irrString.h"
 #include "irrTypes.h"
@@ -148,6 +151,7 @@
 #include "IShadowVolumeSceneNode.h"
 #include "ISkinnedMesh.h"
 #include "ITerrainSceneNode.h"
+#include "IPagedTerrainSceneNode.h"
 #include "IInstancedMeshSceneNode.h"
 #include "ITextSceneNode.h"
 #include "ITexture.h"
@@ -12,6 +12,7 @@
 #include "aabbox3d.h"
 #include "rect.h"
 #include "irrString.h"
+#include "matrix4SSE.h"
 
 // enable this to keep track of changes to the matrix
 // and make simpler identity check for seldomly changing matrices
@@ -251,6 +252,24 @@ namespace core
 			is slower than transformBox(). */
 			void transformBoxEx(core::aabbox3d<f32>& box) const;
 
+			//! Transforms an array of vectors by this matrix
+			/** \param out Destination of the transformed vectors, may be the same as in.
+			\param in Vectors to transform.
+			\param count Amount of vectors.
+			\param outStride Distance in bytes between the destination vectors,
+			e.g. the vertex size when transforming the positions of vertices.
+			\param inStride Distance in bytes between the source vectors. */
+			void transformVects(vector3df* out, const vector3df* in, u32 count,
+				u32 outStride=sizeof(vector3df), u32 inStride=sizeof(vector3df)) const;
+
+			//! Rotates an array of vectors by the rotation part of this matrix
+			/** Parameters as in transformVects(). */
+			void rotateVects(vector3df* out, const vector3df* in, u32 count,
+				u32 outStride=sizeof(vector3df), u32 inStride=sizeof(vector3df)) const;
+
+			//! Transforms an array of axis aligned bounding boxes like transformBoxEx()
+			void transformBoxesEx(core::aabbox3d<f32>* boxes, u32 count) const;
+
 			//! Multiplies this matrix by a 1x4 matrix
 			void multiplyWith1x4Matrix(T* matrix) const;
 
@@ -662,6 +681,16 @@ namespace core
 		const T *m1 = other_a.M;
 		const T *m2 = other_b.M;
 
+#if defined(_IRR_USE_SSE_)
+		if (sse::multiply(M, m1, m2))
+		{
+#if defined ( USE_MATRIX_TEST )
+			definitelyIdentityMatrix=false;
+#endif
+			return *this;
+		}
+#endif
+
 		M[0] = m1[0]*m2[0] + m1[4]*m2[1] + m1[8]*m2[2] + m1[12]*m2[3];
 		M[1] = m1[1]*m2[0] + m1[5]*m2[1] + m1[9]*m2[2] + m1[13]*m2[3];
 		M[2] = m1[2]*m2[0] + m1[6]*m2[1] + m1[10]*m2[2] + m1[14]*m2[3];
@@ -1179,6 +1208,10 @@ namespace core
 	template <class T>
 	inline void CMatrix4<T>::transformVect(T *out, const core::vector3df &in) const
 	{
+#if defined(_IRR_USE_SSE_)
+		if (sse::transformVect(M, out, in))
+			return;
+#endif
 		out[0] = in.X*M[0] + in.Y*M[4] + in.Z*M[8] + M[12];
 		out[1] = in.X*M[1] + in.Y*M[5] + in.Z*M[9] + M[13];
 		out[2] = in.X*M[2] + in.Y*M[6] + in.Z*M[10] + M[14];
@@ -1241,6 +1274,11 @@ namespace core
 			return;
 #endif
 
+#if defined(_IRR_USE_SSE_)
+		if (sse::transformBoxesEx(M, &box, 1))
+			return;
+#endif
+
 		const f32 Amin[3] = {box.MinEdge.X, box.MinEdge.Y, box.MinEdge.Z};
 		const f32 Amax[3] = {box.MaxEdge.X, box.MaxEdge.Y, box.MaxEdge.Z};
 
@@ -1283,6 +1321,67 @@ namespace core
 	}
 
 
+	//! Transforms an array of vectors by this matrix
+	template <class T>
+	inline void CMatrix4<T>::transformVects(vector3df* out, const vector3df* in, u32 count,
+		u32 outStride, u32 inStride) const
+	{
+#if defined(_IRR_USE_SSE_)
+		if (sse::transformVects(M, out, in, count, outStride, inStride, true))
+			return;
+#endif
+
+		const u8* src = (const u8*)in;
+		u8* dst = (u8*)out;
+		for (u32 i = 0; i < count; ++i)
+		{
+			transformVect(*(vector3df*)dst, vector3df(*(const vector3df*)src));
+			src += inStride;
+			dst += outStride;
+		}
+	}
+
+
+	//! Rotates an array of vectors by the rotation part of this matrix
+	template <class T>
+	inline void CMatrix4<T>::rotateVects(vector3df* out, const vector3df* in, u32 count,
+		u32 outStride, u32 inStride) const
+	{
+#if defined(_IRR_USE_SSE_)
+		if (sse::transformVects(M, out, in, count, outStride, inStride, false))
+			return;
+#endif
+
+		const u8* src = (const u8*)in;
+		u8* dst = (u8*)out;
+		for (u32 i = 0; i < count; ++i)
+		{
+			rotateVect(*(vector3df*)dst, vector3df(*(const vector3df*)src));
+			src += inStride;
+			dst += outStride;
+		}
+	}
+
+
+	//! Transforms an array of axis aligned bounding boxes
+	template <class T>
+	inline void CMatrix4<T>::transformBoxesEx(core::aabbox3d<f32>* boxes, u32 count) const
+	{
+#if defined ( USE_MATRIX_TEST )
+		if (isIdentity())
+			return;
+#endif
+
+#if defined(_IRR_USE_SSE_)
+		if (sse::transformBoxesEx(M, boxes, count))
+			return;
+#endif
+
+		for (u32 i = 0; i < count; ++i)
+			transformBoxEx(boxes[i]);
+	}
+
+
 	//! Multiplies this matrix by a 1x4 matrix
 	template <class T>
 	inline void CMatrix4<T>::multiplyWith1x4Matrix(T* matrix) const
@@ -1337,6 +1436,18 @@ namespace core
 			return true;
 		}
 #endif
+
+#if defined(_IRR_USE_SSE_)
+		bool invertible;
+		if (sse::inverse(M, out.M, invertible))
+		{
+#if defined ( USE_MATRIX_TEST )
+			out.definitelyIdentityMatrix = definitelyIdentityMatrix;
+#endif
+			return invertible;
+		}
+#endif
+
 		const CMatrix4<T> &m = *this;
 
 		f32 d = (m(0, 0) * m(1, 1) - m(0, 1) * m(1, 0)) * (m(2, 2) * m(3, 3) - m(2, 3) * m(3, 2)) -
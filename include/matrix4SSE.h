@@ -0,0 +1,303 @@
+// Copyright (C) 2002-2012 Nikolaus Gebhardt
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#ifndef __IRR_MATRIX_SSE_H_INCLUDED__
+#define __IRR_MATRIX_SSE_H_INCLUDED__
+
+#include "IrrCompileConfig.h"
+
+#if defined(_IRR_USE_SSE_)
+
+#include "irrMath.h"
+#include "vector3d.h"
+#include "aabbox3d.h"
+#include <xmmintrin.h>
+
+namespace irr
+{
+namespace core
+{
+//! SSE kernels of the matrix4 operations, used when _IRR_USE_SSE_ is defined.
+/** The kernels work on the 16 values of a matrix4 in the layout of
+CMatrix4::M. Each one returns false for matrices of other types than f32,
+those use the scalar code of CMatrix4. The results are the same as those of
+the scalar code, except for the inverse, which rounds differently. */
+namespace sse
+{
+	// rows of the matrix
+	struct SRows
+	{
+		SRows(const f32* m)
+		{
+			R[0] = _mm_loadu_ps(m);
+			R[1] = _mm_loadu_ps(m + 4);
+			R[2] = _mm_loadu_ps(m + 8);
+			R[3] = _mm_loadu_ps(m + 12);
+		}
+
+		__m128 R[4];
+	};
+
+	// x*R0 + y*R1 + z*R2, in the order of the scalar code
+	inline __m128 rotate(const SRows& m, const __m128 x, const __m128 y, const __m128 z)
+	{
+		__m128 r = _mm_mul_ps(m.R[0], x);
+		r = _mm_add_ps(r, _mm_mul_ps(m.R[1], y));
+		return _mm_add_ps(r, _mm_mul_ps(m.R[2], z));
+	}
+
+	// stores the first three values of a register
+	inline void store3(f32* out, const __m128 r)
+	{
+		_mm_storel_pi((__m64*)out, r);
+		_mm_store_ss(out + 2, _mm_movehl_ps(r, r));
+	}
+
+	//! out = m1 * m2, out must be another matrix than m1 and m2
+	template <class T>
+	inline bool multiply(T* out, const T* m1, const T* m2)
+	{
+		return false;
+	}
+
+	inline bool multiply(f32* out, const f32* m1, const f32* m2)
+	{
+		const SRows a(m1);
+
+		for (u32 i = 0; i < 16; i += 4)
+		{
+			const __m128 b = _mm_loadu_ps(m2 + i);
+			__m128 r = rotate(a, _mm_shuffle_ps(b, b, 0x00), _mm_shuffle_ps(b, b, 0x55), _mm_shuffle_ps(b, b, 0xAA));
+			r = _mm_add_ps(r, _mm_mul_ps(a.R[3], _mm_shuffle_ps(b, b, 0xFF)));
+			_mm_storeu_ps(out + i, r);
+		}
+
+		return true;
+	}
+
+	//! Transforms a vector into 4 floats, including w
+	template <class T>
+	inline bool transformVect(const T* m, T* out, const vector3df& in)
+	{
+		return false;
+	}
+
+	inline bool transformVect(const f32* m, f32* out, const vector3df& in)
+	{
+		const SRows rows(m);
+		const __m128 r = rotate(rows, _mm_set1_ps(in.X), _mm_set1_ps(in.Y), _mm_set1_ps(in.Z));
+		_mm_storeu_ps(out, _mm_add_ps(r, rows.R[3]));
+		return true;
+	}
+
+	//! Transforms or rotates vectors with a byte stride, in may be out
+	template <class T>
+	inline bool transformVects(const T* m, vector3df* out, const vector3df* in,
+		u32 count, u32 outStride, u32 inStride, bool translate)
+	{
+		return false;
+	}
+
+	inline bool transformVects(const f32* m, vector3df* out, const vector3df* in,
+		u32 count, u32 outStride, u32 inStride, bool translate)
+	{
+		const SRows rows(m);
+		const __m128 t = translate ? rows.R[3] : _mm_setzero_ps();
+
+		const u8* src = (const u8*)in;
+		u8* dst = (u8*)out;
+		u32 i = 0;
+
+		// packed vectors are transposed, four at once, so that each register holds one coordinate
+		if (inStride == sizeof(vector3df) && outStride == sizeof(vector3df))
+		{
+			const __m128 m0 = _mm_set1_ps(m[0]), m1 = _mm_set1_ps(m[1]), m2 = _mm_set1_ps(m[2]);
+			const __m128 m4 = _mm_set1_ps(m[4]), m5 = _mm_set1_ps(m[5]), m6 = _mm_set1_ps(m[6]);
+			const __m128 m8 = _mm_set1_ps(m[8]), m9 = _mm_set1_ps(m[9]), m10 = _mm_set1_ps(m[10]);
+			const __m128 m12 = _mm_set1_ps(translate ? m[12] : 0.f);
+			const __m128 m13 = _mm_set1_ps(translate ? m[13] : 0.f);
+			const __m128 m14 = _mm_set1_ps(translate ? m[14] : 0.f);
+
+			for (; i + 4 <= count; i += 4)
+			{
+				// x0 y0 z0 x1, y1 z1 x2 y2, z2 x3 y3 z3
+				const __m128 a = _mm_loadu_ps((const f32*)src);
+				const __m128 b = _mm_loadu_ps((const f32*)src + 4);
+				const __m128 c = _mm_loadu_ps((const f32*)src + 8);
+
+				const __m128 xy23 = _mm_shuffle_ps(b, c, _MM_SHUFFLE(2,1,3,2));
+				const __m128 x = _mm_shuffle_ps(a, xy23, _MM_SHUFFLE(2,0,3,0));
+				const __m128 y = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(0,0,1,1)), xy23, _MM_SHUFFLE(3,1,2,0));
+				const __m128 z = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(1,1,2,2)),
+					_mm_shuffle_ps(c, c, _MM_SHUFFLE(3,0,3,0)), _MM_SHUFFLE(1,0,2,0));
+
+				const __m128 ox = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, m0), _mm_mul_ps(y, m4)), _mm_mul_ps(z, m8)), m12);
+				const __m128 oy = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, m1), _mm_mul_ps(y, m5)), _mm_mul_ps(z, m9)), m13);
+				const __m128 oz = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, m2), _mm_mul_ps(y, m6)), _mm_mul_ps(z, m10)), m14);
+
+				// and back
+				f32* o = (f32*)dst;
+				_mm_storeu_ps(o, _mm_shuffle_ps(_mm_shuffle_ps(ox, oy, _MM_SHUFFLE(0,0,0,0)),
+					_mm_shuffle_ps(oz, ox, _MM_SHUFFLE(1,1,0,0)), _MM_SHUFFLE(2,0,2,0)));
+				_mm_storeu_ps(o + 4, _mm_shuffle_ps(_mm_shuffle_ps(oy, oz, _MM_SHUFFLE(1,1,1,1)),
+					_mm_shuffle_ps(ox, oy, _MM_SHUFFLE(2,2,2,2)), _MM_SHUFFLE(2,0,2,0)));
+				_mm_storeu_ps(o + 8, _mm_shuffle_ps(_mm_shuffle_ps(oz, ox, _MM_SHUFFLE(3,3,2,2)),
+					_mm_shuffle_ps(oy, oz, _MM_SHUFFLE(3,3,3,3)), _MM_SHUFFLE(2,0,2,0)));
+
+				src += 4 * sizeof(vector3df);
+				dst += 4 * sizeof(vector3df);
+			}
+		}
+
+		for (; i < count; ++i)
+		{
+			const vector3df& v = *(const vector3df*)src;
+			const __m128 r = rotate(rows, _mm_set1_ps(v.X), _mm_set1_ps(v.Y), _mm_set1_ps(v.Z));
+			store3(&((vector3df*)dst)->X, translate ? _mm_add_ps(r, t) : r);
+
+			src += inStride;
+			dst += outStride;
+		}
+
+		return true;
+	}
+
+	//! Transforms boxes like CMatrix4::transformBoxEx
+	template <class T>
+	inline bool transformBoxesEx(const T* m, aabbox3d<f32>* boxes, u32 count)
+	{
+		return false;
+	}
+
+	inline bool transformBoxesEx(const f32* m, aabbox3d<f32>* boxes, u32 count)
+	{
+		const SRows rows(m);
+
+		for (u32 i = 0; i < count; ++i)
+		{
+			aabbox3d<f32>& box = boxes[i];
+			const f32* amin = &box.MinEdge.X;
+			const f32* amax = &box.MaxEdge.X;
+
+			__m128 bmin = rows.R[3];
+			__m128 bmax = rows.R[3];
+
+			for (u32 j = 0; j < 3; ++j)
+			{
+				const __m128 a = _mm_mul_ps(rows.R[j], _mm_set1_ps(amin[j]));
+				const __m128 b = _mm_mul_ps(rows.R[j], _mm_set1_ps(amax[j]));
+				bmin = _mm_add_ps(bmin, _mm_min_ps(a, b));
+				bmax = _mm_add_ps(bmax, _mm_max_ps(a, b));
+			}
+
+			store3(&box.MinEdge.X, bmin);
+			store3(&box.MaxEdge.X, bmax);
+		}
+
+		return true;
+	}
+
+	//! Inverse by Cramer's rule, with the cofactors of four values at once
+	/** \param invertible Set to false if the matrix has no inverse. */
+	template <class T>
+	inline bool inverse(const T* m, T* out, bool& invertible)
+	{
+		return false;
+	}
+
+	inline bool inverse(const f32* m, f32* out, bool& invertible)
+	{
+		// the matrix is loaded transposed
+		__m128 tmp = _mm_loadh_pi(_mm_loadl_pi(_mm_setzero_ps(), (const __m64*)(m)), (const __m64*)(m + 4));
+		__m128 row1 = _mm_loadh_pi(_mm_loadl_pi(_mm_setzero_ps(), (const __m64*)(m + 8)), (const __m64*)(m + 12));
+		__m128 row0 = _mm_shuffle_ps(tmp, row1, 0x88);
+		row1 = _mm_shuffle_ps(row1, tmp, 0xDD);
+		tmp = _mm_loadh_pi(_mm_loadl_pi(_mm_setzero_ps(), (const __m64*)(m + 2)), (const __m64*)(m + 6));
+		__m128 row3 = _mm_loadh_pi(_mm_loadl_pi(_mm_setzero_ps(), (const __m64*)(m + 10)), (const __m64*)(m + 14));
+		__m128 row2 = _mm_shuffle_ps(tmp, row3, 0x88);
+		row3 = _mm_shuffle_ps(row3, tmp, 0xDD);
+
+		__m128 minor0, minor1, minor2, minor3;
+
+		tmp = _mm_mul_ps(row2, row3);
+		tmp = _mm_shuffle_ps(tmp, tmp, 0xB1);
+		minor0 = _mm_mul_ps(row1, tmp);
+		minor1 = _mm_mul_ps(row0, tmp);
+		tmp = _mm_shuffle_ps(tmp, tmp, 0x4E);
+		minor0 = _mm_sub_ps(_mm_mul_ps(row1, tmp), minor0);
+		minor1 = _mm_sub_ps(_mm_mul_ps(row0, tmp), minor1);
+		minor1 = _mm_shuffle_ps(minor1, minor1, 0x4E);
+
+		tmp = _mm_mul_ps(row1, row2);
+		tmp = _mm_shuffle_ps(tmp, tmp, 0xB1);
+		minor0 = _mm_add_ps(_mm_mul_ps(row3, tmp), minor0);
+		minor3 = _mm_mul_ps(row0, tmp);
+		tmp = _mm_shuffle_ps(tmp, tmp, 0x4E);
+		minor0 = _mm_sub_ps(minor0, _mm_mul_ps(row3, tmp));
+		minor3 = _mm_sub_ps(_mm_mul_ps(row0, tmp), minor3);
+		minor3 = _mm_shuffle_ps(minor3, minor3, 0x4E);
+
+		tmp = _mm_mul_ps(_mm_shuffle_ps(row1, row1, 0x4E), row3);
+		tmp = _mm_shuffle_ps(tmp, tmp, 0xB1);
+		row2 = _mm_shuffle_ps(row2, row2, 0x4E);
+		minor0 = _mm_add_ps(_mm_mul_ps(row2, tmp), minor0);
+		minor2 = _mm_mul_ps(row0, tmp);
+		tmp = _mm_shuffle_ps(tmp, tmp, 0x4E);
+		minor0 = _mm_sub_ps(minor0, _mm_mul_ps(row2, tmp));
+		minor2 = _mm_sub_ps(_mm_mul_ps(row0, tmp), minor2);
+		minor2 = _mm_shuffle_ps(minor2, minor2, 0x4E);
+
+		tmp = _mm_mul_ps(row0, row1);
+		tmp = _mm_shuffle_ps(tmp, tmp, 0xB1);
+		minor2 = _mm_add_ps(_mm_mul_ps(row3, tmp), minor2);
+		minor3 = _mm_sub_ps(_mm_mul_ps(row2, tmp), minor3);
+		tmp = _mm_shuffle_ps(tmp, tmp, 0x4E);
+		minor2 = _mm_sub_ps(_mm_mul_ps(row3, tmp), minor2);
+		minor3 = _mm_sub_ps(minor3, _mm_mul_ps(row2, tmp));
+
+		tmp = _mm_mul_ps(row0, row3);
+		tmp = _mm_shuffle_ps(tmp, tmp, 0xB1);
+		minor1 = _mm_sub_ps(minor1, _mm_mul_ps(row2, tmp));
+		minor2 = _mm_add_ps(_mm_mul_ps(row1, tmp), minor2);
+		tmp = _mm_shuffle_ps(tmp, tmp, 0x4E);
+		minor1 = _mm_add_ps(_mm_mul_ps(row2, tmp), minor1);
+		minor2 = _mm_sub_ps(minor2, _mm_mul_ps(row1, tmp));
+
+		tmp = _mm_mul_ps(row0, row2);
+		tmp = _mm_shuffle_ps(tmp, tmp, 0xB1);
+		minor1 = _mm_add_ps(_mm_mul_ps(row3, tmp), minor1);
+		minor3 = _mm_sub_ps(minor3, _mm_mul_ps(row1, tmp));
+		tmp = _mm_shuffle_ps(tmp, tmp, 0x4E);
+		minor1 = _mm_sub_ps(minor1, _mm_mul_ps(row3, tmp));
+		minor3 = _mm_add_ps(_mm_mul_ps(row1, tmp), minor3);
+
+		// determinant
+		__m128 det = _mm_mul_ps(row0, minor0);
+		det = _mm_add_ps(_mm_shuffle_ps(det, det, 0x4E), det);
+		det = _mm_add_ss(_mm_shuffle_ps(det, det, 0xB1), det);
+
+		f32 d;
+		_mm_store_ss(&d, det);
+
+		invertible = !iszero(d, FLT_MIN);
+		if (!invertible)
+			return true;
+
+		det = _mm_set1_ps(reciprocal(d));
+		_mm_storeu_ps(out, _mm_mul_ps(det, minor0));
+		_mm_storeu_ps(out + 4, _mm_mul_ps(det, minor1));
+		_mm_storeu_ps(out + 8, _mm_mul_ps(det, minor2));
+		_mm_storeu_ps(out + 12, _mm_mul_ps(det, minor3));
+
+		return true;
+	}
+
+} // end namespace sse
+} // end namespace core
+} // end namespace irr
+
+#endif
+
+#endif
+
@@ -17,6 +17,8 @@
 #include "IMeshCache.h"
 #include "IAnimatedMesh.h"
 #include "quaternion.h"
+#include "IProfiler.h"
+#include "EProfileIDs.h"
 
 
 namespace irr
@@ -323,6 +325,8 @@ void CAnimatedMeshSceneNode::render()
 	// render original meshes
 	if (renderMeshes)
 	{
+		const bool cullBuffers = (AutomaticCullingState & EAC_MESH_BUFFERS) != 0;
+
 		for (u32 i=0; i<m->getMeshBufferCount(); ++i)
 		{
 			video::IMaterialRenderer* rnd = driver->getMaterialRenderer(Materials[i].MaterialType);
@@ -334,10 +338,27 @@ void CAnimatedMeshSceneNode::render()
 			{
 				scene::IMeshBuffer* mb = m->getMeshBuffer(i);
 				const video::SMaterial& material = ReadOnlyMaterials ? mb->getMaterial() : Materials[i];
+
+				core::matrix4 transform(AbsoluteTransformation);
+				if (RenderFromIdentity)
+					transform.makeIdentity();
+				else if (Mesh->getMeshType() == EAMT_SKINNED)
+					transform *= ((IMeshBuffer*)mb)->getTransformation();
+
+				if (cullBuffers)
+				{
+					if (SceneManager->isCulled(mb->getBoundingBox(), EAC_FRUSTUM_BOX, transform))
+					{
+						IRR_PROFILE(getProfiler().start(EPID_SM_BUFFERS_CULLED); getProfiler().stop(EPID_SM_BUFFERS_CULLED);)
+						continue;
+					}
+					IRR_PROFILE(getProfiler().start(EPID_SM_BUFFERS_VISIBLE); getProfiler().stop(EPID_SM_BUFFERS_VISIBLE);)
+				}
+
 				if (RenderFromIdentity)
 					driver->setTransform(video::ETS_WORLD, core::IdentityMatrix );
 				else if (Mesh->getMeshType() == EAMT_SKINNED)
-					driver->setTransform(video::ETS_WORLD, AbsoluteTransformation * ((IMeshBuffer*)mb)->getTransformation());
+					driver->setTransform(video::ETS_WORLD, transform);
 
 				driver->setMaterial(material);
 				driver->drawMeshBuffer(mb);
@@ -0,0 +1,153 @@
+// Copyright (C) 2002-2012 Nikolaus Gebhardt
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#include "CArchiveEntryCache.h"
+#include "CMemoryFile.h"
+#include <string.h>
+
+namespace irr
+{
+namespace io
+{
+
+
+CArchiveEntryCache::CArchiveEntryCache()
+	: First(0), Last(0), Size(0), MaxSize(0), NextArchive(0)
+{
+	#ifdef _DEBUG
+	setDebugName("CArchiveEntryCache");
+	#endif
+}
+
+
+CArchiveEntryCache::~CArchiveEntryCache()
+{
+	shrink(0);
+}
+
+
+void CArchiveEntryCache::setMaxSize(u32 bytes)
+{
+	MaxSize = bytes;
+	shrink(MaxSize);
+}
+
+
+u32 CArchiveEntryCache::addArchive()
+{
+	return NextArchive++;
+}
+
+
+void CArchiveEntryCache::removeArchive(u32 archive)
+{
+	SEntry* entry = First;
+	while (entry)
+	{
+		SEntry* next = entry->Next;
+		if ((u32)(entry->Key >> 32) == archive)
+			remove(entry);
+		entry = next;
+	}
+}
+
+
+IReadFile* CArchiveEntryCache::createAndOpenFile(u32 archive, u32 index, const io::path& name)
+{
+	core::hash_map<u64, SEntry*>::Node* node = Entries.find(getKey(archive, index));
+	if (!node)
+		return 0;
+
+	SEntry* entry = node->getValue();
+	unlink(entry);
+	link(entry);
+
+	u8* data = new u8[entry->Size];
+	memcpy(data, entry->Data, entry->Size);
+	return new CMemoryReadFile(data, entry->Size, name, true);
+}
+
+
+IReadFile* CArchiveEntryCache::add(u32 archive, u32 index, IReadFile* file)
+{
+	if (!file)
+		return 0;
+
+	const long size = file->getSize();
+	if (size <= 0 || (u32)size > MaxSize || Entries.find(getKey(archive, index)))
+		return file;
+
+	u8* data = new u8[size];
+	file->seek(0);
+	if (file->read(data, size) != size)
+	{
+		delete [] data;
+		file->seek(0);
+		return file;
+	}
+
+	shrink(MaxSize - size);
+
+	SEntry* entry = new SEntry;
+	entry->Key = getKey(archive, index);
+	entry->Data = data;
+	entry->Size = size;
+	link(entry);
+	Entries.insert(entry->Key, entry);
+	Size += size;
+
+	u8* copy = new u8[size];
+	memcpy(copy, data, size);
+	IReadFile* cached = new CMemoryReadFile(copy, size, file->getFileName(), true);
+	file->drop();
+	return cached;
+}
+
+
+void CArchiveEntryCache::link(SEntry* entry)
+{
+	entry->Prev = 0;
+	entry->Next = First;
+	if (First)
+		First->Prev = entry;
+	else
+		Last = entry;
+	First = entry;
+}
+
+
+void CArchiveEntryCache::unlink(SEntry* entry)
+{
+	if (entry->Prev)
+		entry->Prev->Next = entry->Next;
+	else
+		First = entry->Next;
+
+	if (entry->Next)
+		entry->Next->Prev = entry->Prev;
+	else
+		Last = entry->Prev;
+}
+
+
+void CArchiveEntryCache::remove(SEntry* entry)
+{
+	unlink(entry);
+	Entries.remove(entry->Key);
+	Size -= entry->Size;
+	delete [] entry->Data;
+	delete entry;
+}
+
+
+void CArchiveEntryCache::shrink(u32 size)
+{
+	while (Last && Size > size)
+		remove(Last);
+}
+
+
+} // end namespace io
+} // end namespace irr
+
@@ -0,0 +1,96 @@
+// Copyright (C) 2002-2012 Nikolaus Gebhardt
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#ifndef __C_ARCHIVE_ENTRY_CACHE_H_INCLUDED__
+#define __C_ARCHIVE_ENTRY_CACHE_H_INCLUDED__
+
+#include "IReadFile.h"
+#include "irrHashMap.h"
+
+namespace irr
+{
+namespace io
+{
+
+	//! Size bounded cache of the contents of archive entries
+	/** The archive readers keep the decompressed data of the entries they
+	open here, so opening the same entry again only copies it. When the cache
+	is full, the entries which weren't opened for the longest time are removed.
+	A maximum size of 0 disables the cache, which is the default. */
+	class CArchiveEntryCache : public virtual IReferenceCounted
+	{
+	public:
+
+		//! constructor
+		CArchiveEntryCache();
+
+		//! destructor
+		virtual ~CArchiveEntryCache();
+
+		//! sets the maximum number of bytes kept, removes entries which don't fit anymore
+		void setMaxSize(u32 bytes);
+
+		//! returns the maximum number of bytes kept
+		u32 getMaxSize() const { return MaxSize; }
+
+		//! returns the number of bytes kept
+		u32 getSize() const { return Size; }
+
+		//! returns a new id for the entries of an archive
+		u32 addArchive();
+
+		//! removes all entries of an archive
+		void removeArchive(u32 archive);
+
+		//! opens a copy of a cached entry
+		/** \return Memory read file, or 0 if the entry is not cached. */
+		IReadFile* createAndOpenFile(u32 archive, u32 index, const io::path& name);
+
+		//! adds an opened entry to the cache
+		/** Reads the file to the end if it fits into the cache.
+		\return A memory read file with the content, which replaces the
+		dropped file, or the file itself if it wasn't cached. */
+		IReadFile* add(u32 archive, u32 index, IReadFile* file);
+
+	private:
+
+		struct SEntry
+		{
+			u64 Key;
+			u8* Data;
+			u32 Size;
+
+			// least recently used list
+			SEntry* Prev;
+			SEntry* Next;
+		};
+
+		static u64 getKey(u32 archive, u32 index)
+		{
+			return ((u64)archive << 32) | index;
+		}
+
+		void link(SEntry* entry);
+		void unlink(SEntry* entry);
+		void remove(SEntry* entry);
+
+		//! removes the least recently used entries until size bytes are kept at most
+		void shrink(u32 size);
+
+		core::hash_map<u64, SEntry*> Entries;
+
+		// most and least recently used entry
+		SEntry* First;
+		SEntry* Last;
+
+		u32 Size;
+		u32 MaxSize;
+		u32 NextArchive;
+	};
+
+} // end namespace io
+} // end namespace irr
+
+#endif
+
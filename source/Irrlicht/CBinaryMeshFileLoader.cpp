@@ -0,0 +1,612 @@
+// Copyright (C) 2002-2012 Nikolaus Gebhardt
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#include "IrrCompileConfig.h"
+#ifdef _IRR_COMPILE_WITH_BINARY_MESH_LOADER_
+
+#include "CBinaryMeshFileLoader.h"
+#include "os.h"
+#include "IReadFile.h"
+#include "IAttributes.h"
+#include "SMesh.h"
+#include "SAnimatedMesh.h"
+#include "CMeshBuffer.h"
+#include "CSkinnedMesh.h"
+#include "CVertexDescriptor.h"
+
+namespace irr
+{
+namespace scene
+{
+
+
+u32 getBinaryMeshSourceHash(io::IReadFile* file, u32& size)
+{
+	// FNV-1a over the whole file
+	u32 hash = 2166136261u;
+	size = 0;
+
+	if (!file)
+		return hash;
+
+	const long pos = file->getPos();
+	file->seek(0);
+
+	c8 buffer[16384];
+	s32 read;
+	while ((read = file->read(buffer, sizeof(buffer))) > 0)
+	{
+		for (s32 i=0; i<read; ++i)
+		{
+			hash ^= (u8)buffer[i];
+			hash *= 16777619u;
+		}
+		size += (u32)read;
+	}
+
+	file->seek(pos);
+	return hash;
+}
+
+
+//! Constructor
+CBinaryMeshFileLoader::CBinaryMeshFileLoader(video::IVideoDriver* driver)
+	: Driver(driver)
+{
+	#ifdef _DEBUG
+	setDebugName("CBinaryMeshFileLoader");
+	#endif
+}
+
+
+//! Returns true if the file maybe is able to be loaded by this class.
+/** This decision should be based only on the file extension (e.g. ".cob") */
+bool CBinaryMeshFileLoader::isALoadableFileExtension(const io::path& filename) const
+{
+	return core::hasFileExtension ( filename, "irrbmesh" );
+}
+
+
+bool CBinaryMeshFileLoader::readHeader(io::IReadFile* file, SBinaryMeshHeader& header)
+{
+	if (!file)
+		return false;
+
+	file->seek(0);
+	const bool ok = file->read(&header, sizeof(SBinaryMeshHeader)) == (s32)sizeof(SBinaryMeshHeader) &&
+		header.Magic[0] == 'I' && header.Magic[1] == 'R' &&
+		header.Magic[2] == 'B' && header.Magic[3] == 'M' &&
+		header.ByteOrder == BINARY_MESH_BYTE_ORDER &&
+		header.Version == BINARY_MESH_VERSION;
+	file->seek(0);
+
+	return ok;
+}
+
+
+//! creates/loads an animated mesh from the file.
+//! \return Pointer to the created mesh. Returns 0 if loading failed.
+//! If you no longer need the mesh, you should call IAnimatedMesh::drop().
+//! See IReferenceCounted::drop() for more information.
+IAnimatedMesh* CBinaryMeshFileLoader::createMesh(io::IReadFile* file)
+{
+	SBinaryMeshHeader header;
+	if (!readHeader(file, header))
+	{
+		os::Printer::log("Not a valid .irrbmesh file of this version", file->getFileName(), ELL_WARNING);
+		return 0;
+	}
+	file->seek(sizeof(SBinaryMeshHeader));
+
+	// every record takes some bytes, larger counts are from a corrupt file
+	if (!fitsInFile(file, header.BufferCount, sizeof(u32)) || !fitsInFile(file, header.JointCount, sizeof(u32)))
+	{
+		os::Printer::log("Could not read .irrbmesh file, it is truncated or corrupt", file->getFileName(), ELL_ERROR);
+		return 0;
+	}
+
+	core::array<IMeshBuffer*> buffers;
+	buffers.reallocate(header.BufferCount);
+
+	bool ok = true;
+	for (u32 i=0; i<header.BufferCount; ++i)
+	{
+		IMeshBuffer* buffer = readMeshBuffer(file);
+		if (!buffer)
+		{
+			ok = false;
+			break;
+		}
+		buffers.push_back(buffer);
+	}
+
+	IAnimatedMesh* result = 0;
+
+	if (ok && header.JointCount)
+	{
+#ifdef _IRR_COMPILE_WITH_SKINNED_MESH_SUPPORT_
+		CSkinnedMesh* mesh = new CSkinnedMesh();
+
+		for (u32 i=0; i<buffers.size(); ++i)
+			mesh->addMeshBuffer(buffers[i]);
+
+		// create all joints first, so children can be linked by index
+		for (u32 i=0; i<header.JointCount; ++i)
+			mesh->addJoint(0);
+
+		for (u32 i=0; ok && i<header.JointCount; ++i)
+			ok = readJoint(file, mesh, mesh->getAllJoints()[i]);
+
+		if (ok)
+		{
+			mesh->setAnimationSpeed(header.AnimationSpeed);
+			mesh->finalize();
+			result = mesh;
+		}
+		else
+			mesh->drop();
+#else
+		os::Printer::log("Skinned meshes are not supported in this build", file->getFileName(), ELL_ERROR);
+		ok = false;
+#endif
+	}
+	else if (ok)
+	{
+		SMesh* mesh = new SMesh();
+
+		for (u32 i=0; i<buffers.size(); ++i)
+			mesh->addMeshBuffer(buffers[i]);
+
+		mesh->setBoundingBox(core::aabbox3df(header.BoundingBox[0], header.BoundingBox[1], header.BoundingBox[2],
+			header.BoundingBox[3], header.BoundingBox[4], header.BoundingBox[5]));
+
+		SAnimatedMesh* animatedMesh = new SAnimatedMesh(mesh, (E_ANIMATED_MESH_TYPE)header.MeshType);
+		animatedMesh->setAnimationSpeed(header.AnimationSpeed);
+		mesh->drop();
+		result = animatedMesh;
+	}
+
+	for (u32 i=0; i<buffers.size(); ++i)
+		buffers[i]->drop();
+
+	if (!ok)
+		os::Printer::log("Could not read .irrbmesh file, it is truncated or corrupt", file->getFileName(), ELL_ERROR);
+
+	return result;
+}
+
+
+IMeshBuffer* CBinaryMeshFileLoader::readMeshBuffer(io::IReadFile* file)
+{
+	core::stringc descriptorName;
+	core::array<core::stringc> attributeNames;
+	core::array<u32> attributeValues;
+	if (!readVertexDescriptor(file, descriptorName, attributeNames, attributeValues))
+		return 0;
+
+	u32 streamCount;
+	if (!readU32(file, streamCount) || streamCount == 0 || !fitsInFile(file, streamCount, 3*sizeof(u32)))
+		return 0;
+
+	core::array<u32> streams;
+	streams.set_used(streamCount * 3);
+	for (u32 i=0; i<streams.size(); ++i)
+	{
+		if (!readU32(file, streams[i]))
+			return 0;
+	}
+
+	// the step rates belong to the layout, the descriptor knows the streams used by its attributes
+	u32 descriptorStreams = 0;
+	for (u32 i=0; i<attributeNames.size(); ++i)
+		descriptorStreams = core::max_(descriptorStreams, attributeValues[i*4+3]+1);
+
+	if (descriptorStreams > streamCount)
+		return 0;
+
+	for (u32 i=0; i<descriptorStreams; ++i)
+	{
+		const u32 stepRate = streams[i*3+1];
+		if (stepRate != video::EIDSR_PER_VERTEX && stepRate != video::EIDSR_PER_INSTANCE)
+			return 0;
+	}
+
+	// an existing descriptor of the same name has to describe the same layout
+	video::IVertexDescriptor* descriptor = Driver->getVertexDescriptor(descriptorName);
+	if (descriptor)
+	{
+		bool match = matchesVertexDescriptor(descriptor, attributeNames, attributeValues);
+		for (u32 i=0; match && i<descriptorStreams; ++i)
+			match = (u32)descriptor->getInstanceDataStepRate(i) == streams[i*3+1];
+
+		if (!match)
+		{
+			os::Printer::log("Vertex descriptor in .irrbmesh file does not match the driver's", descriptorName.c_str(), ELL_ERROR);
+			return 0;
+		}
+	}
+
+	u32 indexType, indexCount, primitiveType;
+	if (!readU32(file, indexType) || !readU32(file, indexCount) || !readU32(file, primitiveType))
+		return 0;
+
+	f32 box[6];
+	core::matrix4 transformation(core::matrix4::EM4CONST_NOTHING);
+	if (!readFloats(file, box, 6) || !readFloats(file, transformation.pointer(), 16))
+		return 0;
+
+	// material, restored through the attribute serialization of the driver
+	u32 materialAttributeCount;
+	if (!readU32(file, materialAttributeCount))
+		return 0;
+
+	video::SMaterial material;
+	io::IAttributes* attributes = Driver->createAttributesFromMaterial(material);
+	core::stringc name, value;
+	for (u32 i=0; i<materialAttributeCount; ++i)
+	{
+		if (!readString(file, name) || !readString(file, value))
+		{
+			if (attributes)
+				attributes->drop();
+			return 0;
+		}
+		if (attributes)
+			attributes->setAttribute(name.c_str(), value.c_str());
+	}
+	if (attributes)
+	{
+		Driver->fillMaterialStructureFromAttributes(material, attributes);
+		attributes->drop();
+	}
+
+	const video::E_INDEX_TYPE itype = (indexType == video::EIT_32BIT) ? video::EIT_32BIT : video::EIT_16BIT;
+
+	// a new descriptor is only added to the driver when the whole buffer
+	// was read, until then the buffer uses a copy of its own
+	const bool created = (descriptor == 0);
+	if (created)
+	{
+		descriptor = new video::CVertexDescriptor(descriptorName, 0);
+		for (u32 i=0; i<attributeNames.size(); ++i)
+		{
+			const u32* values = &attributeValues[i*4];
+			if (!descriptor->addAttribute(attributeNames[i], values[0], (video::E_VERTEX_ATTRIBUTE_SEMANTIC)values[1],
+				(video::E_VERTEX_ATTRIBUTE_TYPE)values[2], values[3]))
+			{
+				// names and semantics have to be unique
+				descriptor->drop();
+				return 0;
+			}
+		}
+
+		for (u32 i=0; i<descriptorStreams; ++i)
+			descriptor->setInstanceDataStepRate((video::E_INSTANCE_DATA_STEP_RATE)streams[i*3+1], i);
+	}
+
+	IMeshBuffer* buffer = 0;
+	for (u32 i=0; i<streamCount; ++i)
+	{
+		const u32 vertexSize = streams[i*3];
+
+		// the first vertex buffer is created by the mesh buffer itself
+		if (i == 0)
+		{
+			switch (vertexSize)
+			{
+			case sizeof(video::S3DVertex):
+				buffer = new CMeshBuffer<video::S3DVertex>(descriptor, itype);
+				break;
+			case sizeof(video::S3DVertex2TCoords):
+				buffer = new CMeshBuffer<video::S3DVertex2TCoords>(descriptor, itype);
+				break;
+			case sizeof(video::S3DVertexTangents):
+				buffer = new CMeshBuffer<video::S3DVertexTangents>(descriptor, itype);
+				break;
+			}
+		}
+		else
+		{
+			IVertexBuffer* vertices = 0;
+			switch (vertexSize)
+			{
+			case sizeof(video::S3DVertex):
+				vertices = new CVertexBuffer<video::S3DVertex>();
+				break;
+			case sizeof(video::S3DVertex2TCoords):
+				vertices = new CVertexBuffer<video::S3DVertex2TCoords>();
+				break;
+			case sizeof(video::S3DVertexTangents):
+				vertices = new CVertexBuffer<video::S3DVertexTangents>();
+				break;
+			}
+
+			if (vertices)
+			{
+				buffer->addVertexBuffer(vertices);
+				vertices->drop();
+				continue;
+			}
+		}
+
+		if (!buffer || buffer->getVertexBufferCount() != i+1)
+		{
+			os::Printer::log("Unsupported vertex size in .irrbmesh file", core::stringc(vertexSize).c_str(), ELL_ERROR);
+			if (buffer)
+				buffer->drop();
+			if (created)
+				descriptor->drop();
+			return 0;
+		}
+	}
+
+	// the buffer holds the descriptor now
+	if (created)
+		descriptor->drop();
+
+	for (u32 i=0; i<streamCount; ++i)
+	{
+		const u32 vertexSize = streams[i*3];
+		const u32 vertexCount = streams[i*3+2];
+		IVertexBuffer* vertices = buffer->getVertexBuffer(i);
+
+		skipToAlignment(file);
+		if (!fitsInFile(file, vertexCount, vertexSize))
+		{
+			buffer->drop();
+			return 0;
+		}
+		vertices->set_used(vertexCount);
+		const s32 bytes = (s32)(vertexSize * vertexCount);
+		if (file->read(vertices->getVertices(), bytes) != bytes)
+		{
+			buffer->drop();
+			return 0;
+		}
+	}
+
+	skipToAlignment(file);
+	IIndexBuffer* indices = buffer->getIndexBuffer();
+	if (!fitsInFile(file, indexCount, indices->getIndexSize()))
+	{
+		buffer->drop();
+		return 0;
+	}
+	indices->set_used(indexCount);
+	const s32 bytes = (s32)(indices->getIndexSize() * indexCount);
+	if (file->read(indices->getIndices(), bytes) != bytes)
+	{
+		buffer->drop();
+		return 0;
+	}
+	skipToAlignment(file);
+
+	buffer->getMaterial() = material;
+	buffer->setPrimitiveType((E_PRIMITIVE_TYPE)primitiveType);
+	buffer->getBoundingBox() = core::aabbox3df(box[0], box[1], box[2], box[3], box[4], box[5]);
+	buffer->getTransformation() = transformation;
+
+	if (created)
+		registerVertexDescriptor(buffer);
+
+	return buffer;
+}
+
+
+bool CBinaryMeshFileLoader::readVertexDescriptor(io::IReadFile* file, core::stringc& name,
+	core::array<core::stringc>& names, core::array<u32>& values)
+{
+	u32 attributeCount;
+	if (!readString(file, name) || !readU32(file, attributeCount) ||
+		!fitsInFile(file, attributeCount, 5*sizeof(u32)))
+		return false;
+
+	names.reallocate(attributeCount);
+	values.set_used(attributeCount * 4);
+
+	core::stringc attributeName;
+	for (u32 i=0; i<attributeCount; ++i)
+	{
+		if (!readString(file, attributeName))
+			return false;
+		names.push_back(attributeName);
+		for (u32 j=0; j<4; ++j)
+		{
+			if (!readU32(file, values[i*4+j]))
+				return false;
+		}
+
+		// element count, semantic and type, the buffer id is checked against the streams
+		if (values[i*4] < 1 || values[i*4] > 4 || values[i*4+1] >= video::EVAS_COUNT ||
+			values[i*4+2] > video::EVAT_DOUBLE)
+			return false;
+	}
+
+	return true;
+}
+
+
+bool CBinaryMeshFileLoader::matchesVertexDescriptor(const video::IVertexDescriptor* descriptor,
+	const core::array<core::stringc>& names, const core::array<u32>& values) const
+{
+	if (descriptor->getAttributeCount() != names.size())
+		return false;
+
+	for (u32 i=0; i<names.size(); ++i)
+	{
+		const video::IVertexAttribute* attribute = descriptor->getAttribute(i);
+		if (attribute->getName() != names[i] ||
+			attribute->getElementCount() != values[i*4] ||
+			(u32)attribute->getSemantic() != values[i*4+1] ||
+			(u32)attribute->getType() != values[i*4+2] ||
+			attribute->getBufferID() != values[i*4+3])
+			return false;
+	}
+
+	return true;
+}
+
+
+void CBinaryMeshFileLoader::registerVertexDescriptor(IMeshBuffer* buffer)
+{
+	const video::IVertexDescriptor* own = buffer->getVertexDescriptor();
+	video::IVertexDescriptor* descriptor = Driver->addVertexDescriptor(own->getName());
+
+	u32 streams = 0;
+	for (u32 i=0; i<own->getAttributeCount(); ++i)
+	{
+		const video::IVertexAttribute* attribute = own->getAttribute(i);
+		descriptor->addAttribute(attribute->getName(), attribute->getElementCount(),
+			attribute->getSemantic(), attribute->getType(), attribute->getBufferID());
+		streams = core::max_(streams, attribute->getBufferID()+1);
+	}
+
+	for (u32 i=0; i<streams; ++i)
+		descriptor->setInstanceDataStepRate(own->getInstanceDataStepRate(i), i);
+
+	buffer->setVertexDescriptor(descriptor);
+}
+
+
+bool CBinaryMeshFileLoader::readJoint(io::IReadFile* file, ISkinnedMesh* mesh, ISkinnedMesh::SJoint* joint)
+{
+	const core::array<ISkinnedMesh::SJoint*>& allJoints = mesh->getAllJoints();
+
+	if (!readString(file, joint->Name) ||
+		!readFloats(file, joint->LocalMatrix.pointer(), 16) ||
+		!readFloats(file, joint->GlobalInversedMatrix.pointer(), 16))
+		return false;
+
+	u32 count, value;
+
+	if (!readU32(file, count))
+		return false;
+	for (u32 i=0; i<count; ++i)
+	{
+		if (!readU32(file, value) || value >= allJoints.size())
+			return false;
+		joint->Children.push_back(allJoints[value]);
+	}
+
+	if (!readU32(file, count) || !fitsInFile(file, count, sizeof(u32)))
+		return false;
+	joint->AttachedMeshes.set_used(count);
+	for (u32 i=0; i<count; ++i)
+	{
+		if (!readU32(file, joint->AttachedMeshes[i]) || joint->AttachedMeshes[i] >= mesh->getMeshBufferCount())
+			return false;
+	}
+
+	core::array<f32> keys;
+
+	if (!readU32(file, count) || !fitsInFile(file, count, 4*sizeof(f32)))
+		return false;
+	keys.set_used(count*4);
+	if (!readFloats(file, keys.pointer(), keys.size()))
+		return false;
+	for (u32 i=0; i<count; ++i)
+	{
+		ISkinnedMesh::SPositionKey* key = mesh->addPositionKey(joint);
+		key->frame = keys[i*4];
+		key->position.set(keys[i*4+1], keys[i*4+2], keys[i*4+3]);
+	}
+
+	if (!readU32(file, count) || !fitsInFile(file, count, 4*sizeof(f32)))
+		return false;
+	keys.set_used(count*4);
+	if (!readFloats(file, keys.pointer(), keys.size()))
+		return false;
+	for (u32 i=0; i<count; ++i)
+	{
+		ISkinnedMesh::SScaleKey* key = mesh->addScaleKey(joint);
+		key->frame = keys[i*4];
+		key->scale.set(keys[i*4+1], keys[i*4+2], keys[i*4+3]);
+	}
+
+	if (!readU32(file, count) || !fitsInFile(file, count, 5*sizeof(f32)))
+		return false;
+	keys.set_used(count*5);
+	if (!readFloats(file, keys.pointer(), keys.size()))
+		return false;
+	for (u32 i=0; i<count; ++i)
+	{
+		ISkinnedMesh::SRotationKey* key = mesh->addRotationKey(joint);
+		key->frame = keys[i*5];
+		key->rotation.set(keys[i*5+1], keys[i*5+2], keys[i*5+3], keys[i*5+4]);
+	}
+
+	if (!readU32(file, count) || !fitsInFile(file, count, 3*sizeof(u32)))
+		return false;
+	core::array<u32> weights;
+	weights.set_used(count*3);
+	const s32 bytes = (s32)(weights.size()*sizeof(u32));
+	if (file->read(weights.pointer(), bytes) != bytes)
+		return false;
+	joint->Weights.reallocate(count);
+	for (u32 i=0; i<count; ++i)
+	{
+		if (weights[i*3] >= mesh->getMeshBufferCount() ||
+			weights[i*3+1] >= mesh->getMeshBuffer(weights[i*3])->getVertexBuffer()->getVertexCount())
+			return false;
+		ISkinnedMesh::SWeight* weight = mesh->addWeight(joint);
+		weight->buffer_id = (u16)weights[i*3];
+		weight->vertex_id = weights[i*3+1];
+		memcpy(&weight->strength, &weights[i*3+2], sizeof(f32));
+	}
+
+	return true;
+}
+
+
+bool CBinaryMeshFileLoader::readString(io::IReadFile* file, core::stringc& str)
+{
+	u32 length;
+	if (!readU32(file, length) || length > (u32)(file->getSize() - file->getPos()))
+		return false;
+
+	core::array<c8> chars;
+	chars.set_used(((length+3) & ~3) + 1);
+	if (file->read(chars.pointer(), chars.size()-1) != (s32)(chars.size()-1))
+		return false;
+	chars[length] = 0;
+	str = chars.pointer();
+
+	return true;
+}
+
+
+bool CBinaryMeshFileLoader::readU32(io::IReadFile* file, u32& value)
+{
+	return file->read(&value, sizeof(u32)) == (s32)sizeof(u32);
+}
+
+
+bool CBinaryMeshFileLoader::readFloats(io::IReadFile* file, f32* values, u32 count)
+{
+	const s32 bytes = (s32)(count*sizeof(f32));
+	return file->read(values, bytes) == bytes;
+}
+
+
+bool CBinaryMeshFileLoader::fitsInFile(io::IReadFile* file, u32 count, u32 size)
+{
+	const long remaining = file->getSize() - file->getPos();
+	return remaining >= 0 && (!size || count <= (u32)remaining / size);
+}
+
+
+void CBinaryMeshFileLoader::skipToAlignment(io::IReadFile* file)
+{
+	const long pos = file->getPos();
+	const long aligned = (pos + BINARY_MESH_BLOB_ALIGNMENT-1) & ~(long)(BINARY_MESH_BLOB_ALIGNMENT-1);
+	if (aligned != pos)
+		file->seek(aligned);
+}
+
+
+} // end namespace scene
+} // end namespace irr
+
+#endif // _IRR_COMPILE_WITH_BINARY_MESH_LOADER_
+
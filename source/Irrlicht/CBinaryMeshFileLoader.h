@@ -0,0 +1,126 @@
+// Copyright (C) 2002-2012 Nikolaus Gebhardt
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#ifndef __C_BINARY_MESH_FILE_LOADER_H_INCLUDED__
+#define __C_BINARY_MESH_FILE_LOADER_H_INCLUDED__
+
+#include "IMeshLoader.h"
+#include "IVideoDriver.h"
+#include "ISkinnedMesh.h"
+
+namespace irr
+{
+namespace io
+{
+	class IReadFile;
+}
+namespace scene
+{
+
+	//! Layout of the .irrbmesh file header
+	/** The file starts with this header, followed by one record per mesh
+	buffer and, for skinned meshes, one record per joint. All vertex and
+	index data is stored as raw blobs in the layout described by the stored
+	vertex descriptor, each blob starting at a 16 byte aligned file offset,
+	so the data can be copied or mapped into a buffer without parsing. */
+	struct SBinaryMeshHeader
+	{
+		//! 'I','R','B','M'
+		c8 Magic[4];
+		//! BINARY_MESH_BYTE_ORDER as written by the creating machine
+		u32 ByteOrder;
+		//! BINARY_MESH_VERSION
+		u32 Version;
+		//! Size of the source file this mesh was converted from, or 0
+		u32 SourceSize;
+		//! Hash of the source file this mesh was converted from, or 0
+		u32 SourceHash;
+		//! E_ANIMATED_MESH_TYPE of the mesh
+		u32 MeshType;
+		u32 BufferCount;
+		//! Number of joints, only skinned meshes have joints
+		u32 JointCount;
+		f32 AnimationSpeed;
+		f32 BoundingBox[6];
+		u32 Reserved;
+	};
+
+	const u32 BINARY_MESH_BYTE_ORDER = 0x01020304;
+	const u32 BINARY_MESH_VERSION = 1;
+	//! Alignment of all vertex and index blobs in the file
+	const u32 BINARY_MESH_BLOB_ALIGNMENT = 16;
+
+	//! Calculates the key used to check if a cached .irrbmesh file is up to date
+	/** Reads the whole file and restores the file position afterwards.
+	\param file File to hash.
+	\param size Receives the file size.
+	\return Hash of the file contents. */
+	u32 getBinaryMeshSourceHash(io::IReadFile* file, u32& size);
+
+
+//! Meshloader capable of loading .irrbmesh files, the binary Irrlicht Engine mesh format
+class CBinaryMeshFileLoader : public IMeshLoader
+{
+public:
+
+	//! Constructor
+	CBinaryMeshFileLoader(video::IVideoDriver* driver);
+
+	//! returns true if the file maybe is able to be loaded by this class
+	//! based on the file extension (e.g. ".irrbmesh")
+	virtual bool isALoadableFileExtension(const io::path& filename) const _IRR_OVERRIDE_;
+
+	//! creates/loads an animated mesh from the file.
+	//! \return Pointer to the created mesh. Returns 0 if loading failed.
+	//! If you no longer need the mesh, you should call IAnimatedMesh::drop().
+	//! See IReferenceCounted::drop() for more information.
+	virtual IAnimatedMesh* createMesh(io::IReadFile* file) _IRR_OVERRIDE_;
+
+	//! Reads only the header of a .irrbmesh file
+	/** Used by the mesh cache to check if a cached file belongs to the
+	current version of its source file. The file position is reset to 0.
+	\return True if the file is a valid .irrbmesh file of this version. */
+	static bool readHeader(io::IReadFile* file, SBinaryMeshHeader& header);
+
+private:
+
+	//! reads a mesh buffer record
+	IMeshBuffer* readMeshBuffer(io::IReadFile* file);
+
+	//! reads a joint record into a joint created before
+	bool readJoint(io::IReadFile* file, ISkinnedMesh* mesh, ISkinnedMesh::SJoint* joint);
+
+	//! reads the vertex descriptor stored in the file, without adding it to the driver
+	/** \param names Names of the attributes.
+	\param values Element count, semantic, type and buffer id of each attribute.
+	\return False if the record is truncated or a value is out of range. */
+	bool readVertexDescriptor(io::IReadFile* file, core::stringc& name,
+		core::array<core::stringc>& names, core::array<u32>& values);
+
+	//! checks that a descriptor of the driver has the layout stored in the file
+	bool matchesVertexDescriptor(const video::IVertexDescriptor* descriptor,
+		const core::array<core::stringc>& names, const core::array<u32>& values) const;
+
+	//! adds a copy of the descriptor a mesh buffer was read with to the driver
+	void registerVertexDescriptor(IMeshBuffer* buffer);
+
+	bool readString(io::IReadFile* file, core::stringc& str);
+
+	bool readU32(io::IReadFile* file, u32& value);
+
+	bool readFloats(io::IReadFile* file, f32* values, u32 count);
+
+	//! checks that count records of the given size can follow in the file
+	bool fitsInFile(io::IReadFile* file, u32 count, u32 size);
+
+	void skipToAlignment(io::IReadFile* file);
+
+	video::IVideoDriver* Driver;
+};
+
+} // end namespace scene
+} // end namespace irr
+
+#endif
+
@@ -0,0 +1,352 @@
+// Copyright (C) 2002-2012 Nikolaus Gebhardt
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#include "IrrCompileConfig.h"
+
+#ifdef _IRR_COMPILE_WITH_BINARY_MESH_WRITER_
+
+#include "CBinaryMeshWriter.h"
+#include "CBinaryMeshFileLoader.h"
+#include "os.h"
+#include "IWriteFile.h"
+#include "IMesh.h"
+#include "ISkinnedMesh.h"
+#include "IAttributes.h"
+
+namespace irr
+{
+namespace scene
+{
+
+
+CBinaryMeshWriter::CBinaryMeshWriter(video::IVideoDriver* driver)
+	: VideoDriver(driver), File(0), WriteFailed(false), SourceSize(0), SourceHash(0)
+{
+	#ifdef _DEBUG
+	setDebugName("CBinaryMeshWriter");
+	#endif
+
+	if (VideoDriver)
+		VideoDriver->grab();
+}
+
+
+CBinaryMeshWriter::~CBinaryMeshWriter()
+{
+	if (VideoDriver)
+		VideoDriver->drop();
+}
+
+
+//! Returns the type of the mesh writer
+EMESH_WRITER_TYPE CBinaryMeshWriter::getType() const
+{
+	return EMWT_BINARY_MESH;
+}
+
+
+void CBinaryMeshWriter::setSourceKey(u32 size, u32 hash)
+{
+	SourceSize = size;
+	SourceHash = hash;
+}
+
+
+//! writes a static mesh
+bool CBinaryMeshWriter::writeMesh(io::IWriteFile* file, scene::IMesh* mesh, s32 flags)
+{
+	return write(file, mesh, EAMT_UNKNOWN, 0.f, 0);
+}
+
+
+//! writes an animated mesh
+bool CBinaryMeshWriter::writeAnimatedMesh(io::IWriteFile* file, scene::IAnimatedMesh* mesh, s32 flags)
+{
+	if (!mesh)
+		return false;
+
+	if (mesh->getMeshType() == EAMT_SKINNED)
+		return write(file, mesh, EAMT_SKINNED, mesh->getAnimationSpeed(), (ISkinnedMesh*)mesh);
+
+	return write(file, mesh->getMesh(0), mesh->getMeshType(), mesh->getAnimationSpeed(), 0);
+}
+
+
+bool CBinaryMeshWriter::write(io::IWriteFile* file, IMesh* mesh, E_ANIMATED_MESH_TYPE type, f32 animationSpeed, ISkinnedMesh* skinnedMesh)
+{
+	if (!file || !mesh)
+		return false;
+
+	for (u32 i=0; i<mesh->getMeshBufferCount(); ++i)
+	{
+		if (!canWriteMeshBuffer(mesh->getMeshBuffer(i)))
+		{
+			os::Printer::log("Mesh buffer cannot be written as .irrbmesh, unsupported vertex type", file->getFileName(), ELL_WARNING);
+			return false;
+		}
+	}
+
+	os::Printer::log("Writing mesh", file->getFileName());
+
+	File = file;
+	WriteFailed = false;
+
+	SBinaryMeshHeader header;
+	memset(&header, 0, sizeof(SBinaryMeshHeader));
+	header.Magic[0] = 'I';
+	header.Magic[1] = 'R';
+	header.Magic[2] = 'B';
+	header.Magic[3] = 'M';
+	header.ByteOrder = BINARY_MESH_BYTE_ORDER;
+	header.Version = BINARY_MESH_VERSION;
+	header.SourceSize = SourceSize;
+	header.SourceHash = SourceHash;
+	header.MeshType = type;
+	header.BufferCount = mesh->getMeshBufferCount();
+	header.JointCount = skinnedMesh ? skinnedMesh->getAllJoints().size() : 0;
+	header.AnimationSpeed = animationSpeed;
+
+	const core::aabbox3df& box = mesh->getBoundingBox();
+	header.BoundingBox[0] = box.MinEdge.X;
+	header.BoundingBox[1] = box.MinEdge.Y;
+	header.BoundingBox[2] = box.MinEdge.Z;
+	header.BoundingBox[3] = box.MaxEdge.X;
+	header.BoundingBox[4] = box.MaxEdge.Y;
+	header.BoundingBox[5] = box.MaxEdge.Z;
+
+	writeBytes(&header, sizeof(SBinaryMeshHeader));
+
+	for (u32 i=0; i<mesh->getMeshBufferCount(); ++i)
+		writeMeshBuffer(mesh->getMeshBuffer(i));
+
+	if (skinnedMesh)
+		writeJoints(skinnedMesh);
+
+	File = 0;
+
+	if (WriteFailed)
+		os::Printer::log("Could not write mesh", file->getFileName(), ELL_ERROR);
+
+	return !WriteFailed;
+}
+
+
+bool CBinaryMeshWriter::canWriteMeshBuffer(const IMeshBuffer* buffer) const
+{
+	if (!buffer || !buffer->getVertexDescriptor())
+		return false;
+
+	for (u32 i=0; i<buffer->getVertexBufferCount(); ++i)
+	{
+		const u32 size = buffer->getVertexBuffer(i)->getVertexSize();
+
+		if (size != sizeof(video::S3DVertex) && size != sizeof(video::S3DVertex2TCoords) && size != sizeof(video::S3DVertexTangents))
+			return false;
+	}
+
+	return true;
+}
+
+
+void CBinaryMeshWriter::writeMeshBuffer(const IMeshBuffer* buffer)
+{
+	// vertex layout
+
+	const video::IVertexDescriptor* descriptor = buffer->getVertexDescriptor();
+
+	writeString(descriptor->getName());
+	writeU32(descriptor->getAttributeCount());
+
+	for (u32 i=0; i<descriptor->getAttributeCount(); ++i)
+	{
+		const video::IVertexAttribute* attribute = descriptor->getAttribute(i);
+		writeString(attribute->getName());
+		writeU32(attribute->getElementCount());
+		writeU32(attribute->getSemantic());
+		writeU32(attribute->getType());
+		writeU32(attribute->getBufferID());
+	}
+
+	// the descriptor knows the step rates of the streams used by its attributes
+	u32 descriptorStreams = 0;
+	for (u32 i=0; i<descriptor->getAttributeCount(); ++i)
+		descriptorStreams = core::max_(descriptorStreams, descriptor->getAttribute(i)->getBufferID()+1);
+
+	const u32 streamCount = buffer->getVertexBufferCount();
+	writeU32(streamCount);
+
+	for (u32 i=0; i<streamCount; ++i)
+	{
+		writeU32(buffer->getVertexBuffer(i)->getVertexSize());
+		writeU32(i < descriptorStreams ? descriptor->getInstanceDataStepRate(i) : video::EIDSR_PER_VERTEX);
+		writeU32(buffer->getVertexBuffer(i)->getVertexCount());
+	}
+
+	IIndexBuffer* indices = buffer->getIndexBuffer();
+	writeU32(indices->getType());
+	writeU32(indices->getIndexCount());
+	writeU32(buffer->getPrimitiveType());
+
+	const core::aabbox3df& box = buffer->getBoundingBox();
+	writeFloats(&box.MinEdge.X, 3);
+	writeFloats(&box.MaxEdge.X, 3);
+	writeFloats(const_cast<IMeshBuffer*>(buffer)->getTransformation().pointer(), 16);
+
+	// material, simply use irrlichts built-in attribute serialization capabilities here
+
+	io::IAttributes* attributes = VideoDriver->createAttributesFromMaterial(buffer->getMaterial());
+
+	if (attributes)
+	{
+		writeU32(attributes->getAttributeCount());
+		for (u32 i=0; i<attributes->getAttributeCount(); ++i)
+		{
+			writeString(attributes->getAttributeName(i));
+			writeString(attributes->getAttributeAsString(i));
+		}
+		attributes->drop();
+	}
+	else
+		writeU32(0);
+
+	// raw data blobs
+
+	for (u32 i=0; i<streamCount; ++i)
+	{
+		IVertexBuffer* vertices = buffer->getVertexBuffer(i);
+
+		writePadding();
+		writeBytes(vertices->getVertices(), vertices->getVertexCount() * vertices->getVertexSize());
+	}
+
+	writePadding();
+	writeBytes(indices->getIndices(), indices->getIndexCount() * indices->getIndexSize());
+	writePadding();
+}
+
+
+void CBinaryMeshWriter::writeJoints(ISkinnedMesh* mesh)
+{
+	const core::array<ISkinnedMesh::SJoint*>& joints = mesh->getAllJoints();
+
+	for (u32 i=0; i<joints.size(); ++i)
+	{
+		const ISkinnedMesh::SJoint* joint = joints[i];
+
+		writeString(joint->Name);
+		writeFloats(joint->LocalMatrix.pointer(), 16);
+		writeFloats(joint->GlobalInversedMatrix.pointer(), 16);
+
+		writeU32(joint->Children.size());
+		for (u32 j=0; j<joint->Children.size(); ++j)
+			writeU32((u32)joints.linear_search(joint->Children[j]));
+
+		writeU32(joint->AttachedMeshes.size());
+		for (u32 j=0; j<joint->AttachedMeshes.size(); ++j)
+			writeU32(joint->AttachedMeshes[j]);
+
+		core::array<f32> keys;
+
+		keys.reallocate(joint->PositionKeys.size()*4);
+		for (u32 j=0; j<joint->PositionKeys.size(); ++j)
+		{
+			const ISkinnedMesh::SPositionKey& key = joint->PositionKeys[j];
+			keys.push_back(key.frame);
+			keys.push_back(key.position.X);
+			keys.push_back(key.position.Y);
+			keys.push_back(key.position.Z);
+		}
+		writeU32(joint->PositionKeys.size());
+		writeFloats(keys.const_pointer(), keys.size());
+
+		keys.set_used(0);
+		for (u32 j=0; j<joint->ScaleKeys.size(); ++j)
+		{
+			const ISkinnedMesh::SScaleKey& key = joint->ScaleKeys[j];
+			keys.push_back(key.frame);
+			keys.push_back(key.scale.X);
+			keys.push_back(key.scale.Y);
+			keys.push_back(key.scale.Z);
+		}
+		writeU32(joint->ScaleKeys.size());
+		writeFloats(keys.const_pointer(), keys.size());
+
+		keys.set_used(0);
+		for (u32 j=0; j<joint->RotationKeys.size(); ++j)
+		{
+			const ISkinnedMesh::SRotationKey& key = joint->RotationKeys[j];
+			keys.push_back(key.frame);
+			keys.push_back(key.rotation.X);
+			keys.push_back(key.rotation.Y);
+			keys.push_back(key.rotation.Z);
+			keys.push_back(key.rotation.W);
+		}
+		writeU32(joint->RotationKeys.size());
+		writeFloats(keys.const_pointer(), keys.size());
+
+		core::array<u32> weights;
+		weights.reallocate(joint->Weights.size()*3);
+		for (u32 j=0; j<joint->Weights.size(); ++j)
+		{
+			const ISkinnedMesh::SWeight& weight = joint->Weights[j];
+			u32 strength;
+			memcpy(&strength, &weight.strength, sizeof(u32));
+			weights.push_back(weight.buffer_id);
+			weights.push_back(weight.vertex_id);
+			weights.push_back(strength);
+		}
+		writeU32(joint->Weights.size());
+		writeBytes(weights.const_pointer(), weights.size()*sizeof(u32));
+	}
+}
+
+
+void CBinaryMeshWriter::writeString(const core::stringc& str)
+{
+	const u32 length = str.size();
+	writeU32(length);
+	writeBytes(str.c_str(), length);
+
+	const u32 zero = 0;
+	if (length & 3)
+		writeBytes(&zero, 4 - (length & 3));
+}
+
+
+void CBinaryMeshWriter::writeU32(u32 value)
+{
+	writeBytes(&value, sizeof(u32));
+}
+
+
+void CBinaryMeshWriter::writeFloats(const f32* values, u32 count)
+{
+	writeBytes(values, count*sizeof(f32));
+}
+
+
+void CBinaryMeshWriter::writePadding()
+{
+	static const c8 zeros[BINARY_MESH_BLOB_ALIGNMENT] = { 0 };
+
+	const u32 pos = (u32)File->getPos();
+	const u32 padding = (BINARY_MESH_BLOB_ALIGNMENT - (pos % BINARY_MESH_BLOB_ALIGNMENT)) % BINARY_MESH_BLOB_ALIGNMENT;
+	if (padding)
+		writeBytes(zeros, padding);
+}
+
+
+
+void CBinaryMeshWriter::writeBytes(const void* data, u32 size)
+{
+	if (size && !WriteFailed && File->write(data, size) != (s32)size)
+		WriteFailed = true;
+}
+
+
+} // end namespace
+} // end namespace
+
+#endif
+
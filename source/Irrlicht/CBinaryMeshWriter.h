@@ -0,0 +1,79 @@
+// Copyright (C) 2002-2012 Nikolaus Gebhardt
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#ifndef __IRR_BINARY_MESH_WRITER_H_INCLUDED__
+#define __IRR_BINARY_MESH_WRITER_H_INCLUDED__
+
+#include "IMeshWriter.h"
+#include "IVideoDriver.h"
+#include "IAnimatedMesh.h"
+
+namespace irr
+{
+namespace scene
+{
+	class IMeshBuffer;
+	class ISkinnedMesh;
+
+	//! class to write meshes, implementing a binary .irrbmesh writer
+	/** The file layout is described in CBinaryMeshFileLoader.h. Vertex and
+	index buffers are written as raw aligned blobs, so loading them back is
+	a single read per buffer. */
+	class CBinaryMeshWriter : public IMeshWriter
+	{
+	public:
+
+		CBinaryMeshWriter(video::IVideoDriver* driver);
+		virtual ~CBinaryMeshWriter();
+
+		//! Returns the type of the mesh writer
+		virtual EMESH_WRITER_TYPE getType() const _IRR_OVERRIDE_;
+
+		//! writes a static mesh
+		virtual bool writeMesh(io::IWriteFile* file, scene::IMesh* mesh, s32 flags=EMWF_NONE) _IRR_OVERRIDE_;
+
+		//! writes an animated mesh
+		/** Skinned meshes are written with their joints and keys, all other
+		meshes are written as the static mesh of their first frame. */
+		bool writeAnimatedMesh(io::IWriteFile* file, scene::IAnimatedMesh* mesh, s32 flags=EMWF_NONE);
+
+		//! Sets size and hash of the source file, stored in the header of written files
+		/** Used by the mesh cache to detect outdated files. */
+		void setSourceKey(u32 size, u32 hash);
+
+	protected:
+
+		bool write(io::IWriteFile* file, IMesh* mesh, E_ANIMATED_MESH_TYPE type, f32 animationSpeed, ISkinnedMesh* skinnedMesh);
+
+		bool canWriteMeshBuffer(const IMeshBuffer* buffer) const;
+
+		void writeMeshBuffer(const IMeshBuffer* buffer);
+
+		void writeJoints(ISkinnedMesh* mesh);
+
+		void writeString(const core::stringc& str);
+
+		void writeU32(u32 value);
+
+		void writeFloats(const f32* values, u32 count);
+
+		void writePadding();
+
+		//! writes to File and remembers if writing failed
+		void writeBytes(const void* data, u32 size);
+
+		// member variables:
+
+		video::IVideoDriver* VideoDriver;
+		io::IWriteFile* File;
+		bool WriteFailed;
+		u32 SourceSize;
+		u32 SourceHash;
+	};
+
+} // end namespace
+} // end namespace
+
+#endif
+
@@ -852,6 +852,13 @@ void CBurningShader_Raster_Reference::drawTriangle ( const s4DVertex *a,const s4
 	sScanConvertData scan;
 	u32 i;
 
+	// depth writes which may store farther values break the depth tile bounds
+	if ( ShaderParam.RenderState [ BD3DRS_ZWRITEENABLE ] &&
+		( !ShaderParam.RenderState [ BD3DRS_ZENABLE ] ||
+		( ShaderParam.RenderState [ BD3DRS_ZFUNC ] != BD3DCMP_LESSEQUAL &&
+		ShaderParam.RenderState [ BD3DRS_ZFUNC ] != BD3DCMP_EQUAL ) ) )
+		DepthBuffer->invalidateTiles ();
+
 	// sort on height, y
 	if ( F32_A_GREATER_B ( a->Pos.y , b->Pos.y ) ) swapVertexPointer(&a, &b);
 	if ( F32_A_GREATER_B ( b->Pos.y , c->Pos.y ) ) swapVertexPointer(&b, &c);
@@ -0,0 +1,449 @@
+// Copyright (C) 2002-2012 Nikolaus Gebhardt / Thomas Alten
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#include "IrrCompileConfig.h"
+#ifdef _IRR_COMPILE_WITH_BURNINGSVIDEO_
+
+#include "CBurningVertexFetch.h"
+#include "IMeshBuffer.h"
+#include "irrHashMap.h"
+#include "SColor.h"
+#include <string.h>
+
+namespace irr
+{
+namespace video
+{
+
+namespace
+{
+	//! copies float components
+	void fetchCopy(u8* dst, const u8* src, const SVertexFetchOp& op)
+	{
+		memcpy(dst, src, op.Count * sizeof(f32));
+	}
+
+	//! converts components of type T to float
+	template <class T>
+	void fetchVector(u8* dst, const u8* src, const SVertexFetchOp& op)
+	{
+		f32* d = (f32*) dst;
+		const T* s = (const T*) src;
+
+		for (u32 i = 0; i != op.Count; ++i)
+			d[i] = (f32) s[i] * op.Scale;
+	}
+
+	//! copies four unsigned bytes, they are in the memory order of SColor
+	void fetchColor(u8* dst, const u8* src, const SVertexFetchOp& op)
+	{
+		memcpy(dst, src, sizeof(u32));
+	}
+
+	//! converts rgba components of type T to SColor
+	template <class T>
+	void fetchColorVector(u8* dst, const u8* src, const SVertexFetchOp& op)
+	{
+		f32 c[4] = { 0.f, 0.f, 0.f, 1.f };
+		const T* s = (const T*) src;
+
+		for (u32 i = 0; i != op.Count; ++i)
+			c[i] = (f32) s[i] * op.Scale;
+
+		const u32 color = SColorf(c[0], c[1], c[2], c[3]).toSColor().color;
+		memcpy(dst, &color, sizeof(u32));
+	}
+
+	//! scale which maps the range of an integer type to -1..1 or 0..1
+	f32 normalizeScale(E_VERTEX_ATTRIBUTE_TYPE type)
+	{
+		switch (type)
+		{
+		case EVAT_BYTE: return 1.f / 127.f;
+		case EVAT_UBYTE: return 1.f / 255.f;
+		case EVAT_SHORT: return 1.f / 32767.f;
+		case EVAT_USHORT: return 1.f / 65535.f;
+		case EVAT_INT: return 1.f / 2147483647.f;
+		case EVAT_UINT: return 1.f / 4294967295.f;
+		default: return 1.f;
+		}
+	}
+
+	//! selects the conversion of vector components
+	tVertexFetchFunction selectVector(E_VERTEX_ATTRIBUTE_TYPE type, f32 scale)
+	{
+		switch (type)
+		{
+		case EVAT_BYTE: return fetchVector<s8>;
+		case EVAT_UBYTE: return fetchVector<u8>;
+		case EVAT_SHORT: return fetchVector<s16>;
+		case EVAT_USHORT: return fetchVector<u16>;
+		case EVAT_INT: return fetchVector<s32>;
+		case EVAT_UINT: return fetchVector<u32>;
+		case EVAT_DOUBLE: return fetchVector<f64>;
+		case EVAT_FLOAT:
+		default:
+			return scale == 1.f ? fetchCopy : fetchVector<f32>;
+		}
+	}
+
+	//! selects the conversion of colors
+	tVertexFetchFunction selectColor(E_VERTEX_ATTRIBUTE_TYPE type, u32 elementCount)
+	{
+		switch (type)
+		{
+		case EVAT_BYTE: return fetchColorVector<s8>;
+		case EVAT_UBYTE: return elementCount == 4 ? fetchColor : fetchColorVector<u8>;
+		case EVAT_SHORT: return fetchColorVector<s16>;
+		case EVAT_USHORT: return fetchColorVector<u16>;
+		case EVAT_INT: return fetchColorVector<s32>;
+		case EVAT_UINT: return fetchColorVector<u32>;
+		case EVAT_DOUBLE: return fetchColorVector<f64>;
+		case EVAT_FLOAT:
+		default:
+			return fetchColorVector<f32>;
+		}
+	}
+
+	//! an attribute of a built-in vertex layout
+	struct SBuiltInAttribute
+	{
+		E_VERTEX_ATTRIBUTE_SEMANTIC Semantic;
+		E_VERTEX_ATTRIBUTE_TYPE Type;
+		u32 ElementCount;
+		u32 Offset;
+	};
+
+	const SBuiltInAttribute BuiltInStandard[] =
+	{
+		{ EVAS_POSITION, EVAT_FLOAT, 3, 0 },
+		{ EVAS_NORMAL, EVAT_FLOAT, 3, 12 },
+		{ EVAS_COLOR, EVAT_UBYTE, 4, 24 },
+		{ EVAS_TEXCOORD0, EVAT_FLOAT, 2, 28 },
+		{ EVAS_TEXCOORD1, EVAT_FLOAT, 2, 36 },
+	};
+
+	const SBuiltInAttribute BuiltInTangents[] =
+	{
+		{ EVAS_POSITION, EVAT_FLOAT, 3, 0 },
+		{ EVAS_NORMAL, EVAT_FLOAT, 3, 12 },
+		{ EVAS_COLOR, EVAT_UBYTE, 4, 24 },
+		{ EVAS_TEXCOORD0, EVAT_FLOAT, 2, 28 },
+		{ EVAS_TANGENT, EVAT_FLOAT, 3, 36 },
+		{ EVAS_BINORMAL, EVAT_FLOAT, 3, 48 },
+	};
+
+} // end anonymous namespace
+
+
+//! constructor
+CBurningVertexFetch::CBurningVertexFetch(IVertexDescriptor* descriptor)
+	: Descriptor(descriptor), AttributeCount(0), StreamCount(0),
+	InstanceTransformStream(-1), InstanceTransformOffset(0),
+	VertexType(EVT_STANDARD), Valid(false), DirectLayout(false), Direct(false)
+{
+	#ifdef _DEBUG
+	setDebugName("CBurningVertexFetch");
+	#endif
+
+	Descriptor->grab();
+	AttributeCount = Descriptor->getAttributeCount();
+	DescriptorHash = getDescriptorHash();
+
+	u32 i;
+	for (i = 0; i != MAX_STREAMS; ++i)
+	{
+		PerInstance[i] = false;
+		Base[i] = 0;
+		Stride[i] = 0;
+	}
+
+	for (i = 0; i != AttributeCount; ++i)
+	{
+		const u32 stream = Descriptor->getAttribute(i)->getBufferID();
+		if (stream < MAX_STREAMS)
+		{
+			StreamCount = core::max_(StreamCount, stream + 1);
+			PerInstance[stream] = Descriptor->getInstanceDataStepRate(stream) == EIDSR_PER_INSTANCE;
+		}
+	}
+
+	// instance matrix, four rows on consecutive texture coordinates of a per instance stream
+	s32 matrixSemantic = -1;
+	for (u32 s = EVAS_TEXCOORD0; s + 3 <= EVAS_TEXCOORD7 && matrixSemantic < 0; ++s)
+	{
+		const IVertexAttribute* row0 = Descriptor->getAttributeBySemantic((E_VERTEX_ATTRIBUTE_SEMANTIC) s);
+		if (!row0 || row0->getBufferID() >= MAX_STREAMS || !PerInstance[row0->getBufferID()])
+			continue;
+
+		u32 r;
+		for (r = 0; r != 4; ++r)
+		{
+			const IVertexAttribute* row = Descriptor->getAttributeBySemantic((E_VERTEX_ATTRIBUTE_SEMANTIC) (s + r));
+			if (!row || row->getBufferID() != row0->getBufferID() || row->getType() != EVAT_FLOAT ||
+				row->getElementCount() != 4 || row->getOffset() != row0->getOffset() + r * 4 * sizeof(f32))
+				break;
+		}
+
+		if (r == 4)
+		{
+			matrixSemantic = s;
+			InstanceTransformStream = row0->getBufferID();
+			InstanceTransformOffset = row0->getOffset();
+		}
+	}
+
+	// layout of the staging vertex
+	const bool texture1 = Descriptor->getAttributeBySemantic(EVAS_TEXCOORD1) &&
+		( matrixSemantic < 0 || matrixSemantic > EVAS_TEXCOORD1 );
+
+	if (Descriptor->getAttributeBySemantic(EVAS_TANGENT) || Descriptor->getAttributeBySemantic(EVAS_BINORMAL))
+		VertexType = EVT_TANGENTS;
+	else if (texture1)
+		VertexType = EVT_2TCOORDS;
+
+	// defaults of missing attributes
+	S3DVertexTangents staging;
+	staging.Normal.set(0.f, 0.f, 1.f);
+	staging.Color.set(255, 255, 255, 255);
+	memset(Staging, 0, sizeof(Staging));
+	memcpy(Staging, &staging, sizeof(staging));
+
+	for (i = 0; i != AttributeCount; ++i)
+	{
+		const IVertexAttribute* attribute = Descriptor->getAttribute(i);
+		const u32 stream = attribute->getBufferID();
+
+		if (stream >= MAX_STREAMS)
+			continue;
+
+		if (matrixSemantic >= 0 && attribute->getSemantic() >= (u32) matrixSemantic &&
+			attribute->getSemantic() < (u32) matrixSemantic + 4)
+			continue;
+
+		SVertexFetchOp op;
+		if (!compile(attribute, op))
+			continue;
+
+		if (PerInstance[stream])
+		{
+			InstanceOps.push_back(op);
+		}
+		else
+		{
+			VertexOps.push_back(op);
+
+			if (op.Semantic == EVAS_POSITION)
+				Valid = true;
+		}
+	}
+
+	DirectLayout = isBuiltInLayout();
+}
+
+
+//! destructor
+CBurningVertexFetch::~CBurningVertexFetch()
+{
+	Descriptor->drop();
+}
+
+
+//! returns false if the descriptor was changed after the fetch was compiled
+bool CBurningVertexFetch::isCurrent() const
+{
+	return AttributeCount == Descriptor->getAttributeCount() && DescriptorHash == getDescriptorHash();
+}
+
+
+//! returns a hash of everything the fetch was compiled from
+u32 CBurningVertexFetch::getDescriptorHash() const
+{
+	const u32 count = Descriptor->getAttributeCount();
+	u32 hash = count;
+
+	for (u32 i = 0; i != count; ++i)
+	{
+		const IVertexAttribute* attribute = Descriptor->getAttribute(i);
+		const u32 stream = attribute->getBufferID();
+
+		hash = core::hashCombine(hash, attribute->getSemantic());
+		hash = core::hashCombine(hash, attribute->getType());
+		hash = core::hashCombine(hash, attribute->getElementCount());
+		hash = core::hashCombine(hash, attribute->getOffset());
+		hash = core::hashCombine(hash, stream);
+		hash = core::hashCombine(hash, Descriptor->getInstanceDataStepRate(stream));
+	}
+
+	return hash;
+}
+
+
+//! compiles the fetch of an attribute, returns false if the pipeline doesn't use it
+bool CBurningVertexFetch::compile(const IVertexAttribute* attribute, SVertexFetchOp& op) const
+{
+	op.Stream = attribute->getBufferID();
+	op.Offset = attribute->getOffset();
+	op.Semantic = attribute->getSemantic();
+	op.Type = attribute->getType();
+	op.ElementCount = attribute->getElementCount();
+	op.Scale = 1.f;
+
+	u32 dstCount = 0;
+
+	switch (op.Semantic)
+	{
+	case EVAS_POSITION:
+		op.DstOffset = 0;
+		dstCount = 3;
+		break;
+	case EVAS_NORMAL:
+		op.DstOffset = 12;
+		op.Scale = normalizeScale(op.Type);
+		dstCount = 3;
+		break;
+	case EVAS_COLOR:
+		op.DstOffset = 24;
+		op.Scale = normalizeScale(op.Type);
+		op.Count = core::min_(op.ElementCount, 4u);
+		op.Fetch = selectColor(op.Type, op.ElementCount);
+		return true;
+	case EVAS_TEXCOORD0:
+		op.DstOffset = 28;
+		dstCount = 2;
+		break;
+	case EVAS_TEXCOORD1:
+		if (VertexType != EVT_2TCOORDS)
+			return false;
+		op.DstOffset = 36;
+		dstCount = 2;
+		break;
+	case EVAS_TANGENT:
+		op.DstOffset = 36;
+		op.Scale = normalizeScale(op.Type);
+		dstCount = 3;
+		break;
+	case EVAS_BINORMAL:
+		op.DstOffset = 48;
+		op.Scale = normalizeScale(op.Type);
+		dstCount = 3;
+		break;
+	default:
+		return false;
+	}
+
+	op.Count = core::min_(op.ElementCount, dstCount);
+	op.Fetch = selectVector(op.Type, op.Scale);
+	return true;
+}
+
+
+//! tests for the built-in layout of VertexType
+bool CBurningVertexFetch::isBuiltInLayout() const
+{
+	if (!InstanceOps.empty())
+		return false;
+
+	const SBuiltInAttribute* layout = BuiltInStandard;
+	u32 size = 4;
+
+	switch (VertexType)
+	{
+	case EVT_2TCOORDS:
+		size = 5;
+		break;
+	case EVT_TANGENTS:
+		layout = BuiltInTangents;
+		size = 6;
+		break;
+	default:
+		break;
+	}
+
+	if (VertexOps.size() != size)
+		return false;
+
+	for (u32 i = 0; i != VertexOps.size(); ++i)
+	{
+		const SVertexFetchOp& op = VertexOps[i];
+
+		u32 k = 0;
+		while (k != size && layout[k].Semantic != op.Semantic)
+			++k;
+
+		if (k == size || op.Stream != 0 || op.Type != layout[k].Type ||
+			op.ElementCount != layout[k].ElementCount || op.Offset != layout[k].Offset)
+			return false;
+	}
+
+	return true;
+}
+
+
+//! sets the streams of a mesh buffer
+u32 CBurningVertexFetch::bind(const scene::IMeshBuffer* mb, u32& vertexCount)
+{
+	if (mb->getVertexBufferCount() < StreamCount)
+		return 0;
+
+	bool vertexStream = false;
+	bool instanceStream = false;
+	u32 instanceCount = 1;
+	vertexCount = 0;
+
+	for (u32 i = 0; i != StreamCount; ++i)
+	{
+		scene::IVertexBuffer* vertexBuffer = mb->getVertexBuffer(i);
+		const u32 count = vertexBuffer->getVertexCount();
+
+		Base[i] = (const u8*) vertexBuffer->getVertices();
+		Stride[i] = vertexBuffer->getVertexSize();
+
+		if (PerInstance[i])
+		{
+			instanceCount = instanceStream ? core::min_(instanceCount, count) : count;
+			instanceStream = true;
+		}
+		else
+		{
+			vertexCount = vertexStream ? core::min_(vertexCount, count) : count;
+			vertexStream = true;
+		}
+	}
+
+	u32 builtInSize = sizeof(S3DVertex);
+	if (VertexType == EVT_2TCOORDS)
+		builtInSize = sizeof(S3DVertex2TCoords);
+	else if (VertexType == EVT_TANGENTS)
+		builtInSize = sizeof(S3DVertexTangents);
+
+	Direct = DirectLayout && Stride[0] == builtInSize;
+
+	return instanceCount;
+}
+
+
+//! reads the per instance attributes of an instance
+void CBurningVertexFetch::setInstance(u32 instance)
+{
+	for (u32 i = 0; i != InstanceOps.size(); ++i)
+	{
+		const SVertexFetchOp& op = InstanceOps[i];
+		op.Fetch((u8*) Staging + op.DstOffset, Base[op.Stream] + instance * Stride[op.Stream] + op.Offset, op);
+	}
+
+	if (InstanceTransformStream >= 0)
+	{
+		f32 m[16];
+		memcpy(m, Base[InstanceTransformStream] + instance * Stride[InstanceTransformStream] + InstanceTransformOffset, sizeof(m));
+		InstanceTransform.setM(m);
+	}
+}
+
+
+} // end namespace video
+} // end namespace irr
+
+#endif // _IRR_COMPILE_WITH_BURNINGSVIDEO_
+
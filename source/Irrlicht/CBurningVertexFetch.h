@@ -0,0 +1,161 @@
+// Copyright (C) 2002-2012 Nikolaus Gebhardt / Thomas Alten
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#ifndef __C_BURNING_VERTEX_FETCH_H_INCLUDED__
+#define __C_BURNING_VERTEX_FETCH_H_INCLUDED__
+
+#include "IReferenceCounted.h"
+#include "IVertexDescriptor.h"
+#include "S3DVertex.h"
+#include "matrix4.h"
+#include "irrArray.h"
+
+namespace irr
+{
+namespace scene
+{
+	class IMeshBuffer;
+}
+
+namespace video
+{
+
+	struct SVertexFetchOp;
+
+	//! converts one attribute of a vertex
+	typedef void (*tVertexFetchFunction)(u8* dst, const u8* src, const SVertexFetchOp& op);
+
+	//! fetch of one attribute, compiled from an IVertexAttribute
+	struct SVertexFetchOp
+	{
+		tVertexFetchFunction Fetch;
+
+		u32 Stream;
+		u32 Offset;
+		u32 DstOffset;
+
+		//! number of components converted
+		u32 Count;
+
+		//! normalizes integer components
+		f32 Scale;
+
+		E_VERTEX_ATTRIBUTE_SEMANTIC Semantic;
+		E_VERTEX_ATTRIBUTE_TYPE Type;
+		u32 ElementCount;
+	};
+
+	//! gathers vertices described by an IVertexDescriptor into a built-in vertex layout
+	/** The attributes the fixed function pipeline of Burning's Video knows are
+	compiled once per descriptor into a list of fetch operations, each one a
+	conversion function specialized for the attribute type, reading from one of
+	the vertex streams of a mesh buffer. The operations write into a staging
+	vertex of the layout returned by getVertexType(), which the vertex cache
+	transforms like any other vertex.
+
+	Streams with EIDSR_PER_INSTANCE are read once per instance. Four float4
+	attributes of such a stream on consecutive texture coordinate semantics
+	are taken as the world matrix of the instance, which is the layout
+	CInstancedMeshSceneNode uses. */
+	class CBurningVertexFetch : public virtual IReferenceCounted
+	{
+	public:
+
+		//! constructor
+		CBurningVertexFetch(IVertexDescriptor* descriptor);
+
+		//! destructor
+		virtual ~CBurningVertexFetch();
+
+		//! returns false if the descriptor has no usable position
+		bool isValid() const { return Valid; }
+
+		//! returns false if the descriptor was changed after the fetch was compiled
+		bool isCurrent() const;
+
+		//! returns the layout of the gathered vertices
+		E_VERTEX_TYPE getVertexType() const { return VertexType; }
+
+		//! returns true if stream 0 can be read without gathering
+		/** The per vertex attributes are exactly the built-in layout of
+		getVertexType() and the only per instance data is the world matrix. */
+		bool isDirect() const { return Direct; }
+
+		//! returns true if every instance has its own world matrix
+		bool hasInstanceTransform() const { return InstanceTransformStream >= 0; }
+
+		//! sets the streams of a mesh buffer
+		/** \param vertexCount receives the vertex count of the per vertex streams
+		\return number of instances, 0 if the mesh buffer doesn't fit */
+		u32 bind(const scene::IMeshBuffer* mb, u32& vertexCount);
+
+		//! reads the per instance attributes of an instance
+		void setInstance(u32 instance);
+
+		//! returns the world matrix of the current instance
+		const core::matrix4& getInstanceTransform() const { return InstanceTransform; }
+
+		//! gathers a vertex, returns the staging vertex
+		/** The staging vertex is only valid until the next call. */
+		const void* fetch(u32 index)
+		{
+			for (u32 i = 0; i != VertexOps.size(); ++i)
+			{
+				const SVertexFetchOp& op = VertexOps[i];
+				op.Fetch((u8*) Staging + op.DstOffset, Base[op.Stream] + index * Stride[op.Stream] + op.Offset, op);
+			}
+
+			return Staging;
+		}
+
+		//! returns stream 0 of the bound mesh buffer
+		const void* getDirectVertices() const { return Base[0]; }
+
+	private:
+
+		enum { MAX_STREAMS = 8 };
+
+		//! compiles the fetch of an attribute, returns false if the pipeline doesn't use it
+		bool compile(const IVertexAttribute* attribute, SVertexFetchOp& op) const;
+
+		//! tests for the built-in layout of VertexType
+		bool isBuiltInLayout() const;
+
+		//! returns a hash of everything the fetch was compiled from
+		u32 getDescriptorHash() const;
+
+		IVertexDescriptor* Descriptor;
+		u32 AttributeCount;
+		u32 DescriptorHash;
+
+		core::array<SVertexFetchOp> VertexOps;
+		core::array<SVertexFetchOp> InstanceOps;
+
+		// streams referenced by the descriptor
+		u32 StreamCount;
+		bool PerInstance[MAX_STREAMS];
+
+		// streams of the bound mesh buffer
+		const u8* Base[MAX_STREAMS];
+		u32 Stride[MAX_STREAMS];
+
+		// stream and offset of the instance matrix, or -1
+		s32 InstanceTransformStream;
+		u32 InstanceTransformOffset;
+		core::matrix4 InstanceTransform;
+
+		E_VERTEX_TYPE VertexType;
+		bool Valid;
+		bool DirectLayout;
+		bool Direct;
+
+		// vertex of the largest built-in layout, u32 for alignment
+		u32 Staging[(sizeof(S3DVertexTangents) + 3) / 4];
+	};
+
+} // end namespace video
+} // end namespace irr
+
+#endif
+
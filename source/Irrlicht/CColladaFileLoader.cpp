@@ -22,6 +22,7 @@
 #include "IMeshSceneNode.h"
 #include "CMeshBuffer.h"
 #include "irrMap.h"
+#include "irrHashMap.h"
 
 #ifdef _DEBUG
 #define COLLADA_READER_DEBUG
@@ -806,9 +807,8 @@ void CColladaFileLoader::readNodeSection(io::IXMLReaderUTF8* reader, scene::ISce
 				if (node && newnode)
 				{
 					// move children from dummy to new node
-					ISceneNodeList::ConstIterator it = node->getChildren().begin();
-					for (; it != node->getChildren().end(); it = node->getChildren().begin())
-						(*it)->setParent(newnode);
+					while (node->getChildCount())
+						node->getChild(0)->setParent(newnode);
 
 					// remove previous dummy node
 					node->remove();
@@ -2133,7 +2133,7 @@ void CColladaFileLoader::readPolygonSection(io::IXMLReaderUTF8* reader,
 		CMeshBuffer<video::S3DVertex>* mbuffer = new CMeshBuffer<video::S3DVertex>(SceneManager->getVideoDriver()->getVertexDescriptor(0));
 		buffer = mbuffer;
 
-		core::map<video::S3DVertex, int> vertMap;
+		core::hash_map<video::S3DVertex, int> vertMap;
 
 		for (u32 i=0; i<polygons.size(); ++i)
 		{
@@ -2207,7 +2207,7 @@ void CColladaFileLoader::readPolygonSection(io::IXMLReaderUTF8* reader,
 				}
 
 				//first, try to find this vertex in the mesh
-				core::map<video::S3DVertex, int>::Node* n = vertMap.find(vtx);
+				core::hash_map<video::S3DVertex, int>::Node* n = vertMap.find(vtx);
 				if (n)
 				{
 					indices.push_back(n->getValue());
@@ -376,12 +376,9 @@ bool CColladaMeshWriter::writeScene(io::IWriteFile* file, scene::ISceneNode* roo
 		{
 			// The visual_scene element is identical to our scenemanager and acts as root,
 			// so we do not write the root itself if it points to the scenemanager.
-			const core::list<ISceneNode*>& rootChildren = root->getChildren();
-			for ( core::list<ISceneNode*>::ConstIterator it = rootChildren.begin();
-					it != rootChildren.end();
-					++ it )
+			for ( u32 i=0; i<root->getChildCount(); ++i )
 			{
-				writeSceneNode(*it);
+				writeSceneNode(root->getChild(i));
 			}
 		}
 
@@ -427,10 +424,9 @@ void CColladaMeshWriter::makeMeshNames(irr::scene::ISceneNode * node)
 		}
 	}
 
-	const core::list<ISceneNode*>& children = node->getChildren();
-	for ( core::list<ISceneNode*>::ConstIterator it = children.begin(); it != children.end(); ++it )
+	for ( u32 i=0; i<node->getChildCount(); ++i )
 	{
-		makeMeshNames(*it);
+		makeMeshNames(node->getChild(i));
 	}
 }
 
@@ -488,10 +484,9 @@ void CColladaMeshWriter::writeNodeMaterials(irr::scene::ISceneNode * node)
 		}
 	}
 
-	const core::list<ISceneNode*>& children = node->getChildren();
-	for ( core::list<ISceneNode*>::ConstIterator it = children.begin(); it != children.end(); ++it )
+	for ( u32 i=0; i<node->getChildCount(); ++i )
 	{
-		writeNodeMaterials( *it );
+		writeNodeMaterials( node->getChild(i) );
 	}
 }
 
@@ -549,10 +544,9 @@ void CColladaMeshWriter::writeNodeEffects(irr::scene::ISceneNode * node)
 		}
 	}
 
-	const core::list<ISceneNode*>& children = node->getChildren();
-	for ( core::list<ISceneNode*>::ConstIterator it = children.begin(); it != children.end(); ++it )
+	for ( u32 i=0; i<node->getChildCount(); ++i )
 	{
-		writeNodeEffects( *it );
+		writeNodeEffects( node->getChild(i) );
 	}
 }
 
@@ -629,10 +623,9 @@ void CColladaMeshWriter::writeNodeLights(irr::scene::ISceneNode * node)
 
 	}
 
-	const core::list<ISceneNode*>& children = node->getChildren();
-	for ( core::list<ISceneNode*>::ConstIterator it = children.begin(); it != children.end(); ++it )
+	for ( u32 i=0; i<node->getChildCount(); ++i )
 	{
-		writeNodeLights( *it );
+		writeNodeLights( node->getChild(i) );
 	}
 }
 
@@ -703,10 +696,9 @@ void CColladaMeshWriter::writeNodeCameras(irr::scene::ISceneNode * node)
 		Writer->writeLineBreak();
 	}
 
-	const core::list<ISceneNode*>& children = node->getChildren();
-	for ( core::list<ISceneNode*>::ConstIterator it = children.begin(); it != children.end(); ++it )
+	for ( u32 i=0; i<node->getChildCount(); ++i )
 	{
-		writeNodeCameras( *it );
+		writeNodeCameras( node->getChild(i) );
 	}
 }
 
@@ -799,10 +791,9 @@ void CColladaMeshWriter::writeSceneNode(irr::scene::ISceneNode * node )
 			writeCameraInstance(camNode->getValue());
 	}
 
-	const core::list<ISceneNode*>& children = node->getChildren();
-	for ( core::list<ISceneNode*>::ConstIterator it = children.begin(); it != children.end(); ++it )
+	for ( u32 i=0; i<node->getChildCount(); ++i )
 	{
-		writeSceneNode( *it );
+		writeSceneNode( node->getChild(i) );
 	}
 
 	Writer->writeClosingTag(L"node");
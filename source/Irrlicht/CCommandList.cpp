@@ -0,0 +1,94 @@
+// Copyright (C) 2002-2012 Nikolaus Gebhardt
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#include "CCommandList.h"
+
+namespace irr
+{
+namespace video
+{
+
+//! constructor
+CCommandList::CCommandList()
+{
+	#ifdef _DEBUG
+	setDebugName("CCommandList");
+	#endif
+}
+
+
+//! records setting a transformation
+void CCommandList::setTransform(E_TRANSFORMATION_STATE state, const core::matrix4& mat)
+{
+	STransform transform;
+	transform.State = state;
+	transform.Matrix = mat;
+
+	addCommand(ECT_TRANSFORM, Transforms.size());
+	Transforms.push_back(transform);
+}
+
+
+//! records setting a material
+void CCommandList::setMaterial(const SMaterial& material)
+{
+	// materials are large, only record changes
+	if (Materials.size() && Materials.getLast() == material)
+		return;
+
+	addCommand(ECT_MATERIAL, Materials.size());
+	Materials.push_back(material);
+}
+
+
+//! records drawing a mesh buffer
+void CCommandList::drawMeshBuffer(const scene::IMeshBuffer* mb)
+{
+	if (!mb)
+		return;
+
+	addCommand(ECT_DRAW, MeshBuffers.size());
+	MeshBuffers.push_back(mb);
+}
+
+
+//! removes all commands
+void CCommandList::clear()
+{
+	// plain data keeps its memory for the next recording
+	Commands.set_used(0);
+	Transforms.set_used(0);
+	MeshBuffers.set_used(0);
+
+	// materials may own texture matrices
+	Materials.clear();
+}
+
+
+//! executes the commands on a driver
+void CCommandList::replay(IVideoDriver* driver) const
+{
+	for (u32 i = 0; i < Commands.size(); ++i)
+	{
+		const SCommand& command = Commands[i];
+
+		switch (command.Type)
+		{
+		case ECT_TRANSFORM:
+			driver->setTransform(Transforms[command.Index].State, Transforms[command.Index].Matrix);
+			break;
+		case ECT_MATERIAL:
+			driver->setMaterial(Materials[command.Index]);
+			break;
+		case ECT_DRAW:
+			driver->drawMeshBuffer(MeshBuffers[command.Index]);
+			break;
+		}
+	}
+}
+
+
+} // end namespace video
+} // end namespace irr
+
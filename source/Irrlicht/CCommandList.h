@@ -0,0 +1,74 @@
+// Copyright (C) 2002-2012 Nikolaus Gebhardt
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#ifndef __C_COMMAND_LIST_H_INCLUDED__
+#define __C_COMMAND_LIST_H_INCLUDED__
+
+#include "ICommandList.h"
+#include "irrArray.h"
+
+namespace irr
+{
+namespace video
+{
+
+	//! Command list of the drivers, replayed through the IVideoDriver interface
+	class CCommandList : public ICommandList
+	{
+	public:
+
+		//! constructor
+		CCommandList();
+
+		virtual void setTransform(E_TRANSFORMATION_STATE state, const core::matrix4& mat) _IRR_OVERRIDE_;
+
+		virtual void setMaterial(const SMaterial& material) _IRR_OVERRIDE_;
+
+		virtual void drawMeshBuffer(const scene::IMeshBuffer* mb) _IRR_OVERRIDE_;
+
+		virtual void clear() _IRR_OVERRIDE_;
+
+		virtual u32 getCommandCount() const _IRR_OVERRIDE_ { return Commands.size(); }
+
+		virtual void replay(IVideoDriver* driver) const _IRR_OVERRIDE_;
+
+	private:
+
+		enum E_COMMAND_TYPE
+		{
+			ECT_TRANSFORM = 0,
+			ECT_MATERIAL,
+			ECT_DRAW
+		};
+
+		//! a command and the index of its data in the array of its type
+		struct SCommand
+		{
+			E_COMMAND_TYPE Type;
+			u32 Index;
+		};
+
+		struct STransform
+		{
+			E_TRANSFORMATION_STATE State;
+			core::matrix4 Matrix;
+		};
+
+		void addCommand(E_COMMAND_TYPE type, u32 index)
+		{
+			const SCommand command = { type, index };
+			Commands.push_back(command);
+		}
+
+		core::array<SCommand> Commands;
+		core::array<STransform> Transforms;
+		core::array<SMaterial> Materials;
+		core::array<const scene::IMeshBuffer*> MeshBuffers;
+	};
+
+} // end namespace video
+} // end namespace irr
+
+#endif
+
@@ -916,6 +916,7 @@ void CD3D8Driver::drawVertexPrimitiveList(const void* vertices,
 		os::Printer::log("Too many vertices for 16bit index type, render artifacts may occur.");
 
 	PrimitivesDrawn += primitiveCount;
+	++DrawCalls;
 
 	if (!vertexCount || !primitiveCount)
 		return;
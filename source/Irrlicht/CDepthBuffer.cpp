@@ -16,7 +16,7 @@ namespace video
 
 //! constructor
 CDepthBuffer::CDepthBuffer(const core::dimension2d<u32>& size)
-: Buffer(0), Size(0,0)
+: Buffer(0), TileDepth(0), Size(0,0), TilesValid(false)
 {
 	#ifdef _DEBUG
 	setDebugName("CDepthBuffer");
@@ -32,6 +32,8 @@ CDepthBuffer::~CDepthBuffer()
 {
 	if (Buffer)
 		delete [] Buffer;
+
+	delete [] TileDepth;
 }
 
 
@@ -50,6 +52,8 @@ void CDepthBuffer::clear()
 	zMaxValue = IR(zMax);
 
 	memset32 ( Buffer, zMaxValue, TotalSize );
+	memset32 ( TileDepth, zMaxValue, TileCount * sizeof ( f32 ) );
+	TilesValid = true;
 }
 
 
@@ -68,6 +72,13 @@ void CDepthBuffer::setSize(const core::dimension2d<u32>& size)
 	Pitch = size.Width * sizeof ( fp24 );
 	TotalSize = Pitch * size.Height;
 	Buffer = new u8[TotalSize];
+
+	delete [] TileDepth;
+	const u32 tileMask = ( 1 << SOFTWARE_DRIVER_2_DEPTH_TILE_LOG2 ) - 1;
+	TilePitch = ( size.Width + tileMask ) >> SOFTWARE_DRIVER_2_DEPTH_TILE_LOG2;
+	TileCount = TilePitch * ( ( size.Height + tileMask ) >> SOFTWARE_DRIVER_2_DEPTH_TILE_LOG2 );
+	TileDepth = new f32[TileCount];
+
 	clear ();
 }
 
@@ -40,13 +40,34 @@ namespace video
 		//! returns pitch of depthbuffer (in bytes)
 		virtual u32 getPitch() const _IRR_OVERRIDE_ { return Pitch; }
 
+		//! returns one conservative depth bound per tile
+		/** Each value is never nearer than the farthest depth stored in
+		its tile. Used by the quad rasterizer to reject whole tiles. */
+		f32* lockTiles() { return TileDepth; }
+
+		//! returns number of tiles per row
+		u32 getTilePitch() const { return TilePitch; }
+
+		//! returns if the tile bounds can be used until the next clear
+		bool tilesValid() const { return TilesValid; }
+
+		//! marks the tile bounds as unusable until the next clear
+		/** Has to be called by everything which may move a stored depth
+		value farther away, e.g. depth writes with a compare function other
+		than less-equal. */
+		void invalidateTiles() { TilesValid = false; }
+
 
 	private:
 
 		u8* Buffer;
+		f32* TileDepth;
 		core::dimension2d<u32> Size;
 		u32 TotalSize;
 		u32 Pitch;
+		u32 TilePitch;
+		u32 TileCount;
+		bool TilesValid;
 	};
 
 
@@ -114,6 +114,12 @@ public:
 	//! Returns the base path of the file list
 	virtual const io::path& getPath() const _IRR_OVERRIDE_;
 
+	//! Returns true if files are searched by their name only
+	virtual bool isIgnoringPaths() const _IRR_OVERRIDE_ { return IgnorePaths; }
+
+	//! Returns true if the names of the file list are lower case
+	virtual bool isIgnoringCase() const _IRR_OVERRIDE_ { return IgnoreCase; }
+
 protected:
 
 	//! Ignore paths when adding or searching for files
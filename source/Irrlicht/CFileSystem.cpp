@@ -51,6 +51,7 @@ namespace io
 
 //! constructor
 CFileSystem::CFileSystem()
+	: EntryCache(new CArchiveEntryCache())
 {
 	#ifdef _DEBUG
 	setDebugName("CFileSystem");
@@ -61,11 +62,11 @@ CFileSystem::CFileSystem()
 	getWorkingDirectory();
 
 #ifdef __IRR_COMPILE_WITH_PAK_ARCHIVE_LOADER_
-	ArchiveLoader.push_back(new CArchiveLoaderPAK(this));
+	ArchiveLoader.push_back(new CArchiveLoaderPAK(this, EntryCache));
 #endif
 
 #ifdef __IRR_COMPILE_WITH_NPK_ARCHIVE_LOADER_
-	ArchiveLoader.push_back(new CArchiveLoaderNPK(this));
+	ArchiveLoader.push_back(new CArchiveLoaderNPK(this, EntryCache));
 #endif
 
 #ifdef __IRR_COMPILE_WITH_TAR_ARCHIVE_LOADER_
@@ -81,7 +82,7 @@ CFileSystem::CFileSystem()
 #endif
 
 #ifdef __IRR_COMPILE_WITH_ZIP_ARCHIVE_LOADER_
-	ArchiveLoader.push_back(new CArchiveLoaderZIP(this));
+	ArchiveLoader.push_back(new CArchiveLoaderZIP(this, EntryCache));
 #endif
 
 }
@@ -101,20 +102,29 @@ CFileSystem::~CFileSystem()
 	{
 		ArchiveLoader[i]->drop();
 	}
+
+	EntryCache->drop();
 }
 
 
 //! opens a file for read access
 IReadFile* CFileSystem::createAndOpenFile(const io::path& filename)
 {
-	IReadFile* file = 0;
-	u32 i;
-
-	for (i=0; i< FileArchives.size(); ++i)
+	SFileIndexEntry entry;
+	if (findInFileIndex(filename, entry) &&
+		!FileArchives[entry.Archive]->getFileList()->isDirectory(entry.File))
 	{
-		file = FileArchives[i]->createAndOpenFile(filename);
+		IReadFile* file = FileArchives[entry.Archive]->createAndOpenFile(entry.File);
 		if (file)
 			return file;
+
+		// the archive failed to open its file, try the archives after it
+		for (u32 i=entry.Archive+1; i < FileArchives.size(); ++i)
+		{
+			file = FileArchives[i]->createAndOpenFile(filename);
+			if (file)
+				return file;
+		}
 	}
 
 	// Create the file using an absolute path so that it matches
@@ -188,6 +198,36 @@ IArchiveLoader* CFileSystem::getArchiveLoader(u32 index) const
 		return 0;
 }
 
+
+//! Sets the size of the cache for the contents of archive entries
+void CFileSystem::setArchiveCacheSize(u32 bytes)
+{
+	EntryCache->setMaxSize(bytes);
+}
+
+
+//! Gets the size of the cache for the contents of archive entries
+u32 CFileSystem::getArchiveCacheSize() const
+{
+	return EntryCache->getMaxSize();
+}
+
+
+//! Sets a directory in which the file lists of zip archives are kept
+void CFileSystem::setArchiveIndexCacheDirectory(const path& directory)
+{
+	IndexCacheDirectory = directory;
+	IndexCacheDirectory.replace('\\', '/');
+}
+
+
+//! Gets the directory in which the file lists of zip archives are kept
+const path& CFileSystem::getArchiveIndexCacheDirectory() const
+{
+	return IndexCacheDirectory;
+}
+
+
 //! move the hirarchy of the filesystem. moves sourceIndex relative up or down
 bool CFileSystem::moveFileArchive(u32 sourceIndex, s32 relative)
 {
@@ -207,6 +247,9 @@ bool CFileSystem::moveFileArchive(u32 sourceIndex, s32 relative)
 		FileArchives[s] = t;
 		r = true;
 	}
+
+	if (r)
+		rebuildFileIndex();
 	return r;
 }
 
@@ -304,6 +347,7 @@ bool CFileSystem::addFileArchive(const io::path& filename, bool ignoreCase,
 	if (archive)
 	{
 		FileArchives.push_back(archive);
+		addToFileIndex(FileArchives.size()-1);
 		if (password.size())
 			archive->Password=password;
 		if (retArchive)
@@ -343,6 +387,98 @@ bool CFileSystem::changeArchivePassword(const path& filename,
 	return false;
 }
 
+//! adds the files of FileArchives[first] and following to the file index
+void CFileSystem::addToFileIndex(u32 first)
+{
+	SFileIndexEntry entry;
+	io::path key;
+
+	for (entry.Archive = first; entry.Archive < FileArchives.size(); ++entry.Archive)
+	{
+		const IFileList* list = FileArchives[entry.Archive]->getFileList();
+		core::hash_map<io::path, SFileIndexEntry>* index = FileIndex[list->isIgnoringPaths() ? 1 : 0];
+		const bool exactCase = !list->isIgnoringCase();
+
+		for (entry.File = 0; entry.File < list->getFileCount(); ++entry.File)
+		{
+			// directories keep the trailing slash which findFile expects for them
+			key = list->getFullFileName(entry.File);
+			if (list->isDirectory(entry.File))
+				key.append('/');
+
+			// archives before have priority
+			if (exactCase)
+				index[1].insert(key, entry);
+
+			// file lists also find names differing by case
+			key.make_lower();
+			index[0].insert(key, entry);
+		}
+	}
+}
+
+
+//! rebuilds the file index after archives were removed or moved
+void CFileSystem::rebuildFileIndex()
+{
+	for (u32 i=0; i<2; ++i)
+	{
+		FileIndex[i][0].clear();
+		FileIndex[i][1].clear();
+	}
+	addToFileIndex(0);
+}
+
+
+//! finds the archive of highest priority containing a file
+bool CFileSystem::findInFileIndex(const io::path& filename, SFileIndexEntry& entry) const
+{
+	if (FileIndex[0][0].empty() && FileIndex[1][0].empty())
+		return false;
+
+	// same normalization as CFileList::findFile, a trailing slash names a directory
+	io::path name(filename);
+	name.replace('\\', '/');
+	const bool directory = (name.lastChar() == '/');
+	if (directory)
+		name = name.subString(0, name.size()-1);
+
+	const core::hash_map<io::path, SFileIndexEntry>::Node* found = 0;
+
+	for (u32 paths=0; paths<2; ++paths)
+	{
+		if (paths)
+			core::deletePathFromFilename(name);
+
+		io::path key(name);
+		if (directory)
+			key.append('/');
+
+		io::path lowerKey(key);
+		lowerKey.make_lower();
+
+		// the exact name is checked first and wins within the same archive
+		const core::hash_map<io::path, SFileIndexEntry>::Node* node[2] = { 0, 0 };
+		if (!FileIndex[paths][1].empty())
+			node[0] = FileIndex[paths][1].find(key);
+		if (!FileIndex[paths][0].empty())
+			node[1] = FileIndex[paths][0].find(lowerKey);
+
+		for (u32 i=0; i<2; ++i)
+		{
+			if (node[i] && (!found || node[i]->getValue().Archive < found->getValue().Archive))
+				found = node[i];
+		}
+	}
+
+	if (!found)
+		return false;
+
+	entry = found->getValue();
+	return true;
+}
+
+
 bool CFileSystem::addFileArchive(IReadFile* file, bool ignoreCase,
 		bool ignorePaths, E_FILE_ARCHIVE_TYPE archiveType,
 		const core::stringc& password, IFileArchive** retArchive)
@@ -410,6 +546,7 @@ bool CFileSystem::addFileArchive(IReadFile* file, bool ignoreCase,
 		if (archive)
 		{
 			FileArchives.push_back(archive);
+			addToFileIndex(FileArchives.size()-1);
 			if (password.size())
 				archive->Password=password;
 			if (retArchive)
@@ -438,6 +575,7 @@ bool CFileSystem::addFileArchive(IFileArchive* archive)
 		}
 	}
 	FileArchives.push_back(archive);
+	addToFileIndex(FileArchives.size()-1);
 	return true;
 }
 
@@ -450,6 +588,7 @@ bool CFileSystem::removeFileArchive(u32 index)
 	{
 		FileArchives[index]->drop();
 		FileArchives.erase(index);
+		rebuildFileIndex();
 		ret = true;
 	}
 	_IRR_IMPLEMENT_MANAGED_MARSHALLING_BUGFIX;
@@ -955,9 +1094,9 @@ IFileList* CFileSystem::createEmptyFileList(const io::path& path, bool ignoreCas
 //! determines if a file exists and would be able to be opened.
 bool CFileSystem::existFile(const io::path& filename) const
 {
-	for (u32 i=0; i < FileArchives.size(); ++i)
-		if (FileArchives[i]->getFileList()->findFile(filename)!=-1)
-			return true;
+	SFileIndexEntry entry;
+	if (findInFileIndex(filename, entry))
+		return true;
 
 #if defined(_IRR_WINDOWS_CE_PLATFORM_)
 #if defined(_IRR_WCHAR_FILESYSTEM)
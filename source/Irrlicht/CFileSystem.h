@@ -7,6 +7,8 @@
 
 #include "IFileSystem.h"
 #include "irrArray.h"
+#include "irrHashMap.h"
+#include "CArchiveEntryCache.h"
 
 namespace irr
 {
@@ -74,6 +76,18 @@ public:
 	//! Gets the archive loader by index.
 	virtual IArchiveLoader* getArchiveLoader(u32 index) const _IRR_OVERRIDE_;
 
+	//! Sets the size of the cache for the contents of archive entries
+	virtual void setArchiveCacheSize(u32 bytes) _IRR_OVERRIDE_;
+
+	//! Gets the size of the cache for the contents of archive entries
+	virtual u32 getArchiveCacheSize() const _IRR_OVERRIDE_;
+
+	//! Sets a directory in which the file lists of zip archives are kept
+	virtual void setArchiveIndexCacheDirectory(const path& directory) _IRR_OVERRIDE_;
+
+	//! Gets the directory in which the file lists of zip archives are kept
+	virtual const path& getArchiveIndexCacheDirectory() const _IRR_OVERRIDE_;
+
 	//! gets the file archive count
 	virtual u32 getFileArchiveCount() const _IRR_OVERRIDE_;
 
@@ -155,6 +169,27 @@ private:
 			const core::stringc& password,
 			IFileArchive** archive = 0);
 
+	//! file of a mounted archive
+	struct SFileIndexEntry
+	{
+		//! index in FileArchives
+		u32 Archive;
+
+		//! index in the file list of the archive
+		u32 File;
+	};
+
+	//! adds the files of FileArchives[first] and following to the file index
+	/** Files which are already in the index belong to an archive of higher
+	priority and are kept. Directories are added with a trailing slash. */
+	void addToFileIndex(u32 first);
+
+	//! rebuilds the file index after archives were removed or moved
+	void rebuildFileIndex();
+
+	//! finds the archive of highest priority containing a file
+	bool findInFileIndex(const io::path& filename, SFileIndexEntry& entry) const;
+
 	//! Currently used FileSystemType
 	EFileSystemType FileSystemType;
 	//! WorkingDirectory for Native and Virtual filesystems
@@ -163,6 +198,15 @@ private:
 	core::array<IArchiveLoader*> ArchiveLoader;
 	//! currently attached Archives
 	core::array<IFileArchive*> FileArchives;
+	//! names of the files of all archives, keyed with path in [0][x] and
+	//! without path in [1][x] for archives ignoring paths. [x][0] holds the
+	//! lower case names of all archives, [x][1] the unchanged names of the
+	//! archives which don't ignore case.
+	core::hash_map<io::path, SFileIndexEntry> FileIndex[2][2];
+	//! contents of archive entries, shared by the built-in archive loaders
+	CArchiveEntryCache* EntryCache;
+	//! directory of the zip index cache files, empty if disabled
+	io::path IndexCacheDirectory;
 };
 
 
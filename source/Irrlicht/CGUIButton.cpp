@@ -50,6 +50,8 @@ CGUIButton::~CGUIButton()
 //! Sets if the images should be scaled to fit the button
 void CGUIButton::setScaleImage(bool scaleImage)
 {
+	if (ScaleImage != scaleImage)
+		Environment->invalidate(AbsoluteClippingRect);
 	ScaleImage = scaleImage;
 }
 
@@ -65,6 +67,8 @@ bool CGUIButton::isScalingImage() const
 //! Sets if the button should use the skin to draw its border
 void CGUIButton::setDrawBorder(bool border)
 {
+	if (DrawBorder != border)
+		Environment->invalidate(AbsoluteClippingRect);
 	DrawBorder = border;
 }
 
@@ -83,6 +87,11 @@ void CGUIButton::setSpriteBank(IGUISpriteBank* sprites)
 
 void CGUIButton::setSprite(EGUI_BUTTON_STATE state, s32 index, video::SColor color, bool loop, bool scale)
 {
+	// containing elements set their sprites again in each frame
+	const ButtonSprite& sprite = ButtonSprites[(u32)state];
+	if (sprite.Index != index || sprite.Color != color || sprite.Loop != loop || sprite.Scale != scale)
+		Environment->invalidate(AbsoluteClippingRect);
+
 	ButtonSprites[(u32)state].Index	= index;
 	ButtonSprites[(u32)state].Color	= color;
 	ButtonSprites[(u32)state].Loop	= loop;
@@ -460,6 +469,9 @@ void CGUIButton::setImage(EGUI_BUTTON_IMAGE_STATE state, video::ITexture* image,
 	if ( ButtonImages[stateIdx].Texture )
 		ButtonImages[stateIdx].Texture->drop();
 
+	if (ButtonImages[stateIdx].Texture != image || ButtonImages[stateIdx].SourceRect != sourceRect)
+		Environment->invalidate(AbsoluteClippingRect);
+
 	ButtonImages[stateIdx].Texture = image;
 	ButtonImages[stateIdx].SourceRect = sourceRect;
 }
@@ -488,6 +500,7 @@ void CGUIButton::setPressed(bool pressed)
 	{
 		ClickTime = os::Timer::getTime();
 		Pressed = pressed;
+		Environment->invalidate(AbsoluteClippingRect);
 	}
 }
 
@@ -503,6 +516,8 @@ bool CGUIButton::isPushButton() const
 //! Sets if the alpha channel should be used for drawing images on the button (default is false)
 void CGUIButton::setUseAlphaChannel(bool useAlphaChannel)
 {
+	if (UseAlphaChannel != useAlphaChannel)
+		Environment->invalidate(AbsoluteClippingRect);
 	UseAlphaChannel = useAlphaChannel;
 }
 
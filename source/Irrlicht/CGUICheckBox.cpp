@@ -190,6 +190,8 @@ void CGUICheckBox::draw()
 //! set if box is checked
 void CGUICheckBox::setChecked(bool checked)
 {
+	if (Checked != checked)
+		Environment->invalidate(AbsoluteClippingRect);
 	Checked = checked;
 }
 
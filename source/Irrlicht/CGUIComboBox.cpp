@@ -196,6 +196,8 @@ void CGUIComboBox::setSelected(s32 idx)
 		SelectedText->setText(L"");
 	else
 		SelectedText->setText(Items[Selected].Name.c_str());
+
+	Environment->invalidate(AbsoluteClippingRect);
 }
 
 
@@ -59,7 +59,8 @@ const io::path CGUIEnvironment::DefaultFontName = "#DefaultFont";
 CGUIEnvironment::CGUIEnvironment(io::IFileSystem* fs, video::IVideoDriver* driver, IOSOperator* op)
 : IGUIElement(EGUIET_ROOT, 0, 0, 0, core::rect<s32>(core::position2d<s32>(0,0), driver ? core::dimension2d<s32>(driver->getScreenSize()) : core::dimension2d<s32>(0,0))),
 	Driver(driver), Hovered(0), HoveredNoSubelement(0), Focus(0), LastHoveredMousePos(0,0), CurrentSkin(0),
-	FileSystem(fs), UserReceiver(0), Operator(op), FocusFlags(EFF_SET_ON_LMOUSE_DOWN|EFF_SET_ON_TAB)
+	FileSystem(fs), UserReceiver(0), Operator(op), FocusFlags(EFF_SET_ON_LMOUSE_DOWN|EFF_SET_ON_TAB),
+	RetainedBackground(255,0,0,0), RetainedFrame(0), RetainedMode(false)
 {
 	if (Driver)
 		Driver->grab();
@@ -204,6 +205,7 @@ void CGUIEnvironment::drawAll()
 			AbsoluteClippingRect = DesiredRect;
 			AbsoluteRect = DesiredRect;
 			updateAbsolutePosition();
+			invalidate(AbsoluteRect);
 		}
 	}
 
@@ -211,11 +213,195 @@ void CGUIEnvironment::drawAll()
 	if (ToolTip.Element)
 		bringToFront(ToolTip.Element);
 
-	draw();
+	if (RetainedMode && Driver)
+		drawChangedAreas();
+	else
+		draw();
 	OnPostRender ( os::Timer::getTime () );
 }
 
 
+//! enables drawing only the parts of the screen in which the GUI changed
+void CGUIEnvironment::setRetainedMode(bool retained, video::SColor background)
+{
+	RetainedMode = retained;
+	RetainedBackground = background;
+
+	ElementStates.clear();
+	ChangedAreas.clear();
+	invalidate(AbsoluteRect);
+}
+
+
+//! returns true if drawAll() only draws the changed parts of the GUI
+bool CGUIEnvironment::isRetainedMode() const
+{
+	return RetainedMode;
+}
+
+
+//! marks an area of the screen as changed, so retained mode draws it again
+void CGUIEnvironment::invalidate(const core::rect<s32>& area)
+{
+	if (!RetainedMode || !area.isValid() || area.getArea() == 0)
+		return;
+
+	// keep the list short, areas touching each other are drawn together anyway
+	for (u32 i=0; i<ChangedAreas.size(); ++i)
+	{
+		if (ChangedAreas[i].isRectCollided(area))
+		{
+			ChangedAreas[i].addInternalPoint(area.UpperLeftCorner);
+			ChangedAreas[i].addInternalPoint(area.LowerRightCorner);
+			return;
+		}
+	}
+
+	ChangedAreas.push_back(area);
+}
+
+
+//! draws the areas which changed since the last frame
+void CGUIEnvironment::drawChangedAreas()
+{
+	++RetainedFrame;
+	updateElementStates(this);
+
+	// elements which weren't visited are removed or invisible now
+	core::array<IGUIElement*> removed;
+	for (core::hash_map<IGUIElement*, SElementState>::Iterator it = ElementStates.getIterator(); !it.atEnd(); ++it)
+	{
+		if (it->getValue().Frame != RetainedFrame)
+		{
+			invalidate(it->getValue().Clip);
+			removed.push_back(it->getKey());
+		}
+	}
+	for (u32 i=0; i<removed.size(); ++i)
+		ElementStates.remove(removed[i]);
+
+	// merge areas which grew into each other, use the bounding box for many
+	for (u32 i=0; i<ChangedAreas.size(); ++i)
+	{
+		for (u32 j=i+1; j<ChangedAreas.size(); ++j)
+		{
+			if (ChangedAreas.size() > 16 || ChangedAreas[i].isRectCollided(ChangedAreas[j]))
+			{
+				ChangedAreas[i].addInternalPoint(ChangedAreas[j].UpperLeftCorner);
+				ChangedAreas[i].addInternalPoint(ChangedAreas[j].LowerRightCorner);
+				ChangedAreas.erase(j);
+				j = i;
+			}
+		}
+	}
+
+	// elements which change while they are drawn invalidate the next frame
+	core::array<core::rect<s32> > areas;
+	areas.swap(ChangedAreas);
+
+	// draw the children clipped to each area, the root clipping rect is
+	// the clipping rect of all elements
+	core::rect<s32> presented(0,0,0,0);
+	for (u32 i=0; i<areas.size(); ++i)
+	{
+		core::rect<s32> area(areas[i]);
+		area.clipAgainst(AbsoluteRect);
+		if (!area.isValid() || area.getArea() == 0)
+			continue;
+
+		Driver->draw2DRectangle(RetainedBackground, area);
+
+		AbsoluteClippingRect = area;
+		core::list<IGUIElement*>::Iterator it = Children.begin();
+		for (; it != Children.end(); ++it)
+			(*it)->updateAbsolutePosition();
+
+		draw();
+
+		if (presented.getArea() == 0)
+			presented = area;
+		else
+		{
+			presented.addInternalPoint(area.UpperLeftCorner);
+			presented.addInternalPoint(area.LowerRightCorner);
+		}
+	}
+
+	if (areas.size())
+	{
+		AbsoluteClippingRect = AbsoluteRect;
+		core::list<IGUIElement*>::Iterator it = Children.begin();
+		for (; it != Children.end(); ++it)
+			(*it)->updateAbsolutePosition();
+	}
+
+	Driver->setPresentArea(presented);
+}
+
+
+//! compares the visible elements below element with the last frame
+void CGUIEnvironment::updateElementStates(IGUIElement* element)
+{
+	core::list<IGUIElement*>::ConstIterator it = element->getChildren().begin();
+	for (; it != element->getChildren().end(); ++it)
+	{
+		IGUIElement* child = *it;
+		if (!child->isVisible())
+			continue;
+
+		const core::rect<s32>& clip = child->getAbsoluteClippingRect();
+		core::hash_map<IGUIElement*, SElementState>::Node* node = ElementStates.find(child);
+		if (!node)
+		{
+			SElementState state;
+			state.Clip = clip;
+			state.Text = child->getText();
+			state.Frame = RetainedFrame;
+			state.Enabled = child->isEnabled();
+			ElementStates.insert(child, state);
+			invalidate(clip);
+		}
+		else
+		{
+			SElementState& state = node->getValue();
+			if (state.Clip != clip || state.Enabled != child->isEnabled() || state.Text != child->getText())
+			{
+				invalidate(state.Clip);
+				invalidate(clip);
+				state.Clip = clip;
+				state.Text = child->getText();
+				state.Enabled = child->isEnabled();
+			}
+			state.Frame = RetainedFrame;
+		}
+
+		// faders and the cursor of edit boxes change with time
+		if (child->getType() == EGUIET_IN_OUT_FADER ||
+			(child == Focus && child->getType() == EGUIET_EDIT_BOX))
+			invalidate(clip);
+
+		updateElementStates(child);
+	}
+}
+
+
+//! marks the elements which get input as changed
+void CGUIEnvironment::invalidateInputElements()
+{
+	IGUIElement* elements[2] = { HoveredNoSubelement, Focus };
+	for (u32 i=0; i<2; ++i)
+	{
+		// sub elements like scrollbars change their parent
+		IGUIElement* element = elements[i];
+		while (element && element->isSubElement() && element->getParent())
+			element = element->getParent();
+
+		if (element && element != this)
+			invalidate(element->getAbsoluteClippingRect());
+	}
+}
+
+
 //! sets the focus to an element
 bool CGUIEnvironment::setFocus(IGUIElement* element)
 {
@@ -565,6 +751,21 @@ void CGUIEnvironment::setUserEventReceiver(IEventReceiver* evr)
 
 //! posts an input event to the environment
 bool CGUIEnvironment::postEventFromUser(const SEvent& event)
+{
+	if (!RetainedMode)
+		return processEventFromUser(event);
+
+	// the elements which had and which get the input are drawn again
+	invalidateInputElements();
+	const bool result = processEventFromUser(event);
+	invalidateInputElements();
+
+	return result;
+}
+
+
+//! handles an input event, postEventFromUser() without retained mode
+bool CGUIEnvironment::processEventFromUser(const SEvent& event)
 {
 	switch(event.EventType)
 	{
@@ -663,6 +864,8 @@ void CGUIEnvironment::setSkin(IGUISkin* skin)
 
 	if (CurrentSkin)
 		CurrentSkin->grab();
+
+	invalidate(AbsoluteRect);
 }
 
 
@@ -13,6 +13,7 @@
 #include "irrArray.h"
 #include "IFileSystem.h"
 #include "IOSOperator.h"
+#include "irrHashMap.h"
 
 namespace irr
 {
@@ -36,6 +37,15 @@ public:
 	//! draws all gui elements
 	virtual void drawAll() _IRR_OVERRIDE_;
 
+	//! enables drawing only the parts of the screen in which the GUI changed
+	virtual void setRetainedMode(bool retained, video::SColor background) _IRR_OVERRIDE_;
+
+	//! returns true if drawAll() only draws the changed parts of the GUI
+	virtual bool isRetainedMode() const _IRR_OVERRIDE_;
+
+	//! marks an area of the screen as changed, so retained mode draws it again
+	virtual void invalidate(const core::rect<s32>& area) _IRR_OVERRIDE_;
+
 	//! returns the current video driver
 	virtual video::IVideoDriver* getVideoDriver() const _IRR_OVERRIDE_;
 
@@ -276,6 +286,27 @@ private:
 
 	void updateHoveredElement(core::position2d<s32> mousePos);
 
+	//! handles an input event, postEventFromUser() without retained mode
+	bool processEventFromUser(const SEvent& event);
+
+	//! draws the areas which changed since the last frame
+	void drawChangedAreas();
+
+	//! compares the visible elements below element with the last frame
+	void updateElementStates(IGUIElement* element);
+
+	//! marks the elements which get input as changed
+	void invalidateInputElements();
+
+	//! state of a visible element in the last frame
+	struct SElementState
+	{
+		core::rect<s32> Clip;
+		core::stringw Text;
+		u32 Frame;
+		bool Enabled;
+	};
+
 	void loadBuiltInFont();
 
 	struct SFont
@@ -325,6 +356,14 @@ private:
 	IEventReceiver* UserReceiver;
 	IOSOperator* Operator;
 	u32 FocusFlags;
+
+	// retained mode
+	core::hash_map<IGUIElement*, SElementState> ElementStates;
+	core::array<core::rect<s32> > ChangedAreas;
+	video::SColor RetainedBackground;
+	u32 RetainedFrame;
+	bool RetainedMode;
+
 	static const io::path DefaultFontName;
 };
 
@@ -49,6 +49,8 @@ CGUIFont::CGUIFont(IGUIEnvironment *env, const io::path& filename)
 //! destructor
 CGUIFont::~CGUIFont()
 {
+	clearGlyphRuns();
+
 	if (Driver)
 		Driver->drop();
 
@@ -191,8 +193,8 @@ bool CGUIFont::load(io::IXMLReader* xml, const io::path& directory)
 		}
 	}
 
-	// set bad character
-	WrongCharacter = getAreaFromCharacter(L' ');
+	// set bad character and the character table
+	updateCharacterTable();
 
 	setMaxHeight();
 
@@ -273,7 +275,7 @@ bool CGUIFont::loadTexture(video::IImage* image, const io::path& name)
 	}
 	readPositions(tmpImage, lowerRightPositions);
 
-	WrongCharacter = getAreaFromCharacter(L' ');
+	updateCharacterTable();
 
 	// output warnings
 	if (!lowerRightPositions || !SpriteBank->getSprites().size())
@@ -381,6 +383,9 @@ void CGUIFont::readPositions(video::IImage* image, s32& lowerRightPositions)
 //! set an Pixel Offset on Drawing ( scale position on width )
 void CGUIFont::setKerningWidth(s32 kerning)
 {
+	if (GlobalKerningWidth != kerning)
+		clearGlyphRuns();
+
 	GlobalKerningWidth = kerning;
 }
 
@@ -427,7 +432,10 @@ u32 CGUIFont::getSpriteNoFromChar(const wchar_t *c) const
 
 s32 CGUIFont::getAreaFromCharacter(const wchar_t c) const
 {
-	core::map<wchar_t, s32>::Node* n = CharacterMap.find(c);
+	if ((u32)c < CharacterTable.size())
+		return CharacterTable[c] & ~CHARACTER_INVISIBLE;
+
+	core::hash_map<wchar_t, s32>::Node* n = CharacterMap.find(c);
 	if (n)
 		return n->getValue();
 	else
@@ -437,6 +445,121 @@ s32 CGUIFont::getAreaFromCharacter(const wchar_t c) const
 void CGUIFont::setInvisibleCharacters( const wchar_t *s )
 {
 	Invisible = s;
+	updateCharacterTable();
+}
+
+
+void CGUIFont::updateCharacterTable()
+{
+	CharacterTable.clear();
+
+	// set bad character
+	WrongCharacter = getAreaFromCharacter(L' ');
+
+	u32 size = 0;
+	for (core::hash_map<wchar_t, s32>::ConstIterator it = CharacterMap.getConstIterator(); !it.atEnd(); ++it)
+	{
+		const u32 c = (u32)it->getKey();
+		if (c < 0x10000 && c >= size)
+			size = c + 1;
+	}
+	for (u32 i = 0; i < Invisible.size(); ++i)
+	{
+		const u32 c = (u32)Invisible[i];
+		if (c < 0x10000 && c >= size)
+			size = c + 1;
+	}
+
+	CharacterTable.set_used(size);
+	for (u32 i = 0; i < size; ++i)
+		CharacterTable[i] = WrongCharacter;
+
+	for (core::hash_map<wchar_t, s32>::ConstIterator it = CharacterMap.getConstIterator(); !it.atEnd(); ++it)
+	{
+		const u32 c = (u32)it->getKey();
+		if (c < size)
+			CharacterTable[c] = (u32)it->getValue();
+	}
+	for (u32 i = 0; i < Invisible.size(); ++i)
+	{
+		const u32 c = (u32)Invisible[i];
+		if (c < size)
+			CharacterTable[c] |= CHARACTER_INVISIBLE;
+	}
+
+	clearGlyphRuns();
+}
+
+
+const CGUIFont::SGlyphRun& CGUIFont::getGlyphRun(const core::stringw& text)
+{
+	core::hash_map<core::stringw, SGlyphRun*>::Node* n = GlyphRuns.find(text);
+	if (n)
+		return *n->getValue();
+
+	// texts of the gui rarely change, so a full cache is simply started anew
+	if (GlyphRuns.size() >= MAX_GLYPH_RUNS)
+		clearGlyphRuns();
+
+	SGlyphRun* run = new SGlyphRun();
+	run->Indices.reallocate(text.size());
+	run->Offsets.reallocate(text.size());
+
+	core::position2di offset(0, 0);
+
+	for (u32 i = 0; i < text.size(); ++i)
+	{
+		wchar_t c = text[i];
+
+		bool lineBreak=false;
+		if ( c == L'\r') // Mac or Windows breaks
+		{
+			lineBreak = true;
+			if ( text[i + 1] == L'\n') // Windows breaks
+				c = text[++i];
+		}
+		else if ( c == L'\n') // Unix breaks
+		{
+			lineBreak = true;
+		}
+
+		if (lineBreak)
+		{
+			if (run->Dimension.Width < offset.X)
+				run->Dimension.Width = offset.X;
+			offset.Y += MaxHeight;
+			offset.X = 0;
+			continue;
+		}
+
+		const u32 entry = getCharacterEntry(c);
+		const SFontArea& area = Areas[entry & ~CHARACTER_INVISIBLE];
+
+		offset.X += area.underhang;
+		if (!(entry & CHARACTER_INVISIBLE))
+		{
+			run->Indices.push_back(area.spriteno);
+			run->Offsets.push_back(offset);
+		}
+
+		offset.X += area.width + area.overhang + GlobalKerningWidth;
+	}
+
+	if (run->Dimension.Width < offset.X)
+		run->Dimension.Width = offset.X;
+	run->Dimension.Height = offset.Y + MaxHeight;
+
+	GlyphRuns.insert(text, run);
+	return *run;
+}
+
+
+void CGUIFont::clearGlyphRuns()
+{
+	for (core::hash_map<core::stringw, SGlyphRun*>::Iterator it = GlyphRuns.getIterator(); !it.atEnd(); ++it)
+		delete it->getValue();
+
+	GlyphRuns.clear();
 }
 
 
@@ -490,70 +613,30 @@ void CGUIFont::draw(const core::stringw& text, const core::rect<s32>& position,
 	if (!Driver || !SpriteBank)
 		return;
 
-	core::dimension2d<s32> textDimension;	// NOTE: don't make this u32 or the >> later on can fail when the dimension width is < position width
-	core::position2d<s32> offset = position.UpperLeftCorner;
+	const SGlyphRun& run = getGlyphRun(text);
 
-	if (hcenter || vcenter || clip)
-		textDimension = getDimension(text.c_str());
+	core::position2d<s32> offset = position.UpperLeftCorner;
 
+	// NOTE: the dimension is s32 or the >> can fail when the text is wider than the position
 	if (hcenter)
-		offset.X += (position.getWidth() - textDimension.Width) >> 1;
+		offset.X += (position.getWidth() - run.Dimension.Width) >> 1;
 
 	if (vcenter)
-		offset.Y += (position.getHeight() - textDimension.Height) >> 1;
+		offset.Y += (position.getHeight() - run.Dimension.Height) >> 1;
 
 	if (clip)
 	{
-		core::rect<s32> clippedRect(offset, textDimension);
+		core::rect<s32> clippedRect(offset, run.Dimension);
 		clippedRect.clipAgainst(*clip);
 		if (!clippedRect.isValid())
 			return;
 	}
 
-	core::array<u32> indices(text.size());
-	core::array<core::position2di> offsets(text.size());
-
-	for(u32 i = 0;i < text.size();i++)
-	{
-		wchar_t c = text[i];
-
-		bool lineBreak=false;
-		if ( c == L'\r') // Mac or Windows breaks
-		{
-			lineBreak = true;
-			if ( text[i + 1] == L'\n') // Windows breaks
-				c = text[++i];
-		}
-		else if ( c == L'\n') // Unix breaks
-		{
-			lineBreak = true;
-		}
-
-		if (lineBreak)
-		{
-			offset.Y += MaxHeight;
-			offset.X = position.UpperLeftCorner.X;
-
-			if ( hcenter )
-			{
-				offset.X += (position.getWidth() - textDimension.Width) >> 1;
-			}
-			continue;
-		}
-
-		SFontArea& area = Areas[getAreaFromCharacter(c)];
-
-		offset.X += area.underhang;
-		if ( Invisible.findFirst ( c ) < 0 )
-		{
-			indices.push_back(area.spriteno);
-			offsets.push_back(offset);
-		}
-
-		offset.X += area.width + area.overhang + GlobalKerningWidth;
-	}
+	DrawPositions.set_used(run.Offsets.size());
+	for (u32 i = 0; i < run.Offsets.size(); ++i)
+		DrawPositions[i] = run.Offsets[i] + offset;
 
-	SpriteBank->draw2DSpriteBatch(indices, offsets, clip, color);
+	SpriteBank->draw2DSpriteBatch(run.Indices, DrawPositions, clip, color);
 }
 
 
@@ -10,7 +10,7 @@
 
 #include "IGUIFontBitmap.h"
 #include "irrString.h"
-#include "irrMap.h"
+#include "irrHashMap.h"
 #include "IXMLReader.h"
 #include "IReadFile.h"
 #include "irrArray.h"
@@ -95,11 +95,58 @@ private:
 
 	void readPositions(video::IImage* texture, s32& lowerRightPositions);
 
+	//! sprites and positions of a text
+	/** Positions are relative to the upper left corner of the text, all
+	lines start at 0. A run depends on the text and the kerning only, the
+	layout of a draw call is a single translation. */
+	struct SGlyphRun
+	{
+		core::array<u32> Indices;
+		core::array<core::position2di> Offsets;
+		core::dimension2d<s32> Dimension;
+	};
+
+	enum
+	{
+		//! flag of invisible characters in CharacterTable
+		CHARACTER_INVISIBLE = 0x80000000,
+
+		//! the glyph run cache is emptied when it has this many runs
+		MAX_GLYPH_RUNS = 256
+	};
+
 	s32 getAreaFromCharacter (const wchar_t c) const;
 	void setMaxHeight();
 
+	//! returns the area of a character, with CHARACTER_INVISIBLE for invisible characters
+	u32 getCharacterEntry(const wchar_t c) const
+	{
+		if ((u32)c < CharacterTable.size())
+			return CharacterTable[c];
+
+		u32 entry = (u32)getAreaFromCharacter(c);
+		if (Invisible.findFirst(c) >= 0)
+			entry |= CHARACTER_INVISIBLE;
+		return entry;
+	}
+
+	//! rebuilds CharacterTable from CharacterMap and Invisible
+	void updateCharacterTable();
+
+	//! returns the cached glyph run of a text, creates it if needed
+	const SGlyphRun& getGlyphRun(const core::stringw& text);
+
+	//! removes all glyph runs, they are outdated when the font changes
+	void clearGlyphRuns();
+
 	core::array<SFontArea>		Areas;
-	core::map<wchar_t, s32>		CharacterMap;
+	core::hash_map<wchar_t, s32>	CharacterMap;
+
+	//! area and invisible flag of all BMP characters up to the largest one used
+	core::array<u32>		CharacterTable;
+
+	core::hash_map<core::stringw, SGlyphRun*>	GlyphRuns;
+	core::array<core::position2di>	DrawPositions;
 	video::IVideoDriver*		Driver;
 	IGUISpriteBank*			SpriteBank;
 	IGUIEnvironment*		Environment;
@@ -47,6 +47,8 @@ void CGUIImage::setImage(video::ITexture* image)
 
 	if (Texture)
 		Texture->grab();
+
+	Environment->invalidate(AbsoluteClippingRect);
 }
 
 //! Gets the image texture
@@ -59,6 +61,7 @@ video::ITexture* CGUIImage::getImage() const
 void CGUIImage::setColor(video::SColor color)
 {
 	Color = color;
+	Environment->invalidate(AbsoluteClippingRect);
 }
 
 //! Gets the color of the image
@@ -120,6 +123,7 @@ void CGUIImage::draw()
 void CGUIImage::setUseAlphaChannel(bool use)
 {
 	UseAlphaChannel = use;
+	Environment->invalidate(AbsoluteClippingRect);
 }
 
 
@@ -127,6 +131,7 @@ void CGUIImage::setUseAlphaChannel(bool use)
 void CGUIImage::setScaleImage(bool scale)
 {
 	ScaleImage = scale;
+	Environment->invalidate(AbsoluteClippingRect);
 }
 
 
@@ -148,6 +153,7 @@ bool CGUIImage::isAlphaChannelUsed() const
 void CGUIImage::setSourceRect(const core::rect<s32>& sourceRect)
 {
 	SourceRect = sourceRect;
+	Environment->invalidate(AbsoluteClippingRect);
 }
 
 //! Returns the customized source rectangle of the image to be used.
@@ -168,6 +174,7 @@ void CGUIImage::setDrawBounds(const core::rect<f32>& drawBoundUVs)
 		DrawBounds.UpperLeftCorner.X = DrawBounds.LowerRightCorner.X;
 	if ( DrawBounds.UpperLeftCorner.Y > DrawBounds.LowerRightCorner.Y )
 		DrawBounds.UpperLeftCorner.Y = DrawBounds.LowerRightCorner.Y;
+	Environment->invalidate(AbsoluteClippingRect);
 }
 
 //! Get target drawing-area restrictions.
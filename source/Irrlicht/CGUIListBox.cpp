@@ -122,6 +122,7 @@ void CGUIListBox::removeItem(u32 id)
 	Items.erase(id);
 
 	recalculateItemHeight();
+	Environment->invalidate(AbsoluteClippingRect);
 }
 
 
@@ -153,6 +154,7 @@ void CGUIListBox::clear()
 		ScrollBar->setPos(0);
 
 	recalculateItemHeight();
+	Environment->invalidate(AbsoluteClippingRect);
 }
 
 
@@ -209,6 +211,7 @@ void CGUIListBox::setSelected(s32 id)
 	selectTime = os::Timer::getTime();
 
 	recalculateScrollPos();
+	Environment->invalidate(AbsoluteClippingRect);
 }
 
 //! sets the selected item. Set this to -1 if no item should be selected
@@ -604,6 +607,7 @@ u32 CGUIListBox::addItem(const wchar_t* text, s32 icon)
 	Items.push_back(i);
 	recalculateItemHeight();
 	recalculateItemWidth(icon);
+	Environment->invalidate(AbsoluteClippingRect);
 
 	return Items.size() - 1;
 }
@@ -346,6 +346,8 @@ s32 CGUIScrollBar::getPosFromMousePos(const core::position2di &pos) const
 //! sets the position of the scrollbar
 void CGUIScrollBar::setPos(s32 pos)
 {
+	const s32 oldDrawPos = DrawPos;
+	const s32 oldDrawHeight = DrawHeight;
 	Pos = core::s32_clamp ( pos, Min, Max );
 
 	if (Horizontal)
@@ -362,6 +364,9 @@ void CGUIScrollBar::setPos(s32 pos)
 		DrawHeight = RelativeRect.getWidth();
 	}
 
+	// also called while drawing, only a moved thumb is drawn again
+	if (DrawPos != oldDrawPos || DrawHeight != oldDrawHeight)
+		Environment->invalidate(AbsoluteClippingRect);
 }
 
 
@@ -0,0 +1,175 @@
+// Copyright (C) 2002-2012 Nikolaus Gebhardt
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#include "CInflateReadFile.h"
+
+#ifdef _IRR_COMPILE_WITH_ZLIB_
+
+#include "os.h"
+
+#ifndef _IRR_USE_NON_SYSTEM_ZLIB_
+	#include <zlib.h> // use system lib
+#else
+	#include "zlib/zlib.h"
+#endif
+
+namespace irr
+{
+namespace io
+{
+
+namespace
+{
+	// size of the compressed data read at once
+	const u32 INFLATE_INPUT_SIZE = 16384;
+}
+
+
+CInflateReadFile::CInflateReadFile(IReadFile* alreadyOpenedFile, long pos, long compressedSize,
+		long uncompressedSize, const io::path& name)
+	: Filename(name), File(alreadyOpenedFile), AreaStart(pos), AreaSize(compressedSize),
+	Consumed(0), Size(uncompressedSize), Pos(0), Stream(0), Input(0), Valid(false)
+{
+	#ifdef _DEBUG
+	setDebugName("CInflateReadFile");
+	#endif
+
+	if (!File)
+		return;
+
+	File->grab();
+
+	Input = new u8[INFLATE_INPUT_SIZE];
+	Stream = new z_stream;
+	Stream->next_in = 0;
+	Stream->avail_in = 0;
+	Stream->zalloc = (alloc_func)0;
+	Stream->zfree = (free_func)0;
+	Stream->opaque = (voidpf)0;
+
+	// wbits < 0 indicates no zlib header inside the data.
+	Valid = (inflateInit2(Stream, -MAX_WBITS) == Z_OK);
+	if (!Valid)
+		os::Printer::log("Could not initialize inflate stream", Filename, ELL_ERROR);
+}
+
+
+CInflateReadFile::~CInflateReadFile()
+{
+	if (Valid)
+		inflateEnd(Stream);
+	delete Stream;
+	delete [] Input;
+
+	if (File)
+		File->drop();
+}
+
+
+//! returns how much was read
+s32 CInflateReadFile::read(void* buffer, u32 sizeToRead)
+{
+	if (!Valid || Pos >= Size)
+		return 0;
+
+	if ((long)sizeToRead > Size - Pos)
+		sizeToRead = Size - Pos;
+
+	Stream->next_out = (Bytef*)buffer;
+	Stream->avail_out = sizeToRead;
+
+	while (Stream->avail_out)
+	{
+		if (!Stream->avail_in)
+		{
+			const s32 toRead = core::s32_min(INFLATE_INPUT_SIZE, AreaSize - Consumed);
+			if (toRead <= 0)
+				break;
+
+			// the archive file is shared with the other entries
+			File->seek(AreaStart + Consumed);
+			const s32 r = File->read(Input, toRead);
+			if (r <= 0)
+				break;
+
+			Consumed += r;
+			Stream->next_in = Input;
+			Stream->avail_in = r;
+		}
+
+		const s32 err = inflate(Stream, Z_NO_FLUSH);
+		if (err == Z_STREAM_END)
+			break;
+		if (err != Z_OK)
+		{
+			os::Printer::log("Error decompressing", Filename, ELL_ERROR);
+			break;
+		}
+	}
+
+	const s32 r = sizeToRead - Stream->avail_out;
+	Pos += r;
+	return r;
+}
+
+
+//! changes position in file, returns true if successful
+bool CInflateReadFile::seek(long finalPos, bool relativeMovement)
+{
+	if (relativeMovement)
+		finalPos += Pos;
+
+	if (!Valid || finalPos < 0 || finalPos > Size)
+		return false;
+
+	if (finalPos < Pos)
+		reset();
+
+	u8 skipped[1024];
+	while (Pos < finalPos)
+	{
+		if (read(skipped, core::s32_min(sizeof(skipped), finalPos - Pos)) <= 0)
+			return false;
+	}
+
+	return true;
+}
+
+
+//! returns size of file
+long CInflateReadFile::getSize() const
+{
+	return Size;
+}
+
+
+//! returns where in the file we are.
+long CInflateReadFile::getPos() const
+{
+	return Pos;
+}
+
+
+//! returns name of file
+const io::path& CInflateReadFile::getFileName() const
+{
+	return Filename;
+}
+
+
+void CInflateReadFile::reset()
+{
+	inflateReset(Stream);
+	Stream->next_in = 0;
+	Stream->avail_in = 0;
+	Consumed = 0;
+	Pos = 0;
+}
+
+
+} // end namespace io
+} // end namespace irr
+
+#endif // _IRR_COMPILE_WITH_ZLIB_
+
@@ -0,0 +1,78 @@
+// Copyright (C) 2002-2012 Nikolaus Gebhardt
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#ifndef __C_INFLATE_READ_FILE_H_INCLUDED__
+#define __C_INFLATE_READ_FILE_H_INCLUDED__
+
+#include "IrrCompileConfig.h"
+
+#ifdef _IRR_COMPILE_WITH_ZLIB_
+
+#include "IReadFile.h"
+#include "irrString.h"
+
+struct z_stream_s;
+
+namespace irr
+{
+namespace io
+{
+
+	/*! A read file which inflates a raw deflate stream inside another file
+		while it is read, like the deflated entries of zip archives.
+		Only a small input buffer is kept, so the memory needed doesn't
+		depend on the size of the entry. Seeking forward inflates and
+		skips the data in between, seeking backwards starts inflating
+		again from the beginning of the stream.
+	!*/
+	class CInflateReadFile : public IReadFile
+	{
+	public:
+
+		CInflateReadFile(IReadFile* alreadyOpenedFile, long pos, long compressedSize,
+			long uncompressedSize, const io::path& name);
+
+		virtual ~CInflateReadFile();
+
+		//! returns how much was read
+		virtual s32 read(void* buffer, u32 sizeToRead) _IRR_OVERRIDE_;
+
+		//! changes position in file, returns true if successful
+		//! if relativeMovement==true, the pos is changed relative to current pos,
+		//! otherwise from begin of file
+		virtual bool seek(long finalPos, bool relativeMovement = false) _IRR_OVERRIDE_;
+
+		//! returns size of file
+		virtual long getSize() const _IRR_OVERRIDE_;
+
+		//! returns where in the file we are.
+		virtual long getPos() const _IRR_OVERRIDE_;
+
+		//! returns name of file
+		virtual const io::path& getFileName() const _IRR_OVERRIDE_;
+
+	private:
+
+		//! starts inflating from the beginning of the stream
+		void reset();
+
+		io::path Filename;
+		IReadFile* File;
+		long AreaStart;
+		long AreaSize;
+		long Consumed;
+		long Size;
+		long Pos;
+		z_stream_s* Stream;
+		u8* Input;
+		bool Valid;
+	};
+
+} // end namespace io
+} // end namespace irr
+
+#endif // _IRR_COMPILE_WITH_ZLIB_
+
+#endif
+
@@ -373,7 +373,7 @@ bool CIrrDeviceConsole::isWindowMinimized() const
 }
 
 //! presents a surface in the client area
-bool CIrrDeviceConsole::present(video::IImage* surface, void* windowId, core::rect<s32>* src)
+bool CIrrDeviceConsole::present(video::IImage* surface, void* windowId, core::rect<s32>* src, const core::rect<s32>* area)
 {
 
 	if (surface)
@@ -305,7 +305,7 @@ void CIrrDeviceFB::sleep(u32 timeMs, bool pauseTimer=false)
 
 
 //! presents a surface in the client area
-bool CIrrDeviceFB::present(video::IImage* image, void* windowId, core::rect<s32>* src )
+bool CIrrDeviceFB::present(video::IImage* image, void* windowId, core::rect<s32>* src, const core::rect<s32>* area )
 {
 	// this is only necessary for software drivers.
 	if (CreationParams.DriverType != video::EDT_SOFTWARE && CreationParams.DriverType != video::EDT_BURNINGSVIDEO)
@@ -87,7 +87,7 @@ CIrrDeviceLinux::CIrrDeviceLinux(const SIrrlichtCreationParameters& param)
 #endif
 #endif
 	Width(param.WindowSize.Width), Height(param.WindowSize.Height),
-	WindowHasFocus(false), WindowMinimized(false),
+	WindowHasFocus(false), WindowMinimized(false), PresentWholeWindow(true),
 	UseXVidMode(false), UseXRandR(false), UseGLXWindow(false),
 	ExternalWindow(false), AutorepeatSupport(0)
 {
@@ -1049,11 +1049,18 @@ bool CIrrDeviceLinux::run()
 
 					if (VideoDriver)
 						VideoDriver->OnResize(core::dimension2d<u32>(Width, Height));
+
+					PresentWholeWindow=true;
 				}
 				break;
 
 			case MapNotify:
 				WindowMinimized=false;
+				PresentWholeWindow=true;
+				break;
+
+			case Expose:
+				PresentWholeWindow=true;
 				break;
 
 			case UnmapNotify:
@@ -1374,7 +1381,7 @@ void CIrrDeviceLinux::setWindowCaption(const wchar_t* text)
 
 
 //! presents a surface in the client area
-bool CIrrDeviceLinux::present(video::IImage* image, void* windowId, core::rect<s32>* srcRect)
+bool CIrrDeviceLinux::present(video::IImage* image, void* windowId, core::rect<s32>* srcRect, const core::rect<s32>* area)
 {
 #ifdef _IRR_COMPILE_WITH_X11_
 	// this is only necessary for software drivers.
@@ -1404,25 +1411,41 @@ bool CIrrDeviceLinux::present(video::IImage* image, void* windowId, core::rect<s
 			return false;
 	}
 
-	u8* srcdata = reinterpret_cast<u8*>(image->lock());
-	u8* destData = reinterpret_cast<u8*>(SoftwareImage->data);
-
 	const u32 destheight = SoftwareImage->height;
 	const u32 srcheight = core::min_(image->getDimension().Height, destheight);
+
+	Window myWindow=XWindow;
+	if (windowId)
+		myWindow = reinterpret_cast<Window>(windowId);
+
+	// only the changed area is converted and sent to the X server, unless
+	// our window lost its content or we don't get the events of the window
+	core::rect<s32> changed(0, 0, minWidth, srcheight);
+	if (area && !PresentWholeWindow && myWindow == XWindow)
+		changed.clipAgainst(*area);
+	if (myWindow == XWindow)
+		PresentWholeWindow = false;
+	if (changed.getWidth() <= 0 || changed.getHeight() <= 0)
+		return true;
+
 	const u32 srcPitch = image->getPitch();
-	for (u32 y=0; y!=srcheight; ++y)
+	const u32 srcBytes = video::IImage::getBitsPerPixelFromFormat(image->getColorFormat()) / 8;
+	const u32 destBytes = SoftwareImage->bits_per_pixel / 8;
+
+	u8* srcdata = reinterpret_cast<u8*>(image->lock()) + changed.UpperLeftCorner.Y*srcPitch + changed.UpperLeftCorner.X*srcBytes;
+	u8* destData = reinterpret_cast<u8*>(SoftwareImage->data) + changed.UpperLeftCorner.Y*destPitch + changed.UpperLeftCorner.X*destBytes;
+
+	for (s32 y=changed.UpperLeftCorner.Y; y!=changed.LowerRightCorner.Y; ++y)
 	{
-		video::CColorConverter::convert_viaFormat(srcdata,image->getColorFormat(), minWidth, destData, destColor);
+		video::CColorConverter::convert_viaFormat(srcdata,image->getColorFormat(), changed.getWidth(), destData, destColor);
 		srcdata+=srcPitch;
 		destData+=destPitch;
 	}
 	image->unlock();
 
 	GC gc = DefaultGC(XDisplay, DefaultScreen(XDisplay));
-	Window myWindow=XWindow;
-	if (windowId)
-		myWindow = reinterpret_cast<Window>(windowId);
-	XPutImage(XDisplay, myWindow, gc, SoftwareImage, 0, 0, 0, 0, destwidth, destheight);
+	XPutImage(XDisplay, myWindow, gc, SoftwareImage, changed.UpperLeftCorner.X, changed.UpperLeftCorner.Y,
+		changed.UpperLeftCorner.X, changed.UpperLeftCorner.Y, changed.getWidth(), changed.getHeight());
 #endif
 	return true;
 }
@@ -80,7 +80,7 @@ namespace irr
 		virtual video::ECOLOR_FORMAT getColorFormat() const _IRR_OVERRIDE_;
 
 		//! presents a surface in the client area
-		virtual bool present(video::IImage* surface, void* windowId=0, core::rect<s32>* src=0 ) _IRR_OVERRIDE_;
+		virtual bool present(video::IImage* surface, void* windowId=0, core::rect<s32>* src=0, const core::rect<s32>* area=0 ) _IRR_OVERRIDE_;
 
 		//! notifies the device that it should close itself
 		virtual void closeDevice() _IRR_OVERRIDE_;
@@ -419,6 +419,8 @@ namespace irr
 		u32 Width, Height;
 		bool WindowHasFocus;
 		bool WindowMinimized;
+		//! the window lost its content, present() has to send the whole image
+		bool PresentWholeWindow;
 		bool UseXVidMode;
 		bool UseXRandR;
 		bool UseGLXWindow;
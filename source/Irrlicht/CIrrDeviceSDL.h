@@ -57,7 +57,7 @@ namespace irr
 		video::ECOLOR_FORMAT getColorFormat() const;
 
 		//! presents a surface in the client area
-		virtual bool present(video::IImage* surface, void* windowId=0, core::rect<s32>* src=0) _IRR_OVERRIDE_;
+		virtual bool present(video::IImage* surface, void* windowId=0, core::rect<s32>* src=0, const core::rect<s32>* area=0) _IRR_OVERRIDE_;
 
 		//! notifies the device that it should close itself
 		virtual void closeDevice() _IRR_OVERRIDE_;
@@ -1342,7 +1342,7 @@ void CIrrDeviceWin32::setWindowCaption(const wchar_t* text)
 
 
 //! presents a surface in the client area
-bool CIrrDeviceWin32::present(video::IImage* image, void* windowId, core::rect<s32>* src)
+bool CIrrDeviceWin32::present(video::IImage* image, void* windowId, core::rect<s32>* src, const core::rect<s32>* area)
 {
 	HWND hwnd = HWnd;
 	if ( windowId )
@@ -649,7 +649,7 @@ typedef struct {
 
 
 //! presents a surface in the client area
-bool CIrrDeviceWinCE::present(video::IImage* image, void* windowId, core::rect<s32>* src)
+bool CIrrDeviceWinCE::present(video::IImage* image, void* windowId, core::rect<s32>* src, const core::rect<s32>* area)
 {
 	HWND hwnd = HWnd;
 	if ( windowId )
@@ -148,6 +148,9 @@ IMeshBuffer* CIrrMeshFileLoader::readMeshBuffer(io::IXMLReader* reader)
 
 	bool insideVertexSection = false;
 	bool insideIndexSection = false;
+	bool base64Vertices = false;
+	bool base64Indices = false;
+	const core::stringc base64Name = "base64";
 
 	int vertexCount = 0;
 	int indexCount = 0;
@@ -187,6 +190,7 @@ IMeshBuffer* CIrrMeshFileLoader::readMeshBuffer(io::IXMLReader* reader)
 
 				const wchar_t* vertexType = reader->getAttributeValue(L"type");
 				vertexCount = reader->getAttributeValueAsInt(L"vertexCount");
+				base64Vertices = (base64Name == reader->getAttributeValueSafe(L"encoding"));
 
 				insideVertexSection = true;
 
@@ -217,6 +221,15 @@ IMeshBuffer* CIrrMeshFileLoader::readMeshBuffer(io::IXMLReader* reader)
 
 				indexCount = reader->getAttributeValueAsInt(L"indexCount");
 				insideIndexSection = true;
+
+				base64Indices = (base64Name == reader->getAttributeValueSafe(L"encoding"));
+				if (base64Indices && buffer)
+				{
+					// raw data needs the index size it was written with
+					const core::stringc type32Name = "32bit";
+					buffer->getIndexBuffer()->setType((type32Name == reader->getAttributeValueSafe(L"indexType")) ?
+						video::EIT_32BIT : video::EIT_16BIT);
+				}
 			}
 
 		} // end if node type is element
@@ -226,14 +239,30 @@ IMeshBuffer* CIrrMeshFileLoader::readMeshBuffer(io::IXMLReader* reader)
 			// read vertex data
 			if (insideVertexSection)
 			{
-				readMeshBuffer(reader, vertexCount, buffer);
+				if (base64Vertices && buffer)
+				{
+					// decode straight into the vertex buffer, all members of the vertex types are 4 byte values
+					IVertexBuffer* vertices = buffer->getVertexBuffer();
+					vertices->set_used(vertexCount);
+					const u32 count = vertexCount * vertices->getVertexSize() / 4;
+					vertices->set_used(decodeBase64(reader->getNodeData(), vertices->getVertices(), count, 4) * 4 / vertices->getVertexSize());
+				}
+				else
+					readMeshBuffer(reader, vertexCount, buffer);
 				insideVertexSection = false;
 
 			} // end reading vertex array
 			else
 			if (insideIndexSection)
 			{
-				readIndices(reader, indexCount, buffer->getIndexBuffer());
+				if (base64Indices)
+				{
+					IIndexBuffer* indices = buffer->getIndexBuffer();
+					indices->set_used(indexCount);
+					indices->set_used(decodeBase64(reader->getNodeData(), indices->getIndices(), indexCount, indices->getIndexSize()));
+				}
+				else
+					readIndices(reader, indexCount, buffer->getIndexBuffer());
 				insideIndexSection = false;
 			}
 
@@ -272,6 +301,53 @@ void CIrrMeshFileLoader::readIndices(io::IXMLReader* reader, int indexCount, IIn
 }
 
 
+u32 CIrrMeshFileLoader::decodeBase64(const wchar_t* text, void* out, u32 count, u32 elementSize)
+{
+	// 0xff marks characters which are not part of the encoding, like whitespace
+	static u8 table[128];
+	static bool tableInitialized = false;
+	if (!tableInitialized)
+	{
+		const c8* alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+		memset(table, 0xff, sizeof(table));
+		for (u32 i=0; i<64; ++i)
+			table[(u32)alphabet[i]] = (u8)i;
+		tableInitialized = true;
+	}
+
+	const u32 size = count * elementSize;
+	u8* dst = (u8*)out;
+	u32 written = 0;
+	u32 bits = 0;
+	s32 bitCount = 0;
+
+	for (const wchar_t* p = text; *p && *p != L'=' && written < size; ++p)
+	{
+		if ((u32)*p >= 128 || table[*p] == 0xff)
+			continue;
+
+		bits = (bits << 6) | table[*p];
+		bitCount += 6;
+		if (bitCount >= 8)
+		{
+			bitCount -= 8;
+			dst[written++] = (u8)(bits >> bitCount);
+		}
+	}
+
+#ifdef __BIG_ENDIAN__
+	// data is stored in little endian byte order
+	for (u32 i=0; i+elementSize<=written; i+=elementSize)
+	{
+		for (u32 j=0; j<elementSize/2; ++j)
+			core::swap(dst[i+j], dst[i+elementSize-1-j]);
+	}
+#endif
+
+	return written / elementSize;
+}
+
+
 void CIrrMeshFileLoader::readMeshBuffer(io::IXMLReader* reader, int vertexCount, IMeshBuffer* sbuffer)
 {
 	core::stringc data = reader->getNodeData();
@@ -74,6 +74,10 @@ private:
 	//! read indices
 	void readIndices(io::IXMLReader* reader, int indexCount, IIndexBuffer* indices);
 
+	//! decodes base64 text directly into count elements of elementSize bytes
+	//! \return Number of elements decoded
+	u32 decodeBase64(const wchar_t* text, void* out, u32 count, u32 elementSize);
+
 
 	// member variables
 
@@ -21,7 +21,7 @@ namespace scene
 
 CIrrMeshWriter::CIrrMeshWriter(video::IVideoDriver* driver,
 				io::IFileSystem* fs)
-	: FileSystem(fs), VideoDriver(driver), Writer(0)
+	: FileSystem(fs), VideoDriver(driver), Writer(0), WriteBinary(false)
 {
 	#ifdef _DEBUG
 	setDebugName("CIrrMeshWriter");
@@ -76,13 +76,16 @@ bool CIrrMeshWriter::writeMesh(io::IWriteFile* file, scene::IMesh* mesh, s32 fla
 
 	os::Printer::log("Writing mesh", file->getFileName());
 
+	WriteBinary = (flags & EMWF_WRITE_BINARY) != 0;
+
 	// write IRR MESH header
 
 	Writer->writeXMLHeader();
 
+	// version 1.1 files may contain base64 encoded sections
 	Writer->writeElement(L"mesh", false,
 		L"xmlns", L"http://irrlicht.sourceforge.net/IRRMESH_09_2007",
-		L"version", L"1.0");
+		L"version", WriteBinary ? L"1.1" : L"1.0");
 	Writer->writeLineBreak();
 
 	// add some informational comment. Add a space after and before the comment
@@ -184,14 +187,21 @@ void CIrrMeshWriter::writeMeshBuffer(const scene::IMeshBuffer* buffer)
 		break;
 	}
 
+	u32 vertexCount = buffer->getVertexBuffer()->getVertexCount();
+
 	Writer->writeElement(L"vertices", false,
 		L"type", vertexTypeStr.c_str(),
-		L"vertexCount", core::stringw(buffer->getVertexBuffer()->getVertexCount()).c_str());
+		L"vertexCount", core::stringw(vertexCount).c_str(),
+		WriteBinary ? L"encoding" : 0, WriteBinary ? L"base64" : 0);
 
 	Writer->writeLineBreak();
 
-	u32 vertexCount = buffer->getVertexBuffer()->getVertexCount();
-
+	if (WriteBinary)
+	{
+		// all members of the built-in vertex types are 4 byte values
+		writeBase64(buffer->getVertexBuffer()->getVertices(), vertexCount * buffer->getVertexBuffer()->getVertexSize() / 4, 4);
+	}
+	else
 	switch(buffer->getVertexBuffer()->getVertexSize())
 	{
 	case sizeof(video::S3DVertex):
@@ -267,41 +277,54 @@ void CIrrMeshWriter::writeMeshBuffer(const scene::IMeshBuffer* buffer)
 
 	// write indices
 
-	Writer->writeElement(L"indices", false,
-		L"indexCount", core::stringw(buffer->getIndexBuffer()->getIndexCount()).c_str());
-
-	Writer->writeLineBreak();
-
 	int indexCount = (int)buffer->getIndexBuffer()->getIndexCount();
 
 	video::E_INDEX_TYPE iType = buffer->getIndexBuffer()->getType();
 
-	const u16* idx16 = (u16*) buffer->getIndexBuffer()->getIndices();
-	const u32* idx32 = (u32*) buffer->getIndexBuffer()->getIndices();
-	const int maxIndicesPerLine = 25;
+	if (WriteBinary)
+	{
+		Writer->writeElement(L"indices", false,
+			L"indexCount", core::stringw(indexCount).c_str(),
+			L"indexType", (iType == video::EIT_32BIT) ? L"32bit" : L"16bit",
+			L"encoding", L"base64");
+		Writer->writeLineBreak();
 
-	for (int i=0; i<indexCount; ++i)
+		writeBase64(buffer->getIndexBuffer()->getIndices(), indexCount, buffer->getIndexBuffer()->getIndexSize());
+	}
+	else
 	{
-		if(iType == video::EIT_16BIT)
-		{
-			core::stringw str((int)idx16[i]);
-			Writer->writeText(str.c_str());
-		}
-		else
+		Writer->writeElement(L"indices", false,
+			L"indexCount", core::stringw(indexCount).c_str());
+
+		Writer->writeLineBreak();
+
+		const u16* idx16 = (u16*) buffer->getIndexBuffer()->getIndices();
+		const u32* idx32 = (u32*) buffer->getIndexBuffer()->getIndices();
+		const int maxIndicesPerLine = 25;
+
+		for (int i=0; i<indexCount; ++i)
 		{
-			core::stringw str((int)idx32[i]);
-			Writer->writeText(str.c_str());
+			if(iType == video::EIT_16BIT)
+			{
+				core::stringw str((int)idx16[i]);
+				Writer->writeText(str.c_str());
+			}
+			else
+			{
+				core::stringw str((int)idx32[i]);
+				Writer->writeText(str.c_str());
+			}
+
+			if (i % maxIndicesPerLine == maxIndicesPerLine-1)
+				Writer->writeLineBreak();
+			else
+				Writer->writeText(L" ");
 		}
 
-		if (i % maxIndicesPerLine == maxIndicesPerLine-1)
+		if ((indexCount-1) % maxIndicesPerLine != maxIndicesPerLine-1)
 			Writer->writeLineBreak();
-		else
-			Writer->writeText(L" ");
 	}
 
-	if ((indexCount-1) % maxIndicesPerLine != maxIndicesPerLine-1)
-		Writer->writeLineBreak();
-
 	Writer->writeClosingTag(L"indices");
 	Writer->writeLineBreak();
 
@@ -311,6 +334,46 @@ void CIrrMeshWriter::writeMeshBuffer(const scene::IMeshBuffer* buffer)
 }
 
 
+void CIrrMeshWriter::writeBase64(const void* data, u32 count, u32 elementSize)
+{
+	static const wchar_t alphabet[] = L"ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+	// data is always written in little endian byte order
+	const u32 size = count * elementSize;
+	const u8* in = (const u8*)data;
+	wchar_t line[80];
+	u32 pos = 0;
+
+	for (u32 i=0; i<size; i+=3)
+	{
+		u8 b[3] = { 0, 0, 0 };
+		const u32 n = core::min_(3u, size-i);
+		for (u32 j=0; j<n; ++j)
+		{
+#ifdef __BIG_ENDIAN__
+			const u32 k = i+j;
+			b[j] = in[k - (k % elementSize) + (elementSize-1 - (k % elementSize))];
+#else
+			b[j] = in[i+j];
+#endif
+		}
+
+		line[pos++] = alphabet[b[0] >> 2];
+		line[pos++] = alphabet[((b[0] & 0x03) << 4) | (b[1] >> 4)];
+		line[pos++] = (n > 1) ? alphabet[((b[1] & 0x0f) << 2) | (b[2] >> 6)] : L'=';
+		line[pos++] = (n > 2) ? alphabet[b[2] & 0x3f] : L'=';
+
+		if (pos == 76 || i+3 >= size)
+		{
+			line[pos] = 0;
+			Writer->writeText(line);
+			Writer->writeLineBreak();
+			pos = 0;
+		}
+	}
+}
+
+
 void CIrrMeshWriter::writeMaterial(const video::SMaterial& material)
 {
 	// simply use irrlichts built-in attribute serialization capabilities here:
@@ -35,6 +35,8 @@ namespace scene
 		virtual EMESH_WRITER_TYPE getType() const _IRR_OVERRIDE_;
 
 		//! writes a mesh
+		/** With EMWF_WRITE_BINARY, vertex and index sections are written as
+		base64 encoded raw buffer data instead of text numbers. */
 		virtual bool writeMesh(io::IWriteFile* file, scene::IMesh* mesh, s32 flags=EMWF_NONE) _IRR_OVERRIDE_;
 
 	protected:
@@ -45,6 +47,9 @@ namespace scene
 
 		void writeMaterial(const video::SMaterial& material);
 
+		//! writes an array of elements as base64 text, in lines of 76 characters
+		void writeBase64(const void* data, u32 count, u32 elementSize);
+
 		core::stringw getVectorAsStringLine(const core::vector3df& v) const;
 
 		core::stringw getVectorAsStringLine(const core::vector2df& v) const;
@@ -54,6 +59,7 @@ namespace scene
 		io::IFileSystem* FileSystem;
 		video::IVideoDriver* VideoDriver;
 		io::IXMLWriter* Writer;
+		bool WriteBinary;
 	};
 
 } // end namespace
@@ -14,6 +14,12 @@ namespace scene
 static const io::SNamedPath emptyNamedPath;
 
 
+CMeshCache::CMeshCache()
+	: BinaryCacheEnabled(false)
+{
+}
+
+
 CMeshCache::~CMeshCache()
 {
 	clear();
@@ -173,6 +179,20 @@ void CMeshCache::clearUnusedMeshes()
 }
 
 
+//! Enables the binary mesh cache on disk.
+void CMeshCache::setBinaryCacheEnabled(bool enable)
+{
+	BinaryCacheEnabled = enable;
+}
+
+
+//! Check if the binary mesh cache on disk is enabled.
+bool CMeshCache::isBinaryCacheEnabled() const
+{
+	return BinaryCacheEnabled;
+}
+
+
 } // end namespace scene
 } // end namespace irr
 
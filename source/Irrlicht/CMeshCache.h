@@ -17,6 +17,8 @@ namespace scene
 	{
 	public:
 
+		CMeshCache();
+
 		virtual ~CMeshCache();
 
 		//! Adds a mesh to the internal list of loaded meshes.
@@ -94,6 +96,12 @@ namespace scene
 		//! Clears all meshes that are held in the mesh cache but not used anywhere else.
 		virtual void clearUnusedMeshes() _IRR_OVERRIDE_;
 
+		//! Enables the binary mesh cache on disk.
+		virtual void setBinaryCacheEnabled(bool enable) _IRR_OVERRIDE_;
+
+		//! Check if the binary mesh cache on disk is enabled.
+		virtual bool isBinaryCacheEnabled() const _IRR_OVERRIDE_;
+
 	protected:
 
 		struct MeshEntry
@@ -113,6 +121,8 @@ namespace scene
 
 		//! loaded meshes
 		core::array<MeshEntry> Meshes;
+
+		bool BinaryCacheEnabled;
 	};
 
 
@@ -7,7 +7,7 @@
 #include "CMeshBuffer.h"
 #include "SAnimatedMesh.h"
 #include "os.h"
-#include "irrMap.h"
+#include "irrHashMap.h"
 
 namespace irr
 {
@@ -175,18 +175,46 @@ void CMeshManipulator::transform(IMeshBuffer* meshBuffer, const core::matrix4& m
 	u8* offset = static_cast<u8*>(vb->getVertices());
 	offset += attribute->getOffset();
 
-	for (u32 i = 0; i < vb->getVertexCount(); ++i)
-	{
-		core::vector3df* position = (core::vector3df*)offset;
+	core::vector3df* positions = (core::vector3df*)offset;
+	matrix.transformVects(positions, positions, vb->getVertexCount(), vb->getVertexSize(), vb->getVertexSize());
 
-		matrix.transformVect(*position);
+	// normals keep perpendicular to the surface under non uniform scaling
+	core::matrix4 normalMatrix;
+	if (matrix.getInverse(normalMatrix))
+		normalMatrix = normalMatrix.getTransposed();
 
-		offset += vb->getVertexSize();
-	}
+	transformDirections(meshBuffer, video::EVAS_NORMAL, normalMatrix);
+	transformDirections(meshBuffer, video::EVAS_TANGENT, matrix);
+	transformDirections(meshBuffer, video::EVAS_BINORMAL, matrix);
 
 	meshBuffer->recalculateBoundingBox();
 }
 
+
+//! Rotates and normalizes the directions of an attribute
+void CMeshManipulator::transformDirections(IMeshBuffer* meshBuffer, video::E_VERTEX_ATTRIBUTE_SEMANTIC semantic,
+	const core::matrix4& matrix) const
+{
+	video::IVertexAttribute* attribute = meshBuffer->getVertexDescriptor()->getAttributeBySemantic(semantic);
+
+	if (!attribute || attribute->getType() != video::EVAT_FLOAT || attribute->getElementCount() != 3)
+		return;
+
+	IVertexBuffer* vb = meshBuffer->getVertexBuffer(attribute->getBufferID());
+
+	u8* offset = static_cast<u8*>(vb->getVertices());
+	offset += attribute->getOffset();
+
+	matrix.rotateVects((core::vector3df*)offset, (core::vector3df*)offset, vb->getVertexCount(),
+		vb->getVertexSize(), vb->getVertexSize());
+
+	for (u32 i = 0; i < vb->getVertexCount(); ++i)
+	{
+		((core::vector3df*)offset)->normalize();
+		offset += vb->getVertexSize();
+	}
+}
+
 static inline core::vector3df getAngleWeight(const core::vector3df& v1,
 		const core::vector3df& v2,
 		const core::vector3df& v3)
@@ -1488,8 +1516,8 @@ IMesh* CMeshManipulator::createForsythOptimizedMesh(const IMesh* mesh) const
 				buf->getVertexBuffer(0)->reallocate(vcount);
 				buf->getIndexBuffer()->reallocate(icount);
 
-				core::map<const video::S3DVertex, const u16> sind; // search index for fast operation
-				typedef core::map<const video::S3DVertex, const u16>::Node snode;
+				core::hash_map<video::S3DVertex, u16> sind; // search index for fast operation
+				typedef core::hash_map<video::S3DVertex, u16>::Node snode;
 
 				// Main algorithm
 				u32 highest = 0;
@@ -1600,8 +1628,8 @@ IMesh* CMeshManipulator::createForsythOptimizedMesh(const IMesh* mesh) const
 				buf->getVertexBuffer(0)->reallocate(vcount);
 				buf->getIndexBuffer()->reallocate(icount);
 
-				core::map<const video::S3DVertex2TCoords, const u16> sind; // search index for fast operation
-				typedef core::map<const video::S3DVertex2TCoords, const u16>::Node snode;
+				core::hash_map<video::S3DVertex2TCoords, u16> sind; // search index for fast operation
+				typedef core::hash_map<video::S3DVertex2TCoords, u16>::Node snode;
 
 				// Main algorithm
 				u32 highest = 0;
@@ -1713,8 +1741,8 @@ IMesh* CMeshManipulator::createForsythOptimizedMesh(const IMesh* mesh) const
 				buf->getVertexBuffer(0)->reallocate(vcount);
 				buf->getIndexBuffer()->reallocate(icount);
 
-				core::map<const video::S3DVertexTangents, const u16> sind; // search index for fast operation
-				typedef core::map<const video::S3DVertexTangents, const u16>::Node snode;
+				core::hash_map<video::S3DVertexTangents, u16> sind; // search index for fast operation
+				typedef core::hash_map<video::S3DVertexTangents, u16>::Node snode;
 
 				// Main algorithm
 				u32 highest = 0;
@@ -58,6 +58,9 @@ public:
 
 protected:
 	virtual void setVertexColor(IMeshBuffer* meshBuffer, video::SColor color, bool onlyAlpha) const;
+
+	//! rotates and normalizes the directions of an attribute
+	void transformDirections(IMeshBuffer* meshBuffer, video::E_VERTEX_ATTRIBUTE_SEMANTIC semantic, const core::matrix4& matrix) const;
 };
 
 } // end namespace scene
@@ -12,6 +12,8 @@
 #include "IMaterialRenderer.h"
 #include "IFileSystem.h"
 #include "CShadowVolumeSceneNode.h"
+#include "IProfiler.h"
+#include "EProfileIDs.h"
 
 namespace irr
 {
@@ -154,6 +156,8 @@ void CMeshSceneNode::render()
 	// render original meshes
 	if (renderMeshes)
 	{
+		const bool cullBuffers = (AutomaticCullingState & EAC_MESH_BUFFERS) != 0;
+
 		for (u32 i=0; i<Mesh->getMeshBufferCount(); ++i)
 		{
 			scene::IMeshBuffer* mb = Mesh->getMeshBuffer(i);
@@ -168,6 +172,16 @@ void CMeshSceneNode::render()
 				// and solid only in solid pass
 				if (transparent == isTransparentPass)
 				{
+					if (cullBuffers)
+					{
+						if (SceneManager->isCulled(mb->getBoundingBox(), EAC_FRUSTUM_BOX, AbsoluteTransformation))
+						{
+							IRR_PROFILE(getProfiler().start(EPID_SM_BUFFERS_CULLED); getProfiler().stop(EPID_SM_BUFFERS_CULLED);)
+							continue;
+						}
+						IRR_PROFILE(getProfiler().start(EPID_SM_BUFFERS_VISIBLE); getProfiler().stop(EPID_SM_BUFFERS_VISIBLE);)
+					}
+
 					driver->setMaterial(material);
 					driver->drawMeshBuffer(mb);
 				}
@@ -34,12 +34,23 @@ namespace
 
 
 //! Constructor
-CArchiveLoaderNPK::CArchiveLoaderNPK( io::IFileSystem* fs)
-: FileSystem(fs)
+CArchiveLoaderNPK::CArchiveLoaderNPK(io::IFileSystem* fs, CArchiveEntryCache* cache)
+: FileSystem(fs), EntryCache(cache)
 {
 #ifdef _DEBUG
 	setDebugName("CArchiveLoaderNPK");
 #endif
+
+	if (EntryCache)
+		EntryCache->grab();
+}
+
+
+//! Destructor
+CArchiveLoaderNPK::~CArchiveLoaderNPK()
+{
+	if (EntryCache)
+		EntryCache->drop();
 }
 
 
@@ -80,7 +91,7 @@ IFileArchive* CArchiveLoaderNPK::createArchive(io::IReadFile* file, bool ignoreC
 	if ( file )
 	{
 		file->seek ( 0 );
-		archive = new CNPKReader(file, ignoreCase, ignorePaths);
+		archive = new CNPKReader(file, ignoreCase, ignorePaths, EntryCache);
 	}
 	return archive;
 }
@@ -103,13 +114,20 @@ bool CArchiveLoaderNPK::isALoadableFileFormat(io::IReadFile* file) const
 /*!
 	NPK Reader
 */
-CNPKReader::CNPKReader(IReadFile* file, bool ignoreCase, bool ignorePaths)
-: CFileList((file ? file->getFileName() : io::path("")), ignoreCase, ignorePaths), File(file)
+CNPKReader::CNPKReader(IReadFile* file, bool ignoreCase, bool ignorePaths, CArchiveEntryCache* cache)
+: CFileList((file ? file->getFileName() : io::path("")), ignoreCase, ignorePaths), File(file),
+	EntryCache(cache), CacheID(0)
 {
 #ifdef _DEBUG
 	setDebugName("CNPKReader");
 #endif
 
+	if (EntryCache)
+	{
+		EntryCache->grab();
+		CacheID = EntryCache->addArchive();
+	}
+
 	if (File)
 	{
 		File->grab();
@@ -123,6 +141,12 @@ CNPKReader::CNPKReader(IReadFile* file, bool ignoreCase, bool ignorePaths)
 
 CNPKReader::~CNPKReader()
 {
+	if (EntryCache)
+	{
+		EntryCache->removeArchive(CacheID);
+		EntryCache->drop();
+	}
+
 	if (File)
 		File->drop();
 }
@@ -247,7 +271,13 @@ IReadFile* CNPKReader::createAndOpenFile(u32 index)
 		return 0;
 
 	const SFileListEntry &entry = Files[index];
-	return createLimitReadFile( entry.FullName, File, entry.Offset, entry.Size );
+	if (!EntryCache)
+		return createLimitReadFile( entry.FullName, File, entry.Offset, entry.Size );
+
+	IReadFile* file = EntryCache->createAndOpenFile(CacheID, index, entry.FullName);
+	if (!file)
+		file = EntryCache->add(CacheID, index, createLimitReadFile( entry.FullName, File, entry.Offset, entry.Size ));
+	return file;
 }
 
 void CNPKReader::readString(core::stringc& name)
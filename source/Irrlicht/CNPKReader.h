@@ -15,6 +15,7 @@
 #include "irrArray.h"
 #include "irrString.h"
 #include "IFileSystem.h"
+#include "CArchiveEntryCache.h"
 #include "CFileList.h"
 
 namespace irr
@@ -47,7 +48,10 @@ namespace io
 	public:
 
 		//! Constructor
-		CArchiveLoaderNPK(io::IFileSystem* fs);
+		CArchiveLoaderNPK(io::IFileSystem* fs, CArchiveEntryCache* cache=0);
+
+		//! Destructor
+		virtual ~CArchiveLoaderNPK();
 
 		//! returns true if the file maybe is able to be loaded by this class
 		//! based on the file extension (e.g. ".zip")
@@ -76,6 +80,7 @@ namespace io
 
 	private:
 		io::IFileSystem* FileSystem;
+		CArchiveEntryCache* EntryCache;
 	};
 
 
@@ -84,7 +89,7 @@ namespace io
 	{
 	public:
 
-		CNPKReader(IReadFile* file, bool ignoreCase, bool ignorePaths);
+		CNPKReader(IReadFile* file, bool ignoreCase, bool ignorePaths, CArchiveEntryCache* cache=0);
 		virtual ~CNPKReader();
 
 		// file archive methods
@@ -114,6 +119,9 @@ namespace io
 		void readString(core::stringc& name);
 
 		IReadFile* File;
+
+		CArchiveEntryCache* EntryCache;
+		u32 CacheID;
 	};
 
 } // end namespace io
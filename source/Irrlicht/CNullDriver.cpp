@@ -16,6 +16,7 @@
 #include "CColorConverter.h"
 #include "IAttributeExchangingObject.h"
 #include "CVertexDescriptor.h"
+#include "CCommandList.h"
 
 
 namespace irr
@@ -84,7 +85,7 @@ IImageWriter* createImageWriterPPM();
 //! constructor
 CNullDriver::CNullDriver(io::IFileSystem* io, const core::dimension2d<u32>& screenSize)
 : FileSystem(io), MeshManipulator(0), ViewPort(0,0,0,0), ScreenSize(screenSize),
-	PrimitivesDrawn(0), MinVertexCountForVBO(500), TextureCreationFlags(0),
+	PrimitivesDrawn(0), DrawCalls(0), DrawCallsLastFrame(0), MinVertexCountForVBO(500), TextureCreationFlags(0),
 	OverrideMaterial2DEnabled(false), AllowZWriteOnTransparent(false)
 {
 	#ifdef _DEBUG
@@ -342,6 +343,7 @@ bool CNullDriver::beginScene(bool backBuffer, bool zBuffer, SColor color,
 {
 	core::clearFPUException();
 	PrimitivesDrawn = 0;
+	DrawCalls = 0;
 	return true;
 }
 
@@ -350,11 +352,18 @@ bool CNullDriver::beginScene(bool backBuffer, bool zBuffer, SColor color,
 bool CNullDriver::endScene()
 {
 	FPSCounter.registerFrame(os::Timer::getRealTime(), PrimitivesDrawn);
+	DrawCallsLastFrame = DrawCalls;
 	updateAllOcclusionQueries();
 	return true;
 }
 
 
+//! sets the part of the screen which changed in the current frame
+void CNullDriver::setPresentArea(const core::rect<s32>& area)
+{
+}
+
+
 //! Disable a feature of the driver.
 void CNullDriver::disableFeature(E_VIDEO_DRIVER_FEATURE feature, bool flag)
 {
@@ -379,13 +388,15 @@ const io::IAttributes& CNullDriver::getDriverAttributes() const
 //! sets transformation
 void CNullDriver::setTransform(E_TRANSFORMATION_STATE state, const core::matrix4& mat)
 {
+	// kept, so that drawing without a device can be checked
+	TransformationMatrix[state] = mat;
 }
 
 
 //! Returns the transformation set by setTransform
 const core::matrix4& CNullDriver::getTransform(E_TRANSFORMATION_STATE state) const
 {
-	return TransformationMatrix;
+	return TransformationMatrix[state];
 }
 
 
@@ -697,6 +708,7 @@ void CNullDriver::draw2DVertexPrimitiveList(const void* vertices, u32 vertexCoun
 	if ((iType==EIT_16BIT) && (vertexCount>65536))
 		os::Printer::log("Too many vertices for 16bit index type, render artifacts may occur.");
 	PrimitivesDrawn += primitiveCount;
+	++DrawCalls;
 }
 
 
@@ -1028,6 +1040,13 @@ u32 CNullDriver::getPrimitiveCountDrawn( u32 param ) const
 }
 
 
+//! returns amount of draw calls in the last frame
+u32 CNullDriver::getDrawCallCount() const
+{
+	return DrawCallsLastFrame;
+}
+
+
 
 //! Sets the dynamic ambient light color. The default color is
 //! (0,0,0,0) which means it is dark.
@@ -1651,6 +1670,7 @@ void CNullDriver::drawMeshBuffer(const scene::IMeshBuffer* mb)
 		os::Printer::log("Too many vertices for 16bit index type, render artifacts may occur.");
 
 	PrimitivesDrawn += mb->getPrimitiveCount();
+	++DrawCalls;
 
 
 	/*
@@ -1761,6 +1781,21 @@ void CNullDriver::drawMeshBufferNormals(const scene::IMeshBuffer* mb, f32 length
 }
 
 
+//! Creates an empty command list
+ICommandList* CNullDriver::createCommandList()
+{
+	return new CCommandList();
+}
+
+
+//! Draws the commands of a command list
+void CNullDriver::submit(const ICommandList* list)
+{
+	if (list)
+		list->replay(this);
+}
+
+
 IVertexDescriptor* CNullDriver::addVertexDescriptor(const core::stringc& pName)
 {
 	for (u32 i = 0; i < VertexDescriptor.size(); ++i)
@@ -2564,6 +2599,9 @@ IVideoDriver* createNullDriver(io::IFileSystem* io, const core::dimension2d<u32>
 {
 	CNullDriver* nullDriver = new CNullDriver(io, screenSize);
 
+	// mesh loaders need the default vertex descriptors also without hardware
+	nullDriver->createVertexDescriptors();
+
 	// create empty material renderers
 	for(u32 i=0; sBuiltInMaterialTypeNames[i]; ++i)
 	{
@@ -55,6 +55,9 @@ namespace video
 
 		virtual bool endScene() _IRR_OVERRIDE_;
 
+		//! sets the part of the screen which changed in the current frame
+		virtual void setPresentArea(const core::rect<s32>& area) _IRR_OVERRIDE_;
+
 		virtual bool createVertexDescriptors();
 
 		//! Disable a feature of the driver.
@@ -248,6 +251,9 @@ namespace video
 		//! very useful method for statistics.
 		virtual u32 getPrimitiveCountDrawn( u32 param = 0 ) const _IRR_OVERRIDE_;
 
+		//! returns amount of draw calls in the last frame
+		virtual u32 getDrawCallCount() const _IRR_OVERRIDE_;
+
 		//! deletes all dynamic lights there are
 		virtual void deleteAllDynamicLights() _IRR_OVERRIDE_;
 
@@ -376,6 +382,12 @@ namespace video
 		virtual void drawMeshBufferNormals(const scene::IMeshBuffer* mb, f32 length=10.f,
 			SColor color=0xffffffff) _IRR_OVERRIDE_;
 
+		//! Creates an empty command list
+		virtual ICommandList* createCommandList() _IRR_OVERRIDE_;
+
+		//! Draws the commands of a command list
+		virtual void submit(const ICommandList* list) _IRR_OVERRIDE_;
+
 		virtual IVertexDescriptor* addVertexDescriptor(const core::stringc& pName) _IRR_OVERRIDE_;
 
 		virtual IVertexDescriptor* getVertexDescriptor(u32 id) const;
@@ -768,11 +780,13 @@ namespace video
 
 		core::rect<s32> ViewPort;
 		core::dimension2d<u32> ScreenSize;
-		core::matrix4 TransformationMatrix;
+		core::matrix4 TransformationMatrix[ETS_COUNT];
 
 		CFPSCounter FPSCounter;
 
 		u32 PrimitivesDrawn;
+		u32 DrawCalls;
+		u32 DrawCallsLastFrame;
 		u32 MinVertexCountForVBO;
 
 		u32 TextureCreationFlags;
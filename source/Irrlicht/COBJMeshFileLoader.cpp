@@ -89,11 +89,16 @@ IAnimatedMesh* COBJMeshFileLoader::createMesh(io::IReadFile* file)
 	const io::path fullName = file->getFileName();
 	const io::path relPath = FileSystem->getFileDir(fullName)+"/";
 
-	c8* buf = new c8[filesize];
-	memset(buf, 0, filesize);
+	// terminating 0 allows to parse numbers in place
+	c8* buf = new c8[filesize+1];
 	file->read((void*)buf, filesize);
+	buf[filesize] = 0;
 	const c8* const bufEnd = buf+filesize;
 
+	// corners of the current face, reused for all faces
+	core::array<s32> faceCorners;
+	faceCorners.reallocate(32); // should be large enough
+
 	// Process obj information
 	const c8* bufPtr = buf;
 	core::stringc grpName, mtlName;
@@ -194,7 +199,6 @@ IAnimatedMesh* COBJMeshFileLoader::createMesh(io::IReadFile* file)
 
 		case 'f':               // face
 		{
-			c8 vertexWord[WORD_BUFFER_LENGTH]; // for retrieving vertex data
 			video::S3DVertex v;
 			// Assign vertex color from currently active material's diffuse color
 			if (mtlChanged)
@@ -209,77 +213,74 @@ IAnimatedMesh* COBJMeshFileLoader::createMesh(io::IReadFile* file)
 			if (currMtl)
 				v.Color = currMtl->Meshbuffer->getMaterial().DiffuseColor;
 
-			// get all vertices data in this face (current line of obj file)
-			const core::stringc wordBuffer = copyLine(bufPtr, bufEnd);
-			const c8* linePtr = wordBuffer.c_str();
-			const c8* const endPtr = linePtr+wordBuffer.size();
-
-			core::array<int> faceCorners;
-			faceCorners.reallocate(32); // should be large enough
+			IVertexBuffer* vb = currMtl->Meshbuffer->getVertexBuffer();
+			faceCorners.set_used(0); // fast clear
 
-			// read in all vertices
-			linePtr = goNextWord(linePtr, endPtr);
-			while (0 != linePtr[0])
+			// read in all vertices of this face directly from the file buffer
+			const c8* linePtr = goNextWord(bufPtr, bufEnd, false);
+			while (linePtr != bufEnd && *linePtr != '\n' && *linePtr != '\r')
 			{
-				// Array to communicate with retrieveVertexIndices()
+				// Array to communicate with readFaceIndices()
 				// sends the buffer sizes and gets the actual indices
 				// if index not set returns -1
 				s32 Idx[3];
-				Idx[0] = Idx[1] = Idx[2] = -1;
 
-				// read in next vertex's data
-				u32 wlength = copyWord(vertexWord, linePtr, WORD_BUFFER_LENGTH, endPtr);
 				// this function will also convert obj's 1-based index to c++'s 0-based index
-				retrieveVertexIndices(vertexWord, Idx, vertexWord+wlength+1, vertexBuffer.size(), textureCoordBuffer.size(), normalsBuffer.size());
-				if ( -1 != Idx[0] && Idx[0] < (irr::s32)vertexBuffer.size() )
-					v.Pos = vertexBuffer[Idx[0]];
-				else
+				linePtr = readFaceIndices(linePtr, Idx, bufEnd, vertexBuffer.size(), textureCoordBuffer.size(), normalsBuffer.size());
+				if ( Idx[0] < 0 || Idx[0] >= (irr::s32)vertexBuffer.size() )
 				{
-					os::Printer::log("Invalid vertex index in this line:", wordBuffer.c_str(), ELL_ERROR);
+					os::Printer::log("Invalid vertex index in this line:", copyLine(bufPtr, bufEnd).c_str(), ELL_ERROR);
 					delete [] buf;
 					return 0;
 				}
-				if ( -1 != Idx[1] && Idx[1] < (irr::s32)textureCoordBuffer.size() )
-					v.TCoords = textureCoordBuffer[Idx[1]];
-				else
-					v.TCoords.set(0.0f,0.0f);
-				if ( -1 != Idx[2] && Idx[2] < (irr::s32)normalsBuffer.size() )
-					v.Normal = normalsBuffer[Idx[2]];
-				else
-				{
-					v.Normal.set(0.0f,0.0f,0.0f);
-					currMtl->RecalculateNormals=true;
-				}
-
-				int vertLocation;
-				core::map<video::S3DVertex, int>::Node* n = currMtl->VertMap.find(v);
+				// missing or invalid indices are handled like not given ones
+				if ( Idx[1] < 0 || Idx[1] >= (irr::s32)textureCoordBuffer.size() )
+					Idx[1] = -1;
+				if ( Idx[2] < 0 || Idx[2] >= (irr::s32)normalsBuffer.size() )
+					Idx[2] = -1;
+
+				const core::vector3di key(Idx[0], Idx[1], Idx[2]);
+				core::hash_map<core::vector3di, s32>::Node* n = currMtl->VertMap.find(key);
+				s32 vertLocation;
 				if (n)
 				{
 					vertLocation = n->getValue();
 				}
 				else
 				{
-					currMtl->Meshbuffer->getVertexBuffer()->addVertex((void*)&v);
-					vertLocation = currMtl->Meshbuffer->getVertexBuffer()->getVertexCount() -1;
-					currMtl->VertMap.insert(v, vertLocation);
+					v.Pos = vertexBuffer[Idx[0]];
+					if ( -1 != Idx[1] )
+						v.TCoords = textureCoordBuffer[Idx[1]];
+					else
+						v.TCoords.set(0.0f,0.0f);
+					if ( -1 != Idx[2] )
+						v.Normal = normalsBuffer[Idx[2]];
+					else
+					{
+						v.Normal.set(0.0f,0.0f,0.0f);
+						currMtl->RecalculateNormals=true;
+					}
+
+					vb->addVertex((void*)&v);
+					vertLocation = vb->getVertexCount() -1;
+					currMtl->VertMap.insert(key, vertLocation);
 				}
 
 				faceCorners.push_back(vertLocation);
 
 				// go to next vertex
-				linePtr = goNextWord(linePtr, endPtr);
+				linePtr = goFirstWord(linePtr, bufEnd, false);
 			}
 
 			// triangulate the face
-			for ( u32 i = 1; i < faceCorners.size() - 1; ++i )
+			IIndexBuffer* ib = currMtl->Meshbuffer->getIndexBuffer();
+			for ( u32 i = 1; i + 1 < faceCorners.size(); ++i )
 			{
 				// Add a triangle
-				currMtl->Meshbuffer->getIndexBuffer()->addIndex( faceCorners[i+1] );
-				currMtl->Meshbuffer->getIndexBuffer()->addIndex( faceCorners[i] );
-				currMtl->Meshbuffer->getIndexBuffer()->addIndex( faceCorners[0] );
+				ib->addIndex( faceCorners[i+1] );
+				ib->addIndex( faceCorners[i] );
+				ib->addIndex( faceCorners[0] );
 			}
-			faceCorners.set_used(0); // fast clear
-			faceCorners.reallocate(32);
 		}
 		break;
 
@@ -684,15 +685,14 @@ const c8* COBJMeshFileLoader::readColor(const c8* bufPtr, video::SColor& color,
 //! Read 3d vector of floats
 const c8* COBJMeshFileLoader::readVec3(const c8* bufPtr, core::vector3df& vec, const c8* const bufEnd)
 {
-	const u32 WORD_BUFFER_LENGTH = 256;
-	c8 wordBuffer[WORD_BUFFER_LENGTH];
-
-	bufPtr = goAndCopyNextWord(wordBuffer, bufPtr, WORD_BUFFER_LENGTH, bufEnd);
-	vec.X=-core::fast_atof(wordBuffer); // change handedness
-	bufPtr = goAndCopyNextWord(wordBuffer, bufPtr, WORD_BUFFER_LENGTH, bufEnd);
-	vec.Y=core::fast_atof(wordBuffer);
-	bufPtr = goAndCopyNextWord(wordBuffer, bufPtr, WORD_BUFFER_LENGTH, bufEnd);
-	vec.Z=core::fast_atof(wordBuffer);
+	// numbers are parsed in place, the file buffer is 0-terminated
+	bufPtr = goNextWord(bufPtr, bufEnd, false);
+	bufPtr = core::fast_atof_move(bufPtr, vec.X);
+	vec.X=-vec.X; // change handedness
+	bufPtr = goNextWord(bufPtr, bufEnd, false);
+	bufPtr = core::fast_atof_move(bufPtr, vec.Y);
+	bufPtr = goNextWord(bufPtr, bufEnd, false);
+	bufPtr = core::fast_atof_move(bufPtr, vec.Z);
 	return bufPtr;
 }
 
@@ -700,13 +700,12 @@ const c8* COBJMeshFileLoader::readVec3(const c8* bufPtr, core::vector3df& vec, c
 //! Read 2d vector of floats
 const c8* COBJMeshFileLoader::readUV(const c8* bufPtr, core::vector2df& vec, const c8* const bufEnd)
 {
-	const u32 WORD_BUFFER_LENGTH = 256;
-	c8 wordBuffer[WORD_BUFFER_LENGTH];
-
-	bufPtr = goAndCopyNextWord(wordBuffer, bufPtr, WORD_BUFFER_LENGTH, bufEnd);
-	vec.X=core::fast_atof(wordBuffer);
-	bufPtr = goAndCopyNextWord(wordBuffer, bufPtr, WORD_BUFFER_LENGTH, bufEnd);
-	vec.Y=1-core::fast_atof(wordBuffer); // change handedness
+	// numbers are parsed in place, the file buffer is 0-terminated
+	bufPtr = goNextWord(bufPtr, bufEnd, false);
+	bufPtr = core::fast_atof_move(bufPtr, vec.X);
+	bufPtr = goNextWord(bufPtr, bufEnd, false);
+	bufPtr = core::fast_atof_move(bufPtr, vec.Y);
+	vec.Y=1-vec.Y; // change handedness
 	return bufPtr;
 }
 
@@ -849,72 +848,31 @@ const c8* COBJMeshFileLoader::goAndCopyNextWord(c8* outBuf, const c8* inBuf, u32
 }
 
 
-bool COBJMeshFileLoader::retrieveVertexIndices(c8* vertexData, s32* idx, const c8* bufEnd, u32 vbsize, u32 vtsize, u32 vnsize)
+const c8* COBJMeshFileLoader::readFaceIndices(const c8* bufPtr, s32* idx, const c8* const bufEnd, u32 vbsize, u32 vtsize, u32 vnsize)
 {
-	c8 word[16] = "";
-	const c8* p = goFirstWord(vertexData, bufEnd);
-	u32 idxType = 0;	// 0 = posIdx, 1 = texcoordIdx, 2 = normalIdx
+	const u32 sizes[3] = { vbsize, vtsize, vnsize };
+	idx[0] = idx[1] = idx[2] = -1;
 
-	u32 i = 0;
-	while ( p != bufEnd )
+	// 0 = posIdx, 1 = texcoordIdx, 2 = normalIdx
+	for (u32 idxType=0; idxType<3 && bufPtr != bufEnd; ++idxType)
 	{
-		if ( ( core::isdigit(*p)) || (*p == '-') )
+		if (core::isdigit(*bufPtr) || *bufPtr == '-')
 		{
-			// build up the number
-			word[i++] = *p;
+			const s32 value = core::strtol10(bufPtr, &bufPtr);
+			// 0 is not a valid index and becomes -1
+			idx[idxType] = (value < 0) ? value + (s32)sizes[idxType] : value - 1;
 		}
-		else if ( *p == '/' || *p == ' ' || *p == '\0' )
-		{
-			// number is completed. Convert and store it
-			word[i] = '\0';
-			// if no number was found index will become 0 and later on -1 by decrement
-			idx[idxType] = core::strtol10(word);
-			if (idx[idxType]<0)
-			{
-				switch (idxType)
-				{
-					case 0:
-						idx[idxType] += vbsize;
-						break;
-					case 1:
-						idx[idxType] += vtsize;
-						break;
-					case 2:
-						idx[idxType] += vnsize;
-						break;
-				}
-			}
-			else
-				idx[idxType]-=1;
-
-			// reset the word
-			word[0] = '\0';
-			i = 0;
 
-			// go to the next kind of index type
-			if (*p == '/')
-			{
-				if ( ++idxType > 2 )
-				{
-					// error checking, shouldn't reach here unless file is wrong
-					idxType = 0;
-				}
-			}
-			else
-			{
-				// set all missing values to disable (=-1)
-				while (++idxType < 3)
-					idx[idxType]=-1;
-				++p;
-				break; // while
-			}
-		}
-
-		// go to the next char
-		++p;
+		if (bufPtr == bufEnd || *bufPtr != '/')
+			break;
+		++bufPtr;
 	}
 
-	return true;
+	// skip anything left of this corner
+	while (bufPtr != bufEnd && !core::isspace(*bufPtr))
+		++bufPtr;
+
+	return bufPtr;
 }
 
 
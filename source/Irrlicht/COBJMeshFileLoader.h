@@ -9,8 +9,8 @@
 #include "IFileSystem.h"
 #include "ISceneManager.h"
 #include "irrString.h"
+#include "irrHashMap.h"
 #include "CMeshBuffer.h"
-#include "irrMap.h"
 #include "IVideoDriver.h"
 
 namespace irr
@@ -62,7 +62,8 @@ private:
 			Meshbuffer->getMaterial() = o.Meshbuffer->getMaterial();
 		}
 
-		core::map<video::S3DVertex, int> VertMap;
+		//! maps obj index triples (position, texcoord, normal) to meshbuffer vertices
+		core::hash_map<core::vector3di, s32> VertMap;
 		scene::CMeshBuffer<video::S3DVertex> *Meshbuffer;
 		core::stringc Name;
 		core::stringc Group;
@@ -104,10 +105,11 @@ private:
 	//! Read boolean value represented as 'on' or 'off'
 	const c8* readBool(const c8* bufPtr, bool& tf, const c8* const bufEnd);
 
-	// reads and convert to integer the vertex indices in a line of obj file's face statement
+	// reads and convert to integer the vertex indices of one face corner directly from the file buffer
 	// -1 for the index if it doesn't exist
 	// indices are changed to 0-based index instead of 1-based from the obj file
-	bool retrieveVertexIndices(c8* vertexData, s32* idx, const c8* bufEnd, u32 vbsize, u32 vtsize, u32 vnsize);
+	// returns pointer to the first character after the corner
+	const c8* readFaceIndices(const c8* bufPtr, s32* idx, const c8* const bufEnd, u32 vbsize, u32 vtsize, u32 vnsize);
 
 	void cleanUp();
 
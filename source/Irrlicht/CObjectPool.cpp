@@ -0,0 +1,120 @@
+// Copyright (C) 2002-2012 Nikolaus Gebhardt
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#include "irrMemoryPool.h"
+#include "IProfiler.h"
+#include "EProfileIDs.h"
+
+namespace irr
+{
+namespace core
+{
+
+namespace
+{
+
+//! objects are rounded up to multiples of this size
+const u32 POOL_GRANULARITY = 16;
+
+//! number of pools per type, larger objects come from the heap
+const u32 POOL_SIZE_CLASSES = 64;
+
+//! pools of one type of objects, one for each size class
+struct SObjectPools
+{
+	SObjectPools()
+	{
+		for (u32 i=0; i<POOL_SIZE_CLASSES; ++i)
+			Pools[i] = 0;
+	}
+
+	~SObjectPools()
+	{
+		// objects which outlive the pools, e.g. in other static objects,
+		// still point into the chunks, so they are only freed when empty
+		if (Statistics.Allocations != Statistics.Deallocations)
+			return;
+
+		for (u32 i=0; i<POOL_SIZE_CLASSES; ++i)
+			delete Pools[i];
+	}
+
+	memoryPool* Pools[POOL_SIZE_CLASSES];
+	SObjectPoolStatistics Statistics;
+};
+
+SObjectPools& getPools(E_OBJECT_POOL type)
+{
+	static SObjectPools pools[EOP_COUNT];
+	return pools[type];
+}
+
+#ifdef _IRR_COMPILE_WITH_PROFILING_
+//! counts the allocation as one call of the profile id of the type
+void profileAllocation(E_OBJECT_POOL type)
+{
+	const s32 id = type == EOP_SCENE_NODE ? EPID_OP_ALLOC_NODE : EPID_OP_ALLOC_ANIMATOR;
+	getProfiler().start(id);
+	getProfiler().stop(id);
+}
+#endif
+
+} // end anonymous namespace
+
+
+IRRLICHT_API void* IRRCALLCONV allocateObject(size_t size, E_OBJECT_POOL type)
+{
+	SObjectPools& pools = getPools(type);
+	++pools.Statistics.Allocations;
+	IRR_PROFILE(profileAllocation(type);)
+
+#ifdef _IRR_USE_OBJECT_POOLS_
+	const u32 sizeClass = (u32)((size + POOL_GRANULARITY - 1) / POOL_GRANULARITY);
+	if (sizeClass && sizeClass <= POOL_SIZE_CLASSES)
+	{
+		memoryPool*& pool = pools.Pools[sizeClass-1];
+		if (!pool)
+			pool = new memoryPool(sizeClass * POOL_GRANULARITY);
+
+		const size_t reserved = pool->getReservedSize();
+		void* ptr = pool->allocate();
+		pools.Statistics.ReservedBytes += (u32)(pool->getReservedSize() - reserved);
+		return ptr;
+	}
+#endif
+
+	return new u8[size];
+}
+
+
+IRRLICHT_API void IRRCALLCONV deallocateObject(void* ptr, size_t size, E_OBJECT_POOL type)
+{
+	if (!ptr)
+		return;
+
+	SObjectPools& pools = getPools(type);
+	++pools.Statistics.Deallocations;
+
+#ifdef _IRR_USE_OBJECT_POOLS_
+	const u32 sizeClass = (u32)((size + POOL_GRANULARITY - 1) / POOL_GRANULARITY);
+	if (sizeClass && sizeClass <= POOL_SIZE_CLASSES)
+	{
+		pools.Pools[sizeClass-1]->deallocate(ptr);
+		return;
+	}
+#endif
+
+	delete [] (u8*)ptr;
+}
+
+
+IRRLICHT_API SObjectPoolStatistics IRRCALLCONV getObjectPoolStatistics(E_OBJECT_POOL type)
+{
+	return getPools(type).Statistics;
+}
+
+
+} // end namespace core
+} // end namespace irr
+
@@ -0,0 +1,377 @@
+// Copyright (C) 2002-2012 Nikolaus Gebhardt
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#include "IrrCompileConfig.h"
+#include "CPagedTerrainSceneNode.h"
+#include "CTerrainSceneNode.h"
+#include "ISceneManager.h"
+#include "ICameraSceneNode.h"
+#include "IFileSystem.h"
+#include "IReadFile.h"
+#include "os.h"
+
+namespace irr
+{
+namespace scene
+{
+
+//! constructor
+CPagedTerrainSceneNode::CPagedTerrainSceneNode(ISceneNode* parent, ISceneManager* mgr,
+		io::IFileSystem* fs, s32 id, const io::path& tileFileName, s32 tileSize,
+		const core::vector3df& position, const core::vector3df& scale,
+		video::SColor vertexColor, s32 maxLOD, E_TERRAIN_PATCH_SIZE patchSize, s32 smoothFactor)
+	: IPagedTerrainSceneNode(parent, mgr, id, position), FileSystem(fs),
+	TileFileName(tileFileName), TileSize(tileSize), VertexColor(vertexColor),
+	MaxLOD(maxLOD), PatchSize(patchSize), SmoothFactor(smoothFactor), Frame(0),
+	ViewRadius(1), MaxCachedTiles(16), TilesPerFrame(1), RetryDelay(1000),
+	ArchiveCount(fs ? fs->getFileArchiveCount() : 0), TileScale(scale)
+{
+	#ifdef _DEBUG
+	setDebugName("CPagedTerrainSceneNode");
+	#endif
+
+	if (FileSystem)
+		FileSystem->grab();
+
+	setAutomaticCulling(EAC_OFF);
+
+	updateAbsolutePosition();
+	Origin = getAbsolutePosition();
+}
+
+
+//! destructor
+CPagedTerrainSceneNode::~CPagedTerrainSceneNode()
+{
+	for (TileMap::Iterator it = Tiles.getIterator(); !it.atEnd(); ++it)
+	{
+		if (it->getValue().Node)
+			it->getValue().Node->drop();
+	}
+
+	if (FileSystem)
+		FileSystem->drop();
+}
+
+
+//! shows the tiles around the camera and loads missing ones
+void CPagedTerrainSceneNode::OnRegisterSceneNode()
+{
+	if (IsVisible)
+	{
+		updateOrigin();
+
+		ICameraSceneNode* camera = SceneManager->getActiveCamera();
+		if (camera)
+		{
+			updateTiles(camera->getAbsolutePosition(), TilesPerFrame);
+
+			// all LODs first, the stitched borders depend on the LODs of the neighbours
+			for (TileMap::Iterator it = Tiles.getIterator(); !it.atEnd(); ++it)
+			{
+				CTerrainSceneNode* node = it->getValue().Node;
+				if (node && node->isVisible())
+					node->updateLODs();
+			}
+
+			for (TileMap::Iterator it = Tiles.getIterator(); !it.atEnd(); ++it)
+			{
+				CTerrainSceneNode* node = it->getValue().Node;
+				if (node && node->isVisible())
+					node->updateIndices();
+			}
+		}
+	}
+
+	ISceneNode::OnRegisterSceneNode();
+}
+
+
+//! returns the bounding box of the loaded tiles
+const core::aabbox3d<f32>& CPagedTerrainSceneNode::getBoundingBox() const
+{
+	return Box;
+}
+
+
+//! returns the material the tiles are drawn with
+video::SMaterial& CPagedTerrainSceneNode::getMaterial(u32 i)
+{
+	return Material;
+}
+
+
+//! returns amount of materials used by this scene node
+u32 CPagedTerrainSceneNode::getMaterialCount() const
+{
+	return 1;
+}
+
+
+//! returns the size of a tile in world units
+core::vector3df CPagedTerrainSceneNode::getTileExtent() const
+{
+	return core::vector3df((TileSize - 1) * TileScale.X, 0.f, (TileSize - 1) * TileScale.Z);
+}
+
+
+//! returns the terrain of a tile, or 0 if the tile is not loaded
+ITerrainSceneNode* CPagedTerrainSceneNode::getTile(s32 x, s32 z) const
+{
+	const TileMap::Node* node = Tiles.find(getTileKey(x, z));
+	return node ? node->getValue().Node : 0;
+}
+
+
+//! loads all tiles within the view radius around a position at once
+void CPagedTerrainSceneNode::loadTilesAround(const core::vector3df& position)
+{
+	updateOrigin();
+	updateTiles(position, 0xffffffff);
+}
+
+
+//! returns the height of the terrain at a position
+f32 CPagedTerrainSceneNode::getHeight(f32 x, f32 z) const
+{
+	s32 tileX, tileZ;
+	getTileCoordinates(core::vector3df(x, 0.f, z), tileX, tileZ);
+
+	const ITerrainSceneNode* tile = getTile(tileX, tileZ);
+	return tile ? tile->getHeight(x, z) : -FLT_MAX;
+}
+
+
+//! returns the tile containing a position in world coordinates
+void CPagedTerrainSceneNode::getTileCoordinates(const core::vector3df& position, s32& x, s32& z) const
+{
+	const core::vector3df extent = getTileExtent();
+	x = core::floor32((position.X - Origin.X) / extent.X);
+	z = core::floor32((position.Z - Origin.Z) / extent.Z);
+}
+
+
+//! shows the tiles around a position, loads at most budget missing ones
+void CPagedTerrainSceneNode::updateTiles(const core::vector3df& position, u32 budget)
+{
+	if (TileSize < 2)
+		return;
+
+	++Frame;
+
+	const u32 now = os::Timer::getTime();
+
+	// a new archive may contain tiles which were missing so far
+	if (FileSystem && FileSystem->getFileArchiveCount() != ArchiveCount)
+	{
+		ArchiveCount = FileSystem->getFileArchiveCount();
+		for (TileMap::Iterator it = Tiles.getIterator(); !it.atEnd(); ++it)
+			it->getValue().RetryTime = now;
+	}
+
+	s32 centerX, centerZ;
+	getTileCoordinates(position, centerX, centerZ);
+
+	// rings of growing distance, so that the nearest tiles are loaded first
+	const s32 radius = (s32)ViewRadius;
+	for (s32 ring = 0; ring <= radius; ++ring)
+	{
+		for (s32 z = centerZ - ring; z <= centerZ + ring; ++z)
+		{
+			const s32 step = (z == centerZ - ring || z == centerZ + ring) ? 1 : core::max_(2 * ring, 1);
+			for (s32 x = centerX - ring; x <= centerX + ring; x += step)
+			{
+				TileMap::Node* node = Tiles.find(getTileKey(x, z));
+				if (!node)
+				{
+					if (!budget)
+						continue;
+					--budget;
+
+					Tiles.insert(getTileKey(x, z), loadTile(x, z, now));
+					node = Tiles.find(getTileKey(x, z));
+				}
+				else if (!node->getValue().Node && budget && (s32)(now - node->getValue().RetryTime) >= 0)
+				{
+					--budget;
+					node->getValue() = loadTile(x, z, now);
+				}
+
+				node->getValue().LastUsed = Frame;
+			}
+		}
+	}
+
+	evictTiles();
+
+	Box.reset(Origin);
+	bool first = true;
+	for (TileMap::Iterator it = Tiles.getIterator(); !it.atEnd(); ++it)
+	{
+		const STile& tile = it->getValue();
+		if (!tile.Node)
+			continue;
+
+		const bool visible = tile.LastUsed == Frame;
+		tile.Node->setVisible(visible);
+		if (!visible)
+			continue;
+
+		tile.Node->getMaterial(0) = Material;
+
+		if (first)
+			Box = tile.Node->getBoundingBox();
+		else
+			Box.addInternalBox(tile.Node->getBoundingBox());
+		first = false;
+	}
+
+	linkTiles();
+}
+
+
+//! stitches the borders of the visible tiles to their neighbours
+void CPagedTerrainSceneNode::linkTiles()
+{
+	// hidden and removed tiles are unlinked, so that no tile points to the patches of a removed one
+	for (TileMap::Iterator it = Tiles.getIterator(); !it.atEnd(); ++it)
+	{
+		CTerrainSceneNode* node = it->getValue().Node;
+		if (!node)
+			continue;
+
+		const s32 x = (s32)(u32)(it->getKey() >> 32);
+		const s32 z = (s32)(u32)it->getKey();
+		const bool visible = node->isVisible();
+
+		// in the order of CTerrainSceneNode::E_BORDER
+		const s32 offset[4][2] = { { -1, 0 }, { 1, 0 }, { 0, -1 }, { 0, 1 } };
+		for (u32 i = 0; i < 4; ++i)
+		{
+			CTerrainSceneNode* neighbour = 0;
+			if (visible)
+			{
+				const TileMap::Node* other = Tiles.find(getTileKey(x + offset[i][0], z + offset[i][1]));
+				if (other && other->getValue().Node && other->getValue().Node->isVisible())
+					neighbour = other->getValue().Node;
+			}
+
+			node->setNeighbour((CTerrainSceneNode::E_BORDER)i, neighbour);
+		}
+	}
+}
+
+
+//! loads a tile from its file
+CPagedTerrainSceneNode::STile CPagedTerrainSceneNode::loadTile(s32 x, s32 z, u32 now) const
+{
+	STile tile;
+	tile.Node = 0;
+	tile.LastUsed = Frame;
+	tile.RetryTime = now + RetryDelay;
+
+	io::path fileName(TileFileName);
+	fileName.replace(io::path("{x}"), io::path(x));
+	fileName.replace(io::path("{z}"), io::path(z));
+
+	// areas without tiles are simply empty
+	if (!FileSystem->existFile(fileName))
+		return tile;
+
+	io::IReadFile* file = FileSystem->createAndOpenFile(fileName);
+	if (!file)
+		return tile;
+
+	const core::vector3df extent = getTileExtent();
+	const core::vector3df position(Origin.X + x * extent.X, Origin.Y, Origin.Z + z * extent.Z);
+
+	CTerrainSceneNode* node = new CTerrainSceneNode(const_cast<CPagedTerrainSceneNode*>(this),
+		SceneManager, FileSystem, -1, MaxLOD, PatchSize, position,
+		core::vector3df(0.f, 0.f, 0.f), TileScale);
+
+	io::path extension;
+	core::getFileNameExtension(extension, fileName);
+	extension.make_lower();
+
+	bool loaded;
+	if (extension == ".raw")
+		loaded = node->loadHeightMapRAW(file, 16, false, false, TileSize, VertexColor, SmoothFactor);
+	else
+		loaded = node->loadHeightMap(file, VertexColor, SmoothFactor);
+
+	file->drop();
+
+	if (loaded && (s32)node->getMesh()->getMeshBuffer(0)->getVertexBuffer()->getVertexCount() != TileSize * TileSize)
+	{
+		os::Printer::log("Terrain tile does not have the size of the other tiles.", fileName, ELL_WARNING);
+		loaded = false;
+	}
+
+	if (!loaded)
+	{
+		node->remove();
+		node->drop();
+		return tile;
+	}
+
+	// the parent keeps its own reference, this one keeps the tile alive while it is cached
+	tile.Node = node;
+	return tile;
+}
+
+
+//! moves the tiles when the node was moved
+void CPagedTerrainSceneNode::updateOrigin()
+{
+	updateAbsolutePosition();
+	const core::vector3df origin = getAbsolutePosition();
+	if (origin == Origin)
+		return;
+
+	const core::vector3df offset = origin - Origin;
+	Origin = origin;
+
+	for (TileMap::Iterator it = Tiles.getIterator(); !it.atEnd(); ++it)
+	{
+		CTerrainSceneNode* node = it->getValue().Node;
+		if (node)
+			node->setPosition(node->getPosition() + offset);
+	}
+}
+
+
+//! removes hidden tiles until the cache fits
+void CPagedTerrainSceneNode::evictTiles()
+{
+	while (Tiles.size() > MaxCachedTiles)
+	{
+		u64 oldestKey = 0;
+		u32 oldest = Frame;
+		for (TileMap::Iterator it = Tiles.getIterator(); !it.atEnd(); ++it)
+		{
+			if (it->getValue().LastUsed < oldest)
+			{
+				oldest = it->getValue().LastUsed;
+				oldestKey = it->getKey();
+			}
+		}
+
+		// only tiles within the view radius are left
+		if (oldest == Frame)
+			break;
+
+		CTerrainSceneNode* node = Tiles.find(oldestKey)->getValue().Node;
+		if (node)
+		{
+			node->remove();
+			node->drop();
+		}
+		Tiles.remove(oldestKey);
+	}
+}
+
+
+} // end namespace scene
+} // end namespace irr
+
@@ -0,0 +1,149 @@
+// Copyright (C) 2002-2012 Nikolaus Gebhardt
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#ifndef __C_PAGED_TERRAIN_SCENE_NODE_H_INCLUDED__
+#define __C_PAGED_TERRAIN_SCENE_NODE_H_INCLUDED__
+
+#include "IPagedTerrainSceneNode.h"
+#include "ITerrainSceneNode.h"
+#include "irrHashMap.h"
+#include "path.h"
+
+namespace irr
+{
+namespace io
+{
+	class IFileSystem;
+}
+namespace scene
+{
+	class CTerrainSceneNode;
+
+	//! A terrain made of heightmap tiles which are loaded around the camera
+	class CPagedTerrainSceneNode : public IPagedTerrainSceneNode
+	{
+	public:
+
+		//! constructor
+		//! \param tileFileName: Pattern of the tile file names, with {x} and {z} as placeholders.
+		//! \param tileSize: Number of vertices along each side of a tile, the size of the heightmaps.
+		CPagedTerrainSceneNode(ISceneNode* parent, ISceneManager* mgr, io::IFileSystem* fs, s32 id,
+			const io::path& tileFileName, s32 tileSize,
+			const core::vector3df& position, const core::vector3df& scale,
+			video::SColor vertexColor, s32 maxLOD, E_TERRAIN_PATCH_SIZE patchSize, s32 smoothFactor);
+
+		//! destructor
+		virtual ~CPagedTerrainSceneNode();
+
+		//! shows the tiles around the camera and loads missing ones
+		virtual void OnRegisterSceneNode() _IRR_OVERRIDE_;
+
+		//! the tiles render themselves
+		virtual void render() _IRR_OVERRIDE_ {}
+
+		//! returns the bounding box of the loaded tiles
+		virtual const core::aabbox3d<f32>& getBoundingBox() const _IRR_OVERRIDE_;
+
+		//! returns the material the tiles are drawn with
+		virtual video::SMaterial& getMaterial(u32 i) _IRR_OVERRIDE_;
+
+		//! returns amount of materials used by this scene node
+		virtual u32 getMaterialCount() const _IRR_OVERRIDE_;
+
+		//! returns the type of the scene node
+		virtual ESCENE_NODE_TYPE getType() const _IRR_OVERRIDE_ { return ESNT_PAGED_TERRAIN; }
+
+		virtual void setViewRadius(u32 radius) _IRR_OVERRIDE_ { ViewRadius = radius; }
+
+		virtual u32 getViewRadius() const _IRR_OVERRIDE_ { return ViewRadius; }
+
+		virtual void setMaxCachedTiles(u32 count) _IRR_OVERRIDE_ { MaxCachedTiles = count; }
+
+		virtual u32 getMaxCachedTiles() const _IRR_OVERRIDE_ { return MaxCachedTiles; }
+
+		virtual void setTilesPerFrame(u32 count) _IRR_OVERRIDE_ { TilesPerFrame = count; }
+
+		virtual void setRetryDelay(u32 milliseconds) _IRR_OVERRIDE_ { RetryDelay = milliseconds; }
+
+		virtual u32 getRetryDelay() const _IRR_OVERRIDE_ { return RetryDelay; }
+
+		virtual core::vector3df getTileExtent() const _IRR_OVERRIDE_;
+
+		virtual u32 getCachedTileCount() const _IRR_OVERRIDE_ { return Tiles.size(); }
+
+		virtual ITerrainSceneNode* getTile(s32 x, s32 z) const _IRR_OVERRIDE_;
+
+		virtual void loadTilesAround(const core::vector3df& position) _IRR_OVERRIDE_;
+
+		virtual f32 getHeight(f32 x, f32 z) const _IRR_OVERRIDE_;
+
+	private:
+
+		struct STile
+		{
+			//! the terrain, 0 if there is no file for the tile
+			CTerrainSceneNode* Node;
+
+			//! frame in which the tile was last within the view radius
+			u32 LastUsed;
+
+			//! time after which a tile without file is loaded again
+			u32 RetryTime;
+		};
+
+		typedef core::hash_map<u64, STile> TileMap;
+
+		static u64 getTileKey(s32 x, s32 z)
+		{
+			return ((u64)(u32)x << 32) | (u32)z;
+		}
+
+		//! returns the tile containing a position in world coordinates
+		void getTileCoordinates(const core::vector3df& position, s32& x, s32& z) const;
+
+		//! shows the tiles around a position, loads at most budget missing ones
+		void updateTiles(const core::vector3df& position, u32 budget);
+
+		//! loads a tile from its file
+		STile loadTile(s32 x, s32 z, u32 now) const;
+
+		//! stitches the borders of the visible tiles to their neighbours
+		void linkTiles();
+
+		//! moves the tiles when the node was moved
+		void updateOrigin();
+
+		//! removes hidden tiles until the cache fits
+		void evictTiles();
+
+		io::IFileSystem* FileSystem;
+
+		io::path TileFileName;
+		s32 TileSize;
+		video::SColor VertexColor;
+		s32 MaxLOD;
+		E_TERRAIN_PATCH_SIZE PatchSize;
+		s32 SmoothFactor;
+
+		TileMap Tiles;
+		u32 Frame;
+
+		u32 ViewRadius;
+		u32 MaxCachedTiles;
+		u32 TilesPerFrame;
+		u32 RetryDelay;
+		u32 ArchiveCount;
+
+		core::vector3df Origin;
+		core::vector3df TileScale;
+
+		video::SMaterial Material;
+		core::aabbox3d<f32> Box;
+	};
+
+} // end namespace scene
+} // end namespace irr
+
+#endif
+
@@ -30,12 +30,23 @@ inline bool isHeaderValid(const SPAKFileHeader& header)
 } // end namespace
 
 //! Constructor
-CArchiveLoaderPAK::CArchiveLoaderPAK( io::IFileSystem* fs)
-: FileSystem(fs)
+CArchiveLoaderPAK::CArchiveLoaderPAK(io::IFileSystem* fs, CArchiveEntryCache* cache)
+: FileSystem(fs), EntryCache(cache)
 {
 #ifdef _DEBUG
 	setDebugName("CArchiveLoaderPAK");
 #endif
+
+	if (EntryCache)
+		EntryCache->grab();
+}
+
+
+//! Destructor
+CArchiveLoaderPAK::~CArchiveLoaderPAK()
+{
+	if (EntryCache)
+		EntryCache->drop();
 }
 
 
@@ -76,7 +87,7 @@ IFileArchive* CArchiveLoaderPAK::createArchive(io::IReadFile* file, bool ignoreC
 	if ( file )
 	{
 		file->seek ( 0 );
-		archive = new CPakReader(file, ignoreCase, ignorePaths);
+		archive = new CPakReader(file, ignoreCase, ignorePaths, EntryCache);
 	}
 	return archive;
 }
@@ -99,13 +110,20 @@ bool CArchiveLoaderPAK::isALoadableFileFormat(io::IReadFile* file) const
 /*!
 	PAK Reader
 */
-CPakReader::CPakReader(IReadFile* file, bool ignoreCase, bool ignorePaths)
-: CFileList((file ? file->getFileName() : io::path("")), ignoreCase, ignorePaths), File(file)
+CPakReader::CPakReader(IReadFile* file, bool ignoreCase, bool ignorePaths, CArchiveEntryCache* cache)
+: CFileList((file ? file->getFileName() : io::path("")), ignoreCase, ignorePaths), File(file),
+	EntryCache(cache), CacheID(0)
 {
 #ifdef _DEBUG
 	setDebugName("CPakReader");
 #endif
 
+	if (EntryCache)
+	{
+		EntryCache->grab();
+		CacheID = EntryCache->addArchive();
+	}
+
 	if (File)
 	{
 		File->grab();
@@ -117,6 +135,12 @@ CPakReader::CPakReader(IReadFile* file, bool ignoreCase, bool ignorePaths)
 
 CPakReader::~CPakReader()
 {
+	if (EntryCache)
+	{
+		EntryCache->removeArchive(CacheID);
+		EntryCache->drop();
+	}
+
 	if (File)
 		File->drop();
 }
@@ -186,7 +210,13 @@ IReadFile* CPakReader::createAndOpenFile(u32 index)
 		return 0;
 
 	const SFileListEntry &entry = Files[index];
-	return createLimitReadFile( entry.FullName, File, entry.Offset, entry.Size );
+	if (!EntryCache)
+		return createLimitReadFile( entry.FullName, File, entry.Offset, entry.Size );
+
+	IReadFile* file = EntryCache->createAndOpenFile(CacheID, index, entry.FullName);
+	if (!file)
+		file = EntryCache->add(CacheID, index, createLimitReadFile( entry.FullName, File, entry.Offset, entry.Size ));
+	return file;
 }
 
 } // end namespace io
@@ -14,6 +14,7 @@
 #include "irrArray.h"
 #include "irrString.h"
 #include "IFileSystem.h"
+#include "CArchiveEntryCache.h"
 #include "CFileList.h"
 
 namespace irr
@@ -44,7 +45,10 @@ namespace io
 	public:
 
 		//! Constructor
-		CArchiveLoaderPAK(io::IFileSystem* fs);
+		CArchiveLoaderPAK(io::IFileSystem* fs, CArchiveEntryCache* cache=0);
+
+		//! Destructor
+		virtual ~CArchiveLoaderPAK();
 
 		//! returns true if the file maybe is able to be loaded by this class
 		//! based on the file extension (e.g. ".zip")
@@ -73,6 +77,7 @@ namespace io
 
 	private:
 		io::IFileSystem* FileSystem;
+		CArchiveEntryCache* EntryCache;
 	};
 
 
@@ -81,7 +86,7 @@ namespace io
 	{
 	public:
 
-		CPakReader(IReadFile* file, bool ignoreCase, bool ignorePaths);
+		CPakReader(IReadFile* file, bool ignoreCase, bool ignorePaths, CArchiveEntryCache* cache=0);
 		virtual ~CPakReader();
 
 		// file archive methods
@@ -111,6 +116,8 @@ namespace io
 
 		IReadFile* File;
 
+		CArchiveEntryCache* EntryCache;
+		u32 CacheID;
 	};
 
 } // end namespace io
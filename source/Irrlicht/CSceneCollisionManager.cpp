@@ -74,13 +74,11 @@ void CSceneCollisionManager::getPickedNodeBB(ISceneNode* root,
 		core::line3df& ray, s32 bits, bool noDebugObjects,
 		f32& outbestdistance, ISceneNode*& outbestnode)
 {
-	const ISceneNodeList& children = root->getChildren();
 	const core::vector3df rayVector = ray.getVector().normalize();
 
-	ISceneNodeList::ConstIterator it = children.begin();
-	for (; it != children.end(); ++it)
+	for (u32 i=0; i<root->getChildCount(); ++i)
 	{
-		ISceneNode* current = *it;
+		ISceneNode* current = root->getChild(i);
 
 		if (current->isVisible())
 		{
@@ -276,12 +274,9 @@ void CSceneCollisionManager::getPickedNodeFromBBAndSelector(
 				core::vector3df & outBestCollisionPoint,
 				core::triangle3df & outBestTriangle)
 {
-	const ISceneNodeList& children = root->getChildren();
-
-	ISceneNodeList::ConstIterator it = children.begin();
-	for (; it != children.end(); ++it)
+	for (u32 i=0; i<root->getChildCount(); ++i)
 	{
-		ISceneNode* current = *it;
+		ISceneNode* current = root->getChild(i);
 		ITriangleSelector * selector = current->getTriangleSelector();
 
 		if (selector && current->isVisible() &&
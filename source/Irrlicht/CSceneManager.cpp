@@ -21,6 +21,8 @@
 
 #include "os.h"
 
+#include <stdio.h>
+
 // We need this include for the case of skinned mesh support without
 // any such loader
 #ifdef _IRR_COMPILE_WITH_SKINNED_MESH_SUPPORT_
@@ -31,6 +33,10 @@
 #include "CIrrMeshFileLoader.h"
 #endif
 
+#ifdef _IRR_COMPILE_WITH_BINARY_MESH_LOADER_
+#include "CBinaryMeshFileLoader.h"
+#endif
+
 #ifdef _IRR_COMPILE_WITH_BSP_LOADER_
 #include "CBSPMeshFileLoader.h"
 #endif
@@ -123,6 +129,10 @@
 #include "CIrrMeshWriter.h"
 #endif
 
+#ifdef _IRR_COMPILE_WITH_BINARY_MESH_WRITER_
+#include "CBinaryMeshWriter.h"
+#endif
+
 #ifdef _IRR_COMPILE_WITH_STL_WRITER_
 #include "CSTLMeshWriter.h"
 #endif
@@ -150,6 +160,8 @@
 #include "CDummyTransformationSceneNode.h"
 #include "CWaterSurfaceSceneNode.h"
 #include "CTerrainSceneNode.h"
+#include "CPagedTerrainSceneNode.h"
+#include "CStaticBatchBuilder.h"
 #include "CEmptySceneNode.h"
 #include "CTextSceneNode.h"
 #include "CQuake3ShaderSceneNode.h"
@@ -189,7 +201,7 @@ CSceneManager::CSceneManager(video::IVideoDriver* driver, io::IFileSystem* fs,
 : ISceneNode(0, 0), Driver(driver), FileSystem(fs), GUIEnvironment(gui),
 	CursorControl(cursorControl), CollisionManager(0),
 	ActiveCamera(0), ShadowColor(150,0,0,0), AmbientLight(0,0,0,0), Parameters(0),
-	MeshCache(cache), CurrentRenderPass(ESNRP_NONE), LightManager(0),
+	MeshCache(cache), CurrentRenderPass(ESNRP_NONE), ViewCameras(0), ViewCount(0), LightManager(0),
 	IRR_XML_FORMAT_SCENE(L"irr_scene"), IRR_XML_FORMAT_NODE(L"node"), IRR_XML_FORMAT_NODE_ATTR_TYPE(L"type")
 {
 	#ifdef _DEBUG
@@ -298,6 +310,9 @@ CSceneManager::CSceneManager(video::IVideoDriver* driver, io::IFileSystem* fs,
 	#ifdef _IRR_COMPILE_WITH_B3D_LOADER_
 	MeshLoaderList.push_back(new CB3DMeshFileLoader(this));
 	#endif
+	#ifdef _IRR_COMPILE_WITH_BINARY_MESH_LOADER_
+	MeshLoaderList.push_back(new CBinaryMeshFileLoader(Driver));
+	#endif
 
 	// scene loaders
 	#ifdef _IRR_COMPILE_WITH_IRR_SCENE_LOADER_
@@ -328,6 +343,10 @@ CSceneManager::CSceneManager(video::IVideoDriver* driver, io::IFileSystem* fs,
 			getProfiler().add(EPID_SM_RENDER_TRANSPARENT, L"transp.nodes", L"Irrlicht scene");
 			getProfiler().add(EPID_SM_RENDER_EFFECT, L"effectnodes", L"Irrlicht scene");
 			getProfiler().add(EPID_SM_REGISTER, L"reg.render.node", L"Irrlicht scene");
+			getProfiler().add(EPID_SM_BUFFERS_VISIBLE, L"visible buffers", L"Irrlicht scene");
+			getProfiler().add(EPID_SM_BUFFERS_CULLED, L"culled buffers", L"Irrlicht scene");
+			getProfiler().add(EPID_OP_ALLOC_NODE, L"node allocs", L"Irrlicht scene");
+			getProfiler().add(EPID_OP_ALLOC_ANIMATOR, L"anim. allocs", L"Irrlicht scene");
 		}
  	)
 }
@@ -408,6 +427,27 @@ IAnimatedMesh* CSceneManager::getMesh(const io::path& filename)
 		return 0;
 	}
 
+#if defined(_IRR_COMPILE_WITH_BINARY_MESH_LOADER_) && defined(_IRR_COMPILE_WITH_BINARY_MESH_WRITER_)
+	u32 sourceSize = 0;
+	u32 sourceHash = 0;
+	const bool useBinaryCache = MeshCache->isBinaryCacheEnabled() &&
+		!core::hasFileExtension(filename, "irrbmesh");
+
+	if (useBinaryCache)
+	{
+		sourceHash = getBinaryMeshSourceHash(file, sourceSize);
+		msh = readBinaryMeshCache(filename, sourceSize, sourceHash);
+		if (msh)
+		{
+			file->drop();
+			MeshCache->addMesh(filename, msh);
+			msh->drop();
+			os::Printer::log("Loaded mesh from binary cache", filename, ELL_INFORMATION);
+			return msh;
+		}
+	}
+#endif
+
 	// iterate the list in reverse order so user-added loaders can override the built-in ones
 	s32 count = MeshLoaderList.size();
 	for (s32 i=count-1; i>=0; --i)
@@ -431,12 +471,102 @@ IAnimatedMesh* CSceneManager::getMesh(const io::path& filename)
 	if (!msh)
 		os::Printer::log("Could not load mesh, file format seems to be unsupported", filename, ELL_ERROR);
 	else
+	{
 		os::Printer::log("Loaded mesh", filename, ELL_INFORMATION);
 
+#if defined(_IRR_COMPILE_WITH_BINARY_MESH_LOADER_) && defined(_IRR_COMPILE_WITH_BINARY_MESH_WRITER_)
+		if (useBinaryCache)
+			writeBinaryMeshCache(filename, msh, sourceSize, sourceHash);
+#endif
+	}
+
 	return msh;
 }
 
 
+//! loads the binary cache file of a mesh source, if it is up to date
+IAnimatedMesh* CSceneManager::readBinaryMeshCache(const io::path& filename, u32 sourceSize, u32 sourceHash)
+{
+#ifdef _IRR_COMPILE_WITH_BINARY_MESH_LOADER_
+	const io::path cacheName = filename + ".irrbmesh";
+	if (!FileSystem->existFile(cacheName))
+		return 0;
+
+	io::IReadFile* file = FileSystem->createAndOpenFile(cacheName);
+	if (!file)
+		return 0;
+
+	IAnimatedMesh* msh = 0;
+	SBinaryMeshHeader header;
+	if (CBinaryMeshFileLoader::readHeader(file, header) &&
+		header.SourceSize == sourceSize && header.SourceHash == sourceHash)
+	{
+		CBinaryMeshFileLoader* loader = new CBinaryMeshFileLoader(Driver);
+		msh = loader->createMesh(file);
+		loader->drop();
+	}
+	else
+		os::Printer::log("Binary mesh cache is outdated", cacheName, ELL_DEBUG);
+
+	file->drop();
+	return msh;
+#else
+	return 0;
+#endif
+}
+
+
+//! writes the binary cache file of a mesh source
+void CSceneManager::writeBinaryMeshCache(const io::path& filename, IAnimatedMesh* mesh, u32 sourceSize, u32 sourceHash)
+{
+#ifdef _IRR_COMPILE_WITH_BINARY_MESH_WRITER_
+	// meshes with vertex animation or special interfaces like the Quake 3 level mesh are not cached
+	const E_ANIMATED_MESH_TYPE type = mesh->getMeshType();
+	if (type != EAMT_SKINNED && (type == EAMT_BSP || mesh->getFrameCount() > 1))
+		return;
+
+	// written under a temporary name first, so a failed write never leaves a truncated cache
+	const io::path cacheName = filename + ".irrbmesh";
+	const io::path tempName = cacheName + ".tmp";
+	io::IWriteFile* file = FileSystem->createAndWriteFile(tempName);
+	if (!file)
+	{
+		os::Printer::log("Could not write binary mesh cache", cacheName, ELL_WARNING);
+		return;
+	}
+
+	CBinaryMeshWriter* writer = new CBinaryMeshWriter(Driver);
+	writer->setSourceKey(sourceSize, sourceHash);
+	const bool written = writer->writeAnimatedMesh(file, mesh);
+	writer->drop();
+	file->drop();
+
+	// rename does not replace existing files on Windows
+#if defined(_IRR_WCHAR_FILESYSTEM)
+	#if defined(_IRR_WINDOWS_API_)
+	if (written)
+		::_wremove(cacheName.c_str());
+	#endif
+	if (!written || ::_wrename(tempName.c_str(), cacheName.c_str()) != 0)
+	{
+		::_wremove(tempName.c_str());
+		os::Printer::log("Could not write binary mesh cache", cacheName, ELL_WARNING);
+	}
+#else
+	#if defined(_IRR_WINDOWS_API_)
+	if (written)
+		::remove(cacheName.c_str());
+	#endif
+	if (!written || ::rename(tempName.c_str(), cacheName.c_str()) != 0)
+	{
+		::remove(tempName.c_str());
+		os::Printer::log("Could not write binary mesh cache", cacheName, ELL_WARNING);
+	}
+#endif
+#endif
+}
+
+
 //! gets an animateable mesh. loads it if needed. returned pointer must not be dropped.
 IAnimatedMesh* CSceneManager::getMesh(io::IReadFile* file)
 {
@@ -934,6 +1064,32 @@ ITerrainSceneNode* CSceneManager::addTerrainSceneNode(
 }
 
 
+//! Adds a terrain scene node which loads heightmap tiles around the camera.
+IPagedTerrainSceneNode* CSceneManager::addPagedTerrainSceneNode(
+	const io::path& tileFileName, s32 tileSize,
+	ISceneNode* parent, s32 id,
+	const core::vector3df& position,
+	const core::vector3df& scale,
+	video::SColor vertexColor,
+	s32 maxLOD, E_TERRAIN_PATCH_SIZE patchSize, s32 smoothFactor)
+{
+	if (!parent)
+		parent = this;
+
+	if (tileSize < 2)
+	{
+		os::Printer::log("Could not add paged terrain, invalid tile size.", tileFileName, ELL_ERROR);
+		return 0;
+	}
+
+	IPagedTerrainSceneNode* node = new CPagedTerrainSceneNode(parent, this, FileSystem, id,
+		tileFileName, tileSize, position, scale, vertexColor, maxLOD, patchSize, smoothFactor);
+
+	node->drop();
+	return node;
+}
+
+
 //! Adds an empty scene node.
 ISceneNode* CSceneManager::addEmptySceneNode(ISceneNode* parent, s32 id)
 {
@@ -947,6 +1103,19 @@ ISceneNode* CSceneManager::addEmptySceneNode(ISceneNode* parent, s32 id)
 }
 
 
+//! Merges the static mesh scene nodes of a subtree into a few large mesh buffers.
+ISceneNode* CSceneManager::addStaticBatchSceneNode(ISceneNode* root, f32 cellSize, s32 id)
+{
+	if (!root)
+		root = this;
+
+	CStaticBatchBuilder builder(this, cellSize);
+	builder.collect(root);
+
+	return builder.build(id);
+}
+
+
 //! Adds a dummy transformation scene node to the scene graph.
 IDummyTransformationSceneNode* CSceneManager::addDummyTransformationSceneNode(
 	ISceneNode* parent, s32 id)
@@ -1222,15 +1391,12 @@ bool CSceneManager::isCulled(const ISceneNode* node) const
 	// can be seen by cam pyramid planes ?
 	if (!result && (node->getAutomaticCulling() & scene::EAC_FRUSTUM_BOX))
 	{
-		SViewFrustum frust = *cam->getViewFrustum();
-
-		//transform the frustum to the node's current absolute transformation
-		core::matrix4 invTrans(node->getAbsoluteTransformation(), core::matrix4::EM4CONST_INVERSE);
-		//invTrans.makeInverse();
-		frust.transform(invTrans);
+		const SViewFrustum& frust = *cam->getViewFrustum();
 
+		// the edges are transformed to world space, which keeps their side of the planes
 		core::vector3df edges[8];
 		node->getBoundingBox().getEdges(edges);
+		node->getAbsoluteTransformation().transformVects(edges, edges, 8);
 
 		for (s32 i=0; i<scene::SViewFrustum::VF_PLANE_COUNT; ++i)
 		{
@@ -1266,18 +1432,22 @@ bool CSceneManager::isCulled(core::aabbox3d<f32> tbox, scene::E_CULLING_TYPE typ
 
 	bool result = false;
 
+	// the box and sphere tests are done in world space
+	core::aabbox3d<f32> worldBox(tbox);
+	if (type & (scene::EAC_BOX | scene::EAC_FRUSTUM_SPHERE))
+		absoluteTransformation.transformBoxEx(worldBox);
+
 	// can be seen by a bounding box ?
 	if (!result && (type & scene::EAC_BOX))
 	{
-		absoluteTransformation.transformBoxEx(tbox);
-		result = !(tbox.intersectsWithBox(cam->getViewFrustum()->getBoundingBox()));
+		result = !(worldBox.intersectsWithBox(cam->getViewFrustum()->getBoundingBox()));
 	}
 
 	// can be seen by a bounding sphere
 	if (!result && (type & scene::EAC_FRUSTUM_SPHERE))
 	{
-		const float rad = tbox.getRadius();
-		const core::vector3df center = tbox.getCenter();
+		const float rad = worldBox.getRadius();
+		const core::vector3df center = worldBox.getCenter();
 
 		const float camrad = cam->getViewFrustum()->getBoundingRadius();
 		const core::vector3df camcenter = cam->getViewFrustum()->getBoundingCenter();
@@ -1291,15 +1461,12 @@ bool CSceneManager::isCulled(core::aabbox3d<f32> tbox, scene::E_CULLING_TYPE typ
 	// can be seen by cam pyramid planes ?
 	if (!result && (type & scene::EAC_FRUSTUM_BOX))
 	{
-		SViewFrustum frust = *cam->getViewFrustum();
-
-		//transform the frustum to the node's current absolute transformation
-		core::matrix4 invTrans(absoluteTransformation, core::matrix4::EM4CONST_INVERSE);
-		//invTrans.makeInverse();
-		frust.transform(invTrans);
+		const SViewFrustum& frust = *cam->getViewFrustum();
 
+		// the edges are transformed to world space, which keeps their side of the planes
 		core::vector3df edges[8];
 		tbox.getEdges(edges);
+		absoluteTransformation.transformVects(edges, edges, 8);
 
 		for (s32 i = 0; i<scene::SViewFrustum::VF_PLANE_COUNT; ++i)
 		{
@@ -1325,12 +1492,112 @@ bool CSceneManager::isCulled(core::aabbox3d<f32> tbox, scene::E_CULLING_TYPE typ
 }
 
 
+//! returns a bit for each view of drawAllViews which can see the node
+u32 CSceneManager::getVisibleViews(const ISceneNode* node) const
+{
+	const u32 all = ViewCount < 32 ? (1u << ViewCount) - 1 : 0xffffffff;
+
+	// has occlusion query information, the same for all views
+	if ((node->getAutomaticCulling() & scene::EAC_OCC_QUERY) &&
+		Driver->getOcclusionQueryResult(const_cast<ISceneNode*>(node))==0)
+		return 0;
+
+	const u32 culling = node->getAutomaticCulling() & (scene::EAC_BOX | scene::EAC_FRUSTUM_SPHERE | scene::EAC_FRUSTUM_BOX);
+	if (!culling)
+		return all;
+
+	// the node is transformed once, the views only test against it
+	core::aabbox3d<f32> tbox = node->getBoundingBox();
+	node->getAbsoluteTransformation().transformBoxEx(tbox);
+	const f32 rad = tbox.getRadius();
+	const core::vector3df center = tbox.getCenter();
+
+	core::vector3df edges[8];
+	if (culling & scene::EAC_FRUSTUM_BOX)
+	{
+		node->getBoundingBox().getEdges(edges);
+		node->getAbsoluteTransformation().transformVects(edges, edges, 8);
+	}
+
+	u32 views = 0;
+	for (u32 view=0; view<ViewCount; ++view)
+	{
+		const SViewFrustum* frustum = (*ViewCameras)[view]->getViewFrustum();
+
+		if ((culling & scene::EAC_BOX) && !tbox.intersectsWithBox(frustum->getBoundingBox()))
+			continue;
+
+		if (culling & scene::EAC_FRUSTUM_SPHERE)
+		{
+			const f32 camrad = frustum->getBoundingRadius();
+			if ((center - frustum->getBoundingCenter()).getLengthSQ() > (rad + camrad) * (rad + camrad))
+				continue;
+		}
+
+		if (culling & scene::EAC_FRUSTUM_BOX)
+		{
+			bool culled = false;
+			for (s32 i=0; i<scene::SViewFrustum::VF_PLANE_COUNT && !culled; ++i)
+			{
+				culled = true;
+				for (u32 j=0; j<8; ++j)
+				{
+					if (frustum->planes[i].classifyPointRelation(edges[j]) != core::ISREL3D_FRONT)
+					{
+						culled = false;
+						break;
+					}
+				}
+			}
+
+			if (culled)
+				continue;
+		}
+
+		views |= 1u << view;
+	}
+
+	return views;
+}
+
+
+//! registers a node for all views of drawAllViews which can see it
+u32 CSceneManager::registerNodeForViews(ISceneNode* node, E_SCENE_NODE_RENDER_PASS pass)
+{
+	const u32 views = getVisibleViews(node);
+	if (!views)
+		return 0;
+
+	// transparency doesn't depend on the view
+	if (pass == ESNRP_AUTOMATIC)
+	{
+		pass = ESNRP_SOLID;
+		for (u32 i=0; i<node->getMaterialCount(); ++i)
+		{
+			video::IMaterialRenderer* rnd =
+				Driver->getMaterialRenderer(node->getMaterial(i).MaterialType);
+			if ((rnd && rnd->isTransparent()) || node->getMaterial(i).isTransparent())
+			{
+				pass = ESNRP_TRANSPARENT;
+				break;
+			}
+		}
+	}
+
+	ViewNodeList.push_back(ViewNodeEntry(node, pass, views));
+	return 1;
+}
+
+
 //! registers a node for rendering it at a specific time.
 u32 CSceneManager::registerNodeForRendering(ISceneNode* node, E_SCENE_NODE_RENDER_PASS pass)
 {
 	IRR_PROFILE(CProfileScope p1(EPID_SM_REGISTER);)
 	u32 taken = 0;
 
+	if (ViewCameras && pass != ESNRP_CAMERA && pass != ESNRP_LIGHT && pass != ESNRP_SKY_BOX && pass != ESNRP_NONE)
+		return registerNodeForViews(node, pass);
+
 	switch(pass)
 	{
 		// take camera if it is not already registered
@@ -1496,6 +1763,135 @@ void CSceneManager::drawAll()
 	if (LightManager)
 		LightManager->OnPreRender(LightList);
 
+	renderPasses();
+
+	if (LightManager)
+		LightManager->OnPostRender();
+
+	LightList.set_used(0);
+	SkyBoxList.set_used(0);
+	clearDeletionList();
+
+	CurrentRenderPass = ESNRP_NONE;
+}
+
+
+//! draws the scene once for each of several cameras
+void CSceneManager::drawAllViews(const core::array<ICameraSceneNode*>& cameras,
+		const core::array<core::rect<s32> >& viewPorts)
+{
+	IRR_PROFILE(CProfileScope psAll(EPID_SM_DRAW_ALL);)
+
+	if (!Driver || cameras.empty())
+		return;
+
+	u32 viewCount = cameras.size();
+	if (viewCount > 32)
+	{
+		os::Printer::log("drawAllViews supports up to 32 views, the others are ignored", ELL_WARNING);
+		viewCount = 32;
+	}
+
+	u32 i;
+
+	Driver->setMaterial(video::SMaterial());
+	Driver->setTransform ( video::ETS_PROJECTION, core::IdentityMatrix );
+	Driver->setTransform ( video::ETS_VIEW, core::IdentityMatrix );
+	Driver->setTransform ( video::ETS_WORLD, core::IdentityMatrix );
+	for (i=video::ETS_COUNT-1; i>=video::ETS_TEXTURE_0; --i)
+		Driver->setTransform ( (video::E_TRANSFORMATION_STATE)i, core::IdentityMatrix );
+	Driver->setAllowZWriteOnTransparent(Parameters->getAttributeAsBool(ALLOW_ZWRITE_ON_TRANSPARENT));
+
+	// the scene is animated only once for all views
+	IRR_PROFILE(getProfiler().start(EPID_SM_ANIMATE));
+	OnAnimate(os::Timer::getTime());
+	IRR_PROFILE(getProfiler().stop(EPID_SM_ANIMATE));
+
+	// update the frusta of all views before culling
+	IRR_PROFILE(getProfiler().start(EPID_SM_RENDER_CAMERAS));
+	for (i=0; i<viewCount; ++i)
+		cameras[i]->render();
+	IRR_PROFILE(getProfiler().stop(EPID_SM_RENDER_CAMERAS));
+
+	ICameraSceneNode* activeCamera = ActiveCamera;
+	if (activeCamera)
+		activeCamera->grab();
+	const core::rect<s32> viewPort = Driver->getViewPort();
+
+	// one traversal, each node is tested against all views. Nodes which
+	// need a camera to register see the first one, camera dependent work
+	// of a view is done again when it renders.
+	setActiveCamera(cameras[0]);
+	ViewCameras = &cameras;
+	ViewCount = viewCount;
+	OnRegisterSceneNode();
+	ViewCameras = 0;
+
+	for (u32 view=0; view<viewCount; ++view)
+	{
+		setActiveCamera(cameras[view]);
+		camWorldPos = cameras[view]->getAbsolutePosition();
+
+		if (view < viewPorts.size())
+			Driver->setViewPort(viewPorts[view]);
+
+		// the lists of this view, sorted for its camera by renderPasses
+		const u32 mask = 1u << view;
+		CameraList.set_used(0);
+		CameraList.push_back(cameras[view]);
+		for (i=0; i<ViewNodeList.size(); ++i)
+		{
+			const ViewNodeEntry& e = ViewNodeList[i];
+			if (!(e.Views & mask))
+				continue;
+
+			switch (e.Pass)
+			{
+			case ESNRP_SOLID:
+				SolidNodeList.push_back(e.Node);
+				break;
+			case ESNRP_TRANSPARENT:
+				TransparentNodeList.push_back(TransparentNodeEntry(e.Node, camWorldPos));
+				break;
+			case ESNRP_TRANSPARENT_EFFECT:
+				TransparentEffectNodeList.push_back(TransparentNodeEntry(e.Node, camWorldPos));
+				break;
+			case ESNRP_SHADOW:
+				ShadowNodeList.push_back(e.Node);
+				break;
+			default:
+				break;
+			}
+		}
+
+		if (LightManager)
+			LightManager->OnPreRender(LightList);
+
+		renderPasses();
+
+		if (LightManager)
+			LightManager->OnPostRender();
+	}
+
+	setActiveCamera(activeCamera);
+	if (activeCamera)
+		activeCamera->drop();
+	Driver->setViewPort(viewPort);
+
+	ViewNodeList.set_used(0);
+	LightList.set_used(0);
+	SkyBoxList.set_used(0);
+	clearDeletionList();
+
+	CurrentRenderPass = ESNRP_NONE;
+}
+
+
+//! renders the registered nodes in the order of the render passes
+void CSceneManager::renderPasses()
+{
+	u32 i;
+
 	//render camera scenes
 	{
 		IRR_PROFILE(CProfileScope psCam(EPID_SM_RENDER_CAMERAS);)
@@ -1582,8 +1978,6 @@ void CSceneManager::drawAll()
 				SkyBoxList[i]->render();
 		}
 
-		SkyBoxList.set_used(0);
-
 		if (LightManager)
 			LightManager->OnRenderPassPostRender(CurrentRenderPass);
 	}
@@ -1720,14 +2114,6 @@ void CSceneManager::drawAll()
 #endif
 		TransparentEffectNodeList.set_used(0);
 	}
-
-	if (LightManager)
-		LightManager->OnPostRender();
-
-	LightList.set_used(0);
-	clearDeletionList();
-
-	CurrentRenderPass = ESNRP_NONE;
 }
 
 void CSceneManager::setLightManager(ILightManager* lightManager)
@@ -2007,11 +2393,9 @@ ISceneNode* CSceneManager::getSceneNodeFromName(const char* name, ISceneNode* st
 
 	ISceneNode* node = 0;
 
-	const ISceneNodeList& list = start->getChildren();
-	ISceneNodeList::ConstIterator it = list.begin();
-	for (; it!=list.end(); ++it)
+	for (u32 i=0; i<start->getChildCount(); ++i)
 	{
-		node = getSceneNodeFromName(name, *it);
+		node = getSceneNodeFromName(name, start->getChild(i));
 		if (node)
 			return node;
 	}
@@ -2031,11 +2415,9 @@ ISceneNode* CSceneManager::getSceneNodeFromId(s32 id, ISceneNode* start)
 
 	ISceneNode* node = 0;
 
-	const ISceneNodeList& list = start->getChildren();
-	ISceneNodeList::ConstIterator it = list.begin();
-	for (; it!=list.end(); ++it)
+	for (u32 i=0; i<start->getChildCount(); ++i)
 	{
-		node = getSceneNodeFromId(id, *it);
+		node = getSceneNodeFromId(id, start->getChild(i));
 		if (node)
 			return node;
 	}
@@ -2055,11 +2437,9 @@ ISceneNode* CSceneManager::getSceneNodeFromType(scene::ESCENE_NODE_TYPE type, IS
 
 	ISceneNode* node = 0;
 
-	const ISceneNodeList& list = start->getChildren();
-	ISceneNodeList::ConstIterator it = list.begin();
-	for (; it!=list.end(); ++it)
+	for (u32 i=0; i<start->getChildCount(); ++i)
 	{
-		node = getSceneNodeFromType(type, *it);
+		node = getSceneNodeFromType(type, start->getChild(i));
 		if (node)
 			return node;
 	}
@@ -2077,12 +2457,9 @@ void CSceneManager::getSceneNodesFromType(ESCENE_NODE_TYPE type, core::array<sce
 	if (start->getType() == type || ESNT_ANY == type)
 		outNodes.push_back(start);
 
-	const ISceneNodeList& list = start->getChildren();
-	ISceneNodeList::ConstIterator it = list.begin();
-
-	for (; it!=list.end(); ++it)
+	for (u32 i=0; i<start->getChildCount(); ++i)
 	{
-		getSceneNodesFromType(type, outNodes, *it);
+		getSceneNodesFromType(type, outNodes, start->getChild(i));
 	}
 }
 
@@ -2440,9 +2817,8 @@ void CSceneManager::writeSceneNode(io::IXMLWriter* writer, ISceneNode* node, ISc
 	}
 	else
 	{
-		ISceneNodeList::ConstIterator it = node->getChildren().begin();
-		for (; it != node->getChildren().end(); ++it)
-			writeSceneNode(writer, (*it), userDataSerializer, currentPath);
+		for (u32 i=0; i<node->getChildCount(); ++i)
+			writeSceneNode(writer, node->getChild(i), userDataSerializer, currentPath);
 	}
 
 	attr->drop();
@@ -2618,6 +2994,13 @@ IMeshWriter* CSceneManager::createMeshWriter(EMESH_WRITER_TYPE type)
 #else
 		return 0;
 #endif
+
+	case EMWT_BINARY_MESH:
+#ifdef _IRR_COMPILE_WITH_BINARY_MESH_WRITER_
+		return new CBinaryMeshWriter(Driver);
+#else
+		return 0;
+#endif
 	}
 
 	return 0;
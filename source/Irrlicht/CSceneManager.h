@@ -123,6 +123,10 @@ namespace scene
 		//! draws all scene nodes
 		virtual void drawAll() _IRR_OVERRIDE_;
 
+		//! draws the scene once for each of several cameras
+		virtual void drawAllViews(const core::array<ICameraSceneNode*>& cameras,
+			const core::array<core::rect<s32> >& viewPorts = core::array<core::rect<s32> >()) _IRR_OVERRIDE_;
+
 		//! Adds a camera scene node to the tree and sets it as active camera.
 		//! \param position: Position of the space relative to its parent where the camera will be placed.
 		//! \param lookat: Position where the camera will look at. Also known as target.
@@ -263,6 +267,15 @@ namespace scene
 			s32 maxLOD=4, E_TERRAIN_PATCH_SIZE patchSize=ETPS_17,s32 smoothFactor=0,
 			bool addAlsoIfHeightmapEmpty=false) _IRR_OVERRIDE_;
 
+		//! Adds a terrain scene node which loads heightmap tiles around the camera.
+		virtual IPagedTerrainSceneNode* addPagedTerrainSceneNode(
+			const io::path& tileFileName, s32 tileSize,
+			ISceneNode* parent=0, s32 id=-1,
+			const core::vector3df& position = core::vector3df(0.0f,0.0f,0.0f),
+			const core::vector3df& scale = core::vector3df(1.0f,1.0f,1.0f),
+			video::SColor vertexColor = video::SColor(255,255,255,255),
+			s32 maxLOD=5, E_TERRAIN_PATCH_SIZE patchSize=ETPS_17, s32 smoothFactor=0) _IRR_OVERRIDE_;
+
 		//! Adds a dummy transformation scene node to the scene graph.
 		virtual IDummyTransformationSceneNode* addDummyTransformationSceneNode(
 			ISceneNode* parent=0, s32 id=-1) _IRR_OVERRIDE_;
@@ -270,6 +283,10 @@ namespace scene
 		//! Adds an empty scene node.
 		virtual ISceneNode* addEmptySceneNode(ISceneNode* parent, s32 id=-1) _IRR_OVERRIDE_;
 
+		//! Merges the static mesh scene nodes of a subtree into a few large mesh buffers.
+		virtual ISceneNode* addStaticBatchSceneNode(ISceneNode* root, f32 cellSize=0.f,
+			s32 id=-1) _IRR_OVERRIDE_;
+
 		//! Returns the root scene node. This is the scene node wich is parent
 		//! of all scene nodes. The root scene node is a special scene node which
 		//! only exists to manage all scene nodes. It is not rendered and cannot
@@ -534,6 +551,21 @@ namespace scene
 		//! clears the deletion list
 		void clearDeletionList();
 
+		//! renders the registered nodes in the order of the render passes
+		void renderPasses();
+
+		//! returns a bit for each view of drawAllViews which can see the node
+		u32 getVisibleViews(const ISceneNode* node) const;
+
+		//! registers a node for all views of drawAllViews which can see it
+		u32 registerNodeForViews(ISceneNode* node, E_SCENE_NODE_RENDER_PASS pass);
+
+		//! loads the binary cache file of a mesh source, if it is up to date
+		IAnimatedMesh* readBinaryMeshCache(const io::path& filename, u32 sourceSize, u32 sourceHash);
+
+		//! writes the binary cache file of a mesh source
+		void writeBinaryMeshCache(const io::path& filename, IAnimatedMesh* mesh, u32 sourceSize, u32 sourceHash);
+
 		//! writes a scene node
 		void writeSceneNode(io::IXMLWriter* writer, ISceneNode* node, ISceneUserDataSerializer* userDataSerializer, const fschar_t* currentPath=0, bool init=false);
 
@@ -575,6 +607,17 @@ namespace scene
 				f64 Distance;
 		};
 
+		//! node registered while drawing several views, with a bit per view which can see it
+		struct ViewNodeEntry
+		{
+			ViewNodeEntry(ISceneNode* n, E_SCENE_NODE_RENDER_PASS pass, u32 views)
+				: Node(n), Pass(pass), Views(views) {}
+
+			ISceneNode* Node;
+			E_SCENE_NODE_RENDER_PASS Pass;
+			u32 Views;
+		};
+
 		//! sort on distance (sphere) to camera
 		struct DistanceNodeEntry
 		{
@@ -624,6 +667,7 @@ namespace scene
 		core::array<DefaultNodeEntry> SolidNodeList;
 		core::array<TransparentNodeEntry> TransparentNodeList;
 		core::array<TransparentNodeEntry> TransparentEffectNodeList;
+		core::array<ViewNodeEntry> ViewNodeList;
 
 		core::array<IMeshLoader*> MeshLoaderList;
 		core::array<ISceneLoader*> SceneLoaderList;
@@ -647,6 +691,10 @@ namespace scene
 
 		E_SCENE_NODE_RENDER_PASS CurrentRenderPass;
 
+		//! cameras of drawAllViews while the nodes register
+		const core::array<ICameraSceneNode*>* ViewCameras;
+		u32 ViewCount;
+
 		//! An optional callbacks manager to allow the user app finer control
 		//! over the scene lighting and rendering.
 		ILightManager* LightManager;
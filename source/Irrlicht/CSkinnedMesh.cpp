@@ -569,7 +569,18 @@ void CSkinnedMesh::skinJoint(SJoint *joint, SJoint *parentJoint)
 		core::matrix4 jointVertexPull(core::matrix4::EM4CONST_NOTHING);
 		jointVertexPull.setbyproduct(joint->GlobalAnimatedMatrix, joint->GlobalInversedMatrix);
 
-		core::vector3df thisVertexMove, thisNormalMove;
+		// pull all vertices of the joint at once
+		const u32 weightCount = joint->Weights.size();
+		JointVertexMoves.set_used(weightCount);
+		jointVertexPull.transformVects(JointVertexMoves.pointer(), &joint->Weights[0].StaticPos,
+			weightCount, sizeof(core::vector3df), sizeof(SWeight));
+
+		if (AnimateNormals)
+		{
+			JointNormalMoves.set_used(weightCount);
+			jointVertexPull.rotateVects(JointNormalMoves.pointer(), &joint->Weights[0].StaticNormal,
+				weightCount, sizeof(core::vector3df), sizeof(SWeight));
+		}
 
 		core::array<scene::IMeshBuffer*> &buffersUsed=*SkinningBuffers;
 
@@ -589,11 +600,8 @@ void CSkinnedMesh::skinJoint(SJoint *joint, SJoint *parentJoint)
 			u8* positionOffset = Vertices + attributeP->getOffset();
 			u8* normalOffset = Vertices + attributeN->getOffset();
 
-			// Pull this vertex...
-			jointVertexPull.transformVect(thisVertexMove, weight.StaticPos);
-
-			if (AnimateNormals)
-				jointVertexPull.rotateVect(thisNormalMove, weight.StaticNormal);
+			const core::vector3df& thisVertexMove = JointVertexMoves[i];
+			const core::vector3df& thisNormalMove = AnimateNormals ? JointNormalMoves[i] : thisVertexMove;
 
 			if (! (*(weight.Moved)) )
 			{
@@ -184,6 +184,10 @@ private:
 
 		core::array< core::array<bool> > Vertices_Moved;
 
+		//! moves of the weights of the joint being skinned
+		core::array<core::vector3df> JointVertexMoves;
+		core::array<core::vector3df> JointNormalMoves;
+
 		core::aabbox3d<f32> BoundingBox;
 
 		f32 AnimationFrames;
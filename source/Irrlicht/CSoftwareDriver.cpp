@@ -227,6 +227,7 @@ bool CSoftwareDriver::beginScene(bool backBuffer, bool zBuffer, SColor color,
 	CNullDriver::beginScene(backBuffer, zBuffer, color, videoData, sourceRect);
 	WindowId=videoData.D3D9.HWnd;
 	SceneSourceRect = sourceRect;
+	PresentArea = core::rect<s32>(core::position2d<s32>(0,0), BackBuffer ? core::dimension2d<s32>(BackBuffer->getDimension()) : core::dimension2d<s32>(0,0));
 
 	if (backBuffer && BackBuffer)
 		BackBuffer->fill(color);
@@ -243,7 +244,17 @@ bool CSoftwareDriver::endScene()
 {
 	CNullDriver::endScene();
 
-	return Presenter->present(BackBuffer, WindowId, SceneSourceRect);
+	// also called for an empty area, the window may need to be drawn again
+	return Presenter->present(BackBuffer, WindowId, SceneSourceRect, &PresentArea);
+}
+
+
+//! sets the part of the screen which changed in the current frame
+void CSoftwareDriver::setPresentArea(const core::rect<s32>& area)
+{
+	PresentArea = area;
+	if (BackBuffer)
+		PresentArea.clipAgainst(core::rect<s32>(core::position2d<s32>(0,0), core::dimension2d<s32>(BackBuffer->getDimension())));
 }
 
 
@@ -387,12 +398,12 @@ void CSoftwareDriver::drawMeshBuffer(const scene::IMeshBuffer* mb)
 		{
 			for (u32 i=0; i < primitiveCount-1; ++i)
 			{
-				core::vector3df* PositionA = (core::vector3df*)OffsetP + vertexSize * indexBuffer->getIndex(i);
-				core::vector3df* PositionB = (core::vector3df*)OffsetP + vertexSize * indexBuffer->getIndex(i + 1);
+				core::vector3df* PositionA = (core::vector3df*)(OffsetP + vertexSize * indexBuffer->getIndex(i));
+				core::vector3df* PositionB = (core::vector3df*)(OffsetP + vertexSize * indexBuffer->getIndex(i + 1));
 
 				if(AttributeC)
 				{
-					SColor* Color = (SColor*)OffsetC + vertexSize * indexBuffer->getIndex(i);
+					SColor* Color = (SColor*)(OffsetC + vertexSize * indexBuffer->getIndex(i));
 
 					draw3DLine(*PositionA, *PositionB, *Color);
 				}
@@ -405,12 +416,12 @@ void CSoftwareDriver::drawMeshBuffer(const scene::IMeshBuffer* mb)
 		{
 			for (u32 i=0; i < primitiveCount-1; ++i)
 			{
-				core::vector3df* PositionA = (core::vector3df*)OffsetP + vertexSize * indexBuffer->getIndex(i);
-				core::vector3df* PositionB = (core::vector3df*)OffsetP + vertexSize * indexBuffer->getIndex(i + 1);
+				core::vector3df* PositionA = (core::vector3df*)(OffsetP + vertexSize * indexBuffer->getIndex(i));
+				core::vector3df* PositionB = (core::vector3df*)(OffsetP + vertexSize * indexBuffer->getIndex(i + 1));
 
 				if(AttributeC)
 				{
-					SColor* Color = (SColor*)OffsetC + vertexSize * indexBuffer->getIndex(i);
+					SColor* Color = (SColor*)(OffsetC + vertexSize * indexBuffer->getIndex(i));
 
 					draw3DLine(*PositionA, *PositionB, *Color);
 				}
@@ -418,12 +429,12 @@ void CSoftwareDriver::drawMeshBuffer(const scene::IMeshBuffer* mb)
 					draw3DLine(*PositionA, *PositionB);
 			}
 
-			core::vector3df* PositionA = (core::vector3df*)OffsetP + vertexSize * indexBuffer->getIndex(primitiveCount - 1);
-			core::vector3df* PositionB = (core::vector3df*)OffsetP + vertexSize * indexBuffer->getIndex(0);
+			core::vector3df* PositionA = (core::vector3df*)(OffsetP + vertexSize * indexBuffer->getIndex(primitiveCount - 1));
+			core::vector3df* PositionB = (core::vector3df*)(OffsetP + vertexSize * indexBuffer->getIndex(0));
 
 			if(AttributeC)
 			{
-				SColor* Color = (SColor*)OffsetC + vertexSize * indexBuffer->getIndex(primitiveCount-1);
+				SColor* Color = (SColor*)(OffsetC + vertexSize * indexBuffer->getIndex(primitiveCount-1));
 
 				draw3DLine(*PositionA, *PositionB, *Color);
 			}
@@ -435,12 +446,12 @@ void CSoftwareDriver::drawMeshBuffer(const scene::IMeshBuffer* mb)
 		{
 			for (u32 i=0; i < 2*primitiveCount; i+=2)
 			{
-				core::vector3df* PositionA = (core::vector3df*)OffsetP + vertexSize * indexBuffer->getIndex(i);
-				core::vector3df* PositionB = (core::vector3df*)OffsetP + vertexSize * indexBuffer->getIndex(i + 1);
+				core::vector3df* PositionA = (core::vector3df*)(OffsetP + vertexSize * indexBuffer->getIndex(i));
+				core::vector3df* PositionB = (core::vector3df*)(OffsetP + vertexSize * indexBuffer->getIndex(i + 1));
 
 				if(AttributeC)
 				{
-					SColor* Color = (SColor*)OffsetC + vertexSize * indexBuffer->getIndex(i);
+					SColor* Color = (SColor*)(OffsetC + vertexSize * indexBuffer->getIndex(i));
 
 					draw3DLine(*PositionA, *PositionB, *Color);
 				}
@@ -48,6 +48,9 @@ namespace video
 		//! presents the rendered scene on the screen, returns false if failed
 		virtual bool endScene() _IRR_OVERRIDE_;
 
+		//! sets the part of the screen which changed in the current frame
+		virtual void setPresentArea(const core::rect<s32>& area) _IRR_OVERRIDE_;
+
 		//! Only used by the internal engine. Used to notify the driver that
 		//! the window was resized.
 		virtual void OnResize(const core::dimension2d<u32>& size) _IRR_OVERRIDE_;
@@ -140,6 +143,7 @@ namespace video
 		video::IImagePresenter* Presenter;
 		void* WindowId;
 		core::rect<s32>* SceneSourceRect;
+		core::rect<s32> PresentArea;
 
 		core::array<S2DVertex> TransformedPoints;
 
@@ -13,6 +13,7 @@
 #include "S3DVertex.h"
 #include "S4DVertex.h"
 #include "CBlit.h"
+#include "CBurningVertexFetch.h"
 
 
 #define MAT_TEXTURE(tex) ( (video::CSoftwareTexture2*) Material.org.getTexture ( tex ) )
@@ -463,6 +464,15 @@ CBurningVideoDriver::~CBurningVideoDriver()
 			BurningShader[i]->drop();
 	}
 
+	for (core::hash_map<u32, IBurningShader*>::Iterator it = Pipelines.getIterator(); !it.atEnd(); ++it)
+	{
+		if (it->getValue())
+			it->getValue()->drop();
+	}
+
+	for (core::hash_map<IVertexDescriptor*, CBurningVertexFetch*>::Iterator it = VertexFetch.getIterator(); !it.atEnd(); ++it)
+		it->getValue()->drop();
+
 	// delete Additional buffer
 	if (StencilBuffer)
 		StencilBuffer->drop();
@@ -587,6 +597,22 @@ void CBurningVideoDriver::setCurrentShader()
 
 	// switchToTriangleRenderer
 	CurrentShader = BurningShader[shader];
+
+	// prefer a pipeline generated for the exact state
+	u32 state;
+	if ( getPipelineState ( shader, state ) )
+	{
+		core::hash_map<u32, IBurningShader*>::Node* node = Pipelines.find ( state );
+		if ( !node )
+		{
+			Pipelines.insert ( state, createTRQuadPipeline ( this, state ) );
+			node = Pipelines.find ( state );
+		}
+
+		if ( node->getValue() )
+			CurrentShader = node->getValue();
+	}
+
 	if ( CurrentShader )
 	{
 		CurrentShader->setZCompareFunc ( Material.org.ZBuffer );
@@ -609,6 +635,77 @@ void CBurningVideoDriver::setCurrentShader()
 
 
 
+/*!
+	maps the material and the shader selected for it to a pipeline state.
+*/
+bool CBurningVideoDriver::getPipelineState ( EBurningFFShader shader, u32 &state ) const
+{
+#ifdef SOFTWARE_DRIVER_2_QUAD_RASTERIZER
+	const SMaterial &m = Material.org;
+	const bool texture1 = m.getTexture(1) != 0;
+
+	// vertex color modulates textures unless the material type ignores lighting
+	bool color = true;
+
+	switch ( shader )
+	{
+		case ETR_GOURAUD:
+			state = BPS_BLEND_SOLID;
+			break;
+		case ETR_TEXTURE_GOURAUD:
+		case ETR_TEXTURE_GOURAUD_NOZ:
+			state = BPS_BLEND_SOLID | BPS_TEXTURE0;
+			break;
+		case ETR_TEXTURE_GOURAUD_ADD:
+			state = BPS_BLEND_ADD | BPS_TEXTURE0;
+			color = false;
+			break;
+		case ETR_TEXTURE_GOURAUD_ALPHA:
+		case ETR_TEXTURE_GOURAUD_ALPHA_NOZ:
+			state = BPS_BLEND_ALPHA_CHANNEL | BPS_TEXTURE0;
+			break;
+		case ETR_TEXTURE_GOURAUD_LIGHTMAP_M1:
+		case ETR_TEXTURE_GOURAUD_LIGHTMAP_M2:
+		case ETR_TEXTURE_GOURAUD_LIGHTMAP_M4:
+		case ETR_TEXTURE_LIGHTMAP_M4:
+			if ( !texture1 )
+				return false;
+			state = BPS_BLEND_SOLID | BPS_TEXTURE0 | BPS_TEXTURE1;
+			if ( shader == ETR_TEXTURE_GOURAUD_LIGHTMAP_M2 )
+				state |= BPS_TEXTURE1_M2;
+			else if ( shader == ETR_TEXTURE_GOURAUD_LIGHTMAP_M4 || shader == ETR_TEXTURE_LIGHTMAP_M4 )
+				state |= BPS_TEXTURE1_M4;
+			color = m.MaterialType == EMT_LIGHTMAP_LIGHTING ||
+					m.MaterialType == EMT_LIGHTMAP_LIGHTING_M2 ||
+					m.MaterialType == EMT_LIGHTMAP_LIGHTING_M4;
+			break;
+		default:
+			return false;
+	}
+
+#ifdef SOFTWARE_DRIVER_2_USE_VERTEX_COLOR
+	if ( color )
+		state |= BPS_COLOR0;
+#endif
+
+	if ( m.ZBuffer != ECFN_DISABLED )
+	{
+		state |= BPS_DEPTH_TEST;
+		if ( m.ZWriteEnable && ( AllowZWriteOnTransparent || ( !m.isTransparent() &&
+			!MaterialRenderers[m.MaterialType].Renderer->isTransparent() ) ) )
+			state |= BPS_DEPTH_WRITE;
+	}
+
+	if ( m.FogEnable )
+		state |= BPS_FOG;
+
+	return true;
+#else
+	return false;
+#endif
+}
+
+
 //! queries the features of the driver, returns true if feature is available
 bool CBurningVideoDriver::queryFeature(E_VIDEO_DRIVER_FEATURE feature) const
 {
@@ -693,6 +790,7 @@ bool CBurningVideoDriver::beginScene(bool backBuffer, bool zBuffer,
 	CNullDriver::beginScene(backBuffer, zBuffer, color, videoData, sourceRect);
 	WindowId = videoData.D3D9.HWnd;
 	SceneSourceRect = sourceRect;
+	PresentArea = core::rect<s32>(core::position2d<s32>(0,0), BackBuffer ? core::dimension2d<s32>(BackBuffer->getDimension()) : core::dimension2d<s32>(0,0));
 
 	if (backBuffer && BackBuffer)
 		BackBuffer->fill(color);
@@ -710,7 +808,17 @@ bool CBurningVideoDriver::endScene()
 {
 	CNullDriver::endScene();
 
-	return Presenter->present(BackBuffer, WindowId, SceneSourceRect);
+	// also called for an empty area, the window may need to be drawn again
+	return Presenter->present(BackBuffer, WindowId, SceneSourceRect, &PresentArea);
+}
+
+
+//! sets the part of the screen which changed in the current frame
+void CBurningVideoDriver::setPresentArea(const core::rect<s32>& area)
+{
+	PresentArea = area;
+	if (BackBuffer)
+		PresentArea.clipAgainst(core::rect<s32>(core::position2d<s32>(0,0), core::dimension2d<s32>(BackBuffer->getDimension())));
 }
 
 
@@ -725,7 +833,11 @@ bool CBurningVideoDriver::setRenderTarget(video::ITexture* texture, bool clearBa
 	}
 
 	if (RenderTargetTexture)
+	{
+		// the shaders fetch from the tiled copy of what was rendered
+		RenderTargetTexture->regenerateMipMapLevels();
 		RenderTargetTexture->drop();
+	}
 
 	RenderTargetTexture = texture;
 
@@ -1181,7 +1293,10 @@ void CBurningVideoDriver::VertexCache_fill(const u32 sourceIndex, const u32 dest
 	u8 * source;
 	s4DVertex *dest;
 
-	source = (u8*) VertexCache.vertices + ( sourceIndex * vSize[VertexCache.vType].Pitch );
+	if ( VertexCache.fetch )
+		source = (u8*) VertexCache.fetch->fetch ( sourceIndex );
+	else
+		source = (u8*) VertexCache.vertices + ( sourceIndex * vSize[VertexCache.vType].Pitch );
 
 	// it's a look ahead so we never hit it..
 	// but give priority...
@@ -1489,17 +1604,36 @@ REALINLINE s4DVertex * CBurningVideoDriver::VertexCache_getVertex ( const u32 so
 }
 
 
+//! returns the source vertex of an index position
+REALINLINE u32 VertexCache_sourceIndex ( const SVertexCache& cache, const u32 position )
+{
+	switch ( cache.iType )
+	{
+		case 1:
+			return ((const u16*) cache.indices) [ position ];
+		case 2:
+			return ((const u32*) cache.indices) [ position ];
+		default:
+			return position;
+	}
+}
+
+
 /*
 	Cache based on linear walk indices
 	fill blockwise on the next 16(Cache_Size) unique vertices in indexlist
 	merge the next 16 vertices with the current
+
+	Primitive assembly: face receives primitiveSize vertices, the unused
+	entries repeat the last one. Fans and loops refer back to their first
+	vertex, which is kept in every cache line.
 */
 REALINLINE void CBurningVideoDriver::VertexCache_get(const s4DVertex ** face)
 {
 	SCacheInfo info[VERTEXCACHE_ELEMENT];
 
 	// next primitive must be complete in cache
-	if (	VertexCache.indicesIndex - VertexCache.indicesRun < 3 &&
+	if (	VertexCache.indicesIndex - VertexCache.indicesRun < VertexCache.primitiveSize &&
 			VertexCache.indicesIndex < VertexCache.indexCount
 		)
 	{
@@ -1514,22 +1648,16 @@ REALINLINE void CBurningVideoDriver::VertexCache_get(const s4DVertex ** face)
 		u32 i;
 		u32 sourceIndex;
 
+		if ( VertexCache.pType == scene::EPT_TRIANGLE_FAN || VertexCache.pType == scene::EPT_LINE_LOOP )
+		{
+			info[fillIndex++].index = VertexCache_sourceIndex ( VertexCache, 0 );
+		}
+
 		while ( VertexCache.indicesIndex < VertexCache.indexCount &&
 				fillIndex < VERTEXCACHE_ELEMENT
 				)
 		{
-			switch ( VertexCache.iType )
-			{
-				case 1:
-					sourceIndex =  ((u16*)VertexCache.indices) [ VertexCache.indicesIndex ];
-					break;
-				case 2:
-					sourceIndex =  ((u32*)VertexCache.indices) [ VertexCache.indicesIndex ];
-					break;
-				case 4:
-					sourceIndex = VertexCache.indicesIndex;
-					break;
-			}
+			sourceIndex = VertexCache_sourceIndex ( VertexCache, VertexCache.indicesIndex );
 
 			VertexCache.indicesIndex += 1;
 
@@ -1589,38 +1717,39 @@ REALINLINE void CBurningVideoDriver::VertexCache_get(const s4DVertex ** face)
 		}
 	}
 
-	const u32 i0 = core::if_c_a_else_0 ( VertexCache.pType != scene::EPT_TRIANGLE_FAN, VertexCache.indicesRun );
+	// index positions of the primitive
+	const u32 run = VertexCache.indicesRun;
+	u32 p0 = run;
+	u32 p1 = run + 1;
+	u32 p2 = run + 2;
 
-	switch ( VertexCache.iType )
+	switch ( VertexCache.pType )
 	{
-		case 1:
-		{
-			const u16 *p = (const u16 *) VertexCache.indices;
-			face[0] = VertexCache_getVertex ( p[ i0    ] );
-			face[1] = VertexCache_getVertex ( p[ VertexCache.indicesRun + 1] );
-			face[2] = VertexCache_getVertex ( p[ VertexCache.indicesRun + 2] );
-		}
-		break;
-
-		case 2:
-		{
-			const u32 *p = (const u32 *) VertexCache.indices;
-			face[0] = VertexCache_getVertex ( p[ i0    ] );
-			face[1] = VertexCache_getVertex ( p[ VertexCache.indicesRun + 1] );
-			face[2] = VertexCache_getVertex ( p[ VertexCache.indicesRun + 2] );
-		}
-		break;
-
-		case 4:
-			face[0] = VertexCache_getVertex ( VertexCache.indicesRun + 0 );
-			face[1] = VertexCache_getVertex ( VertexCache.indicesRun + 1 );
-			face[2] = VertexCache_getVertex ( VertexCache.indicesRun + 2 );
-		break;
+		case scene::EPT_POINTS:
+		case scene::EPT_POINT_SPRITES:
+			p1 = p2 = run;
+			break;
+		case scene::EPT_LINES:
+		case scene::EPT_LINE_STRIP:
+			p2 = p1;
+			break;
+		case scene::EPT_LINE_LOOP:
+			// closing line
+			if ( p1 == VertexCache.indexCount )
+				p1 = 0;
+			p2 = p1;
+			break;
+		case scene::EPT_TRIANGLE_FAN:
+			p0 = 0;
+			break;
 		default:
-			face[0] = face[1] = face[2] = VertexCache_getVertex(VertexCache.indicesRun + 0);
-		break;
+			break;
 	}
 
+	face[0] = VertexCache_getVertex ( VertexCache_sourceIndex ( VertexCache, p0 ) );
+	face[1] = VertexCache_getVertex ( VertexCache_sourceIndex ( VertexCache, p1 ) );
+	face[2] = VertexCache_getVertex ( VertexCache_sourceIndex ( VertexCache, p2 ) );
+
 	VertexCache.indicesRun += VertexCache.primitivePitch;
 }
 
@@ -1684,38 +1813,44 @@ void CBurningVideoDriver::VertexCache_reset ( const void* vertices, u32 vertexCo
 
 	switch ( VertexCache.pType )
 	{
-		// most types here will not work as expected, only triangles/triangle_fan
-		// is known to work.
 		case scene::EPT_POINTS:
 			VertexCache.indexCount = primitiveCount;
+			VertexCache.primitiveSize = 1;
 			VertexCache.primitivePitch = 1;
 			break;
 		case scene::EPT_LINE_STRIP:
 			VertexCache.indexCount = primitiveCount+1;
+			VertexCache.primitiveSize = 2;
 			VertexCache.primitivePitch = 1;
 			break;
 		case scene::EPT_LINE_LOOP:
-			VertexCache.indexCount = primitiveCount+1;
+			VertexCache.indexCount = primitiveCount;
+			VertexCache.primitiveSize = 2;
 			VertexCache.primitivePitch = 1;
 			break;
 		case scene::EPT_LINES:
 			VertexCache.indexCount = 2*primitiveCount;
+			VertexCache.primitiveSize = 2;
 			VertexCache.primitivePitch = 2;
 			break;
 		case scene::EPT_TRIANGLE_STRIP:
 			VertexCache.indexCount = primitiveCount+2;
+			VertexCache.primitiveSize = 3;
 			VertexCache.primitivePitch = 1;
 			break;
 		case scene::EPT_TRIANGLES:
 			VertexCache.indexCount = primitiveCount + primitiveCount + primitiveCount;
+			VertexCache.primitiveSize = 3;
 			VertexCache.primitivePitch = 3;
 			break;
 		case scene::EPT_TRIANGLE_FAN:
 			VertexCache.indexCount = primitiveCount + 2;
+			VertexCache.primitiveSize = 3;
 			VertexCache.primitivePitch = 1;
 			break;
 		case scene::EPT_POINT_SPRITES:
 			VertexCache.indexCount = primitiveCount;
+			VertexCache.primitiveSize = 1;
 			VertexCache.primitivePitch = 1;
 			break;
 	}
@@ -1732,36 +1867,67 @@ void CBurningVideoDriver::drawMeshBuffer(const scene::IMeshBuffer* mb)
 	if (!checkPrimitiveCount(mb->getPrimitiveCount()))
 		return;
 
-	if (mb->getVertexBufferCount() > 1)
-	{
-		os::Printer::log("Software driver can not handle more than one vertex buffer per mesh buffer", ELL_ERROR);
+	CBurningVertexFetch* fetch = getVertexFetch(mb->getVertexDescriptor());
+	if (!fetch)
 		return;
-	}
 
-	scene::IVertexBuffer* vertexBuffer = mb->getVertexBuffer(0);
-	E_VERTEX_TYPE vertexType = EVT_STANDARD;
+	u32 vertexCount;
+	const u32 instanceCount = fetch->bind(mb, vertexCount);
 
 	scene::IIndexBuffer* indexBuffer = mb->getIndexBuffer();
 	const u32 primitiveCount = mb->getPrimitiveCount();
 	const scene::E_PRIMITIVE_TYPE primitiveType = mb->getPrimitiveType();
 
-	// Supported are only built-in Irrlicht vertex formats.
-	switch(vertexBuffer->getVertexSize())
-	{
-	case sizeof(S3DVertex):
-		vertexType = EVT_STANDARD;
-		break;
-	case sizeof(S3DVertex2TCoords):
-		vertexType = EVT_2TCOORDS;
-		break;
-	case sizeof(S3DVertexTangents):
-		vertexType = EVT_TANGENTS;
-		break;
-	default:
-		return;
+	// built-in vertex formats are read in place
+	const void* vertices = 0;
+	if (fetch->isDirect())
+		vertices = fetch->getDirectVertices();
+
+	// instances replace the world matrix
+	core::matrix4 world;
+	if (fetch->hasInstanceTransform())
+		world = Transformation[ETS_WORLD];
+
+	for (u32 i = 0; i != instanceCount; ++i)
+	{
+		fetch->setInstance(i);
+		if (fetch->hasInstanceTransform())
+			setTransform(ETS_WORLD, fetch->getInstanceTransform());
+
+		VertexCache.fetch = vertices ? 0 : fetch;
+		drawVertexPrimitiveList(vertices, vertexCount, indexBuffer->getIndices(), primitiveCount, fetch->getVertexType(), primitiveType, indexBuffer->getType());
+	}
+
+	VertexCache.fetch = 0;
+
+	if (fetch->hasInstanceTransform())
+		setTransform(ETS_WORLD, world);
+}
+
+
+//! returns the compiled vertex fetch of a descriptor
+CBurningVertexFetch* CBurningVideoDriver::getVertexFetch(IVertexDescriptor* descriptor)
+{
+	if (!descriptor)
+		return 0;
+
+	core::hash_map<IVertexDescriptor*, CBurningVertexFetch*>::Node* node = VertexFetch.find(descriptor);
+
+	if (!node)
+	{
+		VertexFetch.insert(descriptor, new CBurningVertexFetch(descriptor));
+		node = VertexFetch.find(descriptor);
+	}
+	else if (!node->getValue()->isCurrent())
+	{
+		node->getValue()->drop();
+		node->getValue() = new CBurningVertexFetch(descriptor);
 	}
 
-	drawVertexPrimitiveList(vertexBuffer->getVertices(), vertexBuffer->getVertexCount(), indexBuffer->getIndices(), primitiveCount, vertexType, primitiveType, indexBuffer->getType());
+	if (!node->getValue()->isValid())
+		return 0;
+
+	return node->getValue();
 }
 
 
@@ -1777,21 +1943,29 @@ void CBurningVideoDriver::drawVertexPrimitiveList(const void* vertices, u32 vert
 	if((iType == EIT_16BIT) && (vertexCount > 65536))
 		os::Printer::log("Too many vertices for 16bit index type, render artifacts may occur.");
 
-	// These calls would lead to crashes due to wrong index usage.
-	// The vertex cache needs to be rewritten for these primitives.
-	if (pType==scene::EPT_POINTS || pType==scene::EPT_LINE_STRIP ||
-		pType==scene::EPT_LINE_LOOP || pType==scene::EPT_LINES ||
-		pType==scene::EPT_TRIANGLE_FAN ||
-		pType==scene::EPT_POINT_SPRITES)
-		return;
-
 	if ( 0 == CurrentShader )
 		return;
 		
 	PrimitivesDrawn += primitiveCount;
+	++DrawCalls;
 
 	VertexCache_reset ( vertices, vertexCount, indexList, primitiveCount, vType, pType, iType );
 
+	switch ( pType )
+	{
+		case scene::EPT_POINTS:
+		case scene::EPT_POINT_SPRITES:
+			drawPrimitivePoints ( primitiveCount );
+			return;
+		case scene::EPT_LINES:
+		case scene::EPT_LINE_STRIP:
+		case scene::EPT_LINE_LOOP:
+			drawPrimitiveLines ( primitiveCount );
+			return;
+		default:
+			break;
+	}
+
 	const s4DVertex * face[3];
 
 	f32 dc_area;
@@ -1936,6 +2110,163 @@ void CBurningVideoDriver::drawVertexPrimitiveList(const void* vertices, u32 vert
 }
 
 
+//! rasterizes points as screen aligned squares of Material.Thickness pixels
+/** Point sprites span their first texture over the square. */
+void CBurningVideoDriver::drawPrimitivePoints ( u32 primitiveCount )
+{
+	const s4DVertex * face[3];
+
+	const bool sprite = VertexCache.pType == scene::EPT_POINT_SPRITES;
+	const f32 size = core::max_ ( Material.org.Thickness, 1.f ) * 0.5f;
+	const f32 isize = core::reciprocal ( size + size );
+
+	const f32 clipX0 = (f32) ViewPort.UpperLeftCorner.X;
+	const f32 clipY0 = (f32) ViewPort.UpperLeftCorner.Y;
+	const f32 clipX1 = (f32) ViewPort.LowerRightCorner.X;
+	const f32 clipY1 = (f32) ViewPort.LowerRightCorner.Y;
+
+	// the square has the same size for all points, so has the mipmap
+	u32 m;
+	video::CSoftwareTexture2* tex;
+	for ( m = 0; m != vSize[VertexCache.vType].TexSize; ++m )
+	{
+		if ( 0 == (tex = MAT_TEXTURE ( m )) )
+		{
+			CurrentShader->setTextureParam(m, 0, 0);
+			continue;
+		}
+
+		s32 lodLevel = 0;
+		if ( sprite && 0 == m )
+			lodLevel = s32_log2_f32 ( tex->getLODFactor ( 1.f ) * isize * isize );
+
+		CurrentShader->setTextureParam(m, tex, lodLevel );
+	}
+
+	u32 i;
+	u32 g;
+	for ( i = 0; i < primitiveCount; ++i )
+	{
+		VertexCache_get(face);
+
+		if ( ( face[0]->flag & VERTEX4D_CLIPMASK ) != VERTEX4D_INSIDE )
+			continue;
+
+		const sVec4 center = ( face[0] + 1 )->Pos;
+
+		// clip the square to the viewport
+		const f32 x0 = core::max_ ( center.x - size, clipX0 );
+		const f32 y0 = core::max_ ( center.y - size, clipY0 );
+		const f32 x1 = core::min_ ( center.x + size, clipX1 );
+		const f32 y1 = core::min_ ( center.y + size, clipY1 );
+
+		if ( x0 >= x1 || y0 >= y1 )
+			continue;
+
+		// corners clockwise from the upper left
+		for ( g = 0; g != 8; g += 2 )
+		{
+			irr::memcpy32_small ( CurrentOut.data + g, face[0], SIZEOF_SVERTEX * 2 );
+		}
+
+		CurrentOut.data[1].Pos.x = x0; CurrentOut.data[1].Pos.y = y0;
+		CurrentOut.data[3].Pos.x = x1; CurrentOut.data[3].Pos.y = y0;
+		CurrentOut.data[5].Pos.x = x1; CurrentOut.data[5].Pos.y = y1;
+		CurrentOut.data[7].Pos.x = x0; CurrentOut.data[7].Pos.y = y1;
+
+		if ( sprite )
+		{
+			for ( g = 0; g != 8; g += 2 )
+			{
+				CurrentOut.data[g].Tex[0].x = ( CurrentOut.data[g + 1].Pos.x - center.x + size ) * isize;
+				CurrentOut.data[g].Tex[0].y = ( CurrentOut.data[g + 1].Pos.y - center.y + size ) * isize;
+			}
+		}
+
+		for ( m = 0; m != vSize[VertexCache.vType].TexSize; ++m )
+		{
+			if ( (tex = MAT_TEXTURE ( m )) )
+				select_polygon_mipmap ( CurrentOut.data, 8, m, tex->getSize() );
+		}
+
+		// rasterize
+		CurrentShader->drawTriangle ( CurrentOut.data + 1, CurrentOut.data + 3, CurrentOut.data + 5 );
+		CurrentShader->drawTriangle ( CurrentOut.data + 1, CurrentOut.data + 5, CurrentOut.data + 7 );
+	}
+}
+
+
+//! rasterizes lines with the wire shader
+void CBurningVideoDriver::drawPrimitiveLines ( u32 primitiveCount )
+{
+	const s4DVertex * face[3];
+
+	IBurningShader * line;
+	line = BurningShader [ ETR_TEXTURE_GOURAUD_WIRE ];
+	line->setRenderTarget(RenderTargetSurface, ViewPort);
+
+	u32 i;
+	u32 g;
+	for ( i = 0; i < primitiveCount; ++i )
+	{
+		VertexCache_get(face);
+
+		// if fully outside on same side
+		if ( ( (face[0]->flag | face[1]->flag) & VERTEX4D_CLIPMASK ) != VERTEX4D_INSIDE )
+			continue;
+
+		irr::memcpy32_small ( CurrentOut.data + 0, face[0], SIZEOF_SVERTEX * 2 );
+		irr::memcpy32_small ( CurrentOut.data + 2, face[1], SIZEOF_SVERTEX * 2 );
+
+		const u32 flag = CurrentOut.data->flag & VERTEX4D_FORMAT_MASK;
+
+		for ( g = 0; g != CurrentOut.ElementSize; ++g )
+		{
+			CurrentOut.data[g].flag = flag;
+			Temp.data[g].flag = flag;
+		}
+
+		drawClippedLine ( line, 0 );
+	}
+}
+
+
+//! clips, projects and rasterizes the line CurrentOut.data[0] - CurrentOut.data[2]
+/** \param color replaces the vertex colors if set */
+void CBurningVideoDriver::drawClippedLine ( IBurningShader* line, const SColor* color )
+{
+	u32 g;
+	u32 vOut;
+
+	// vertices count per line
+	vOut = clipToFrustum ( CurrentOut.data, Temp.data, 2 );
+	if ( vOut < 2 )
+		return;
+
+	vOut <<= 1;
+
+	// to DC Space, project homogenous vertex
+	ndc_2_dc_and_project ( CurrentOut.data + 1, CurrentOut.data, vOut );
+
+	// unproject vertex color
+#ifdef SOFTWARE_DRIVER_2_USE_VERTEX_COLOR
+	for ( g = 0; g != vOut; g+= 2 )
+	{
+		if ( color )
+			CurrentOut.data[ g + 1].Color[0].setA8R8G8B8 ( color->color );
+		else
+			CurrentOut.data[ g + 1].Color[0] = CurrentOut.data[ g ].Color[0];
+	}
+#endif
+
+	for ( g = 0; g <= vOut - 4; g += 2 )
+	{
+		// rasterize
+		line->drawLine ( CurrentOut.data + 1, CurrentOut.data + g + 3 );
+	}
+}
+
+
 //! Sets the dynamic ambient light color. The default color is
 //! (0,0,0,0) which means it is dark.
 //! \param color: New color of the ambient light.
@@ -2276,11 +2607,33 @@ void CBurningVideoDriver::draw2DImage(const video::ITexture* texture, const core
 			return;
 		}
 
+	// the blitter doesn't clip, so the source is cut like the destination
+	core::rect<s32> dest(destRect);
+	core::rect<s32> source(sourceRect);
+	if (clipRect)
+	{
+		dest.clipAgainst(*clipRect);
+		if (dest.getWidth() <= 0 || dest.getHeight() <= 0)
+			return;
+
+		if (dest != destRect && destRect.getWidth() > 0 && destRect.getHeight() > 0)
+		{
+			const f32 sx = (f32)sourceRect.getWidth() / destRect.getWidth();
+			const f32 sy = (f32)sourceRect.getHeight() / destRect.getHeight();
+			source.UpperLeftCorner.X += core::round32((dest.UpperLeftCorner.X - destRect.UpperLeftCorner.X) * sx);
+			source.UpperLeftCorner.Y += core::round32((dest.UpperLeftCorner.Y - destRect.UpperLeftCorner.Y) * sy);
+			source.LowerRightCorner.X -= core::round32((destRect.LowerRightCorner.X - dest.LowerRightCorner.X) * sx);
+			source.LowerRightCorner.Y -= core::round32((destRect.LowerRightCorner.Y - dest.LowerRightCorner.Y) * sy);
+			if (source.getWidth() <= 0 || source.getHeight() <= 0)
+				return;
+		}
+	}
+
 	if (useAlphaChannelOfTexture)
-		StretchBlit(BLITTER_TEXTURE_ALPHA_BLEND, RenderTargetSurface, &destRect, &sourceRect,
+		StretchBlit(BLITTER_TEXTURE_ALPHA_BLEND, RenderTargetSurface, &dest, &source,
 			    ((CSoftwareTexture2*)texture)->getImage(), (colors ? colors[0].color : 0));
 	else
-		StretchBlit(BLITTER_TEXTURE, RenderTargetSurface, &destRect, &sourceRect,
+		StretchBlit(BLITTER_TEXTURE, RenderTargetSurface, &dest, &source,
 			    ((CSoftwareTexture2*)texture)->getImage(), (colors ? colors[0].color : 0));
 	}
 }
@@ -2492,7 +2845,6 @@ void CBurningVideoDriver::draw3DLine(const core::vector3df& start,
 	Transformation [ ETS_CURRENT].transformVect ( &CurrentOut.data[2].Pos.x, end );
 
 	u32 g;
-	u32 vOut;
 
 	// no clipping flags
 	for ( g = 0; g != CurrentOut.ElementSize; ++g )
@@ -2501,34 +2853,11 @@ void CBurningVideoDriver::draw3DLine(const core::vector3df& start,
 		Temp.data[g].flag = 0;
 	}
 
-	// vertices count per line
-	vOut = clipToFrustum ( CurrentOut.data, Temp.data, 2 );
-	if ( vOut < 2 )
-		return;
-
-	vOut <<= 1;
-
 	IBurningShader * line;
 	line = BurningShader [ ETR_TEXTURE_GOURAUD_WIRE ];
 	line->setRenderTarget(RenderTargetSurface, ViewPort);
 
-	// to DC Space, project homogenous vertex
-	ndc_2_dc_and_project ( CurrentOut.data + 1, CurrentOut.data, vOut );
-
-	// unproject vertex color
-#ifdef SOFTWARE_DRIVER_2_USE_VERTEX_COLOR
-	for ( g = 0; g != vOut; g+= 2 )
-	{
-		CurrentOut.data[ g + 1].Color[0].setA8R8G8B8 ( color.color );
-	}
-#endif
-
-
-	for ( g = 0; g <= vOut - 4; g += 2 )
-	{
-		// rasterize
-		line->drawLine ( CurrentOut.data + 1, CurrentOut.data + g + 3 );
-	}
+	drawClippedLine ( line, &color );
 }
 
 
@@ -12,11 +12,14 @@
 #include "os.h"
 #include "irrString.h"
 #include "SIrrCreationParameters.h"
+#include "irrHashMap.h"
 
 namespace irr
 {
 namespace video
 {
+	class CBurningVertexFetch;
+
 	class CBurningVideoDriver : public CNullDriver
 	{
 	public:
@@ -51,6 +54,9 @@ namespace video
 		//! presents the rendered scene on the screen, returns false if failed
 		virtual bool endScene() _IRR_OVERRIDE_;
 
+		//! sets the part of the screen which changed in the current frame
+		virtual void setPresentArea(const core::rect<s32>& area) _IRR_OVERRIDE_;
+
 		//! Only used by the internal engine. Used to notify the driver that
 		//! the window was resized.
 		virtual void OnResize(const core::dimension2d<u32>& size) _IRR_OVERRIDE_;
@@ -185,6 +191,7 @@ namespace video
 
 		void* WindowId;
 		core::rect<s32>* SceneSourceRect;
+		core::rect<s32> PresentArea;
 
 		video::ITexture* RenderTargetTexture;
 		video::IImage* RenderTargetSurface;
@@ -196,6 +203,18 @@ namespace video
 		IBurningShader* CurrentShader;
 		IBurningShader* BurningShader[ETR2_COUNT];
 
+		//! returns the eBurningPipelineState for the current material and a legacy shader, false if none fits
+		bool getPipelineState ( EBurningFFShader shader, u32 &state ) const;
+
+		//! pipelines created so far by eBurningPipelineState, 0 for states without one
+		core::hash_map<u32, IBurningShader*> Pipelines;
+
+		//! returns the compiled vertex fetch of a descriptor
+		CBurningVertexFetch* getVertexFetch ( IVertexDescriptor* descriptor );
+
+		//! vertex fetches compiled so far by descriptor
+		core::hash_map<IVertexDescriptor*, CBurningVertexFetch*> VertexFetch;
+
 		IDepthBuffer* DepthBuffer;
 		IStencilBuffer* StencilBuffer;
 
@@ -245,6 +264,11 @@ namespace video
 		void VertexCache_fill ( const u32 sourceIndex,const u32 destIndex );
 		s4DVertex * VertexCache_getVertex ( const u32 sourceIndex );
 
+		// primitive assembly of points and lines
+		void drawPrimitivePoints ( u32 primitiveCount );
+		void drawPrimitiveLines ( u32 primitiveCount );
+		void drawClippedLine ( IBurningShader* line, const SColor* color );
+
 
 		// culling & clipping
 		u32 clipToHyperPlane ( s4DVertex * dest, const s4DVertex * source, u32 inCount, const sVec4 &plane );
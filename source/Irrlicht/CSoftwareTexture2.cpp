@@ -18,7 +18,7 @@ namespace video
 //! constructor
 CSoftwareTexture2::CSoftwareTexture2(IImage* image, const io::path& name,
 		u32 flags, void* mipmapData)
-		: ITexture(name), MipMapLOD(0), Flags ( flags ), OriginalFormat(video::ECF_UNKNOWN)
+		: ITexture(name), LockMode(ETLM_READ_WRITE), MipMapLOD(0), Flags ( flags ), OriginalFormat(video::ECF_UNKNOWN)
 {
 	#ifdef _DEBUG
 	setDebugName("CSoftwareTexture2");
@@ -35,6 +35,10 @@ CSoftwareTexture2::CSoftwareTexture2(IImage* image, const io::path& name,
 	IsRenderTarget = (Flags & IS_RENDERTARGET) != 0;
 
 	memset32 ( MipMap, 0, sizeof ( MipMap ) );
+#ifdef SOFTWARE_DRIVER_2_TEXTURE_TILES
+	memset32 ( Tiles, 0, sizeof ( Tiles ) );
+	memset32 ( TilePitchLog2, 0, sizeof ( TilePitchLog2 ) );
+#endif
 
 	if (image)
 	{
@@ -102,6 +106,9 @@ CSoftwareTexture2::~CSoftwareTexture2()
 	{
 		if ( MipMap[i] )
 			MipMap[i]->drop();
+#ifdef SOFTWARE_DRIVER_2_TEXTURE_TILES
+		delete [] Tiles[i];
+#endif
 	}
 }
 
@@ -111,7 +118,10 @@ CSoftwareTexture2::~CSoftwareTexture2()
 void CSoftwareTexture2::regenerateMipMapLevels(void* mipmapData)
 {
 	if ( !hasMipMaps () )
+	{
+		updateTiles ( 0 );
 		return;
+	}
 
 	s32 i;
 
@@ -168,6 +178,70 @@ void CSoftwareTexture2::regenerateMipMapLevels(void* mipmapData)
 			MipMap[0]->copyToScalingBoxFilter( MipMap[i], 0, false );
 		}
 	}
+
+	for ( i = 0; i < SOFTWARE_DRIVER_2_MIPMAPPING_MAX; ++i )
+		updateTiles ( i );
+}
+
+
+//! returns the texels of a mipmap level in the layout the shaders fetch from
+void* CSoftwareTexture2::getTexels(u32 level, u32& pitchlog2) const
+{
+	if ( !( Flags & GEN_MIPMAP ) )
+		level = 0;
+
+#ifdef SOFTWARE_DRIVER_2_TEXTURE_TILES
+	if ( Tiles[level] )
+	{
+		pitchlog2 = TilePitchLog2[level];
+		return Tiles[level];
+	}
+#endif
+	pitchlog2 = s32_log2_s32 ( MipMap[level]->getPitch() );
+	return MipMap[level]->lock();
+}
+
+
+//! copies a mipmap level into its tiled copy
+void CSoftwareTexture2::updateTiles(u32 level)
+{
+#ifdef SOFTWARE_DRIVER_2_TEXTURE_TILES
+	CImage* image = MipMap[level];
+	if ( !image )
+		return;
+
+	const core::dimension2d<u32>& dim = image->getDimension();
+	const u32 tileSize = 1 << SOFTWARE_DRIVER_2_TEXTURE_TILE_LOG2;
+
+	// a row of tiles covers a power of two of texels, so it is addressed by shift
+	u32 width = tileSize;
+	while ( width < dim.Width )
+		width <<= 1;
+	const u32 height = ( dim.Height + tileSize - 1 ) & ~( tileSize - 1 );
+
+	// level sizes don't change, so the tiles are allocated once
+	if ( !Tiles[level] )
+	{
+		const u32 bytes = ( width * height ) << VIDEO_SAMPLE_GRANULARITY;
+		Tiles[level] = new u8 [ bytes ];
+		memset32 ( Tiles[level], 0, bytes );
+		TilePitchLog2[level] = s32_log2_s32 ( width << ( SOFTWARE_DRIVER_2_TEXTURE_TILE_LOG2 + VIDEO_SAMPLE_GRANULARITY ) );
+	}
+
+	const u8* src = (const u8*) image->lock();
+	const u32 pitch = image->getPitch();
+
+	for ( u32 y = 0; y < dim.Height; ++y )
+	{
+		const tVideoSample* line = (const tVideoSample*) ( src + y * pitch );
+		u8* dst = Tiles[level] + texelRowOffset ( y, TilePitchLog2[level] );
+
+		for ( u32 x = 0; x < dim.Width; ++x )
+			*(tVideoSample*) ( dst + texelColumnOffset ( x ) ) = line[x];
+	}
+
+	image->unlock();
+#endif
 }
 
 
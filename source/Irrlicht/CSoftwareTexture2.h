@@ -45,6 +45,7 @@ public:
 			Pitch = MipMap[MipMapLOD]->getPitch();
 		}
 
+		LockMode = mode;
 		return MipMap[MipMapLOD]->lock();
 	}
 
@@ -52,6 +53,9 @@ public:
 	virtual void unlock() _IRR_OVERRIDE_
 	{
 		MipMap[MipMapLOD]->unlock();
+
+		if (LockMode != ETLM_READ_ONLY)
+			updateTiles(MipMapLOD);
 	}
 
 	//! Returns the size of the largest mipmap.
@@ -73,15 +77,38 @@ public:
 		return MipMap[MipMapLOD];
 	}
 
+	//! returns a mipmap level without changing the locked level, 0 if it doesn't exist
+	CImage* getMipMapLevel(u32 level) const
+	{
+		return level < SOFTWARE_DRIVER_2_MIPMAPPING_MAX ? MipMap[level] : 0;
+	}
+
 	//! Regenerates the mip map levels of the texture. Useful after locking and
 	//! modifying the texture
 	virtual void regenerateMipMapLevels(void* mipmapData=0) _IRR_OVERRIDE_;
 
+	//! returns the texels of a mipmap level in the layout the shaders fetch from
+	/** This is the tiled copy of the level with SOFTWARE_DRIVER_2_TEXTURE_TILES
+	and the level itself otherwise. pitchlog2 receives the log2 of the bytes per
+	row of tiles or texels. */
+	void* getTexels(u32 level, u32& pitchlog2) const;
+
 private:
+
+	//! copies a mipmap level into its tiled copy
+	void updateTiles(u32 level);
+
 	f32 OrigImageDataSizeInPixels;
 
 	CImage * MipMap[SOFTWARE_DRIVER_2_MIPMAPPING_MAX];
 
+#ifdef SOFTWARE_DRIVER_2_TEXTURE_TILES
+	u8* Tiles[SOFTWARE_DRIVER_2_MIPMAPPING_MAX];
+	u32 TilePitchLog2[SOFTWARE_DRIVER_2_MIPMAPPING_MAX];
+#endif
+
+	E_TEXTURE_LOCK_MODE LockMode;
+
 	u32 MipMapLOD;
 	u32 Flags;
 	ECOLOR_FORMAT OriginalFormat;
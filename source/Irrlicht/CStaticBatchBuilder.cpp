@@ -0,0 +1,238 @@
+// Copyright (C) 2002-2012 Nikolaus Gebhardt
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#include "CStaticBatchBuilder.h"
+#include "ISceneManager.h"
+#include "IMeshManipulator.h"
+#include "IVideoDriver.h"
+#include "IMaterialRenderer.h"
+#include "CMeshBuffer.h"
+#include "SMesh.h"
+#include "os.h"
+
+namespace irr
+{
+namespace scene
+{
+
+//! constructor
+CStaticBatchBuilder::CStaticBatchBuilder(ISceneManager* mgr, f32 cellSize)
+	: SceneManager(mgr), CellSize(cellSize)
+{
+}
+
+
+//! destructor
+CStaticBatchBuilder::~CStaticBatchBuilder()
+{
+	for (u32 i = 0; i < Batches.size(); ++i)
+		Batches[i].Buffer->drop();
+}
+
+
+//! collects the static mesh scene nodes of a subtree
+void CStaticBatchBuilder::collect(ISceneNode* root)
+{
+	if (!root || !root->isVisible())
+		return;
+
+	root->updateAbsolutePosition();
+
+	// nodes below animated nodes move, they can't be merged
+	if (!root->getAnimators().empty())
+		return;
+
+	// a node can only be hidden if all its visible children were merged
+	bool children = true;
+
+	for (u32 i = 0; i < root->getChildCount(); ++i)
+	{
+		ISceneNode* child = root->getChild(i);
+		if (!child->isVisible())
+			continue;
+
+		const u32 before = Nodes.size();
+		collect(child);
+		children &= Nodes.size() > before && Nodes.getLast() == child;
+	}
+
+	// the children were added before the node, so that the node is last
+	if (children && root->getType() == ESNT_MESH && isBatchable(static_cast<IMeshSceneNode*>(root)))
+	{
+		IMeshSceneNode* node = static_cast<IMeshSceneNode*>(root);
+		IMesh* mesh = node->getMesh();
+
+		for (u32 i = 0; i < mesh->getMeshBufferCount(); ++i)
+		{
+			IMeshBuffer* mb = mesh->getMeshBuffer(i);
+			add(mb, node->isReadOnlyMaterials() ? mb->getMaterial() : node->getMaterial(i),
+				node->getAbsoluteTransformation());
+		}
+
+		Nodes.push_back(root);
+	}
+}
+
+
+//! adds the batches to the scene and hides the batched nodes
+ISceneNode* CStaticBatchBuilder::build(s32 id)
+{
+	if (Batches.empty())
+		return 0;
+
+	ISceneNode* group = SceneManager->addEmptySceneNode(0, id);
+
+	// one mesh per cell, culled by its own box
+	core::array<bool> done;
+	done.set_used(Batches.size());
+	for (u32 i = 0; i < done.size(); ++i)
+		done[i] = false;
+
+	for (u32 i = 0; i < Batches.size(); ++i)
+	{
+		if (done[i])
+			continue;
+
+		SMesh* mesh = new SMesh();
+
+		for (u32 j = i; j < Batches.size(); ++j)
+		{
+			if (done[j] || Batches[j].Cell[0] != Batches[i].Cell[0] ||
+				Batches[j].Cell[1] != Batches[i].Cell[1] || Batches[j].Cell[2] != Batches[i].Cell[2])
+				continue;
+
+			IMeshBuffer* mb = Batches[j].Buffer;
+			mb->recalculateBoundingBox();
+			mb->setHardwareMappingHint(EHM_STATIC);
+			mesh->addMeshBuffer(mb);
+			done[j] = true;
+		}
+
+		mesh->recalculateBoundingBox();
+		SceneManager->addMeshSceneNode(mesh, group);
+		mesh->drop();
+	}
+
+	for (u32 i = 0; i < Nodes.size(); ++i)
+		Nodes[i]->setVisible(false);
+
+	os::Printer::log("Merged static nodes", core::stringc(Nodes.size()) + " nodes into " +
+		core::stringc(Batches.size()) + " batches", ELL_INFORMATION);
+
+	return group;
+}
+
+
+//! returns true if all mesh buffers of the node can be merged
+bool CStaticBatchBuilder::isBatchable(IMeshSceneNode* node) const
+{
+	IMesh* mesh = node->getMesh();
+	if (!mesh || !mesh->getMeshBufferCount())
+		return false;
+
+	video::IVideoDriver* driver = SceneManager->getVideoDriver();
+
+	for (u32 i = 0; i < mesh->getMeshBufferCount(); ++i)
+	{
+		const IMeshBuffer* mb = mesh->getMeshBuffer(i);
+		if (!mb || !mb->isVertexBufferCompatible() ||
+			mb->getVertexBuffer(0)->getVertexCount() > 65536)
+			return false;
+
+		// only the built-in vertex layouts can be merged
+		IMeshBuffer* buffer = createMeshBuffer(mb);
+		if (!buffer)
+			return false;
+		buffer->drop();
+
+		// transparent buffers are sorted by distance, merging them would break that
+		const video::SMaterial& material = node->isReadOnlyMaterials() ? mb->getMaterial() : node->getMaterial(i);
+		const video::IMaterialRenderer* rnd = driver->getMaterialRenderer(material.MaterialType);
+		if ((rnd && rnd->isTransparent()) || material.isTransparent())
+			return false;
+	}
+
+	return true;
+}
+
+
+//! creates an empty mesh buffer of the vertex type of another one
+IMeshBuffer* CStaticBatchBuilder::createMeshBuffer(const IMeshBuffer* mb) const
+{
+	if (mb->getVertexBufferCount() != 1)
+		return 0;
+
+	switch (mb->getVertexBuffer(0)->getVertexSize())
+	{
+	case sizeof(video::S3DVertex):
+		return new CMeshBuffer<video::S3DVertex>(mb->getVertexDescriptor(), video::EIT_16BIT);
+	case sizeof(video::S3DVertex2TCoords):
+		return new CMeshBuffer<video::S3DVertex2TCoords>(mb->getVertexDescriptor(), video::EIT_16BIT);
+	case sizeof(video::S3DVertexTangents):
+		return new CMeshBuffer<video::S3DVertexTangents>(mb->getVertexDescriptor(), video::EIT_16BIT);
+	default:
+		return 0;
+	}
+}
+
+
+//! appends a mesh buffer to the batch of its cell and material
+void CStaticBatchBuilder::add(IMeshBuffer* mb, const video::SMaterial& material, const core::matrix4& transform)
+{
+	// world space copy
+	IMeshBuffer* copy = createMeshBuffer(mb);
+	copy->append(mb);
+	SceneManager->getMeshManipulator()->transform(copy, transform);
+
+	s32 cell[3] = { 0, 0, 0 };
+	if (CellSize > 0.f)
+	{
+		const core::vector3df center = copy->getBoundingBox().getCenter();
+		cell[0] = core::floor32(center.X / CellSize);
+		cell[1] = core::floor32(center.Y / CellSize);
+		cell[2] = core::floor32(center.Z / CellSize);
+	}
+
+	const u32 vertexCount = copy->getVertexBuffer(0)->getVertexCount();
+
+	SBatch* batch = 0;
+	for (u32 i = 0; i < Batches.size() && !batch; ++i)
+	{
+		SBatch& b = Batches[i];
+		if (!b.Closed && b.Cell[0] == cell[0] && b.Cell[1] == cell[1] && b.Cell[2] == cell[2] &&
+			b.Buffer->getVertexDescriptor() == mb->getVertexDescriptor() &&
+			b.Buffer->getVertexBuffer(0)->getVertexSize() == mb->getVertexBuffer(0)->getVertexSize() &&
+			b.Buffer->getMaterial() == material)
+			batch = &b;
+	}
+
+	// keep the batches addressable by 16 bit indices
+	if (batch && batch->Buffer->getVertexBuffer(0)->getVertexCount() + vertexCount > 65536)
+	{
+		batch->Closed = true;
+		batch = 0;
+	}
+
+	if (!batch)
+	{
+		SBatch b;
+		b.Cell[0] = cell[0];
+		b.Cell[1] = cell[1];
+		b.Cell[2] = cell[2];
+		b.Buffer = createMeshBuffer(mb);
+		b.Buffer->getMaterial() = material;
+		b.Closed = false;
+
+		Batches.push_back(b);
+		batch = &Batches.getLast();
+	}
+
+	batch->Buffer->append(copy);
+	copy->drop();
+}
+
+
+} // end namespace scene
+} // end namespace irr
+
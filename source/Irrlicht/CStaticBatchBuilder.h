@@ -0,0 +1,75 @@
+// Copyright (C) 2002-2012 Nikolaus Gebhardt
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#ifndef __C_STATIC_BATCH_BUILDER_H_INCLUDED__
+#define __C_STATIC_BATCH_BUILDER_H_INCLUDED__
+
+#include "ISceneNode.h"
+#include "IMeshSceneNode.h"
+#include "IMeshBuffer.h"
+#include "irrArray.h"
+
+namespace irr
+{
+namespace scene
+{
+	class ISceneManager;
+
+	//! Merges the mesh buffers of static mesh scene nodes into world space batches
+	/** Mesh buffers with the same material and vertex descriptor within the
+	same cell of a grid are appended to one 16 bit indexed buffer, transformed
+	by the absolute transformation of their node. All batches of a cell are
+	drawn by one mesh scene node, so that each cell is culled by its own
+	bounding box. */
+	class CStaticBatchBuilder
+	{
+	public:
+
+		//! constructor
+		/** \param cellSize Edge length of the grid cells, 0 for a single cell. */
+		CStaticBatchBuilder(ISceneManager* mgr, f32 cellSize);
+
+		//! destructor
+		~CStaticBatchBuilder();
+
+		//! collects the static mesh scene nodes of a subtree
+		void collect(ISceneNode* root);
+
+		//! adds the batches to the scene and hides the batched nodes
+		/** The batches are in world space, so they are added below the root scene node.
+		\return Parent node of the batches, 0 if nothing was batched. */
+		ISceneNode* build(s32 id);
+
+	private:
+
+		struct SBatch
+		{
+			s32 Cell[3];
+			IMeshBuffer* Buffer;
+
+			//! buffer is full, no more buffers are appended
+			bool Closed;
+		};
+
+		//! returns true if all mesh buffers of the node can be merged
+		bool isBatchable(IMeshSceneNode* node) const;
+
+		//! creates an empty mesh buffer of the vertex type of another one
+		IMeshBuffer* createMeshBuffer(const IMeshBuffer* mb) const;
+
+		//! appends a mesh buffer to the batch of its cell and material
+		void add(IMeshBuffer* mb, const video::SMaterial& material, const core::matrix4& transform);
+
+		ISceneManager* SceneManager;
+		f32 CellSize;
+
+		core::array<SBatch> Batches;
+		core::array<ISceneNode*> Nodes;
+	};
+
+} // end namespace scene
+} // end namespace irr
+
+#endif
+
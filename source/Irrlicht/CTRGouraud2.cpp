@@ -3,7 +3,7 @@
 // For conditions of distribution and use, see copyright notice in irrlicht.h
 
 #include "IrrCompileConfig.h"
-#include "IBurningShader.h"
+#include "IBurningQuadShader.h"
 
 #ifdef _IRR_COMPILE_WITH_BURNINGSVIDEO_
 
@@ -75,6 +75,61 @@ namespace irr
 namespace video
 {
 
+#ifdef SOFTWARE_DRIVER_2_QUAD_RASTERIZER
+
+class CTRGouraud2 : public IBurningQuadShader
+{
+public:
+
+	//! constructor
+	CTRGouraud2(CBurningVideoDriver* driver);
+
+protected:
+	virtual void shadeQuad ( sQuadFragment &quad ) _IRR_OVERRIDE_;
+
+};
+
+//! constructor
+CTRGouraud2::CTRGouraud2(CBurningVideoDriver* driver)
+: IBurningQuadShader(driver, QUAD_DEPTH_TEST | QUAD_DEPTH_WRITE
+#ifdef IPOL_C0
+	| QUAD_COLOR0
+#endif
+	)
+{
+	#ifdef _DEBUG
+	setDebugName("CTRGouraud2");
+	#endif
+}
+
+
+/*!
+*/
+void CTRGouraud2::shadeQuad ( sQuadFragment &quad )
+{
+#ifdef IPOL_C0
+	tFixPoint r0, g0, b0;
+#endif
+
+	for ( u32 i = 0; i != 4; ++i )
+	{
+		if ( 0 == ( quad.mask & ( 1 << i ) ) )
+			continue;
+
+#ifdef IPOL_C0
+		r0 = tofix ( quad.r[i], COLOR_MAX * FIX_POINT_F32_MUL );
+		g0 = tofix ( quad.g[i], COLOR_MAX * FIX_POINT_F32_MUL );
+		b0 = tofix ( quad.b[i], COLOR_MAX * FIX_POINT_F32_MUL );
+
+		quad.dst[quad.offset ( i )] = fix_to_color ( r0, g0, b0 );
+#else
+		quad.dst[quad.offset ( i )] = COLOR_BRIGHT_WHITE;
+#endif
+	}
+}
+
+#else
+
 class CTRGouraud2 : public IBurningShader
 {
 public:
@@ -616,6 +671,7 @@ void CTRGouraud2::drawTriangle ( const s4DVertex *a,const s4DVertex *b,const s4D
 
 }
 
+#endif // SOFTWARE_DRIVER_2_QUAD_RASTERIZER
 
 } // end namespace video
 } // end namespace irr
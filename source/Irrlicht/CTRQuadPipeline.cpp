@@ -0,0 +1,350 @@
+// Copyright (C) 2002-2012 Nikolaus Gebhardt / Thomas Alten
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#include "IrrCompileConfig.h"
+#include "IBurningQuadShader.h"
+
+#if defined ( _IRR_COMPILE_WITH_BURNINGSVIDEO_ ) && defined ( SOFTWARE_DRIVER_2_QUAD_RASTERIZER )
+
+#include "CSoftwareDriver2.h"
+
+namespace irr
+{
+
+namespace video
+{
+
+namespace
+{
+	// samples a texel with alpha, the point sampler works on unsigned values
+	REALINLINE void getSample_texture_alpha ( tFixPoint &a, tFixPoint &r, tFixPoint &g, tFixPoint &b,
+						const sInternalTexture * t, const tFixPointu tx, const tFixPointu ty )
+	{
+#ifdef SOFTWARE_DRIVER_2_BILINEAR
+		getSample_texture ( a, r, g, b, t, tx, ty );
+#else
+		getSample_texture ( (tFixPointu&) a, (tFixPointu&) r, (tFixPointu&) g, (tFixPointu&) b, t, tx, ty );
+#endif
+	}
+}
+
+
+//! fragment pipeline specialised for a combination of eBurningPipelineState
+/** All state tests are on compile time constants, so every instance only
+contains the code of its own state. */
+template <u32 STATE>
+class CTRQuadPipeline : public IBurningQuadShader
+{
+public:
+
+	//! constructor
+	CTRQuadPipeline(CBurningVideoDriver* driver);
+
+	virtual void setParam ( u32 index, f32 value) _IRR_OVERRIDE_;
+	virtual void setMaterial ( const SBurningShaderMaterial &material ) _IRR_OVERRIDE_;
+
+protected:
+	virtual void shadeQuad ( sQuadFragment &quad ) _IRR_OVERRIDE_;
+
+private:
+
+	// u32 and not an enum, they are compared with eBurningPipelineState values
+	static const u32 DEPTH_WRITE = ( STATE & BPS_DEPTH_WRITE ) != 0;
+	static const u32 TEXTURE0 = ( STATE & BPS_TEXTURE0 ) != 0;
+	static const u32 TEXTURE1 = ( STATE & BPS_TEXTURE1 ) != 0;
+	static const u32 COLOR0 = ( STATE & BPS_COLOR0 ) != 0;
+	static const u32 FOG = ( STATE & BPS_FOG ) != 0;
+	static const u32 BLEND = STATE & BPS_BLEND_MASK;
+	static const u32 MODULATE = STATE & BPS_TEXTURE1_MASK;
+
+	// fragments discarded by the alpha test must not write depth
+	static const u32 KERNEL_DEPTH_WRITE = DEPTH_WRITE && BLEND == (u32) BPS_BLEND_ALPHA_CHANNEL;
+
+	static u32 quadFlags ();
+
+	tFixPointu AlphaRef;
+
+	E_FOG_TYPE FogType;
+	f32 FogEnd;
+	f32 FogScale;
+	tFixPoint FogR;
+	tFixPoint FogG;
+	tFixPoint FogB;
+};
+
+template <u32 STATE>
+u32 CTRQuadPipeline<STATE>::quadFlags ()
+{
+	u32 flags = 0;
+	if ( STATE & BPS_DEPTH_TEST )
+		flags |= QUAD_DEPTH_TEST;
+	if ( DEPTH_WRITE && !KERNEL_DEPTH_WRITE )
+		flags |= QUAD_DEPTH_WRITE;
+	if ( TEXTURE0 )
+		flags |= QUAD_TEXTURE0;
+	if ( TEXTURE1 )
+		flags |= QUAD_TEXTURE1;
+	if ( COLOR0 )
+		flags |= QUAD_COLOR0;
+	if ( FOG )
+		flags |= QUAD_FOG;
+	return flags;
+}
+
+//! constructor
+template <u32 STATE>
+CTRQuadPipeline<STATE>::CTRQuadPipeline(CBurningVideoDriver* driver)
+: IBurningQuadShader(driver, quadFlags () ), AlphaRef(0), FogType(EFT_FOG_LINEAR),
+	FogEnd(0.f), FogScale(0.f), FogR(0), FogG(0), FogB(0)
+{
+	#ifdef _DEBUG
+	setDebugName("CTRQuadPipeline");
+	#endif
+}
+
+
+/*!
+*/
+template <u32 STATE>
+void CTRQuadPipeline<STATE>::setParam ( u32 index, f32 value)
+{
+	// 0: alpha reference of the alpha channel blend
+	if ( 0 == index )
+		AlphaRef = u32_to_fixPoint ( core::floor32 ( value * 256.f ) );
+}
+
+
+/*!
+*/
+template <u32 STATE>
+void CTRQuadPipeline<STATE>::setMaterial ( const SBurningShaderMaterial &material )
+{
+	if ( !FOG )
+		return;
+
+	SColor color;
+	f32 start;
+	f32 density;
+	bool pixelFog;
+	bool rangeFog;
+	Driver->getFog ( color, FogType, start, FogEnd, density, pixelFog, rangeFog );
+
+	// linear fog is ( end - d ) * scale, the exponential ones use the density
+	if ( EFT_FOG_LINEAR == FogType )
+		FogScale = core::equals ( FogEnd, start ) ? 0.f : core::reciprocal ( FogEnd - start );
+	else
+		FogScale = density;
+
+	FogR = tofix ( color.getRed () * ( 1.f / 255.f ), COLOR_MAX * FIX_POINT_F32_MUL );
+	FogG = tofix ( color.getGreen () * ( 1.f / 255.f ), COLOR_MAX * FIX_POINT_F32_MUL );
+	FogB = tofix ( color.getBlue () * ( 1.f / 255.f ), COLOR_MAX * FIX_POINT_F32_MUL );
+}
+
+
+/*!
+*/
+template <u32 STATE>
+void CTRQuadPipeline<STATE>::shadeQuad ( sQuadFragment &quad )
+{
+	tFixPoint a0, r0, g0, b0;
+	tFixPoint r1, g1, b1;
+
+	for ( u32 i = 0; i != 4; ++i )
+	{
+		if ( 0 == ( quad.mask & ( 1 << i ) ) )
+			continue;
+
+		tVideoSample *dst = quad.dst + quad.offset ( i );
+
+		// fragment color
+		if ( TEXTURE0 )
+		{
+			if ( BLEND == BPS_BLEND_ALPHA_CHANNEL )
+			{
+				getSample_texture_alpha ( a0, r0, g0, b0, quad.tex[0], quad.tx[0][i], quad.ty[0][i] );
+				if ( (tFixPointu) a0 <= AlphaRef )
+					continue;
+			}
+			else
+			{
+				getSample_texture ( r0, g0, b0, quad.tex[0], quad.tx[0][i], quad.ty[0][i] );
+			}
+
+			if ( TEXTURE1 )
+			{
+				getSample_texture ( r1, g1, b1, quad.tex[1], quad.tx[1][i], quad.ty[1][i] );
+
+				switch ( MODULATE )
+				{
+					case BPS_TEXTURE1_M4:
+						r0 = clampfix_maxcolor ( imulFix_tex4 ( r0, r1 ) );
+						g0 = clampfix_maxcolor ( imulFix_tex4 ( g0, g1 ) );
+						b0 = clampfix_maxcolor ( imulFix_tex4 ( b0, b1 ) );
+						break;
+					case BPS_TEXTURE1_M2:
+						r0 = clampfix_maxcolor ( imulFix_tex2 ( r0, r1 ) );
+						g0 = clampfix_maxcolor ( imulFix_tex2 ( g0, g1 ) );
+						b0 = clampfix_maxcolor ( imulFix_tex2 ( b0, b1 ) );
+						break;
+					default:
+						r0 = imulFix_tex1 ( r0, r1 );
+						g0 = imulFix_tex1 ( g0, g1 );
+						b0 = imulFix_tex1 ( b0, b1 );
+						break;
+				}
+			}
+
+			if ( COLOR0 )
+			{
+				r0 = imulFix ( r0, tofix ( quad.r[i] ) );
+				g0 = imulFix ( g0, tofix ( quad.g[i] ) );
+				b0 = imulFix ( b0, tofix ( quad.b[i] ) );
+			}
+		}
+		else if ( COLOR0 )
+		{
+			r0 = tofix ( quad.r[i], COLOR_MAX * FIX_POINT_F32_MUL );
+			g0 = tofix ( quad.g[i], COLOR_MAX * FIX_POINT_F32_MUL );
+			b0 = tofix ( quad.b[i], COLOR_MAX * FIX_POINT_F32_MUL );
+		}
+		else
+		{
+			r0 = FIXPOINT_COLOR_MAX;
+			g0 = FIXPOINT_COLOR_MAX;
+			b0 = FIXPOINT_COLOR_MAX;
+		}
+
+		// fog, f = 1 keeps the fragment color
+		if ( FOG )
+		{
+			f32 f;
+			switch ( FogType )
+			{
+				case EFT_FOG_EXP:
+					f = expf ( -FogScale * quad.w[i] );
+					break;
+				case EFT_FOG_EXP2:
+					f = FogScale * quad.w[i];
+					f = expf ( -f * f );
+					break;
+				default:
+					f = ( FogEnd - quad.w[i] ) * FogScale;
+					break;
+			}
+
+			const tFixPoint fog = tofix ( core::clamp ( f, 0.f, 1.f ) );
+			r0 = FogR + imulFix ( fog, r0 - FogR );
+			g0 = FogG + imulFix ( fog, g0 - FogG );
+			b0 = FogB + imulFix ( fog, b0 - FogB );
+		}
+
+		// blend
+		switch ( BLEND )
+		{
+			case BPS_BLEND_ADD:
+				color_to_fix ( r1, g1, b1, *dst );
+				*dst = fix_to_color ( clampfix_maxcolor ( r1 + r0 ),
+									clampfix_maxcolor ( g1 + g0 ),
+									clampfix_maxcolor ( b1 + b0 )
+								);
+				break;
+
+			case BPS_BLEND_ALPHA_CHANNEL:
+				if ( KERNEL_DEPTH_WRITE )
+					quad.z[quad.offset ( i )] = quad.depth[i];
+
+				color_to_fix ( r1, g1, b1, *dst );
+				a0 >>= COLOR_MAX_LOG2;
+				*dst = fix_to_color ( r1 + imulFix ( a0, r0 - r1 ),
+									g1 + imulFix ( a0, g0 - g1 ),
+									b1 + imulFix ( a0, b0 - b1 )
+								);
+				break;
+
+			default:
+				*dst = fix_to_color ( r0, g0, b0 );
+				break;
+		}
+	}
+}
+
+
+namespace
+{
+	template <u32 STATE>
+	IBurningShader* createPipeline ( CBurningVideoDriver* driver )
+	{
+		return new CTRQuadPipeline<STATE>(driver);
+	}
+
+	struct SPipelineEntry
+	{
+		u32 State;
+		IBurningShader* (*create) ( CBurningVideoDriver* driver );
+	};
+
+	// vertex colors are not interpolated by all renderer configurations
+#ifdef SOFTWARE_DRIVER_2_USE_VERTEX_COLOR
+	const u32 BPS_C0 = BPS_COLOR0;
+#else
+	const u32 BPS_C0 = 0;
+#endif
+
+	const u32 BPS_T0 = BPS_TEXTURE0;
+	const u32 BPS_T01 = BPS_TEXTURE0 | BPS_TEXTURE1;
+
+	// a state with and without fog, each without depth buffer, with depth test and with depth test and write
+	#define BURNING_PIPELINE_DEPTH(state) \
+		{ (state), &createPipeline<(state)> }, \
+		{ (state) | BPS_DEPTH_TEST, &createPipeline<(state) | BPS_DEPTH_TEST> }, \
+		{ (state) | BPS_DEPTH_TEST | BPS_DEPTH_WRITE, &createPipeline<(state) | BPS_DEPTH_TEST | BPS_DEPTH_WRITE> }
+	#define BURNING_PIPELINE(state) \
+		BURNING_PIPELINE_DEPTH(state), \
+		BURNING_PIPELINE_DEPTH((state) | BPS_FOG)
+
+	//! the states the materials of the fixed function pipeline map to
+	const SPipelineEntry Pipelines[] =
+	{
+		BURNING_PIPELINE ( BPS_BLEND_SOLID | BPS_C0 ),
+		BURNING_PIPELINE ( BPS_BLEND_SOLID | BPS_T0 | BPS_C0 ),
+		BURNING_PIPELINE ( BPS_BLEND_SOLID | BPS_T01 | BPS_TEXTURE1_M1 ),
+		BURNING_PIPELINE ( BPS_BLEND_SOLID | BPS_T01 | BPS_TEXTURE1_M2 ),
+		BURNING_PIPELINE ( BPS_BLEND_SOLID | BPS_T01 | BPS_TEXTURE1_M4 ),
+		BURNING_PIPELINE ( BPS_BLEND_SOLID | BPS_T01 | BPS_TEXTURE1_M1 | BPS_C0 ),
+		BURNING_PIPELINE ( BPS_BLEND_SOLID | BPS_T01 | BPS_TEXTURE1_M2 | BPS_C0 ),
+		BURNING_PIPELINE ( BPS_BLEND_SOLID | BPS_T01 | BPS_TEXTURE1_M4 | BPS_C0 ),
+		BURNING_PIPELINE ( BPS_BLEND_ADD | BPS_T0 ),
+		BURNING_PIPELINE ( BPS_BLEND_ALPHA_CHANNEL | BPS_T0 | BPS_C0 ),
+	};
+
+	#undef BURNING_PIPELINE
+	#undef BURNING_PIPELINE_DEPTH
+}
+
+} // end namespace video
+} // end namespace irr
+
+#endif // _IRR_COMPILE_WITH_BURNINGSVIDEO_ && SOFTWARE_DRIVER_2_QUAD_RASTERIZER
+
+namespace irr
+{
+namespace video
+{
+
+//! creates the pipeline for a combination of eBurningPipelineState
+IBurningShader* createTRQuadPipeline(CBurningVideoDriver* driver, u32 state)
+{
+	#if defined ( _IRR_COMPILE_WITH_BURNINGSVIDEO_ ) && defined ( SOFTWARE_DRIVER_2_QUAD_RASTERIZER )
+	for ( u32 i = 0; i != sizeof ( Pipelines ) / sizeof ( Pipelines[0] ); ++i )
+	{
+		if ( Pipelines[i].State == state )
+			return Pipelines[i].create ( driver );
+	}
+	#endif
+	return 0;
+}
+
+
+} // end namespace video
+} // end namespace irr
@@ -3,7 +3,7 @@
 // For conditions of distribution and use, see copyright notice in irrlicht.h
 
 #include "IrrCompileConfig.h"
-#include "IBurningShader.h"
+#include "IBurningQuadShader.h"
 
 #ifdef _IRR_COMPILE_WITH_BURNINGSVIDEO_
 
@@ -75,6 +75,78 @@ namespace irr
 namespace video
 {
 
+#ifdef SOFTWARE_DRIVER_2_QUAD_RASTERIZER
+
+class CTRTextureGouraud2 : public IBurningQuadShader
+{
+public:
+
+	//! constructor
+	CTRTextureGouraud2(CBurningVideoDriver* driver);
+
+protected:
+	virtual void shadeQuad ( sQuadFragment &quad ) _IRR_OVERRIDE_;
+
+};
+
+//! constructor
+CTRTextureGouraud2::CTRTextureGouraud2(CBurningVideoDriver* driver)
+: IBurningQuadShader(driver, QUAD_DEPTH_TEST | QUAD_DEPTH_WRITE | QUAD_TEXTURE0
+#ifdef IPOL_C0
+	| QUAD_COLOR0
+#endif
+	)
+{
+	#ifdef _DEBUG
+	setDebugName("CTRTextureGouraud2");
+	#endif
+}
+
+
+/*!
+*/
+void CTRTextureGouraud2::shadeQuad ( sQuadFragment &quad )
+{
+	tFixPoint r0, g0, b0;
+
+#ifdef IPOL_C0
+	tFixPoint r1, g1, b1;
+#endif
+
+	for ( u32 i = 0; i != 4; ++i )
+	{
+		if ( 0 == ( quad.mask & ( 1 << i ) ) )
+			continue;
+
+		tVideoSample *dst = quad.dst + quad.offset ( i );
+
+#ifdef IPOL_C0
+		r1 = tofix ( quad.r[i] );
+		g1 = tofix ( quad.g[i] );
+		b1 = tofix ( quad.b[i] );
+
+		getSample_texture ( r0, g0, b0, quad.tex[0], quad.tx[0][i], quad.ty[0][i] );
+
+		*dst = fix_to_color ( imulFix ( r0, r1 ),
+							imulFix ( g0, g1 ),
+							imulFix ( b0, b1 )
+						);
+#else
+
+#ifdef BURNINGVIDEO_RENDERER_FAST
+		const tFixPointu d = dithermask [ ( ( quad.y + ( i >> 1 ) ) & 3 ) << 2 | ( ( quad.x + ( i & 1 ) ) & 3 ) ];
+		*dst = getTexel_plain ( quad.tex[0], d + quad.tx[0][i], d + quad.ty[0][i] );
+#else
+		getSample_texture ( r0, g0, b0, quad.tex[0], quad.tx[0][i], quad.ty[0][i] );
+		*dst = fix_to_color ( r0, g0, b0 );
+#endif
+
+#endif
+	}
+}
+
+#else
+
 class CTRTextureGouraud2 : public IBurningShader
 {
 public:
@@ -646,6 +718,8 @@ void CTRTextureGouraud2::drawTriangle ( const s4DVertex *a,const s4DVertex *b,co
 
 }
 
+#endif // SOFTWARE_DRIVER_2_QUAD_RASTERIZER
+
 } // end namespace video
 } // end namespace irr
 
@@ -710,54 +710,90 @@ namespace scene
 	void CTerrainSceneNode::preRenderIndicesCalculations()
 	{
 		scene::IIndexBuffer* indexBuffer = RenderBuffer->getIndexBuffer();
-		IndicesToRender = 0;
-		indexBuffer->set_used(0);
+		const u32 indexSize = indexBuffer->getIndexSize();
+		const s32 count = TerrainData.PatchCount * TerrainData.PatchCount;
 
-		s32 index = 0;
-		// Then generate the indices for all patches that are visible.
-		for (s32 i = 0; i < TerrainData.PatchCount; ++i)
+		// Find the blocks of all patches and the first patch whose indices change.
+		// Patches before it keep their indices where they are.
+		NewIndexBlocks.set_used(count);
+		s32 firstChanged = count;
+		u32 firstChangedStart = 0;
+		u32 indexCount = 0;
+
+		for (s32 i = 0; i < count; ++i)
 		{
-			for (s32 j = 0; j < TerrainData.PatchCount; ++j)
+			const SPatch& patch = TerrainData.Patches[i];
+			NewIndexBlocks[i] = (patch.CurrentLOD >= 0) ? getIndexBlockKey(patch) : (u32)NO_INDEX_BLOCK;
+
+			if (firstChanged == count && (NewIndexBlocks[i] != patch.IndexBlock ||
+				(patch.IndexBlock != NO_INDEX_BLOCK && patch.IndexStart != indexCount)))
 			{
-				if (TerrainData.Patches[index].CurrentLOD >= 0)
-				{
-					s32 x = 0;
-					s32 z = 0;
+				firstChanged = i;
+				firstChangedStart = indexCount;
+			}
+
+			if (NewIndexBlocks[i] != NO_INDEX_BLOCK)
+				indexCount += getIndexBlock(NewIndexBlocks[i]).size();
+		}
+
+		// the LODs changed, but none of the patches
+		if (firstChanged == count && indexCount == IndicesToRender)
+			return;
+
+		// Keep the indices of the following patches, unchanged patches only move.
+		OldIndices.set_used((IndicesToRender - firstChangedStart) * indexSize);
+		if (OldIndices.size())
+			memcpy(OldIndices.pointer(), (u8*)indexBuffer->getIndices() + firstChangedStart * indexSize, OldIndices.size());
+
+		indexBuffer->set_used(indexCount);
+		u8* indices = (u8*)indexBuffer->getIndices();
+
+		u32 start = firstChangedStart;
+		for (s32 i = firstChanged; i < count; ++i)
+		{
+			SPatch& patch = TerrainData.Patches[i];
+			const u32 key = NewIndexBlocks[i];
 
-					// calculate the step we take this patch, based on the patches current LOD
-					const s32 step = 1 << TerrainData.Patches[index].CurrentLOD;
+			if (key != NO_INDEX_BLOCK)
+			{
+				const core::array<u32>& block = getIndexBlock(key);
 
-					// Loop through patch and generate indices
-					while (z < TerrainData.CalcPatchSize)
+				if (key == patch.IndexBlock)
+				{
+					memcpy(indices + start * indexSize,
+						OldIndices.const_pointer() + (patch.IndexStart - firstChangedStart) * indexSize,
+						block.size() * indexSize);
+				}
+				else
+				{
+					// the block is relative to the first vertex of the patch
+					const s32 row = i / TerrainData.PatchCount;
+					const s32 col = i % TerrainData.PatchCount;
+					const u32 first = (row * TerrainData.Size + col) * TerrainData.CalcPatchSize;
+
+					if (indexSize == sizeof(u16))
 					{
-						const s32 index11 = getIndex(j, i, index, x, z);
-						const s32 index21 = getIndex(j, i, index, x + step, z);
-						const s32 index12 = getIndex(j, i, index, x, z + step);
-						const s32 index22 = getIndex(j, i, index, x + step, z + step);
-
-						indexBuffer->addIndex(index12);
-						indexBuffer->addIndex(index11);
-						indexBuffer->addIndex(index22);
-						indexBuffer->addIndex(index22);
-						indexBuffer->addIndex(index11);
-						indexBuffer->addIndex(index21);
-						IndicesToRender+=6;
-
-						// increment index position horizontally
-						x += step;
-
-						// we've hit an edge
-						if (x >= TerrainData.CalcPatchSize)
-						{
-							x = 0;
-							z += step;
-						}
+						u16* dst = (u16*)indices + start;
+						for (u32 j = 0; j < block.size(); ++j)
+							dst[j] = (u16)(block[j] + first);
+					}
+					else
+					{
+						u32* dst = (u32*)indices + start;
+						for (u32 j = 0; j < block.size(); ++j)
+							dst[j] = block[j] + first;
 					}
 				}
-				++index;
+
+				patch.IndexStart = start;
+				start += block.size();
 			}
+
+			patch.IndexBlock = key;
 		}
 
+		IndicesToRender = indexCount;
+
 		RenderBuffer->setDirty(EBT_INDEX);
 
 		if (DynamicSelectorUpdate && TriangleSelector)
@@ -768,6 +804,122 @@ namespace scene
 	}
 
 
+	//! Stitches a border to the patches of a terrain next to it
+	void CTerrainSceneNode::setNeighbour(E_BORDER border, CTerrainSceneNode* neighbour)
+	{
+		const s32 count = TerrainData.PatchCount;
+		if (!TerrainData.Patches)
+			return;
+
+		if (neighbour && (!neighbour->TerrainData.Patches || neighbour->TerrainData.PatchCount != count))
+			neighbour = 0;
+
+		SPatch* patches = TerrainData.Patches;
+		SPatch* other = neighbour ? neighbour->TerrainData.Patches : 0;
+
+		for (s32 i = 0; i < count; ++i)
+		{
+			switch (border)
+			{
+			case EB_TOP:
+				patches[i].Top = other ? &other[(count - 1) * count + i] : 0;
+				break;
+			case EB_BOTTOM:
+				patches[(count - 1) * count + i].Bottom = other ? &other[i] : 0;
+				break;
+			case EB_LEFT:
+				patches[i * count].Left = other ? &other[i * count + count - 1] : 0;
+				break;
+			case EB_RIGHT:
+				patches[i * count + count - 1].Right = other ? &other[i * count] : 0;
+				break;
+			}
+		}
+	}
+
+
+	//! Calculates the LODs of the patches and the indices if the active camera moved
+	void CTerrainSceneNode::updateLODs()
+	{
+		preRenderCalculationsIfNeeded();
+	}
+
+
+	//! Calculates the indices again, needed when only the LODs of neighbours changed
+	void CTerrainSceneNode::updateIndices()
+	{
+		if (TerrainData.Patches && SceneManager->getActiveCamera())
+			preRenderIndicesCalculations();
+	}
+
+
+	//! Returns the key of the index block for the LODs of a patch and its neighbours
+	u32 CTerrainSceneNode::getIndexBlockKey(const SPatch& patch) const
+	{
+		// each border is stitched to the LOD of a coarser neighbour
+		const s32 lod = patch.CurrentLOD;
+		const s32 top = (patch.Top && lod < patch.Top->CurrentLOD) ? patch.Top->CurrentLOD : lod;
+		const s32 bottom = (patch.Bottom && lod < patch.Bottom->CurrentLOD) ? patch.Bottom->CurrentLOD : lod;
+		const s32 left = (patch.Left && lod < patch.Left->CurrentLOD) ? patch.Left->CurrentLOD : lod;
+		const s32 right = (patch.Right && lod < patch.Right->CurrentLOD) ? patch.Right->CurrentLOD : lod;
+
+		return lod | (top << 4) | (bottom << 8) | (left << 12) | (right << 16);
+	}
+
+
+	//! Returns the indices of a patch relative to its first vertex, creates them if needed
+	const core::array<u32>& CTerrainSceneNode::getIndexBlock(u32 key)
+	{
+		core::hash_map<u32, core::array<u32> >::Node* node = IndexBlocks.find(key);
+		if (node)
+			return node->getValue();
+
+		const s32 step = 1 << (key & 0xf);
+		const s32 stitch[4] = { 1 << ((key >> 4) & 0xf), 1 << ((key >> 8) & 0xf),
+			1 << ((key >> 12) & 0xf), 1 << ((key >> 16) & 0xf) };
+
+		core::array<u32> block((TerrainData.CalcPatchSize / step) * (TerrainData.CalcPatchSize / step) * 6);
+
+		// the vertices of the quads, moved like getIndex does
+		for (s32 z = 0; z < TerrainData.CalcPatchSize; z += step)
+		{
+			for (s32 x = 0; x < TerrainData.CalcPatchSize; x += step)
+			{
+				u32 index[4];
+				for (u32 i = 0; i < 4; ++i)
+				{
+					s32 vX = x + (i & 1) * step;
+					s32 vZ = z + (i >> 1) * step;
+
+					if (vZ == 0)
+						vX -= vX % stitch[0];
+					else if (vZ == TerrainData.CalcPatchSize)
+						vX -= vX % stitch[1];
+
+					if (vX == 0)
+						vZ -= vZ % stitch[2];
+					else if (vX == TerrainData.CalcPatchSize)
+						vZ -= vZ % stitch[3];
+
+					index[i] = core::min_(vZ, TerrainData.CalcPatchSize) * TerrainData.Size +
+						core::min_(vX, TerrainData.CalcPatchSize);
+				}
+
+				// index11, index21, index12, index22
+				block.push_back(index[2]);
+				block.push_back(index[0]);
+				block.push_back(index[3]);
+				block.push_back(index[3]);
+				block.push_back(index[0]);
+				block.push_back(index[1]);
+			}
+		}
+
+		IndexBlocks.insert(key, block);
+		return IndexBlocks.find(key)->getValue();
+	}
+
+
 	//! Render the scene node
 	void CTerrainSceneNode::render()
 	{
@@ -777,6 +929,10 @@ namespace scene
 		if (!Mesh->getMeshBufferCount())
 			return;
 
+		// drawAllViews renders the node for other cameras than the one it
+		// registered with, the LODs are only calculated again when it moved
+		preRenderCalculationsIfNeeded();
+
 		video::IVideoDriver* driver = SceneManager->getVideoDriver();
 
 		driver->setTransform (video::ETS_WORLD, core::IdentityMatrix);
@@ -1351,6 +1507,10 @@ namespace scene
 			delete [] TerrainData.Patches;
 
 		TerrainData.Patches = new SPatch[TerrainData.PatchCount * TerrainData.PatchCount];
+
+		// the new patches have no indices yet
+		IndexBlocks.clear();
+		IndicesToRender = 0;
 	}
 
 
@@ -12,6 +12,7 @@
 #include "ITerrainSceneNode.h"
 #include "IMeshBuffer.h"
 #include "path.h"
+#include "irrHashMap.h"
 
 namespace irr
 {
@@ -217,13 +218,43 @@ namespace scene
 		virtual ISceneNode* clone(ISceneNode* newParent,
 				ISceneManager* newManager) _IRR_OVERRIDE_;
 
+		//! Borders of the terrain, named like the neighbours of the patches
+		enum E_BORDER
+		{
+			//! the side with the smallest X
+			EB_TOP = 0,
+			//! the side with the largest X
+			EB_BOTTOM,
+			//! the side with the smallest Z
+			EB_LEFT,
+			//! the side with the largest Z
+			EB_RIGHT
+		};
+
+		//! Stitches a border to the patches of a terrain next to it
+		//! The patches along the border then follow the LOD of the neighbour like the patches
+		//! inside the terrain do, so there are no cracks between the terrains.
+		//! \param border: The border which touches the neighbour.
+		//! \param neighbour: The terrain next to the border, with the same number of patches, or 0.
+		void setNeighbour(E_BORDER border, CTerrainSceneNode* neighbour);
+
+		//! Calculates the LODs of the patches and the indices if the active camera moved
+		void updateLODs();
+
+		//! Calculates the indices again, needed when only the LODs of neighbours changed
+		void updateIndices();
+
 	private:
 		friend class CTerrainTriangleSelector;
 
+		//! key of patches without indices
+		enum { NO_INDEX_BLOCK = 0xffffffff };
+
 		struct SPatch
 		{
 			SPatch()
-			: Top(0), Bottom(0), Right(0), Left(0), CurrentLOD(-1)
+			: Top(0), Bottom(0), Right(0), Left(0), CurrentLOD(-1),
+				IndexStart(0), IndexBlock(NO_INDEX_BLOCK)
 			{
 			}
 
@@ -232,6 +263,10 @@ namespace scene
 			SPatch* Right;
 			SPatch* Left;
 			s32 CurrentLOD;
+
+			//! position and key of the indices of the patch in the render buffer
+			u32 IndexStart;
+			u32 IndexBlock;
 			core::aabbox3df BoundingBox;
 			core::vector3df Center;
 		};
@@ -267,6 +302,12 @@ namespace scene
 		//! get indices when generating index data for patches at varying levels of detail.
 		u32 getIndex(const s32 PatchX, const s32 PatchZ, const s32 PatchIndex, u32 vX, u32 vZ) const;
 
+		//! returns the key of the index block for the LODs of a patch and its neighbours
+		u32 getIndexBlockKey(const SPatch& patch) const;
+
+		//! returns the indices of a patch relative to its first vertex, creates them if needed
+		const core::array<u32>& getIndexBlock(u32 key);
+
 		//! smooth the terrain
 		void smoothTerrain(IMeshBuffer* mb, s32 smoothFactor);
 
@@ -299,6 +340,13 @@ namespace scene
 		u32 VerticesToRender;
 		u32 IndicesToRender;
 
+		//! indices of a patch for its LOD and the LODs its borders are stitched to
+		core::hash_map<u32, core::array<u32> > IndexBlocks;
+
+		// reused while the indices are rebuilt
+		core::array<u32> NewIndexBlocks;
+		core::array<u8> OldIndices;
+
 		bool DynamicSelectorUpdate;
 		bool OverrideDistanceThreshold;
 		bool UseDefaultRotationPivot;
@@ -5,6 +5,7 @@
 #include "CTerrainTriangleSelector.h"
 #include "CTerrainSceneNode.h"
 #include "os.h"
+#include "SMesh.h"
 
 namespace irr
 {
@@ -14,7 +15,8 @@ namespace scene
 
 //! constructor
 CTerrainTriangleSelector::CTerrainTriangleSelector ( ITerrainSceneNode* node, s32 LOD )
-	: SceneNode(node)
+	: SceneNode(node), HeightBuffer(0), Positions(0), Stride(0), Size(0),
+	PatchSize(0), PatchCount(0), CellCount(0), TotalTriangles(0)
 {
 	#ifdef _DEBUG
 	setDebugName ("CTerrainTriangleSelector");
@@ -27,95 +29,312 @@ CTerrainTriangleSelector::CTerrainTriangleSelector ( ITerrainSceneNode* node, s3
 //! destructor
 CTerrainTriangleSelector::~CTerrainTriangleSelector()
 {
-	TrianglePatches.TrianglePatchArray.clear();
+	if (HeightBuffer)
+		HeightBuffer->drop();
 }
 
 
 //! Clears and sets triangle data
 void CTerrainTriangleSelector::setTriangleData(ITerrainSceneNode* node, s32 LOD)
 {
-	video::IVertexAttribute* attribute = node->getRenderBuffer()->getVertexDescriptor()->getAttributeBySemantic(video::EVAS_POSITION);
+	const CTerrainSceneNode* terrain = static_cast<CTerrainSceneNode*>(node);
+	const CTerrainSceneNode::STerrainData& data = terrain->TerrainData;
 
-	if(!attribute)
-		return;
+	IMeshBuffer* buffer = terrain->Mesh->getMeshBufferCount() ? terrain->Mesh->getMeshBuffer(0) : 0;
+	video::IVertexAttribute* attribute = buffer ? buffer->getVertexDescriptor()->getAttributeBySemantic(video::EVAS_POSITION) : 0;
+
+	if (!attribute)
+		buffer = 0;
+
+	// the height grid is only read again when the mesh changed
+	const bool gridChanged = buffer != HeightBuffer || data.Size != Size;
+
+	if (buffer)
+		buffer->grab();
+	if (HeightBuffer)
+		HeightBuffer->drop();
+	HeightBuffer = buffer;
+
+	Positions = 0;
+	Stride = 0;
+	if (HeightBuffer)
+	{
+		Positions = static_cast<const u8*>(HeightBuffer->getVertexBuffer()->getVertices()) + attribute->getOffset();
+		Stride = HeightBuffer->getVertexBuffer()->getVertexSize();
+	}
+
+	Size = data.Size;
+	PatchSize = data.CalcPatchSize;
+	PatchCount = HeightBuffer ? data.PatchCount : 0;
+	CellCount = PatchCount * PatchSize;
+
+	Position = data.Position;
+	Scale = data.Scale;
+	RotationPivot = data.RotationPivot;
+	Rotation.setRotationDegrees(data.Rotation);
+
+	if (LOD > data.MaxLOD - 1)
+		LOD = data.MaxLOD - 1;
+
+	PatchLOD.set_used(PatchCount * PatchCount);
+	TotalTriangles = 0;
+	for (u32 i = 0; i < PatchLOD.size(); ++i)
+	{
+		PatchLOD[i] = (LOD < 0) ? data.Patches[i].CurrentLOD : LOD;
+		if (PatchLOD[i] >= 0)
+		{
+			const s32 cells = PatchSize >> PatchLOD[i];
+			TotalTriangles += cells * cells * 2;
+		}
+	}
 
-	u8* offset = static_cast<u8*>(node->getRenderBuffer()->getVertexBuffer()->getVertices());
-	offset += attribute->getOffset();
+	if (gridChanged)
+		buildHeightLevels();
+}
+
+
+//! builds the height pyramid from the grid
+void CTerrainTriangleSelector::buildHeightLevels()
+{
+	HeightLevels.clear();
 
-	// Clear current data
-	const s32 count = (static_cast<CTerrainSceneNode*>(node))->TerrainData.PatchCount;
-	TrianglePatches.TotalTriangles = 0;
-	TrianglePatches.NumPatches = count*count;
+	if (!CellCount)
+		return;
 
-	TrianglePatches.TrianglePatchArray.reallocate(TrianglePatches.NumPatches);
-	for (s32 o=0; o<TrianglePatches.NumPatches; ++o)
-		TrianglePatches.TrianglePatchArray.push_back(SGeoMipMapTrianglePatch());
+	SHeightLevel level;
+	level.TileSize = TILE_SIZE;
+	level.TileCount = (CellCount + TILE_SIZE - 1) / TILE_SIZE;
+	level.Tiles.set_used(level.TileCount * level.TileCount);
 
-	core::triangle3df tri;
-	core::array<u32> indices;
-	s32 tIndex = 0;
-	for(s32 x = 0; x < count; ++x )
+	for (s32 tileRow = 0; tileRow < level.TileCount; ++tileRow)
 	{
-		for(s32 z = 0; z < count; ++z )
+		for (s32 tileCol = 0; tileCol < level.TileCount; ++tileCol)
 		{
-			TrianglePatches.TrianglePatchArray[tIndex].NumTriangles = 0;
-			TrianglePatches.TrianglePatchArray[tIndex].Box = node->getBoundingBox( x, z );
-			u32 indexCount = node->getIndicesForPatch( indices, x, z, LOD );
+			const s32 rowEnd = core::min_((tileRow + 1) * TILE_SIZE, CellCount);
+			const s32 colEnd = core::min_((tileCol + 1) * TILE_SIZE, CellCount);
+
+			SHeightRange& range = level.Tiles[tileRow * level.TileCount + tileCol];
+			range.Min = range.Max = getGridHeight(tileRow * TILE_SIZE, tileCol * TILE_SIZE);
 
-			TrianglePatches.TrianglePatchArray[tIndex].Triangles.reallocate(indexCount/3);
-			for(u32 i = 0; i < indexCount; i += 3 )
+			for (s32 row = tileRow * TILE_SIZE; row <= rowEnd; ++row)
 			{
-				core::vector3df* PositionA = (core::vector3df*)(offset + node->getRenderBuffer()->getVertexBuffer()->getVertexSize() * indices[i+0]);
-				core::vector3df* PositionB = (core::vector3df*)(offset + node->getRenderBuffer()->getVertexBuffer()->getVertexSize() * indices[i+1]);
-				core::vector3df* PositionC = (core::vector3df*)(offset + node->getRenderBuffer()->getVertexBuffer()->getVertexSize() * indices[i+2]);
-
-				tri.pointA = *PositionA;
-				tri.pointB = *PositionB;
-				tri.pointC = *PositionC;
-				TrianglePatches.TrianglePatchArray[tIndex].Triangles.push_back(tri);
-				++TrianglePatches.TrianglePatchArray[tIndex].NumTriangles;
+				for (s32 col = tileCol * TILE_SIZE; col <= colEnd; ++col)
+				{
+					const f32 height = getGridHeight(row, col);
+					range.Min = core::min_(range.Min, height);
+					range.Max = core::max_(range.Max, height);
+				}
 			}
+		}
+	}
 
-			TrianglePatches.TotalTriangles += TrianglePatches.TrianglePatchArray[tIndex].NumTriangles;
-			++tIndex;
+	HeightLevels.push_back(level);
+
+	// each coarser level joins 2x2 tiles
+	while (HeightLevels.getLast().TileCount > 1)
+	{
+		const SHeightLevel& fine = HeightLevels.getLast();
+
+		SHeightLevel coarse;
+		coarse.TileSize = fine.TileSize * 2;
+		coarse.TileCount = (fine.TileCount + 1) / 2;
+		coarse.Tiles.set_used(coarse.TileCount * coarse.TileCount);
+
+		for (s32 tileRow = 0; tileRow < coarse.TileCount; ++tileRow)
+		{
+			for (s32 tileCol = 0; tileCol < coarse.TileCount; ++tileCol)
+			{
+				SHeightRange& range = coarse.Tiles[tileRow * coarse.TileCount + tileCol];
+				range = fine.Tiles[tileRow * 2 * fine.TileCount + tileCol * 2];
+
+				for (s32 row = tileRow * 2; row < core::min_(tileRow * 2 + 2, fine.TileCount); ++row)
+				{
+					for (s32 col = tileCol * 2; col < core::min_(tileCol * 2 + 2, fine.TileCount); ++col)
+					{
+						const SHeightRange& child = fine.Tiles[row * fine.TileCount + col];
+						range.Min = core::min_(range.Min, child.Min);
+						range.Max = core::max_(range.Max, child.Max);
+					}
+				}
+			}
 		}
+
+		HeightLevels.push_back(coarse);
 	}
 }
 
 
-//! Gets all triangles.
-void CTerrainTriangleSelector::getTriangles(core::triangle3df* triangles,
-			s32 arraySize, s32& outTriangleCount,
-			const core::matrix4* transform) const
+//! returns the position of a grid vertex in world space
+core::vector3df CTerrainTriangleSelector::getVertexPosition(s32 row, s32 col) const
 {
-	s32 count = TrianglePatches.TotalTriangles;
+	// the same transformation CTerrainSceneNode applies to its render buffer
+	core::vector3df position = *(const core::vector3df*)(Positions + (row * Size + col) * Stride);
+	position = position * Scale + Position;
+
+	position -= RotationPivot;
+	Rotation.inverseRotateVect(position);
+	position += RotationPivot;
 
-	if (count > arraySize)
-		count = arraySize;
+	return position;
+}
 
-	core::matrix4 mat;
 
-	if (transform)
-		mat = (*transform);
+//! transforms a position into grid space
+core::vector3df CTerrainTriangleSelector::toGridSpace(const core::vector3df& position) const
+{
+	core::vector3df grid = position - RotationPivot;
+	Rotation.rotateVect(grid);
+	grid += RotationPivot;
+
+	return (grid - Position) / Scale;
+}
+
+
+//! returns the height range of a square of cells, aligned to its size
+const CTerrainTriangleSelector::SHeightRange& CTerrainTriangleSelector::getHeightRange(s32 row, s32 col, s32 size) const
+{
+	u32 i = 0;
+	while (i < HeightLevels.size() - 1 && HeightLevels[i].TileSize < size)
+		++i;
+
+	const SHeightLevel& level = HeightLevels[i];
+	return level.Tiles[(row / level.TileSize) * level.TileCount + col / level.TileSize];
+}
 
-	s32 tIndex = 0;
 
-	for (s32 i=0; i<TrianglePatches.NumPatches; ++i)
+//! returns the step between the vertices of the patch of a cell
+s32 CTerrainTriangleSelector::getCellStep(s32 row, s32 col) const
+{
+	const s32 lod = PatchLOD[(row / PatchSize) * PatchCount + col / PatchSize];
+	return (lod < 0) ? 0 : 1 << lod;
+}
+
+
+//! returns the grid vertex of a patch, moved onto the edges of coarser neighbours
+/** This is CTerrainSceneNode::getIndex with the LODs of the selector. */
+void CTerrainTriangleSelector::getPatchVertex(s32 patchRow, s32 patchCol, s32 row, s32 col, s32& outRow, s32& outCol) const
+{
+	const s32 lod = PatchLOD[patchRow * PatchCount + patchCol];
+	s32 neighbour;
+
+	// top border
+	if (row == 0)
 	{
-		if (tIndex + TrianglePatches.TrianglePatchArray[i].NumTriangles <= count)
-			for (s32 j=0; j<TrianglePatches.TrianglePatchArray[i].NumTriangles; ++j)
-			{
-				triangles[tIndex] = TrianglePatches.TrianglePatchArray[i].Triangles[j];
+		if (patchRow > 0)
+		{
+			neighbour = PatchLOD[(patchRow - 1) * PatchCount + patchCol];
+			if (lod < neighbour && (col % (1 << neighbour)) != 0)
+				col -= col % (1 << neighbour);
+		}
+	}
+	else
+	if (row == PatchSize) // bottom border
+	{
+		if (patchRow < PatchCount - 1)
+		{
+			neighbour = PatchLOD[(patchRow + 1) * PatchCount + patchCol];
+			if (lod < neighbour && (col % (1 << neighbour)) != 0)
+				col -= col % (1 << neighbour);
+		}
+	}
+
+	// left border
+	if (col == 0)
+	{
+		if (patchCol > 0)
+		{
+			neighbour = PatchLOD[patchRow * PatchCount + patchCol - 1];
+			if (lod < neighbour && (row % (1 << neighbour)) != 0)
+				row -= row % (1 << neighbour);
+		}
+	}
+	else
+	if (col == PatchSize) // right border
+	{
+		if (patchCol < PatchCount - 1)
+		{
+			neighbour = PatchLOD[patchRow * PatchCount + patchCol + 1];
+			if (lod < neighbour && (row % (1 << neighbour)) != 0)
+				row -= row % (1 << neighbour);
+		}
+	}
+
+	outRow = patchRow * PatchSize + core::min_(row, PatchSize);
+	outCol = patchCol * PatchSize + core::min_(col, PatchSize);
+}
+
+
+//! creates the two triangles of a cell at the level of detail of its patch
+bool CTerrainTriangleSelector::addCell(s32 row, s32 col, s32 step, STriangleOutput& out) const
+{
+	if (out.Count + 2 > out.ArraySize)
+		return false;
+
+	const s32 patchRow = row / PatchSize;
+	const s32 patchCol = col / PatchSize;
+	row -= patchRow * PatchSize;
+	col -= patchCol * PatchSize;
+
+	s32 r, c;
+	getPatchVertex(patchRow, patchCol, row, col, r, c);
+	const core::vector3df v11 = getVertexPosition(r, c);
+	getPatchVertex(patchRow, patchCol, row, col + step, r, c);
+	const core::vector3df v21 = getVertexPosition(r, c);
+	getPatchVertex(patchRow, patchCol, row + step, col, r, c);
+	const core::vector3df v12 = getVertexPosition(r, c);
+	getPatchVertex(patchRow, patchCol, row + step, col + step, r, c);
+	const core::vector3df v22 = getVertexPosition(r, c);
+
+	core::triangle3df* triangles = out.Triangles + out.Count;
+	triangles[0].set(v12, v11, v22);
+	triangles[1].set(v22, v11, v21);
+
+	if (out.Transform)
+	{
+		for (u32 i = 0; i < 2; ++i)
+		{
+			out.Transform->transformVect(triangles[i].pointA);
+			out.Transform->transformVect(triangles[i].pointB);
+			out.Transform->transformVect(triangles[i].pointC);
+		}
+	}
+
+	out.Count += 2;
+	return true;
+}
 
-				mat.transformVect(triangles[tIndex].pointA);
-				mat.transformVect(triangles[tIndex].pointB);
-				mat.transformVect(triangles[tIndex].pointC);
 
-				++tIndex;
+//! Gets all triangles.
+void CTerrainTriangleSelector::getTriangles(core::triangle3df* triangles,
+			s32 arraySize, s32& outTriangleCount,
+			const core::matrix4* transform) const
+{
+	STriangleOutput out = { triangles, arraySize, 0, transform };
+
+	for (s32 patchRow = 0; patchRow < PatchCount; ++patchRow)
+	{
+		for (s32 patchCol = 0; patchCol < PatchCount; ++patchCol)
+		{
+			const s32 lod = PatchLOD[patchRow * PatchCount + patchCol];
+			if (lod < 0)
+				continue;
+
+			const s32 step = 1 << lod;
+			for (s32 row = 0; row < PatchSize; row += step)
+			{
+				for (s32 col = 0; col < PatchSize; col += step)
+				{
+					if (!addCell(patchRow * PatchSize + row, patchCol * PatchSize + col, step, out))
+					{
+						outTriangleCount = out.Count;
+						return;
+					}
+				}
 			}
+		}
 	}
 
-	outTriangleCount = tIndex;
+	outTriangleCount = out.Count;
 }
 
 
@@ -124,35 +343,63 @@ void CTerrainTriangleSelector::getTriangles(core::triangle3df* triangles,
 		s32 arraySize, s32& outTriangleCount,
 		const core::aabbox3d<f32>& box, const core::matrix4* transform) const
 {
-	s32 count = TrianglePatches.TotalTriangles;
+	STriangleOutput out = { triangles, arraySize, 0, transform };
+	outTriangleCount = 0;
+
+	if (!CellCount)
+		return;
 
-	if (count > arraySize)
-		count = arraySize;
+	// the box in grid space
+	core::vector3df edges[8];
+	box.getEdges(edges);
 
-	core::matrix4 mat;
+	core::aabbox3df gridBox(toGridSpace(edges[0]));
+	for (u32 i = 1; i < 8; ++i)
+		gridBox.addInternalPoint(toGridSpace(edges[i]));
 
-	if (transform)
-		mat = (*transform);
+	// cells touching the box
+	const s32 firstRow = core::max_(core::ceil32(gridBox.MinEdge.X) - 1, 0);
+	const s32 lastRow = core::min_(core::floor32(gridBox.MaxEdge.X), CellCount - 1);
+	const s32 firstCol = core::max_(core::ceil32(gridBox.MinEdge.Z) - 1, 0);
+	const s32 lastCol = core::min_(core::floor32(gridBox.MaxEdge.Z), CellCount - 1);
 
-	s32 tIndex = 0;
+	if (firstRow > lastRow || firstCol > lastCol)
+		return;
 
-	for (s32 i=0; i<TrianglePatches.NumPatches; ++i)
+	for (s32 patchRow = firstRow / PatchSize; patchRow <= lastRow / PatchSize; ++patchRow)
 	{
-		if (tIndex + TrianglePatches.TrianglePatchArray[i].NumTriangles <= count &&
-			TrianglePatches.TrianglePatchArray[i].Box.intersectsWithBox(box))
-			for (s32 j=0; j<TrianglePatches.TrianglePatchArray[i].NumTriangles; ++j)
-			{
-				triangles[tIndex] = TrianglePatches.TrianglePatchArray[i].Triangles[j];
+		for (s32 patchCol = firstCol / PatchSize; patchCol <= lastCol / PatchSize; ++patchCol)
+		{
+			const s32 lod = PatchLOD[patchRow * PatchCount + patchCol];
+			if (lod < 0)
+				continue;
 
-				mat.transformVect(triangles[tIndex].pointA);
-				mat.transformVect(triangles[tIndex].pointB);
-				mat.transformVect(triangles[tIndex].pointC);
+			const s32 step = 1 << lod;
+			const s32 rowStart = patchRow * PatchSize;
+			const s32 colStart = patchCol * PatchSize;
 
-				++tIndex;
+			const s32 rowEnd = core::min_(lastRow, rowStart + PatchSize - 1);
+			const s32 colEnd = core::min_(lastCol, colStart + PatchSize - 1);
+
+			for (s32 row = rowStart + (core::max_(firstRow - rowStart, 0) / step) * step; row <= rowEnd; row += step)
+			{
+				for (s32 col = colStart + (core::max_(firstCol - colStart, 0) / step) * step; col <= colEnd; col += step)
+				{
+					const SHeightRange& range = getHeightRange(row, col, step);
+					if (range.Max < gridBox.MinEdge.Y || range.Min > gridBox.MaxEdge.Y)
+						continue;
+
+					if (!addCell(row, col, step, out))
+					{
+						outTriangleCount = out.Count;
+						return;
+					}
+				}
 			}
+		}
 	}
 
-	outTriangleCount = tIndex;
+	outTriangleCount = out.Count;
 }
 
 
@@ -161,41 +408,146 @@ void CTerrainTriangleSelector::getTriangles(core::triangle3df* triangles,
 		s32 arraySize, s32& outTriangleCount, const core::line3d<f32>& line,
 		const core::matrix4* transform) const
 {
-	const s32 count = core::min_((s32)TrianglePatches.TotalTriangles, arraySize);
+	STriangleOutput out = { triangles, arraySize, 0, transform };
+	outTriangleCount = 0;
 
-	core::matrix4 mat;
+	if (!CellCount)
+		return;
 
-	if (transform)
-		mat = (*transform);
+	// the line in grid space, X are the rows and Z the columns of the grid
+	const core::vector3df start = toGridSpace(line.start);
+	const core::vector3df dir = toGridSpace(line.end) - start;
 
-	s32 tIndex = 0;
+	// clip the line against the cells
+	f32 tStart = 0.f;
+	f32 tEnd = 1.f;
 
-	for (s32 i=0; i<TrianglePatches.NumPatches; ++i)
+	for (u32 axis = 0; axis < 2; ++axis)
 	{
-		if (tIndex + TrianglePatches.TrianglePatchArray[i].NumTriangles <= count
-            && TrianglePatches.TrianglePatchArray[i].Box.intersectsWithLine(line))
+		const f32 s = axis ? start.Z : start.X;
+		const f32 d = axis ? dir.Z : dir.X;
+
+		if (d == 0.f)
 		{
-			for (s32 j=0; j<TrianglePatches.TrianglePatchArray[i].NumTriangles; ++j)
+			if (s < 0.f || s > (f32)CellCount)
+				return;
+			continue;
+		}
+
+		f32 t0 = -s / d;
+		f32 t1 = ((f32)CellCount - s) / d;
+		if (t0 > t1)
+			core::swap(t0, t1);
+
+		tStart = core::max_(tStart, t0);
+		tEnd = core::min_(tEnd, t1);
+	}
+
+	if (tStart > tEnd)
+		return;
+
+	s32 row = core::s32_clamp(core::floor32(start.X + dir.X * tStart), 0, CellCount - 1);
+	s32 col = core::s32_clamp(core::floor32(start.Z + dir.Z * tStart), 0, CellCount - 1);
+	f32 t = tStart;
+
+	// march over squares of cells, either a tile which the line passes
+	// above or below, or the cell of a patch which triangles are created for
+	while (true)
+	{
+		s32 regionRow = 0;
+		s32 regionCol = 0;
+		s32 regionSize = 0;
+
+		const s32 step = getCellStep(row, col);
+		if (!step)
+		{
+			// the patch has no triangles
+			regionRow = (row / PatchSize) * PatchSize;
+			regionCol = (col / PatchSize) * PatchSize;
+			regionSize = PatchSize;
+		}
+		else
+		{
+			// the largest tile which the line doesn't touch, tiles smaller
+			// than the cells of the patch don't bound its triangles
+			for (s32 i = (s32)HeightLevels.size() - 1; i >= 0 && HeightLevels[i].TileSize >= step; --i)
 			{
-				triangles[tIndex] = TrianglePatches.TrianglePatchArray[i].Triangles[j];
+				const SHeightLevel& level = HeightLevels[i];
+				const s32 tileRow = row / level.TileSize;
+				const s32 tileCol = col / level.TileSize;
+
+				f32 tExit = tEnd;
+				if (dir.X > 0.f)
+					tExit = core::min_(tExit, ((tileRow + 1) * level.TileSize - start.X) / dir.X);
+				else if (dir.X < 0.f)
+					tExit = core::min_(tExit, (tileRow * level.TileSize - start.X) / dir.X);
+				if (dir.Z > 0.f)
+					tExit = core::min_(tExit, ((tileCol + 1) * level.TileSize - start.Z) / dir.Z);
+				else if (dir.Z < 0.f)
+					tExit = core::min_(tExit, (tileCol * level.TileSize - start.Z) / dir.Z);
+
+				const f32 y0 = start.Y + dir.Y * t;
+				const f32 y1 = start.Y + dir.Y * tExit;
+
+				const SHeightRange& range = level.Tiles[tileRow * level.TileCount + tileCol];
+				if (core::max_(y0, y1) < range.Min || core::min_(y0, y1) > range.Max)
+				{
+					regionRow = tileRow * level.TileSize;
+					regionCol = tileCol * level.TileSize;
+					regionSize = level.TileSize;
+					break;
+				}
+			}
 
-				mat.transformVect(triangles[tIndex].pointA);
-				mat.transformVect(triangles[tIndex].pointB);
-				mat.transformVect(triangles[tIndex].pointC);
+			if (!regionSize)
+			{
+				regionRow = row - (row % PatchSize) % step;
+				regionCol = col - (col % PatchSize) % step;
+				regionSize = step;
 
-				++tIndex;
+				if (!addCell(regionRow, regionCol, step, out))
+					break;
 			}
 		}
+
+		// leave the square through the side the line hits first
+		f32 tRow = FLT_MAX;
+		f32 tCol = FLT_MAX;
+		if (dir.X > 0.f)
+			tRow = (regionRow + regionSize - start.X) / dir.X;
+		else if (dir.X < 0.f)
+			tRow = (regionRow - start.X) / dir.X;
+		if (dir.Z > 0.f)
+			tCol = (regionCol + regionSize - start.Z) / dir.Z;
+		else if (dir.Z < 0.f)
+			tCol = (regionCol - start.Z) / dir.Z;
+
+		t = core::min_(tRow, tCol);
+		if (t >= tEnd)
+			break;
+
+		if (tRow <= tCol)
+			row = (dir.X > 0.f) ? regionRow + regionSize : regionRow - 1;
+		else
+			row = core::s32_clamp(core::floor32(start.X + dir.X * t), regionRow, regionRow + regionSize - 1);
+
+		if (tCol <= tRow)
+			col = (dir.Z > 0.f) ? regionCol + regionSize : regionCol - 1;
+		else
+			col = core::s32_clamp(core::floor32(start.Z + dir.Z * t), regionCol, regionCol + regionSize - 1);
+
+		if (row < 0 || row >= CellCount || col < 0 || col >= CellCount)
+			break;
 	}
 
-	outTriangleCount = tIndex;
+	outTriangleCount = out.Count;
 }
 
 
 //! Returns amount of all available triangles in this selector
 s32 CTerrainTriangleSelector::getTriangleCount() const
 {
-	return TrianglePatches.TotalTriangles;
+	return TotalTriangles;
 }
 
 
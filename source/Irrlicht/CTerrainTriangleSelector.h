@@ -18,12 +18,19 @@ namespace scene
 {
 
 class ITerrainSceneNode;
+class IMeshBuffer;
 
 //! Triangle Selector for the TerrainSceneNode
 /** The code for the TerrainTriangleSelector is based on the GeoMipMapSelector
 developed by Spintz. He made it available for Irrlicht and allowed it to be
 distributed under this licence. I only modified some parts. A lot of thanks go
 to him.
+
+The selector doesn't store triangles. It queries the height grid of the
+terrain mesh and creates the triangles of the cells a query touches, at the
+level of detail of their patch. A pyramid of tiles with the minimal and
+maximal height of their cells lets queries skip cells far away from a box or
+a line, lines march over the cells of the grid like a 2d DDA.
 */
 class CTerrainTriangleSelector : public ITriangleSelector
 {
@@ -36,6 +43,9 @@ public:
 	virtual ~CTerrainTriangleSelector();
 
 	//! Clears and sets triangle data
+	/** Takes the height grid, the transformation and the level of detail
+	of the patches of the terrain. A LOD of -1 uses the current LOD of each
+	patch. */
 	virtual void setTriangleData(ITerrainSceneNode* node, s32 LOD);
 
 	//! Gets all triangles.
@@ -70,27 +80,87 @@ private:
 
 	friend class CTerrainSceneNode;
 
-	struct SGeoMipMapTrianglePatch
+	//! cells of a tile on the finest level of the height pyramid
+	enum { TILE_SIZE = 4 };
+
+	//! minimal and maximal height of the cells of a tile
+	struct SHeightRange
+	{
+		f32 Min;
+		f32 Max;
+	};
+
+	//! one level of the height pyramid
+	struct SHeightLevel
 	{
-		core::array<core::triangle3df> Triangles;
-		s32 NumTriangles;
-		core::aabbox3df Box;
+		core::array<SHeightRange> Tiles;
+		s32 TileSize;
+		s32 TileCount;
 	};
 
-	struct SGeoMipMapTrianglePatches
+	//! collects created triangles
+	struct STriangleOutput
 	{
-		SGeoMipMapTrianglePatches() :
-			NumPatches(0), TotalTriangles(0)
-		{
-		}
-
-		core::array<SGeoMipMapTrianglePatch> TrianglePatchArray;
-		s32 NumPatches;
-		u32 TotalTriangles;
+		core::triangle3df* Triangles;
+		s32 ArraySize;
+		s32 Count;
+		const core::matrix4* Transform;
 	};
 
+	//! builds the height pyramid from the grid
+	void buildHeightLevels();
+
+	//! returns the height of a grid vertex
+	f32 getGridHeight(s32 row, s32 col) const
+	{
+		return ((const core::vector3df*)(Positions + (row * Size + col) * Stride))->Y;
+	}
+
+	//! returns the position of a grid vertex in world space
+	core::vector3df getVertexPosition(s32 row, s32 col) const;
+
+	//! transforms a position into grid space
+	core::vector3df toGridSpace(const core::vector3df& position) const;
+
+	//! returns the height range of a square of cells, aligned to its size
+	const SHeightRange& getHeightRange(s32 row, s32 col, s32 size) const;
+
+	//! returns the step between the vertices of the patch of a cell
+	s32 getCellStep(s32 row, s32 col) const;
+
+	//! returns the grid vertex of a patch, moved onto the edges of coarser neighbours
+	void getPatchVertex(s32 patchRow, s32 patchCol, s32 row, s32 col, s32& outRow, s32& outCol) const;
+
+	//! creates the two triangles of a cell at the level of detail of its patch
+	/** \return false if the output is full */
+	bool addCell(s32 row, s32 col, s32 step, STriangleOutput& out) const;
+
 	ITerrainSceneNode* SceneNode;
-	SGeoMipMapTrianglePatches TrianglePatches;
+
+	//! mesh buffer with the height grid, in grid space
+	IMeshBuffer* HeightBuffer;
+	const u8* Positions;
+	u32 Stride;
+
+	//! vertices per side of the grid
+	s32 Size;
+
+	//! cells per side of a patch and of all patches
+	s32 PatchSize;
+	s32 PatchCount;
+	s32 CellCount;
+
+	//! LOD of each patch, -1 for patches without triangles
+	core::array<s32> PatchLOD;
+	s32 TotalTriangles;
+
+	core::array<SHeightLevel> HeightLevels;
+
+	// transformation of the terrain when the data was set
+	core::vector3df Position;
+	core::vector3df Scale;
+	core::vector3df RotationPivot;
+	core::matrix4 Rotation;
 };
 
 } // end namespace scene
@@ -754,10 +754,14 @@ bool CXMeshFileLoader::parseDataObjectMesh(SXMesh &mesh)
 	const u32 nVertices = readInt();
 
 	// read vertices
+	core::array<f32> positions;
+	positions.set_used(nVertices*3);
+	readFloats(positions.pointer(), nVertices*3);
+
 	mesh.Vertices.set_used(nVertices);
 	for (u32 n=0; n<nVertices; ++n)
 	{
-		readVector3(mesh.Vertices[n].Pos);
+		mesh.Vertices[n].Pos.set(positions[n*3], positions[n*3+1], positions[n*3+2]);
 		mesh.Vertices[n].Color=0xFFFFFFFF;
 	}
 
@@ -795,8 +799,7 @@ bool CXMeshFileLoader::parseDataObjectMesh(SXMesh &mesh)
 			mesh.Indices.set_used(mesh.Indices.size() + ((triangles-1)*3));
 			mesh.IndexCountPerFace[k] = (u16)(triangles * 3);
 
-			for (u32 f=0; f<fcnt; ++f)
-				polygonfaces[f] = readInt();
+			readInts(polygonfaces.pointer(), fcnt);
 
 			for (u32 jk=0; jk<triangles; ++jk)
 			{
@@ -809,9 +812,8 @@ bool CXMeshFileLoader::parseDataObjectMesh(SXMesh &mesh)
 		}
 		else
 		{
-			mesh.Indices[currentIndex++] = readInt();
-			mesh.Indices[currentIndex++] = readInt();
-			mesh.Indices[currentIndex++] = readInt();
+			readInts(&mesh.Indices[currentIndex], 3);
+			currentIndex += 3;
 			mesh.IndexCountPerFace[k] = 3;
 		}
 	}
@@ -1140,6 +1142,10 @@ bool CXMeshFileLoader::parseDataObjectSkinWeights(SXMesh &mesh)
 	mesh.WeightJoint.reallocate( mesh.WeightJoint.size() + nWeights );
 	mesh.WeightNum.reallocate( mesh.WeightNum.size() + nWeights );
 
+	core::array<u32> vertexIds;
+	vertexIds.set_used(nWeights);
+	readInts(vertexIds.pointer(), nWeights);
+
 	for (i=0; i<nWeights; ++i)
 	{
 		mesh.WeightJoint.push_back(n);
@@ -1148,13 +1154,16 @@ bool CXMeshFileLoader::parseDataObjectSkinWeights(SXMesh &mesh)
 		CSkinnedMesh::SWeight *weight=AnimatedMesh->addWeight(joint);
 
 		weight->buffer_id=0;
-		weight->vertex_id=readInt();
+		weight->vertex_id=vertexIds[i];
 	}
 
 	// read vertex weights
+	core::array<f32> strengths;
+	strengths.set_used(nWeights);
+	readFloats(strengths.pointer(), nWeights);
 
-	for (i=jointStart; i<jointStart+nWeights; ++i)
-		joint->Weights[i].strength = readFloat();
+	for (i=0; i<nWeights; ++i)
+		joint->Weights[jointStart+i].strength = strengths[i];
 
 	// read matrix offset
 
@@ -1232,8 +1241,8 @@ bool CXMeshFileLoader::parseDataObjectMeshNormals(SXMesh &mesh)
 	normals.set_used(nNormals);
 
 	// read normals
-	for (u32 i=0; i<nNormals; ++i)
-		readVector3(normals[i]);
+	if (nNormals)
+		readFloats(&normals[0].X, nNormals*3);
 
 	if (!checkForTwoFollowingSemicolons())
 	{
@@ -1265,18 +1274,16 @@ bool CXMeshFileLoader::parseDataObjectMeshNormals(SXMesh &mesh)
 		if (indexcount == 3)
 		{
 			// default, only one triangle in this face
+			u32 normalnum[3];
+			readInts(normalnum, 3);
 			for (u32 h=0; h<3; ++h)
-			{
-				const u32 normalnum = readInt();
-				mesh.Vertices[mesh.Indices[normalidx++]].Normal.set(normals[normalnum]);
-			}
+				mesh.Vertices[mesh.Indices[normalidx++]].Normal.set(normals[normalnum[h]]);
 		}
 		else
 		{
 			polygonfaces.set_used(fcnt);
 			// multiple triangles in this face
-			for (u32 h=0; h<fcnt; ++h)
-				polygonfaces[h] = readInt();
+			readInts(polygonfaces.pointer(), fcnt);
 
 			for (u32 jk=0; jk<triangles; ++jk)
 			{
@@ -1318,8 +1325,13 @@ bool CXMeshFileLoader::parseDataObjectMeshTextureCoords(SXMesh &mesh)
 	}
 
 	const u32 nCoords = readInt();
-	for (u32 i=0; i<nCoords; ++i)
-		readVector2(mesh.Vertices[i].TCoords);
+	core::array<f32> coords;
+	coords.set_used(nCoords*2);
+	readFloats(coords.pointer(), nCoords*2);
+
+	const u32 nUsed = core::min_(nCoords, mesh.Vertices.size());
+	for (u32 i=0; i<nUsed; ++i)
+		mesh.Vertices[i].TCoords.set(coords[i*2], coords[i*2+1]);
 
 	if (!checkForTwoFollowingSemicolons())
 	{
@@ -1779,10 +1791,12 @@ bool CXMeshFileLoader::parseDataObjectAnimationKey(ISkinnedMesh::SJoint *joint)
 					return false;
 				}
 
-				f32 W = -readFloat();
-				f32 X = -readFloat();
-				f32 Y = -readFloat();
-				f32 Z = -readFloat();
+				f32 q[4];
+				readFloats(q, 4);
+				const f32 W = -q[0];
+				const f32 X = -q[1];
+				const f32 Y = -q[2];
+				const f32 Z = -q[3];
 
 				if (!checkForTwoFollowingSemicolons())
 				{
@@ -1809,7 +1823,7 @@ bool CXMeshFileLoader::parseDataObjectAnimationKey(ISkinnedMesh::SJoint *joint)
 				}
 
 				core::vector3df vector;
-				readVector3(vector);
+				readFloats(&vector.X, 3);
 
 				if (!checkForTwoFollowingSemicolons())
 				{
@@ -1971,7 +1985,7 @@ bool CXMeshFileLoader::parseUnknownDataObject()
 //! checks for closing curly brace, returns false if not there
 bool CXMeshFileLoader::checkForClosingBrace()
 {
-	return (getNextToken() == "}");
+	return (getNextTokenView() == "}");
 }
 
 
@@ -1981,7 +1995,7 @@ bool CXMeshFileLoader::checkForOneFollowingSemicolons()
 	if (BinaryFormat)
 		return true;
 
-	if (getNextToken() == ";")
+	if (getNextTokenView() == ";")
 		return true;
 	else
 	{
@@ -1999,7 +2013,7 @@ bool CXMeshFileLoader::checkForTwoFollowingSemicolons()
 
 	for (u32 k=0; k<2; ++k)
 	{
-		if (getNextToken() != ";")
+		if (getNextTokenView() != ";")
 		{
 			--P;
 			return false;
@@ -2015,13 +2029,13 @@ bool CXMeshFileLoader::checkForTwoFollowingSemicolons()
 //! if there is one
 bool CXMeshFileLoader::readHeadOfDataObject(core::stringc* outname)
 {
-	core::stringc nameOrBrace = getNextToken();
+	const SXToken nameOrBrace = getNextTokenView();
 	if (nameOrBrace != "{")
 	{
 		if (outname)
-			(*outname) = nameOrBrace;
+			(*outname) = core::stringc(nameOrBrace.Start, nameOrBrace.Length);
 
-		if (getNextToken() != "{")
+		if (getNextTokenView() != "{")
 			return false;
 	}
 
@@ -2032,7 +2046,15 @@ bool CXMeshFileLoader::readHeadOfDataObject(core::stringc* outname)
 //! returns next parseable token. Returns empty string if no token there
 core::stringc CXMeshFileLoader::getNextToken()
 {
-	core::stringc s;
+	const SXToken token = getNextTokenView();
+	return core::stringc(token.Start, token.Length);
+}
+
+
+//! returns next parseable token without copying it
+CXMeshFileLoader::SXToken CXMeshFileLoader::getNextTokenView()
+{
+	SXToken token;
 
 	// process binary-formatted file
 	if (BinaryFormat)
@@ -2048,81 +2070,83 @@ core::stringc CXMeshFileLoader::getNextToken()
 			case 1:
 				// name token
 				len = readBinDWord();
-				s = core::stringc(P, len);
+				token.Start = P;
+				token.Length = len;
 				P += len;
-				return s;
+				return token;
 			case 2:
 				// string token
 				len = readBinDWord();
-				s = core::stringc(P, len);
+				token.Start = P;
+				token.Length = len;
 				P += (len + 2);
-				return s;
+				return token;
 			case 3:
 				// integer token
 				P += 4;
-				return "<integer>";
+				return token.set("<integer>");
 			case 5:
 				// GUID token
 				P += 16;
-				return "<guid>";
+				return token.set("<guid>");
 			case 6:
 				len = readBinDWord();
 				P += (len * 4);
-				return "<int_list>";
+				return token.set("<int_list>");
 			case 7:
 				len = readBinDWord();
 				P += (len * FloatSize);
-				return "<flt_list>";
+				return token.set("<flt_list>");
 			case 0x0a:
-				return "{";
+				return token.set("{");
 			case 0x0b:
-				return "}";
+				return token.set("}");
 			case 0x0c:
-				return "(";
+				return token.set("(");
 			case 0x0d:
-				return ")";
+				return token.set(")");
 			case 0x0e:
-				return "[";
+				return token.set("[");
 			case 0x0f:
-				return "]";
+				return token.set("]");
 			case 0x10:
-				return "<";
+				return token.set("<");
 			case 0x11:
-				return ">";
+				return token.set(">");
 			case 0x12:
-				return ".";
+				return token.set(".");
 			case 0x13:
-				return ",";
+				return token.set(",");
 			case 0x14:
-				return ";";
+				return token.set(";");
 			case 0x1f:
-				return "template";
+				return token.set("template");
 			case 0x28:
-				return "WORD";
+				return token.set("WORD");
 			case 0x29:
-				return "DWORD";
+				return token.set("DWORD");
 			case 0x2a:
-				return "FLOAT";
+				return token.set("FLOAT");
 			case 0x2b:
-				return "DOUBLE";
+				return token.set("DOUBLE");
 			case 0x2c:
-				return "CHAR";
+				return token.set("CHAR");
 			case 0x2d:
-				return "UCHAR";
+				return token.set("UCHAR");
 			case 0x2e:
-				return "SWORD";
+				return token.set("SWORD");
 			case 0x2f:
-				return "SDWORD";
+				return token.set("SDWORD");
 			case 0x30:
-				return "void";
+				return token.set("void");
 			case 0x31:
-				return "string";
+				return token.set("string");
 			case 0x32:
-				return "unicode";
+				return token.set("unicode");
 			case 0x33:
-				return "cstring";
+				return token.set("cstring");
 			case 0x34:
-				return "array";
+				return token.set("array");
 		}
 	}
 	// process text-formatted file
@@ -2130,26 +2154,25 @@ core::stringc CXMeshFileLoader::getNextToken()
 	{
 		findNextNoneWhiteSpace();
 
+		token.Start = P;
 		if (P >= End)
-			return s;
+			return token;
 
-		while((P < End) && !core::isspace(P[0]))
+		// delimiters are tokens of their own
+		if (P[0]==';' || P[0]=='}' || P[0]=='{' || P[0]==',')
 		{
-			// either keep token delimiters when already holding a token, or return if first valid char
-			if (P[0]==';' || P[0]=='}' || P[0]=='{' || P[0]==',')
-			{
-				if (!s.size())
-				{
-					s.append(P[0]);
-					++P;
-				}
-				break; // stop for delimiter
-			}
-			s.append(P[0]);
 			++P;
+			token.Length = 1;
+			return token;
 		}
+
+		while((P < End) && !core::isspace(P[0]) &&
+			P[0]!=';' && P[0]!='}' && P[0]!='{' && P[0]!=',')
+			++P;
+
+		token.Length = (u32)(P - token.Start);
 	}
-	return s;
+	return token;
 }
 
 
@@ -2346,11 +2369,111 @@ f32 CXMeshFileLoader::readFloat()
 }
 
 
+//! reads count integers. Binary number lists are copied in one go
+void CXMeshFileLoader::readInts(u32* out, u32 count)
+{
+	if (!BinaryFormat)
+	{
+		for (u32 i=0; i<count; ++i)
+		{
+			findNextNoneWhiteSpaceNumber();
+			out[i] = core::strtoul10(P, &P);
+		}
+		return;
+	}
+
+	while (count)
+	{
+		if (!BinaryNumCount)
+		{
+			const u16 tmp = readBinWord(); // 0x06 or 0x03
+			if (tmp == 0x06)
+				BinaryNumCount = readBinDWord();
+			else
+				BinaryNumCount = 1; // single int
+			if (!BinaryNumCount)
+			{
+				// broken file, empty list
+				memset(out, 0, count*sizeof(u32));
+				return;
+			}
+		}
+
+		const u32 n = core::min_(count, BinaryNumCount);
+#ifndef __BIG_ENDIAN__
+		if (P + n*sizeof(u32) <= End)
+		{
+			memcpy(out, P, n*sizeof(u32));
+			P += n*sizeof(u32);
+		}
+		else
+#endif
+		{
+			for (u32 i=0; i<n; ++i)
+				out[i] = readBinDWord();
+		}
+		out += n;
+		count -= n;
+		BinaryNumCount -= n;
+	}
+}
+
+
+//! reads count floats. Binary number lists are copied in one go
+void CXMeshFileLoader::readFloats(f32* out, u32 count)
+{
+	if (!BinaryFormat)
+	{
+		for (u32 i=0; i<count; ++i)
+		{
+			findNextNoneWhiteSpaceNumber();
+			P = core::fast_atof_move(P, out[i]);
+		}
+		return;
+	}
+
+	while (count)
+	{
+		if (!BinaryNumCount)
+		{
+			const u16 tmp = readBinWord(); // 0x07 or 0x42
+			if (tmp == 0x07)
+				BinaryNumCount = readBinDWord();
+			else
+				BinaryNumCount = 1; // single float
+			if (!BinaryNumCount)
+			{
+				// broken file, empty list
+				memset(out, 0, count*sizeof(f32));
+				return;
+			}
+		}
+
+		const u32 n = core::min_(count, BinaryNumCount);
+#ifndef __BIG_ENDIAN__
+		if ((FloatSize == 4) && (P + n*sizeof(f32) <= End))
+		{
+			memcpy(out, P, n*sizeof(f32));
+			P += n*sizeof(f32);
+			BinaryNumCount -= n;
+		}
+		else
+#endif
+		{
+			// readFloat handles doubles and endianess
+			for (u32 i=0; i<n; ++i)
+				out[i] = readFloat();
+		}
+		out += n;
+		count -= n;
+	}
+}
+
+
 // read 2-dimensional vector. Stops at semicolon after second value for text file format
 bool CXMeshFileLoader::readVector2(core::vector2df& vec)
 {
-	vec.X = readFloat();
-	vec.Y = readFloat();
+	readFloats(&vec.X, 2);
 	return true;
 }
 
@@ -2358,9 +2481,7 @@ bool CXMeshFileLoader::readVector2(core::vector2df& vec)
 // read 3-dimensional vector. Stops at semicolon after third value for text file format
 bool CXMeshFileLoader::readVector3(core::vector3df& vec)
 {
-	vec.X = readFloat();
-	vec.Y = readFloat();
-	vec.Z = readFloat();
+	readFloats(&vec.X, 3);
 	return true;
 }
 
@@ -2393,8 +2514,7 @@ bool CXMeshFileLoader::readRGBA(video::SColor& color)
 // read matrix from list of floats
 bool CXMeshFileLoader::readMatrix(core::matrix4& mat)
 {
-	for (u32 i=0; i<16; ++i)
-		mat[i] = readFloat();
+	readFloats(mat.pointer(), 16);
 	return checkForOneFollowingSemicolons();
 }
 
@@ -86,6 +86,37 @@ public:
 
 private:
 
+	//! token referring into the file buffer, avoids a string copy per token
+	struct SXToken
+	{
+		SXToken() : Start(0), Length(0) {}
+
+		bool operator==(const c8* str) const
+		{
+			u32 i=0;
+			for (; i<Length; ++i)
+				if (Start[i] != str[i])
+					return false;
+			return str[i] == 0;
+		}
+
+		bool operator!=(const c8* str) const
+		{
+			return !(*this == str);
+		}
+
+		//! points the token to a constant string
+		const SXToken& set(const c8* str)
+		{
+			Start = str;
+			Length = (u32)strlen(str);
+			return *this;
+		}
+
+		const c8* Start;
+		u32 Length;
+	};
+
 	bool load(io::IReadFile* file);
 
 	bool readFileIntoMemory(io::IReadFile* file);
@@ -136,6 +167,10 @@ private:
 	//! returns next parseable token. Returns empty string if no token there
 	core::stringc getNextToken();
 
+	//! returns next parseable token without copying it.
+	//! The token is only valid as long as the file buffer exists.
+	SXToken getNextTokenView();
+
 	//! reads header of dataobject including the opening brace.
 	//! returns false if error happened, and writes name of object
 	//! if there is one
@@ -159,6 +194,9 @@ private:
 	u32 readBinDWord();
 	u32 readInt();
 	f32 readFloat();
+	//! reads count numbers into out, faster than count single reads
+	void readInts(u32* out, u32 count);
+	void readFloats(f32* out, u32 count);
 	bool readVector2(core::vector2df& vec);
 	bool readVector3(core::vector3df& vec);
 	bool readMatrix(core::matrix4& mat);
@@ -16,7 +16,13 @@ extern "C" void bz_internal_error(int errorCode)
 
 #include "CFileList.h"
 #include "CReadFile.h"
+#include "IWriteFile.h"
+#include "CInflateReadFile.h"
 #include "coreutil.h"
+#include "irrHashMap.h"
+
+#include <sys/types.h>
+#include <sys/stat.h>
 
 #include "IrrCompileConfig.h"
 #ifdef _IRR_COMPILE_WITH_ZLIB_
@@ -52,12 +58,23 @@ namespace io
 // -----------------------------------------------------------------------------
 
 //! Constructor
-CArchiveLoaderZIP::CArchiveLoaderZIP(io::IFileSystem* fs)
-: FileSystem(fs)
+CArchiveLoaderZIP::CArchiveLoaderZIP(io::IFileSystem* fs, CArchiveEntryCache* cache)
+: FileSystem(fs), EntryCache(cache)
 {
 	#ifdef _DEBUG
 	setDebugName("CArchiveLoaderZIP");
 	#endif
+
+	if (EntryCache)
+		EntryCache->grab();
+}
+
+
+//! Destructor
+CArchiveLoaderZIP::~CArchiveLoaderZIP()
+{
+	if (EntryCache)
+		EntryCache->drop();
 }
 
 //! returns true if the file maybe is able to be loaded by this class
@@ -111,7 +128,7 @@ IFileArchive* CArchiveLoaderZIP::createArchive(io::IReadFile* file, bool ignoreC
 
 		bool isGZip = (sig == 0x8b1f);
 
-		archive = new CZipReader(FileSystem, file, ignoreCase, ignorePaths, isGZip);
+		archive = new CZipReader(FileSystem, file, ignoreCase, ignorePaths, isGZip, EntryCache);
 	}
 	return archive;
 }
@@ -137,34 +154,226 @@ bool CArchiveLoaderZIP::isALoadableFileFormat(io::IReadFile* file) const
 // zip archive
 // -----------------------------------------------------------------------------
 
-CZipReader::CZipReader(IFileSystem* fs, IReadFile* file, bool ignoreCase, bool ignorePaths, bool isGZip)
- : CFileList((file ? file->getFileName() : io::path("")), ignoreCase, ignorePaths), FileSystem(fs), File(file), IsGZip(isGZip)
+namespace
+{
+	// 'ZDIR' and the version of the index cache files
+	const u32 ZIP_INDEX_CACHE_ID = 0x5249445a;
+	const u32 ZIP_INDEX_CACHE_VERSION = 1;
+
+	//! modification time of a file on disk, 0 if the file is not on disk
+	s64 getModificationTime(const io::path& filename)
+	{
+#if defined(_IRR_WCHAR_FILESYSTEM) && defined(_IRR_WINDOWS_API_)
+		struct _stat buf;
+		if (_wstat(filename.c_str(), &buf) == 0)
+			return buf.st_mtime;
+#elif !defined(_IRR_WCHAR_FILESYSTEM)
+		struct stat buf;
+		if (stat(filename.c_str(), &buf) == 0)
+			return buf.st_mtime;
+#endif
+		return 0;
+	}
+
+	void writeString(IWriteFile* file, const io::path& str)
+	{
+		const u32 size = str.size();
+		file->write(&size, sizeof(size));
+		file->write(str.c_str(), size * sizeof(fschar_t));
+	}
+
+	bool readString(IReadFile* file, io::path& str)
+	{
+		u32 size = 0;
+		if (file->read(&size, sizeof(size)) != sizeof(size) || size > 0xffff)
+			return false;
+
+		core::array<fschar_t> tmp(size+1);
+		tmp.set_used(size+1);
+		if (file->read(tmp.pointer(), size * sizeof(fschar_t)) != (s32)(size * sizeof(fschar_t)))
+			return false;
+
+		tmp[size] = 0;
+		str = tmp.const_pointer();
+		return true;
+	}
+}
+
+
+CZipReader::CZipReader(IFileSystem* fs, IReadFile* file, bool ignoreCase, bool ignorePaths, bool isGZip, CArchiveEntryCache* cache)
+ : CFileList((file ? file->getFileName() : io::path("")), ignoreCase, ignorePaths), FileSystem(fs), File(file), IsGZip(isGZip),
+ EntryCache(cache), CacheID(0)
 {
 	#ifdef _DEBUG
 	setDebugName("CZipReader");
 	#endif
 
+	if (EntryCache)
+	{
+		EntryCache->grab();
+		CacheID = EntryCache->addArchive();
+	}
+
 	if (File)
 	{
 		File->grab();
 
 		// load file entries
 		if (IsGZip)
+		{
 			while (scanGZipHeader()) { }
+			sort();
+		}
 		else
-			while (scanZipHeader()) { }
+		{
+			// the file list of an unchanged archive is taken from the index cache
+			const io::path cacheName = getIndexCacheName();
+			const s64 modificationTime = cacheName.size() ? getModificationTime(File->getFileName()) : 0;
 
-		sort();
+			if (!modificationTime || !readIndexCache(cacheName, modificationTime))
+			{
+				while (scanZipHeader()) { }
+				sort();
+
+				if (modificationTime)
+					writeIndexCache(cacheName, modificationTime);
+			}
+		}
 	}
 }
 
 CZipReader::~CZipReader()
 {
+	if (EntryCache)
+	{
+		EntryCache->removeArchive(CacheID);
+		EntryCache->drop();
+	}
+
 	if (File)
 		File->drop();
 }
 
 
+//! returns the name of the index cache file of the archive, empty if there is none
+io::path CZipReader::getIndexCacheName() const
+{
+	io::path name = FileSystem->getArchiveIndexCacheDirectory();
+	if (name.size())
+	{
+		if (name.lastChar() != '/')
+			name += '/';
+		name += io::path(core::hash_traits<io::path>::hash(File->getFileName()));
+		name += ".zdir";
+	}
+	return name;
+}
+
+
+//! reads the file list from the index cache, returns false if it is missing or outdated
+/** The cache holds the entries and the sorted file list, so the archive
+isn't read at all. It is only taken if name, size and modification time of
+the archive and the flags of the file list are the same. */
+bool CZipReader::readIndexCache(const io::path& cacheName, s64 modificationTime)
+{
+	IReadFile* cache = CReadFile::createReadFile(cacheName);
+	if (!cache)
+		return false;
+
+	u32 id = 0;
+	u32 version = 0;
+	s64 size = 0;
+	s64 time = 0;
+	u8 flags[2] = {0, 0};
+	io::path archiveName;
+	bool valid = cache->read(&id, sizeof(id)) == sizeof(id) && id == ZIP_INDEX_CACHE_ID &&
+		cache->read(&version, sizeof(version)) == sizeof(version) && version == ZIP_INDEX_CACHE_VERSION &&
+		cache->read(&size, sizeof(size)) == sizeof(size) && size == File->getSize() &&
+		cache->read(&time, sizeof(time)) == sizeof(time) && time == modificationTime &&
+		cache->read(flags, 2) == 2 && flags[0] == IgnoreCase && flags[1] == IgnorePaths &&
+		readString(cache, archiveName) && archiveName == File->getFileName();
+
+	u32 count = 0;
+	if (valid && cache->read(&count, sizeof(count)) == sizeof(count) && (long)count <= cache->getSize())
+	{
+		FileInfo.set_used(count);
+		valid = cache->read(FileInfo.pointer(), count * sizeof(SZipFileEntry)) == (s32)(count * sizeof(SZipFileEntry));
+	}
+	else
+		valid = false;
+
+	if (valid && cache->read(&count, sizeof(count)) == sizeof(count) && (long)count <= cache->getSize())
+	{
+		Files.reallocate(count);
+		for (u32 i = 0; valid && i < count; ++i)
+		{
+			SFileListEntry entry;
+			u8 isDirectory = 0;
+			valid = readString(cache, entry.Name) && readString(cache, entry.FullName) &&
+				cache->read(&entry.Size, sizeof(entry.Size)) == sizeof(entry.Size) &&
+				cache->read(&entry.ID, sizeof(entry.ID)) == sizeof(entry.ID) &&
+				cache->read(&entry.Offset, sizeof(entry.Offset)) == sizeof(entry.Offset) &&
+				cache->read(&isDirectory, 1) == 1 && entry.ID < FileInfo.size();
+			entry.IsDirectory = isDirectory != 0;
+			Files.push_back(entry);
+		}
+	}
+	else
+		valid = false;
+
+	cache->drop();
+
+	if (!valid)
+	{
+		FileInfo.clear();
+		Files.clear();
+	}
+
+	return valid;
+}
+
+
+//! writes the file list to the index cache
+void CZipReader::writeIndexCache(const io::path& cacheName, s64 modificationTime) const
+{
+	IWriteFile* cache = FileSystem->createAndWriteFile(cacheName);
+	if (!cache)
+	{
+		os::Printer::log("Could not write zip index cache", cacheName, ELL_DEBUG);
+		return;
+	}
+
+	const s64 size = File->getSize();
+	const u8 flags[2] = { IgnoreCase, IgnorePaths };
+	cache->write(&ZIP_INDEX_CACHE_ID, sizeof(ZIP_INDEX_CACHE_ID));
+	cache->write(&ZIP_INDEX_CACHE_VERSION, sizeof(ZIP_INDEX_CACHE_VERSION));
+	cache->write(&size, sizeof(size));
+	cache->write(&modificationTime, sizeof(modificationTime));
+	cache->write(flags, 2);
+	writeString(cache, File->getFileName());
+
+	u32 count = FileInfo.size();
+	cache->write(&count, sizeof(count));
+	cache->write(FileInfo.const_pointer(), count * sizeof(SZipFileEntry));
+
+	count = Files.size();
+	cache->write(&count, sizeof(count));
+	for (u32 i = 0; i < count; ++i)
+	{
+		const SFileListEntry& entry = Files[i];
+		const u8 isDirectory = entry.IsDirectory;
+		writeString(cache, entry.Name);
+		writeString(cache, entry.FullName);
+		cache->write(&entry.Size, sizeof(entry.Size));
+		cache->write(&entry.ID, sizeof(entry.ID));
+		cache->write(&entry.Offset, sizeof(entry.Offset));
+		cache->write(&isDirectory, 1);
+	}
+
+	cache->drop();
+}
+
+
 //! get the archive type
 E_FILE_ARCHIVE_TYPE CZipReader::getType() const
 {
@@ -500,6 +709,22 @@ namespace
 
 //! opens a file by index
 IReadFile* CZipReader::createAndOpenFile(u32 index)
+{
+	if (index >= Files.size() )
+		return 0;
+
+	if (!EntryCache)
+		return createAndOpenEntry(index);
+
+	IReadFile* file = EntryCache->createAndOpenFile(CacheID, index, Files[index].FullName);
+	if (!file)
+		file = EntryCache->add(CacheID, index, createAndOpenEntry(index));
+	return file;
+}
+
+
+//! opens a file by index without the entry cache
+IReadFile* CZipReader::createAndOpenEntry(u32 index)
 {
 	// Irrlicht supports 0, 8, 12, 14, 99
 	//0 - The file is stored (no compression)
@@ -616,71 +841,18 @@ IReadFile* CZipReader::createAndOpenFile(u32 index)
 		{
   			#ifdef _IRR_COMPILE_WITH_ZLIB_
 
+			// inflate while the entry is read, encrypted entries from the decrypted copy
 			const u32 uncompressedSize = e.header.DataDescriptor.UncompressedSize;
-			c8* pBuf = new c8[ uncompressedSize ];
-			if (!pBuf)
-			{
-				swprintf ( buf, 64, L"Not enough memory for decompressing %s", Files[index].FullName.c_str() );
-				os::Printer::log( buf, ELL_ERROR);
-				if (decrypted)
-					decrypted->drop();
-				return 0;
-			}
-
-			u8 *pcData = decryptedBuf;
-			if (!pcData)
-			{
-				pcData = new u8[decryptedSize];
-				if (!pcData)
-				{
-					swprintf ( buf, 64, L"Not enough memory for decompressing %s", Files[index].FullName.c_str() );
-					os::Printer::log( buf, ELL_ERROR);
-					delete [] pBuf;
-					return 0;
-				}
-
-				//memset(pcData, 0, decryptedSize);
-				File->seek(e.Offset);
-				File->read(pcData, decryptedSize);
-			}
-
-			// Setup the inflate stream.
-			z_stream stream;
-			s32 err;
-
-			stream.next_in = (Bytef*)pcData;
-			stream.avail_in = (uInt)decryptedSize;
-			stream.next_out = (Bytef*)pBuf;
-			stream.avail_out = uncompressedSize;
-			stream.zalloc = (alloc_func)0;
-			stream.zfree = (free_func)0;
-
-			// Perform inflation. wbits < 0 indicates no zlib header inside the data.
-			err = inflateInit2(&stream, -MAX_WBITS);
-			if (err == Z_OK)
-			{
-				err = inflate(&stream, Z_FINISH);
-				inflateEnd(&stream);
-				if (err == Z_STREAM_END)
-					err = Z_OK;
-				err = Z_OK;
-				inflateEnd(&stream);
-			}
-
+			IReadFile* file;
 			if (decrypted)
-				decrypted->drop();
-			else
-				delete[] pcData;
-
-			if (err != Z_OK)
 			{
-				swprintf ( buf, 64, L"Error decompressing %s", Files[index].FullName.c_str() );
-				os::Printer::log( buf, ELL_ERROR);
-				delete [] pBuf;
-				return 0;
+				file = new CInflateReadFile(decrypted, 0, decryptedSize, uncompressedSize, Files[index].FullName);
+				decrypted->drop();
 			}
 			else
-				return FileSystem->createMemoryReadFile(pBuf, uncompressedSize, Files[index].FullName, true);
+				file = new CInflateReadFile(File, e.Offset, decryptedSize, uncompressedSize, Files[index].FullName);
+
+			return file;
 
 			#else
 			return 0; // zlib not compiled, we cannot decompress the data.
@@ -13,6 +13,7 @@
 #include "irrArray.h"
 #include "irrString.h"
 #include "IFileSystem.h"
+#include "CArchiveEntryCache.h"
 #include "CFileList.h"
 
 namespace irr
@@ -141,7 +142,10 @@ namespace io
 	public:
 
 		//! Constructor
-		CArchiveLoaderZIP(io::IFileSystem* fs);
+		CArchiveLoaderZIP(io::IFileSystem* fs, CArchiveEntryCache* cache=0);
+
+		//! Destructor
+		virtual ~CArchiveLoaderZIP();
 
 		//! returns true if the file maybe is able to be loaded by this class
 		//! based on the file extension (e.g. ".zip")
@@ -170,6 +174,7 @@ namespace io
 
 	private:
 		io::IFileSystem* FileSystem;
+		CArchiveEntryCache* EntryCache;
 	};
 
 /*!
@@ -180,7 +185,7 @@ namespace io
 	public:
 
 		//! constructor
-		CZipReader(IFileSystem* fs, IReadFile* file, bool ignoreCase, bool ignorePaths, bool isGZip=false);
+		CZipReader(IFileSystem* fs, IReadFile* file, bool ignoreCase, bool ignorePaths, bool isGZip=false, CArchiveEntryCache* cache=0);
 
 		//! destructor
 		virtual ~CZipReader();
@@ -213,6 +218,18 @@ namespace io
 
 		bool scanCentralDirectoryHeader();
 
+		//! opens a file by index without the entry cache
+		IReadFile* createAndOpenEntry(u32 index);
+
+		//! returns the name of the index cache file of the archive, empty if there is none
+		io::path getIndexCacheName() const;
+
+		//! reads the file list from the index cache, returns false if it is missing or outdated
+		bool readIndexCache(const io::path& cacheName, s64 modificationTime);
+
+		//! writes the file list to the index cache
+		void writeIndexCache(const io::path& cacheName, s64 modificationTime) const;
+
 		io::IFileSystem* FileSystem;
 		IReadFile* File;
 
@@ -220,6 +237,9 @@ namespace io
 		core::array<SZipFileEntry> FileInfo;
 
 		bool IsGZip;
+
+		CArchiveEntryCache* EntryCache;
+		u32 CacheID;
 	};
 
 
@@ -26,10 +26,16 @@ namespace irr
 		EPID_SM_RENDER_TRANSPARENT,
 		EPID_SM_RENDER_EFFECT,
 		EPID_SM_REGISTER,
+		EPID_SM_BUFFERS_VISIBLE,
+		EPID_SM_BUFFERS_CULLED,
 
 		//! octrees
 		EPID_OC_RENDER,
-		EPID_OC_CALCPOLYS
+		EPID_OC_CALCPOLYS,
+
+		//! object pools
+		EPID_OP_ALLOC_NODE,
+		EPID_OP_ALLOC_ANIMATOR
     };
 #endif
 } // end namespace irr
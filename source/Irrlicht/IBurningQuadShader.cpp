@@ -0,0 +1,727 @@
+// Copyright (C) 2002-2012 Nikolaus Gebhardt / Thomas Alten
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#include "IrrCompileConfig.h"
+#include "IBurningQuadShader.h"
+
+#if defined ( _IRR_COMPILE_WITH_BURNINGSVIDEO_ ) && defined ( SOFTWARE_DRIVER_2_QUAD_RASTERIZER )
+
+#include "CSoftwareDriver2.h"
+#include "CSoftwareTexture2.h"
+
+#ifdef SOFTWARE_DRIVER_2_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace irr
+{
+namespace video
+{
+
+namespace
+{
+	// attribute planes interpolated over a triangle
+	enum eQuadAttribute
+	{
+		QA_W = 0,
+		QA_Z,
+		QA_T0X,
+		QA_T0Y,
+		QA_T1X,
+		QA_T1Y,
+		QA_A,
+		QA_R,
+		QA_G,
+		QA_B,
+		QA_COUNT
+	};
+
+	// attribute compared against the depth buffer
+#ifdef SOFTWARE_DRIVER_2_USE_WBUFFER
+	const u32 QA_DEPTH = QA_W;
+#else
+	const u32 QA_DEPTH = QA_Z;
+#endif
+
+	const s32 TILE_SIZE = 1 << SOFTWARE_DRIVER_2_DEPTH_TILE_LOG2;
+
+	// depth test of a single pixel
+	REALINLINE bool depth_pass ( const f32 depth, const fp24 z )
+	{
+#ifdef SOFTWARE_DRIVER_2_USE_WBUFFER
+		return depth >= z;
+#else
+		return depth < z;
+#endif
+	}
+
+#ifdef SOFTWARE_DRIVER_2_SSE2
+
+	typedef __m128 f32x4;
+	typedef __m128i s32x4;
+
+	REALINLINE f32x4 f32x4_set ( const f32 v ) { return _mm_set1_ps ( v ); }
+	REALINLINE f32x4 f32x4_set ( const f32 a, const f32 b, const f32 c, const f32 d ) { return _mm_setr_ps ( a, b, c, d ); }
+	REALINLINE f32x4 f32x4_add ( const f32x4 a, const f32x4 b ) { return _mm_add_ps ( a, b ); }
+	REALINLINE f32x4 f32x4_mul ( const f32x4 a, const f32x4 b ) { return _mm_mul_ps ( a, b ); }
+	REALINLINE f32x4 f32x4_div ( const f32x4 a, const f32x4 b ) { return _mm_div_ps ( a, b ); }
+	REALINLINE f32x4 f32x4_max ( const f32x4 a, const f32x4 b ) { return _mm_max_ps ( a, b ); }
+	REALINLINE void f32x4_store ( f32* dst, const f32x4 v ) { _mm_storeu_ps ( dst, v ); }
+
+	// stores v truncated to integers
+	REALINLINE void f32x4_store_s32 ( s32* dst, const f32x4 v )
+	{
+		_mm_storeu_si128 ( (__m128i*) dst, _mm_cvttps_epi32 ( v ) );
+	}
+
+	REALINLINE s32x4 s32x4_set ( const s32 a, const s32 b, const s32 c, const s32 d ) { return _mm_setr_epi32 ( a, b, c, d ); }
+
+	// returns a bit for each lane which is inside of all three edges
+	REALINLINE u32 s32x4_inside ( const s32x4 e0, const s32x4 e1, const s32x4 e2 )
+	{
+		return ~_mm_movemask_ps ( _mm_castsi128_ps ( _mm_or_si128 ( _mm_or_si128 ( e0, e1 ), e2 ) ) ) & 0xF;
+	}
+
+	// loads the depth values of a quad
+	REALINLINE f32x4 depth_load ( const fp24* z, const u32 pitch )
+	{
+		return _mm_loadh_pi ( _mm_loadl_pi ( _mm_setzero_ps (), (const __m64*) z ), (const __m64*) ( z + pitch ) );
+	}
+
+	// returns a bit for each lane passing the depth test
+	REALINLINE u32 depth_test ( const f32x4 depth, const f32x4 z )
+	{
+#ifdef SOFTWARE_DRIVER_2_USE_WBUFFER
+		return _mm_movemask_ps ( _mm_cmpge_ps ( depth, z ) );
+#else
+		return _mm_movemask_ps ( _mm_cmplt_ps ( depth, z ) );
+#endif
+	}
+
+	// stores the depth of the lanes set in mask
+	REALINLINE void depth_store ( fp24* z, const u32 pitch, const f32x4 depth, const f32x4 old, const u32 mask )
+	{
+		const f32x4 m = _mm_castsi128_ps ( _mm_cmpgt_epi32 (
+			_mm_and_si128 ( _mm_set1_epi32 ( mask ), _mm_setr_epi32 ( 1, 2, 4, 8 ) ), _mm_setzero_si128 () ) );
+		const f32x4 v = _mm_or_ps ( _mm_and_ps ( m, depth ), _mm_andnot_ps ( m, old ) );
+
+		_mm_storel_pi ( (__m64*) z, v );
+		_mm_storeh_pi ( (__m64*) ( z + pitch ), v );
+	}
+
+#else
+
+	struct f32x4 { f32 v[4]; };
+	struct s32x4 { s32 v[4]; };
+
+	REALINLINE f32x4 f32x4_set ( const f32 a, const f32 b, const f32 c, const f32 d )
+	{
+		f32x4 r;
+		r.v[0] = a; r.v[1] = b; r.v[2] = c; r.v[3] = d;
+		return r;
+	}
+
+	REALINLINE f32x4 f32x4_set ( const f32 v ) { return f32x4_set ( v, v, v, v ); }
+
+	REALINLINE f32x4 f32x4_add ( const f32x4& a, const f32x4& b )
+	{
+		return f32x4_set ( a.v[0] + b.v[0], a.v[1] + b.v[1], a.v[2] + b.v[2], a.v[3] + b.v[3] );
+	}
+
+	REALINLINE f32x4 f32x4_mul ( const f32x4& a, const f32x4& b )
+	{
+		return f32x4_set ( a.v[0] * b.v[0], a.v[1] * b.v[1], a.v[2] * b.v[2], a.v[3] * b.v[3] );
+	}
+
+	REALINLINE f32x4 f32x4_div ( const f32x4& a, const f32x4& b )
+	{
+		return f32x4_set ( a.v[0] / b.v[0], a.v[1] / b.v[1], a.v[2] / b.v[2], a.v[3] / b.v[3] );
+	}
+
+	REALINLINE f32x4 f32x4_max ( const f32x4& a, const f32x4& b )
+	{
+		return f32x4_set ( core::max_ ( a.v[0], b.v[0] ), core::max_ ( a.v[1], b.v[1] ),
+			core::max_ ( a.v[2], b.v[2] ), core::max_ ( a.v[3], b.v[3] ) );
+	}
+
+	REALINLINE void f32x4_store ( f32* dst, const f32x4& v )
+	{
+		dst[0] = v.v[0]; dst[1] = v.v[1]; dst[2] = v.v[2]; dst[3] = v.v[3];
+	}
+
+	// stores v truncated to integers
+	REALINLINE void f32x4_store_s32 ( s32* dst, const f32x4& v )
+	{
+		dst[0] = (s32) v.v[0]; dst[1] = (s32) v.v[1]; dst[2] = (s32) v.v[2]; dst[3] = (s32) v.v[3];
+	}
+
+	REALINLINE s32x4 s32x4_set ( const s32 a, const s32 b, const s32 c, const s32 d )
+	{
+		s32x4 r;
+		r.v[0] = a; r.v[1] = b; r.v[2] = c; r.v[3] = d;
+		return r;
+	}
+
+	// returns a bit for each lane which is inside of all three edges
+	REALINLINE u32 s32x4_inside ( const s32x4& e0, const s32x4& e1, const s32x4& e2 )
+	{
+		u32 mask = 0;
+		for ( u32 i = 0; i != 4; ++i )
+			if ( ( e0.v[i] | e1.v[i] | e2.v[i] ) >= 0 )
+				mask |= 1 << i;
+		return mask;
+	}
+
+	// loads the depth values of a quad
+	REALINLINE f32x4 depth_load ( const fp24* z, const u32 pitch )
+	{
+		return f32x4_set ( z[0], z[1], z[pitch], z[pitch + 1] );
+	}
+
+	// returns a bit for each lane passing the depth test
+	REALINLINE u32 depth_test ( const f32x4& depth, const f32x4& z )
+	{
+		u32 mask = 0;
+		for ( u32 i = 0; i != 4; ++i )
+			if ( depth_pass ( depth.v[i], z.v[i] ) )
+				mask |= 1 << i;
+		return mask;
+	}
+
+	// stores the depth of the lanes set in mask
+	REALINLINE void depth_store ( fp24* z, const u32 pitch, const f32x4& depth, const f32x4& old, const u32 mask )
+	{
+		if ( mask & 1 ) z[0] = depth.v[0];
+		if ( mask & 2 ) z[1] = depth.v[1];
+		if ( mask & 4 ) z[pitch] = depth.v[2];
+		if ( mask & 8 ) z[pitch + 1] = depth.v[3];
+	}
+
+#endif
+
+} // end anonymous namespace
+
+
+//! constructor
+IBurningQuadShader::IBurningQuadShader(CBurningVideoDriver* driver, u32 flags)
+: IBurningShader(driver), QuadFlags(flags), ClipX0(0), ClipY0(0), ClipX1(-1), ClipY1(-1),
+	SubPixelBits(0), DepthTiles(false)
+{
+	#ifdef _DEBUG
+	setDebugName("IBurningQuadShader");
+	#endif
+
+	for ( u32 i = 0; i != BURNING_MATERIAL_MAX_TEXTURES; ++i )
+	{
+		LevelReady[i] = 0;
+		LevelCount[i] = 0;
+		LockedLevel[i] = 0;
+	}
+}
+
+
+//! sets a render target
+void IBurningQuadShader::setRenderTarget(video::IImage* surface, const core::rect<s32>& viewPort)
+{
+	IBurningShader::setRenderTarget(surface, viewPort);
+
+	ClipX0 = viewPort.UpperLeftCorner.X;
+	ClipY0 = viewPort.UpperLeftCorner.Y;
+	ClipX1 = viewPort.LowerRightCorner.X - 1;
+	ClipY1 = viewPort.LowerRightCorner.Y - 1;
+
+	SubPixelBits = 0;
+	DepthTiles = false;
+
+	if ( !RenderTarget )
+		return;
+
+	// use as many subpixel bits as possible while the edge functions fit into s32
+	const core::dimension2d<u32>& dim = RenderTarget->getDimension();
+	const u32 size = core::max_ ( dim.Width, dim.Height ) + TILE_SIZE;
+	while ( SubPixelBits < 4 && ( size << ( SubPixelBits + 1 ) ) <= 0x4000 )
+		SubPixelBits += 1;
+
+	DepthTiles = DepthBuffer && DepthBuffer->getSize() == dim;
+}
+
+
+//! sets the Texture
+void IBurningQuadShader::setTextureParam( u32 stage, video::CSoftwareTexture2* texture, s32 lodLevel)
+{
+	IBurningShader::setTextureParam(stage, texture, lodLevel);
+
+	LevelReady[stage] = 0;
+	LevelCount[stage] = 0;
+	LockedLevel[stage] = 0;
+
+	if ( !texture )
+		return;
+
+	while ( LevelCount[stage] < SOFTWARE_DRIVER_2_MIPMAPPING_MAX && texture->getMipMapLevel ( LevelCount[stage] ) )
+		LevelCount[stage] += 1;
+
+	if ( LevelCount[stage] > 1 )
+		LockedLevel[stage] = core::s32_clamp ( lodLevel + SOFTWARE_DRIVER_2_MIPMAPPING_LOD_BIAS, 0, SOFTWARE_DRIVER_2_MIPMAPPING_MAX - 1 );
+
+	// texture coordinates are scaled to this size by the driver
+	const core::dimension2d<u32>& dim = texture->getSize();
+	LockedSize[stage][0] = (f32) dim.Width - 0.25f;
+	LockedSize[stage][1] = (f32) dim.Height - 0.25f;
+}
+
+
+//! returns the internal texture of a mipmap level of a stage
+const sInternalTexture* IBurningQuadShader::getLevel ( u32 stage, s32 level )
+{
+	sInternalTexture* it = &Level[stage][level];
+
+	if ( 0 == ( LevelReady[stage] & ( 1 << level ) ) )
+	{
+		CImage* image = IT[stage].Texture->getMipMapLevel ( level );
+		const core::dimension2d<u32>& dim = image->getDimension();
+
+		it->Texture = IT[stage].Texture;
+		it->lodLevel = level;
+		it->data = IT[stage].Texture->getTexels ( level, it->pitchlog2 );
+		it->textureXMask = s32_to_fixPoint ( dim.Width - 1 ) & FIX_POINT_UNSIGNED_MASK;
+		it->textureYMask = s32_to_fixPoint ( dim.Height - 1 ) & FIX_POINT_UNSIGNED_MASK;
+
+		LevelScale[stage][level][0] = ( (f32) dim.Width - 0.25f ) / LockedSize[stage][0];
+		LevelScale[stage][level][1] = ( (f32) dim.Height - 0.25f ) / LockedSize[stage][1];
+
+		LevelReady[stage] |= 1 << level;
+	}
+
+	return it;
+}
+
+
+//! rasterizes a triangle
+void IBurningQuadShader::drawTriangle ( const s4DVertex *a,const s4DVertex *b,const s4DVertex *c )
+{
+	u32 i;
+	u32 k;
+
+	// snap to the subpixel grid, pixel centers are at integer positions
+	const f32 snap = (f32) ( 1 << SubPixelBits );
+	s32 X[3];
+	s32 Y[3];
+
+	X[0] = core::round32 ( a->Pos.x * snap );
+	Y[0] = core::round32 ( a->Pos.y * snap );
+	X[1] = core::round32 ( b->Pos.x * snap );
+	Y[1] = core::round32 ( b->Pos.y * snap );
+	X[2] = core::round32 ( c->Pos.x * snap );
+	Y[2] = core::round32 ( c->Pos.y * snap );
+
+	const s32 area = ( X[1] - X[0] ) * ( Y[2] - Y[0] ) - ( Y[1] - Y[0] ) * ( X[2] - X[0] );
+	if ( 0 == area )
+		return;
+
+	// orient the edges so the edge functions are positive inside
+	if ( area < 0 )
+	{
+		core::swap ( X[1], X[2] );
+		core::swap ( Y[1], Y[2] );
+	}
+
+	// bounding box of the covered pixels
+	const s32 round = ( 1 << SubPixelBits ) - 1;
+	const s32 xMin = core::s32_max ( ( core::min_ ( X[0], X[1], X[2] ) + round ) >> SubPixelBits, ClipX0 );
+	const s32 yMin = core::s32_max ( ( core::min_ ( Y[0], Y[1], Y[2] ) + round ) >> SubPixelBits, ClipY0 );
+	const s32 xMax = core::s32_min ( core::max_ ( X[0], X[1], X[2] ) >> SubPixelBits, ClipX1 );
+	const s32 yMax = core::s32_min ( core::max_ ( Y[0], Y[1], Y[2] ) >> SubPixelBits, ClipY1 );
+
+	if ( xMin > xMax || yMin > yMax )
+		return;
+
+	// edge functions E(x,y) = C + SX * x + SY * y of pixel x,y
+	s32 C[3];
+	s32 SX[3];
+	s32 SY[3];
+
+	for ( i = 0; i != 3; ++i )
+	{
+		const u32 j = i == 2 ? 0 : i + 1;
+		const s32 dx = X[j] - X[i];
+		const s32 dy = Y[j] - Y[i];
+
+		SX[i] = -dy * ( 1 << SubPixelBits );
+		SY[i] = dx * ( 1 << SubPixelBits );
+		C[i] = dy * X[i] - dx * Y[i];
+
+		// top-left fill convention, right and bottom edges are exclusive
+		if ( dy > 0 || ( dy == 0 && dx < 0 ) )
+			C[i] -= 1;
+	}
+
+	// attribute planes, relative to the top left pixel of the bounding box
+	const f32 x1 = b->Pos.x - a->Pos.x;
+	const f32 y1 = b->Pos.y - a->Pos.y;
+	const f32 x2 = c->Pos.x - a->Pos.x;
+	const f32 y2 = c->Pos.y - a->Pos.y;
+
+	const f32 fArea = x1 * y2 - x2 * y1;
+	if ( 0.f == fArea )
+		return;
+
+	const f32 invArea = core::reciprocal ( fArea );
+
+	f32 va[QA_COUNT];
+	f32 vb[QA_COUNT];
+	f32 vc[QA_COUNT];
+	u32 attr[QA_COUNT];
+	u32 attrCount = 0;
+
+	const bool depthTest = ( QuadFlags & QUAD_DEPTH_TEST ) != 0;
+	const bool depthWrite = ( QuadFlags & QUAD_DEPTH_WRITE ) != 0;
+
+	const bool fog = ( QuadFlags & QUAD_FOG ) != 0;
+
+	va[QA_W] = a->Pos.w;
+	vb[QA_W] = b->Pos.w;
+	vc[QA_W] = c->Pos.w;
+#if defined ( SOFTWARE_DRIVER_2_PERSPECTIVE_CORRECT ) || defined ( SOFTWARE_DRIVER_2_USE_WBUFFER )
+	attr[attrCount++] = QA_W;
+#else
+	if ( fog )
+		attr[attrCount++] = QA_W;
+#endif
+
+#ifndef SOFTWARE_DRIVER_2_USE_WBUFFER
+	if ( depthTest )
+	{
+		va[QA_Z] = a->Pos.z;
+		vb[QA_Z] = b->Pos.z;
+		vc[QA_Z] = c->Pos.z;
+		attr[attrCount++] = QA_Z;
+	}
+#endif
+
+	u32 stages = 0;
+	if ( QuadFlags & QUAD_TEXTURE0 )
+		stages = 1;
+	if ( QuadFlags & QUAD_TEXTURE1 )
+		stages = 2;
+
+	for ( i = 0; i != stages; ++i )
+	{
+		va[QA_T0X + i * 2] = a->Tex[i].x;
+		vb[QA_T0X + i * 2] = b->Tex[i].x;
+		vc[QA_T0X + i * 2] = c->Tex[i].x;
+		attr[attrCount++] = QA_T0X + i * 2;
+
+		va[QA_T0Y + i * 2] = a->Tex[i].y;
+		vb[QA_T0Y + i * 2] = b->Tex[i].y;
+		vc[QA_T0Y + i * 2] = c->Tex[i].y;
+		attr[attrCount++] = QA_T0Y + i * 2;
+	}
+
+#ifdef SOFTWARE_DRIVER_2_USE_VERTEX_COLOR
+	const bool color = ( QuadFlags & QUAD_COLOR0 ) != 0;
+	if ( color )
+	{
+		va[QA_A] = a->Color[0].x; vb[QA_A] = b->Color[0].x; vc[QA_A] = c->Color[0].x;
+		va[QA_R] = a->Color[0].y; vb[QA_R] = b->Color[0].y; vc[QA_R] = c->Color[0].y;
+		va[QA_G] = a->Color[0].z; vb[QA_G] = b->Color[0].z; vc[QA_G] = c->Color[0].z;
+		va[QA_B] = a->Color[0].w; vb[QA_B] = b->Color[0].w; vc[QA_B] = c->Color[0].w;
+		attr[attrCount++] = QA_A;
+		attr[attrCount++] = QA_R;
+		attr[attrCount++] = QA_G;
+		attr[attrCount++] = QA_B;
+	}
+#endif
+
+	f32 ref[QA_COUNT];
+	f32 gx[QA_COUNT];
+	f32 gy[QA_COUNT];
+	f32x4 step[QA_COUNT];
+
+	for ( k = 0; k != attrCount; ++k )
+	{
+		const u32 n = attr[k];
+		const f32 d1 = vb[n] - va[n];
+		const f32 d2 = vc[n] - va[n];
+
+		gx[n] = ( d1 * y2 - d2 * y1 ) * invArea;
+		gy[n] = ( d2 * x1 - d1 * x2 ) * invArea;
+		ref[n] = va[n] + gx[n] * ( (f32) xMin - a->Pos.x ) + gy[n] * ( (f32) yMin - a->Pos.y );
+		step[n] = f32x4_set ( 0.f, gx[n], gy[n], gx[n] + gy[n] );
+	}
+
+	// keeps the extrapolated w of pixels outside of the triangle positive
+	const f32x4 minW = f32x4_set ( 0.5f * core::min_ ( va[QA_W], vb[QA_W], vc[QA_W] ) );
+	const f32x4 one = f32x4_set ( 1.f );
+	const f32x4 fixScale = f32x4_set ( FIX_POINT_F32_MUL );
+
+	// per quad mipmap selection relative to the level locked for the triangle
+	s32 levelOffset[BURNING_MATERIAL_MAX_TEXTURES];
+	for ( i = 0; i != stages; ++i )
+		levelOffset[i] = 2 * SOFTWARE_DRIVER_2_MIPMAPPING_SCALE * LockedLevel[i] + SOFTWARE_DRIVER_2_MIPMAPPING_LOD_BIAS;
+
+	// depth tile bounds
+	f32* tiles = 0;
+	u32 tilePitch = 0;
+#ifdef SOFTWARE_DRIVER_2_USE_WBUFFER
+	f32 depthMax = 0.f;
+#else
+	f32 depthMin = 0.f;
+#endif
+
+	if ( depthTest && DepthTiles && DepthBuffer->tilesValid() )
+	{
+		tiles = DepthBuffer->lockTiles();
+		tilePitch = DepthBuffer->getTilePitch();
+#ifdef SOFTWARE_DRIVER_2_USE_WBUFFER
+		depthMax = core::max_ ( va[QA_DEPTH], vb[QA_DEPTH], vc[QA_DEPTH] );
+#else
+		depthMin = core::min_ ( va[QA_DEPTH], vb[QA_DEPTH], vc[QA_DEPTH] );
+#endif
+	}
+
+	tVideoSample* dstBase = (tVideoSample*) RenderTarget->lock();
+	fp24* zBase = (fp24*) DepthBuffer->lock();
+	const u32 pitch = RenderTarget->getDimension().Width;
+
+	sQuadFragment quad;
+	quad.pitch = pitch;
+
+	f32x4 val[QA_COUNT];
+
+	for ( s32 ty = yMin >> SOFTWARE_DRIVER_2_DEPTH_TILE_LOG2; ty <= yMax >> SOFTWARE_DRIVER_2_DEPTH_TILE_LOG2; ++ty )
+	{
+		const s32 y0 = ty << SOFTWARE_DRIVER_2_DEPTH_TILE_LOG2;
+
+		for ( s32 tx = xMin >> SOFTWARE_DRIVER_2_DEPTH_TILE_LOG2; tx <= xMax >> SOFTWARE_DRIVER_2_DEPTH_TILE_LOG2; ++tx )
+		{
+			const s32 x0 = tx << SOFTWARE_DRIVER_2_DEPTH_TILE_LOG2;
+
+			// reject tiles outside of an edge, accept tiles inside of all edges
+			bool full = true;
+			bool outside = false;
+
+			for ( i = 0; i != 3; ++i )
+			{
+				const s32 e = C[i] + SX[i] * x0 + SY[i] * y0;
+				const s32 hx = SX[i] * ( TILE_SIZE - 1 );
+				const s32 hy = SY[i] * ( TILE_SIZE - 1 );
+
+				if ( e + core::s32_max ( hx, 0 ) + core::s32_max ( hy, 0 ) < 0 )
+					outside = true;
+				if ( e + core::s32_min ( hx, 0 ) + core::s32_min ( hy, 0 ) < 0 )
+					full = false;
+			}
+
+			if ( outside )
+				continue;
+
+			// reject tiles behind the farthest depth stored in them
+			f32* tile = 0;
+			if ( tiles )
+			{
+				tile = tiles + ty * tilePitch + tx;
+
+				const f32 d = ref[QA_DEPTH] + gx[QA_DEPTH] * (f32) ( x0 - xMin ) + gy[QA_DEPTH] * (f32) ( y0 - yMin );
+				const f32 hx = gx[QA_DEPTH] * (f32) ( TILE_SIZE - 1 );
+				const f32 hy = gy[QA_DEPTH] * (f32) ( TILE_SIZE - 1 );
+
+#ifdef SOFTWARE_DRIVER_2_USE_WBUFFER
+				const f32 nearest = core::min_ ( d + core::max_ ( hx, 0.f ) + core::max_ ( hy, 0.f ), depthMax );
+				if ( nearest < *tile )
+					continue;
+#else
+				const f32 nearest = core::max_ ( d + core::min_ ( hx, 0.f ) + core::min_ ( hy, 0.f ), depthMin );
+				if ( nearest >= *tile )
+					continue;
+#endif
+			}
+
+			const s32 qx0 = core::s32_max ( x0, xMin & ~1 );
+			const s32 qy0 = core::s32_max ( y0, yMin & ~1 );
+			const s32 qx1 = core::s32_min ( x0 + TILE_SIZE - 1, xMax );
+			const s32 qy1 = core::s32_min ( y0 + TILE_SIZE - 1, yMax );
+
+			bool written = false;
+
+			for ( s32 qy = qy0; qy <= qy1; qy += 2 )
+			{
+				for ( s32 qx = qx0; qx <= qx1; qx += 2 )
+				{
+					// coverage
+					u32 mask = 0xF;
+					if ( !full )
+					{
+						s32x4 e[3];
+						for ( i = 0; i != 3; ++i )
+						{
+							const s32 eq = C[i] + SX[i] * qx + SY[i] * qy;
+							e[i] = s32x4_set ( eq, eq + SX[i], eq + SY[i], eq + SX[i] + SY[i] );
+						}
+						mask = s32x4_inside ( e[0], e[1], e[2] );
+					}
+
+					const bool inner = qx >= ClipX0 && qx < ClipX1 && qy >= ClipY0 && qy < ClipY1;
+					if ( !inner )
+					{
+						if ( qx < ClipX0 )
+							mask &= 0xA;
+						if ( qx >= ClipX1 )
+							mask &= 0x5;
+						if ( qy < ClipY0 )
+							mask &= 0xC;
+						if ( qy >= ClipY1 )
+							mask &= 0x3;
+					}
+
+					if ( 0 == mask )
+						continue;
+
+					// interpolate
+					const f32 fx = (f32) ( qx - xMin );
+					const f32 fy = (f32) ( qy - yMin );
+
+					for ( k = 0; k != attrCount; ++k )
+					{
+						const u32 n = attr[k];
+						val[n] = f32x4_add ( f32x4_set ( ref[n] + gx[n] * fx + gy[n] * fy ), step[n] );
+					}
+
+					quad.x = qx;
+					quad.y = qy;
+					quad.dst = dstBase + qy * pitch + qx;
+					quad.z = zBase + qy * pitch + qx;
+
+					// early depth test
+					if ( depthTest )
+					{
+						f32x4_store ( quad.depth, val[QA_DEPTH] );
+
+						if ( inner )
+						{
+							const f32x4 z = depth_load ( quad.z, pitch );
+							mask &= depth_test ( val[QA_DEPTH], z );
+							if ( mask && depthWrite )
+								depth_store ( quad.z, pitch, val[QA_DEPTH], z, mask );
+						}
+						else
+						{
+							for ( i = 0; i != 4; ++i )
+							{
+								if ( ( mask & ( 1 << i ) ) && !depth_pass ( quad.depth[i], quad.z[quad.offset ( i )] ) )
+									mask &= ~( 1 << i );
+							}
+							if ( depthWrite )
+							{
+								for ( i = 0; i != 4; ++i )
+									if ( mask & ( 1 << i ) )
+										quad.z[quad.offset ( i )] = quad.depth[i];
+							}
+						}
+
+						if ( 0 == mask )
+							continue;
+
+						written = true;
+					}
+
+					quad.mask = mask;
+
+#ifdef SOFTWARE_DRIVER_2_PERSPECTIVE_CORRECT
+					const f32x4 invW = f32x4_div ( one, f32x4_max ( val[QA_W], minW ) );
+					if ( fog )
+						f32x4_store ( quad.w, invW );
+#else
+					if ( fog )
+						f32x4_store ( quad.w, f32x4_div ( one, f32x4_max ( val[QA_W], minW ) ) );
+#endif
+
+					for ( i = 0; i != stages; ++i )
+					{
+						f32x4 u = val[QA_T0X + i * 2];
+						f32x4 v = val[QA_T0Y + i * 2];
+
+#ifdef SOFTWARE_DRIVER_2_PERSPECTIVE_CORRECT
+						u = f32x4_mul ( u, invW );
+						v = f32x4_mul ( v, invW );
+#endif
+
+						// level from the texel area covered by a pixel
+						const sInternalTexture* it = &IT[i];
+						if ( LevelCount[i] > 1 )
+						{
+							f32 fu[4];
+							f32 fv[4];
+							f32x4_store ( fu, u );
+							f32x4_store ( fv, v );
+
+							const f32 texelArea = core::abs_ ( ( fu[1] - fu[0] ) * ( fv[2] - fv[0] ) - ( fu[2] - fu[0] ) * ( fv[1] - fv[0] ) );
+							const s32 level = core::s32_clamp ( s32_log2_f32 ( texelArea * 0.3f ) + levelOffset[i], 0, LevelCount[i] - 1 );
+
+							if ( level != LockedLevel[i] )
+							{
+								it = getLevel ( i, level );
+								u = f32x4_mul ( u, f32x4_set ( LevelScale[i][level][0] ) );
+								v = f32x4_mul ( v, f32x4_set ( LevelScale[i][level][1] ) );
+							}
+						}
+
+						quad.tex[i] = it;
+						f32x4_store_s32 ( quad.tx[i], f32x4_mul ( u, fixScale ) );
+						f32x4_store_s32 ( quad.ty[i], f32x4_mul ( v, fixScale ) );
+					}
+
+#ifdef SOFTWARE_DRIVER_2_USE_VERTEX_COLOR
+					if ( color )
+					{
+#ifdef SOFTWARE_DRIVER_2_PERSPECTIVE_CORRECT
+						f32x4_store ( quad.a, f32x4_mul ( val[QA_A], invW ) );
+						f32x4_store ( quad.r, f32x4_mul ( val[QA_R], invW ) );
+						f32x4_store ( quad.g, f32x4_mul ( val[QA_G], invW ) );
+						f32x4_store ( quad.b, f32x4_mul ( val[QA_B], invW ) );
+#else
+						f32x4_store ( quad.a, val[QA_A] );
+						f32x4_store ( quad.r, val[QA_R] );
+						f32x4_store ( quad.g, val[QA_G] );
+						f32x4_store ( quad.b, val[QA_B] );
+#endif
+					}
+#endif
+
+					shadeQuad ( quad );
+				}
+			}
+
+			// a fully covered tile only holds depths of this triangle or nearer ones now
+			if ( tile && full && depthWrite && written &&
+				x0 >= ClipX0 && x0 + TILE_SIZE - 1 <= ClipX1 &&
+				y0 >= ClipY0 && y0 + TILE_SIZE - 1 <= ClipY1 )
+			{
+				const fp24* z = zBase + y0 * pitch + x0;
+				f32 bound = z[0];
+
+				for ( s32 y = 0; y != TILE_SIZE; ++y, z += pitch )
+				{
+					for ( s32 x = 0; x != TILE_SIZE; ++x )
+					{
+#ifdef SOFTWARE_DRIVER_2_USE_WBUFFER
+						bound = core::min_ ( bound, (f32) z[x] );
+#else
+						bound = core::max_ ( bound, (f32) z[x] );
+#endif
+					}
+				}
+
+				*tile = bound;
+			}
+		}
+	}
+}
+
+
+} // end namespace video
+} // end namespace irr
+
+#endif // _IRR_COMPILE_WITH_BURNINGSVIDEO_ && SOFTWARE_DRIVER_2_QUAD_RASTERIZER
+
@@ -0,0 +1,131 @@
+// Copyright (C) 2002-2012 Nikolaus Gebhardt / Thomas Alten
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#ifndef __I_BURNING_QUAD_SHADER_H_INCLUDED__
+#define __I_BURNING_QUAD_SHADER_H_INCLUDED__
+
+#include "IBurningShader.h"
+
+namespace irr
+{
+
+namespace video
+{
+
+	//! what a fragment kernel needs from the quad rasterizer
+	enum eQuadShaderFlags
+	{
+		//! depth test before the kernel runs
+		QUAD_DEPTH_TEST		= 0x01,
+		//! write depth of all pixels passing the test, the kernel must not discard any of them
+		QUAD_DEPTH_WRITE	= 0x02,
+		//! texture coordinates of stage 0
+		QUAD_TEXTURE0		= 0x04,
+		//! texture coordinates of stage 1
+		QUAD_TEXTURE1		= 0x08,
+		//! vertex color
+		QUAD_COLOR0			= 0x10,
+		//! view depth of the pixels
+		QUAD_FOG			= 0x20
+	};
+
+	//! 2x2 pixels passed to a fragment kernel
+	/** Pixel i of the quad is at ( x + (i & 1), y + (i >> 1) ). Texture
+	coordinates are fixpoint texel positions in the mipmap level tex[] points
+	to, colors are perspective corrected and in the range 0..1. */
+	struct sQuadFragment
+	{
+		//! returns the offset of pixel i from dst and z
+		u32 offset ( const u32 i ) const
+		{
+			return ( i >> 1 ) * pitch + ( i & 1 );
+		}
+
+		tVideoSample* dst;
+		fp24* z;
+		u32 pitch;
+		s32 x;
+		s32 y;
+
+		//! bit i is set if pixel i is covered and passed the depth test
+		u32 mask;
+
+		f32 depth[4];
+
+		const sInternalTexture* tex[BURNING_MATERIAL_MAX_TEXTURES];
+		tFixPoint tx[BURNING_MATERIAL_MAX_TEXTURES][4];
+		tFixPoint ty[BURNING_MATERIAL_MAX_TEXTURES][4];
+
+		f32 a[4];
+		f32 r[4];
+		f32 g[4];
+		f32 b[4];
+
+		//! view depth, set with QUAD_FOG
+		f32 w[4];
+	};
+
+
+	//! rasterizer core for shaders written as fragment kernels
+	/** Walks the bounding box of a triangle in 8x8 pixel tiles using half-space
+	edge functions and hands the covered 2x2 pixel quads to shadeQuad(). Tiles
+	are rejected against the depth buffer tile bounds, the depth test runs
+	before the kernel, and every quad selects its own mipmap level from the
+	texture coordinate derivatives. With SOFTWARE_DRIVER_2_SSE2 the four
+	pixels of a quad are set up in parallel. */
+	class IBurningQuadShader : public IBurningShader
+	{
+	public:
+
+		//! constructor, flags is a combination of eQuadShaderFlags
+		IBurningQuadShader(CBurningVideoDriver* driver, u32 flags);
+
+		//! sets a render target
+		virtual void setRenderTarget(video::IImage* surface, const core::rect<s32>& viewPort) _IRR_OVERRIDE_;
+
+		//! sets the Texture
+		virtual void setTextureParam( u32 stage, video::CSoftwareTexture2* texture, s32 lodLevel) _IRR_OVERRIDE_;
+
+		//! rasterizes a triangle
+		virtual void drawTriangle ( const s4DVertex *a,const s4DVertex *b,const s4DVertex *c ) _IRR_OVERRIDE_;
+
+	protected:
+
+		//! shades the pixels of a quad which are set in quad.mask
+		virtual void shadeQuad ( sQuadFragment &quad ) = 0;
+
+		//! combination of eQuadShaderFlags
+		u32 QuadFlags;
+
+	private:
+
+		//! returns the internal texture of a mipmap level of a stage
+		const sInternalTexture* getLevel ( u32 stage, s32 level );
+
+		// inclusive pixel bounds of the viewport
+		s32 ClipX0;
+		s32 ClipY0;
+		s32 ClipX1;
+		s32 ClipY1;
+
+		// fractional bits of the snapped vertex positions
+		u32 SubPixelBits;
+
+		// depth buffer matches the render target, so its tiles can be used
+		bool DepthTiles;
+
+		// mipmap levels of each stage
+		sInternalTexture Level[BURNING_MATERIAL_MAX_TEXTURES][SOFTWARE_DRIVER_2_MIPMAPPING_MAX];
+		f32 LevelScale[BURNING_MATERIAL_MAX_TEXTURES][SOFTWARE_DRIVER_2_MIPMAPPING_MAX][2];
+		u32 LevelReady[BURNING_MATERIAL_MAX_TEXTURES];
+		s32 LevelCount[BURNING_MATERIAL_MAX_TEXTURES];
+		s32 LockedLevel[BURNING_MATERIAL_MAX_TEXTURES];
+		f32 LockedSize[BURNING_MATERIAL_MAX_TEXTURES][2];
+	};
+
+} // end namespace video
+} // end namespace irr
+
+#endif
+
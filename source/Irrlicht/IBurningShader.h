@@ -121,6 +121,33 @@ namespace video
 		ETR2_COUNT
 	};
 
+	//! material state a specialised fragment pipeline is generated for
+	/** A combination of the flags, one blend mode and one modulation of the
+	second texture. See createTRQuadPipeline(). */
+	enum eBurningPipelineState
+	{
+		BPS_DEPTH_TEST			= 0x0001,
+		BPS_DEPTH_WRITE			= 0x0002,
+		BPS_TEXTURE0			= 0x0004,
+		BPS_TEXTURE1			= 0x0008,
+		BPS_COLOR0				= 0x0010,
+		BPS_FOG					= 0x0020,
+
+		//! writes the fragment
+		BPS_BLEND_SOLID			= 0x0000,
+		//! adds the fragment to the render target
+		BPS_BLEND_ADD			= 0x0040,
+		//! discards fragments with texture alpha below the reference value, blends the others by texture alpha
+		BPS_BLEND_ALPHA_CHANNEL	= 0x0080,
+		BPS_BLEND_MASK			= 0x00C0,
+
+		//! texture 0 times texture 1, times 2 or times 4
+		BPS_TEXTURE1_M1			= 0x0000,
+		BPS_TEXTURE1_M2			= 0x0100,
+		BPS_TEXTURE1_M4			= 0x0200,
+		BPS_TEXTURE1_MASK		= 0x0300
+	};
+
 
 	class CBurningVideoDriver;
 	class IBurningShader : public virtual IReferenceCounted
@@ -192,6 +219,9 @@ namespace video
 
 	IBurningShader* createTriangleRendererReference(CBurningVideoDriver* driver);
 
+	//! returns the pipeline for a combination of eBurningPipelineState, or 0 if it is not compiled in
+	IBurningShader* createTRQuadPipeline(CBurningVideoDriver* driver, u32 state);
+
 
 
 } // end namespace video
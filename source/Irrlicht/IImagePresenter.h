@@ -26,7 +26,10 @@ namespace video
 
 		virtual ~IImagePresenter() {};
 		//! presents a surface in the client area
-		virtual bool present(video::IImage* surface, void* windowId=0, core::rect<s32>* src=0 ) = 0;
+		/** \param area Part of the surface which changed since the last
+		call, may be empty. Presenters which can't tell if the window kept
+		its content ignore it and present the whole surface. */
+		virtual bool present(video::IImage* surface, void* windowId=0, core::rect<s32>* src=0, const core::rect<s32>* area=0 ) = 0;
 	};
 
 } // end namespace video
@@ -1521,7 +1521,7 @@ core::position2di CIrrDeviceMacOSX::getWindowPosition()
 
 
 
-bool CIrrDeviceMacOSX::present(video::IImage* surface, void* windowId, core::rect<s32>* src )
+bool CIrrDeviceMacOSX::present(video::IImage* surface, void* windowId, core::rect<s32>* src, const core::rect<s32>* area )
 {
 	// todo: implement window ID and src rectangle
 
@@ -532,9 +532,10 @@ struct SCacheInfo
 
 #define VERTEXCACHE_ELEMENT	16
 #define VERTEXCACHE_MISS 0xFFFFFFFF
+class CBurningVertexFetch;
 struct SVertexCache
 {
-	SVertexCache (): mem ( VERTEXCACHE_ELEMENT * 2, 128 ) {}
+	SVertexCache (): mem ( VERTEXCACHE_ELEMENT * 2, 128 ), fetch ( 0 ) {}
 
 	SCacheInfo info[VERTEXCACHE_ELEMENT];
 
@@ -547,6 +548,9 @@ struct SVertexCache
 	const void* vertices;
 	u32 vertexCount;
 
+	// gathers the source vertices if set, vertices is unused then
+	CBurningVertexFetch* fetch;
+
 	const void* indices;
 	u32 indexCount;
 	u32 indicesIndex;
@@ -554,6 +558,9 @@ struct SVertexCache
 	u32 indicesRun;
 
 	// primitives consist of x vertices
+	u32 primitiveSize;
+
+	// indices advanced per primitive
 	u32 primitivePitch;
 
 	u32 vType;		//E_VERTEX_TYPE
@@ -93,6 +93,25 @@
 
 #define SOFTWARE_DRIVER_2_MIPMAPPING_SCALE (8/SOFTWARE_DRIVER_2_MIPMAPPING_MAX)
 
+// half-space quad rasterizer, used by the shaders which provide a fragment kernel
+#ifndef SOFTWARE_DRIVER_2_NO_QUAD_RASTERIZER
+	#define SOFTWARE_DRIVER_2_QUAD_RASTERIZER
+#endif
+
+// 4-wide paths of the quad rasterizer
+#if defined ( SOFTWARE_DRIVER_2_QUAD_RASTERIZER ) && ( defined ( __SSE2__ ) || defined ( _M_X64 ) || ( defined ( _M_IX86_FP ) && _M_IX86_FP >= 2 ) )
+	#define SOFTWARE_DRIVER_2_SSE2
+#endif
+
+// shaders fetch texels from a copy of every mipmap level stored in 4x4 texel tiles
+#ifndef SOFTWARE_DRIVER_2_NO_TEXTURE_TILES
+	#define SOFTWARE_DRIVER_2_TEXTURE_TILES
+#endif
+#define SOFTWARE_DRIVER_2_TEXTURE_TILE_LOG2	2
+
+// depth buffer tiles for hierarchical depth rejection are 8x8 pixels
+#define SOFTWARE_DRIVER_2_DEPTH_TILE_LOG2	3
+
 #ifndef REALINLINE
 	#ifdef _MSC_VER
 		#define REALINLINE __forceinline
@@ -707,6 +707,7 @@ struct sInternalTexture
 	u32 textureXMask;
 	u32 textureYMask;
 
+	//! log2 of the bytes per texel row, or per row of tiles
 	u32 pitchlog2;
 	void *data;
 
@@ -714,6 +715,35 @@ struct sInternalTexture
 	s32 lodLevel;
 };
 
+/*
+	Texel addressing. With SOFTWARE_DRIVER_2_TEXTURE_TILES the texels are
+	stored in square tiles of ( 1 << SOFTWARE_DRIVER_2_TEXTURE_TILE_LOG2 ) texels,
+	so the footprint of a bilinear sample or of a rotated span touches fewer
+	cache lines. Row and column offset are separate and combined with or.
+*/
+
+//! byte offset of texel row y, pitchlog2 as in sInternalTexture
+REALINLINE u32 texelRowOffset ( const u32 y, const u32 pitchlog2 )
+{
+#ifdef SOFTWARE_DRIVER_2_TEXTURE_TILES
+	return ( ( y >> SOFTWARE_DRIVER_2_TEXTURE_TILE_LOG2 ) << pitchlog2 ) |
+		( ( y & ( ( 1 << SOFTWARE_DRIVER_2_TEXTURE_TILE_LOG2 ) - 1 ) ) << ( SOFTWARE_DRIVER_2_TEXTURE_TILE_LOG2 + VIDEO_SAMPLE_GRANULARITY ) );
+#else
+	return y << pitchlog2;
+#endif
+}
+
+//! byte offset of texel column x
+REALINLINE u32 texelColumnOffset ( const u32 x )
+{
+#ifdef SOFTWARE_DRIVER_2_TEXTURE_TILES
+	return ( ( x & ~( ( 1 << SOFTWARE_DRIVER_2_TEXTURE_TILE_LOG2 ) - 1 ) ) << ( SOFTWARE_DRIVER_2_TEXTURE_TILE_LOG2 + VIDEO_SAMPLE_GRANULARITY ) ) |
+		( ( x & ( ( 1 << SOFTWARE_DRIVER_2_TEXTURE_TILE_LOG2 ) - 1 ) ) << VIDEO_SAMPLE_GRANULARITY );
+#else
+	return x << VIDEO_SAMPLE_GRANULARITY;
+#endif
+}
+
 
 
 // get video sample plain
@@ -721,8 +751,8 @@ inline tVideoSample getTexel_plain ( const sInternalTexture * t, const tFixPoint
 {
 	u32 ofs;
 
-	ofs = ( ( ty & t->textureYMask ) >> FIX_POINT_PRE ) << t->pitchlog2;
-	ofs |= ( tx & t->textureXMask ) >> ( FIX_POINT_PRE - VIDEO_SAMPLE_GRANULARITY );
+	ofs = texelRowOffset ( ( ty & t->textureYMask ) >> FIX_POINT_PRE, t->pitchlog2 );
+	ofs |= texelColumnOffset ( ( tx & t->textureXMask ) >> FIX_POINT_PRE );
 
 	// texel
 	return *((tVideoSample*)( (u8*) t->data + ofs ));
@@ -735,8 +765,8 @@ inline void getTexel_fix ( tFixPoint &r, tFixPoint &g, tFixPoint &b,
 {
 	u32 ofs;
 
-	ofs = ( ( ty & t->textureYMask ) >> FIX_POINT_PRE ) << t->pitchlog2;
-	ofs |= ( tx & t->textureXMask ) >> ( FIX_POINT_PRE - VIDEO_SAMPLE_GRANULARITY );
+	ofs = texelRowOffset ( ( ty & t->textureYMask ) >> FIX_POINT_PRE, t->pitchlog2 );
+	ofs |= texelColumnOffset ( ( tx & t->textureXMask ) >> FIX_POINT_PRE );
 
 	// texel
 	tVideoSample t00;
@@ -754,8 +784,8 @@ REALINLINE void getTexel_fix ( tFixPoint &a,
 {
 	u32 ofs;
 
-	ofs = ( ( ty & t->textureYMask ) >> FIX_POINT_PRE ) << t->pitchlog2;
-	ofs |= ( tx & t->textureXMask ) >> ( FIX_POINT_PRE - VIDEO_SAMPLE_GRANULARITY );
+	ofs = texelRowOffset ( ( ty & t->textureYMask ) >> FIX_POINT_PRE, t->pitchlog2 );
+	ofs |= texelColumnOffset ( ( tx & t->textureXMask ) >> FIX_POINT_PRE );
 
 	// texel
 	tVideoSample t00;
@@ -784,8 +814,8 @@ inline void getSample_texture_dither (	tFixPoint &r, tFixPoint &g, tFixPoint &b,
 	const tFixPointu _nty = (ty + dithermask [ index ] ) & t->textureYMask;
 
 	u32 ofs;
-	ofs = ( ( _nty ) >> FIX_POINT_PRE ) << t->pitchlog2;
-	ofs |= ( _ntx ) >> ( FIX_POINT_PRE - VIDEO_SAMPLE_GRANULARITY );
+	ofs = texelRowOffset ( ( _nty ) >> FIX_POINT_PRE, t->pitchlog2 );
+	ofs |= texelColumnOffset ( ( _ntx ) >> FIX_POINT_PRE );
 
 	// texel
 	const tVideoSample t00 = *((tVideoSample*)( (u8*) t->data + ofs ));
@@ -809,8 +839,8 @@ inline void getSample_texture ( tFixPoint &r, tFixPoint &g, tFixPoint &b,
 {
 	u32 ofs;
 
-	ofs = ( ( ty & t->textureYMask ) >> FIX_POINT_PRE ) << t->pitchlog2;
-	ofs |= ( tx & t->textureXMask ) >> ( FIX_POINT_PRE - VIDEO_SAMPLE_GRANULARITY );
+	ofs = texelRowOffset ( ( ty & t->textureYMask ) >> FIX_POINT_PRE, t->pitchlog2 );
+	ofs |= texelColumnOffset ( ( tx & t->textureXMask ) >> FIX_POINT_PRE );
 
 	// texel
 	const tVideoSample t00 = *((tVideoSample*)( (u8*) t->data + ofs ));
@@ -826,8 +856,8 @@ inline void getSample_texture ( tFixPointu &a, tFixPointu &r, tFixPointu &g, tFi
 {
 	u32 ofs;
 
-	ofs = ( ( ty & t->textureYMask ) >> FIX_POINT_PRE ) << t->pitchlog2;
-	ofs |= ( tx & t->textureXMask ) >> ( FIX_POINT_PRE - VIDEO_SAMPLE_GRANULARITY );
+	ofs = texelRowOffset ( ( ty & t->textureYMask ) >> FIX_POINT_PRE, t->pitchlog2 );
+	ofs |= texelColumnOffset ( ( tx & t->textureXMask ) >> FIX_POINT_PRE );
 
 	// texel
 	const tVideoSample t00 = *((tVideoSample*)( (u8*) t->data + ofs ));
@@ -849,8 +879,8 @@ REALINLINE void getSample_linear ( tFixPointu &r, tFixPointu &g, tFixPointu &b,
 {
 	u32 ofs;
 
-	ofs = ( ( ty & t->textureYMask ) >> FIX_POINT_PRE ) << t->pitchlog2;
-	ofs |= ( tx & t->textureXMask ) >> ( FIX_POINT_PRE - VIDEO_SAMPLE_GRANULARITY );
+	ofs = texelRowOffset ( ( ty & t->textureYMask ) >> FIX_POINT_PRE, t->pitchlog2 );
+	ofs |= texelColumnOffset ( ( tx & t->textureXMask ) >> FIX_POINT_PRE );
 
 	// texel
 	tVideoSample t00;
@@ -881,10 +911,10 @@ REALINLINE void getSample_texture ( tFixPoint &r, tFixPoint &g, tFixPoint &b,
 	u32 o0, o1,o2,o3;
 	tVideoSample t00;
 
-	o0 = ( ( (ty) & t->textureYMask ) >> FIX_POINT_PRE ) << t->pitchlog2;
-	o1 = ( ( (ty+FIX_POINT_ONE) & t->textureYMask ) >> FIX_POINT_PRE ) << t->pitchlog2;
-	o2 =   ( (tx) & t->textureXMask ) >> ( FIX_POINT_PRE - VIDEO_SAMPLE_GRANULARITY );
-	o3 =   ( (tx+FIX_POINT_ONE) & t->textureXMask ) >> ( FIX_POINT_PRE - VIDEO_SAMPLE_GRANULARITY );
+	o0 = texelRowOffset ( ( (ty) & t->textureYMask ) >> FIX_POINT_PRE, t->pitchlog2 );
+	o1 = texelRowOffset ( ( (ty+FIX_POINT_ONE) & t->textureYMask ) >> FIX_POINT_PRE, t->pitchlog2 );
+	o2 =   texelColumnOffset ( ( (tx) & t->textureXMask ) >> FIX_POINT_PRE );
+	o3 =   texelColumnOffset ( ( (tx+FIX_POINT_ONE) & t->textureXMask ) >> FIX_POINT_PRE );
 
 	t00 = *((tVideoSample*)( (u8*) t->data + (o0 | o2 ) ));
 	r00 =	(t00 & MASK_R) >> SHIFT_R;
@@ -944,8 +974,8 @@ REALINLINE void getSample_linear ( tFixPointu &a, tFixPointu &r, tFixPointu &g,
 {
 	u32 ofs;
 
-	ofs = ( ( ty & t->textureYMask ) >> FIX_POINT_PRE ) << t->pitchlog2;
-	ofs |= ( tx & t->textureXMask ) >> ( FIX_POINT_PRE - VIDEO_SAMPLE_GRANULARITY );
+	ofs = texelRowOffset ( ( ty & t->textureYMask ) >> FIX_POINT_PRE, t->pitchlog2 );
+	ofs |= texelColumnOffset ( ( tx & t->textureXMask ) >> FIX_POINT_PRE );
 
 	// texel
 	tVideoSample t00;
@@ -239,6 +239,14 @@ bool testEncryptedZip(IFileSystem* fs)
 		return false;
 	}
 
+	filename="doc/";
+	if (!fs->existFile(filename))
+	{
+		logTestString("existFile failed on directory\n");
+		fs->removeFileArchive(fs->getFileArchiveCount()-1);
+		return false;
+	}
+
 	filename="doc/readme.txt";
 	IReadFile* readFile = fs->createAndOpenFile(filename);
 	if ( readFile )
@@ -389,6 +397,432 @@ static bool testMountFile(IFileSystem* fs)
 	return result;
 }
 
+// files are taken from the first archive containing them, also after archives were moved or removed
+static bool testArchivePriority(IFileSystem* fs)
+{
+	// make sure there is no archive mounted
+	if ( fs->getFileArchiveCount() )
+	{
+		logTestString("Already mounted archives found\n");
+		return false;
+	}
+
+	// the folder keeps paths, the zip archive searches names only
+	if ( !fs->addFileArchive("media/file_with_path", /*bool ignoreCase=*/true, /*bool ignorePaths=*/false) ||
+		!fs->addFileArchive("media/file_with_path.zip", /*bool ignoreCase=*/true, /*bool ignorePaths=*/true) )
+	{
+		logTestString("Mounting archives failed\n");
+		while (fs->getFileArchiveCount())
+			fs->removeFileArchive(fs->getFileArchiveCount()-1);
+		return false;
+	}
+
+	// the folder opens real files, which have the folder in their name
+	const io::path filename("MyPath/mypath/myfile.txt");
+	bool result = true;
+
+	IReadFile* file = fs->createAndOpenFile(filename);
+	if (!file || file->getFileName().find("file_with_path/") < 0)
+	{
+		logTestString("File not opened from the folder\n");
+		result = false;
+	}
+	if (file)
+		file->drop();
+
+	fs->moveFileArchive(1, -1);
+	file = fs->createAndOpenFile(filename);
+	if (!file || file->getFileName().find("file_with_path/") >= 0)
+	{
+		logTestString("File not opened from the zip archive after move\n");
+		result = false;
+	}
+	if (file)
+		file->drop();
+
+	fs->removeFileArchive((u32)0);
+	file = fs->createAndOpenFile(filename);
+	if (!file || file->getFileName().find("file_with_path/") < 0)
+	{
+		logTestString("File not opened from the folder after remove\n");
+		result = false;
+	}
+	if (file)
+		file->drop();
+
+	if (!fs->existFile("test/test.txt") || fs->existFile("test.txt"))
+	{
+		logTestString("existFile failed on the folder\n");
+		result = false;
+	}
+
+	fs->removeFileArchive((u32)0);
+	if (fs->existFile(filename))
+	{
+		logTestString("File found after all archives were removed\n");
+		result = false;
+	}
+
+	return result;
+}
+
+// deflated entries are inflated while they are read, seeking has to give the same data
+static bool testDeflatedEntry(IFileSystem* fs)
+{
+	// make sure there is no archive mounted
+	if ( fs->getFileArchiveCount() )
+	{
+		logTestString("Already mounted archives found\n");
+		return false;
+	}
+
+	if ( !fs->addFileArchive("media/Monty.zip", /*bool ignoreCase=*/true, /*bool ignorePaths=*/false) )
+	{
+		logTestString("Mounting archive failed\n");
+		return false;
+	}
+
+	const io::path filename("monty/monty.kart");
+	bool result = true;
+
+	IReadFile* file = fs->createAndOpenFile(filename);
+	if (!file || file->getSize() != 636)
+	{
+		logTestString("Deflated file not opened\n");
+		if (file)
+			file->drop();
+		fs->removeFileArchive((u32)0);
+		return false;
+	}
+
+	c8 content[636];
+	result &= (file->read(content, 636) == 636);
+	result &= (file->read(content, 1) == 0);
+
+	c8 tmp[16];
+	const long positions[] = { 300, 500, 10, 620 };
+	for (u32 i = 0; i < 4; ++i)
+	{
+		if (!file->seek(positions[i]) || file->getPos() != positions[i] ||
+			file->read(tmp, 16) != 16 || memcmp(tmp, content+positions[i], 16))
+		{
+			logTestString("Seeking to %d gave wrong data\n", positions[i]);
+			result = false;
+		}
+	}
+	result &= file->seek(-100, true) && file->getPos() == 536;
+	result &= !file->seek(637);
+	file->drop();
+
+	// opening the cached entry again gives the same content
+	fs->setArchiveCacheSize(1024);
+	for (u32 i = 0; i < 2; ++i)
+	{
+		file = fs->createAndOpenFile(filename);
+		c8 cached[636];
+		if (!file || file->read(cached, 636) != 636 || memcmp(cached, content, 636))
+		{
+			logTestString("Wrong content of the cached file\n");
+			result = false;
+		}
+		if (file)
+			file->drop();
+	}
+	fs->setArchiveCacheSize(0);
+
+	fs->removeFileArchive((u32)0);
+	if (!result)
+		logTestString("Reading the deflated file failed\n");
+
+	return result;
+}
+
+// reads a whole file from disk
+static bool readWholeFile(IFileSystem* fs, const io::path& filename, core::array<u8>& data)
+{
+	IReadFile* file = fs->createAndOpenFile(filename);
+	if (!file)
+		return false;
+
+	data.set_used((u32)file->getSize());
+	const bool result = file->read(data.pointer(), data.size()) == (s32)data.size();
+	file->drop();
+	return result;
+}
+
+// writes a whole file to disk
+static bool writeWholeFile(IFileSystem* fs, const io::path& filename, const core::array<u8>& data)
+{
+	IWriteFile* file = fs->createAndWriteFile(filename);
+	if (!file)
+		return false;
+
+	const bool result = file->write(data.const_pointer(), data.size()) == (s32)data.size();
+	file->drop();
+	return result;
+}
+
+// returns the position of a file name in the index cache, -1 if it isn't there
+static s32 findNameInCache(const core::array<u8>& cache, const io::path& name)
+{
+	const u32 bytes = name.size() * sizeof(fschar_t);
+	for (u32 i = 0; i + bytes <= cache.size(); ++i)
+	{
+		if (!memcmp(&cache[i], name.c_str(), bytes))
+			return (s32)i;
+	}
+	return -1;
+}
+
+// mounts the archive and returns its file list and the start of a file
+static bool mountAndRead(IFileSystem* fs, const io::path& archiveName, const io::path& filename,
+	core::array<io::path>& names, c8* content)
+{
+	if ( !fs->addFileArchive(archiveName, /*bool ignoreCase=*/true, /*bool ignorePaths=*/false) )
+	{
+		logTestString("Mounting archive failed\n");
+		return false;
+	}
+
+	const io::IFileList* fileList = fs->getFileArchive(0)->getFileList();
+	names.clear();
+	for ( u32 f=0; f < fileList->getFileCount(); ++f)
+		names.push_back(fileList->getFullFileName(f));
+
+	memset(content, 0, 51);
+	IReadFile* file = fs->createAndOpenFile(filename);
+	const bool result = file && file->read(content, 50) == 50;
+	if (!result)
+		logTestString("Reading %s from the archive failed\n", filename.c_str());
+	if (file)
+		file->drop();
+
+	fs->removeFileArchive((u32)0);
+	return result;
+}
+
+// a zip archive added again takes its file list from the index cache, invalid and outdated caches are written again
+static bool testIndexCache(IFileSystem* fs)
+{
+	// make sure there is no archive mounted
+	if ( fs->getFileArchiveCount() )
+	{
+		logTestString("Already mounted archives found\n");
+		return false;
+	}
+
+	// a copy of the archive, which is changed later
+	const io::path archiveName("results/indexCache.zip");
+	core::array<u8> archive;
+	if (!readWholeFile(fs, "media/Monty.zip", archive) || !writeWholeFile(fs, archiveName, archive))
+	{
+		logTestString("Copying the archive failed\n");
+		return false;
+	}
+
+	fs->setArchiveIndexCacheDirectory("results");
+	const io::path cacheName = io::path("results/") +
+		io::path(core::hash_traits<io::path>::hash(fs->getAbsolutePath(archiveName))) + ".zdir";
+
+	// a broken cache from before is replaced
+	core::array<u8> cache;
+	cache.push_back('x');
+	bool result = writeWholeFile(fs, cacheName, cache);
+
+	core::array<io::path> names[3];
+	c8 content[3][51];
+	result &= mountAndRead(fs, archiveName, "monty/license.txt", names[0], content[0]);
+
+	const io::path original("monty/license.txt");
+	const io::path renamed("monty/lixense.txt");
+	s32 pos = -1;
+	if (!readWholeFile(fs, cacheName, cache) || cache.size() < 4 || memcmp(cache.pointer(), "ZDIR", 4) ||
+		(pos = findNameInCache(cache, original)) < 0)
+	{
+		logTestString("Index cache was not written\n");
+		result = false;
+	}
+
+	// a file renamed in the cache shows that the second mount doesn't scan the archive
+	if (pos >= 0)
+	{
+		memcpy(&cache[pos], renamed.c_str(), renamed.size() * sizeof(fschar_t));
+		result &= writeWholeFile(fs, cacheName, cache);
+		result &= mountAndRead(fs, archiveName, "monty/lixense.txt", names[1], content[1]);
+		if (result && names[1].linear_search("monty/lixense.txt") < 0)
+		{
+			logTestString("File list was not read from the index cache\n");
+			result = false;
+		}
+	}
+
+	// a changed archive is scanned again and its cache is replaced
+	archive.push_back(0);
+	result &= writeWholeFile(fs, archiveName, archive);
+	result &= mountAndRead(fs, archiveName, "monty/license.txt", names[2], content[2]);
+	if (!readWholeFile(fs, cacheName, cache) || findNameInCache(cache, original) < 0 || findNameInCache(cache, renamed) >= 0)
+	{
+		logTestString("Outdated index cache was not written again\n");
+		result = false;
+	}
+
+	fs->setArchiveIndexCacheDirectory("");
+
+	if (result && (names[0] != names[2] || memcmp(content[0], content[1], 51) || memcmp(content[0], content[2], 51)))
+	{
+		logTestString("File list from the index cache differs\n");
+		result = false;
+	}
+
+	return result;
+}
+
+// archive in memory, its files are named after the archive and the file
+class CNamedFileArchive : public IFileArchive
+{
+public:
+	CNamedFileArchive(IFileSystem* fs, const io::path& name, bool ignoreCase, bool failOpen)
+		: FileSystem(fs), Name(name), FailOpen(failOpen)
+	{
+		Files = fs->createEmptyFileList("", ignoreCase, false);
+	}
+
+	~CNamedFileArchive()
+	{
+		Files->drop();
+	}
+
+	void addFile(const io::path& filename, bool isDirectory=false)
+	{
+		Files->addItem(filename, 0, 1, isDirectory);
+		Files->sort();
+	}
+
+	virtual IReadFile* createAndOpenFile(const path& filename)
+	{
+		const s32 index = Files->findFile(filename);
+		return index < 0 ? 0 : createAndOpenFile((u32)index);
+	}
+
+	virtual IReadFile* createAndOpenFile(u32 index)
+	{
+		if (FailOpen || index >= Files->getFileCount())
+			return 0;
+		static char data = 'x';
+		return FileSystem->createMemoryReadFile(&data, 1, Name + "/" + Files->getFullFileName(index), false);
+	}
+
+	virtual const IFileList* getFileList() const { return Files; }
+	virtual const io::path& getArchiveName() const { return Name; }
+
+private:
+	IFileSystem* FileSystem;
+	IFileList* Files;
+	io::path Name;
+	bool FailOpen;
+};
+
+static bool checkOpenedFile(IFileSystem* fs, const io::path& filename, const io::path& expected)
+{
+	IReadFile* file = fs->createAndOpenFile(filename);
+	const bool result = file && file->getFileName() == expected;
+	if (!result)
+		logTestString("%s not opened as %s but as %s\n", filename.c_str(), expected.c_str(), file ? file->getFileName().c_str() : "nothing");
+	if (file)
+		file->drop();
+	return result;
+}
+
+// names of case sensitive archives are found with their case, files which an archive fails to open come from the next one
+static bool testArchiveCase(IFileSystem* fs)
+{
+	// make sure there is no archive mounted
+	if ( fs->getFileArchiveCount() )
+	{
+		logTestString("Already mounted archives found\n");
+		return false;
+	}
+
+	CNamedFileArchive* failing = new CNamedFileArchive(fs, "failing", true, true);
+	failing->addFile("shared.txt");
+	CNamedFileArchive* exact = new CNamedFileArchive(fs, "exact", false, false);
+	exact->addFile("Data.txt");
+	exact->addFile("data.txt");
+	exact->addFile("shared.txt");
+
+	// the file system takes over the references
+	fs->addFileArchive(failing);
+	fs->addFileArchive(exact);
+
+	bool result = true;
+	result &= checkOpenedFile(fs, "data.txt", "exact/data.txt");
+	result &= checkOpenedFile(fs, "Data.txt", "exact/Data.txt");
+	result &= checkOpenedFile(fs, "shared.txt", "exact/shared.txt");
+
+	// without the exact name the file list search ignores case
+	IReadFile* file = fs->createAndOpenFile("DATA.TXT");
+	if (!file || !file->getFileName().equals_ignore_case("exact/data.txt"))
+	{
+		logTestString("DATA.TXT not found ignoring case\n");
+		result = false;
+	}
+	if (file)
+		file->drop();
+
+	while (fs->getFileArchiveCount())
+		fs->removeFileArchive(fs->getFileArchiveCount()-1);
+
+	return result;
+}
+
+// directories are found with a trailing slash, also in archives which ignore paths
+static bool testArchiveDirectories(IFileSystem* fs)
+{
+	// make sure there is no archive mounted
+	if ( fs->getFileArchiveCount() )
+	{
+		logTestString("Already mounted archives found\n");
+		return false;
+	}
+
+	CNamedFileArchive* archive = new CNamedFileArchive(fs, "dirs", false, false);
+	archive->addFile("Models", true);
+	archive->addFile("Models/Sub", true);
+	archive->addFile("Models/Sub/mesh.obj");
+	fs->addFileArchive(archive);
+
+	bool result = true;
+	result &= fs->existFile("Models/") && fs->existFile("Models/Sub/") && fs->existFile("models/sub/");
+	result &= fs->existFile("Models\\Sub\\");
+	result &= fs->existFile("Models/Sub/mesh.obj");
+	result &= !fs->existFile("Models") && !fs->existFile("Models/Sub/mesh.obj/") && !fs->existFile("Sub/");
+	if (!result)
+		logTestString("existFile failed on archive directories\n");
+
+	// a directory is no file to open
+	IReadFile* file = fs->createAndOpenFile("Models/Sub/");
+	if (file)
+	{
+		logTestString("Directory opened as file %s\n", file->getFileName().c_str());
+		file->drop();
+		result = false;
+	}
+
+	while (fs->getFileArchiveCount())
+		fs->removeFileArchive(fs->getFileArchiveCount()-1);
+
+	if (!fs->addFileArchive("media/file_with_path.zip", true, true) || !fs->existFile("test/") || !fs->existFile("mypath/mypath/") || fs->existFile("test"))
+	{
+		logTestString("existFile failed on directory of archive ignoring paths\n");
+		result = false;
+	}
+
+	while (fs->getFileArchiveCount())
+		fs->removeFileArchive(fs->getFileArchiveCount()-1);
+
+	return result;
+}
+
 bool testAddRemove(IFileSystem* fs, const io::path& archiveName)
 {
 	// make sure there is no archive mounted
@@ -459,6 +893,16 @@ bool archiveReader()
 //	ret &= testMountFile(fs);
 	logTestString("Testing add/remove with filenames.\n");
 	ret &= testAddRemove(fs, "media/file_with_path.zip");
+	logTestString("Testing archive priority.\n");
+	ret &= testArchivePriority(fs);
+	logTestString("Testing archive case.\n");
+	ret &= testArchiveCase(fs);
+	logTestString("Testing archive directories.\n");
+	ret &= testArchiveDirectories(fs);
+	logTestString("Testing deflated entries.\n");
+	ret &= testDeflatedEntry(fs);
+	logTestString("Testing the index cache.\n");
+	ret &= testIndexCache(fs);
 
 	device->closeDevice();
 	device->run();
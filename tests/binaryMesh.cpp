@@ -0,0 +1,455 @@
+// Copyright (C) 2008-2012 Colin MacDonald
+// No rights reserved: this software is in the public domain.
+
+#include "testUtils.h"
+
+using namespace irr;
+
+namespace
+{
+
+// Compares layout, raw vertex and index data and materials of two meshes
+bool compareMeshes(scene::IMesh* a, scene::IMesh* b)
+{
+	if (a->getMeshBufferCount() != b->getMeshBufferCount())
+	{
+		logTestString("Mesh buffer count differs.\n");
+		return false;
+	}
+
+	for (u32 i=0; i<a->getMeshBufferCount(); ++i)
+	{
+		scene::IMeshBuffer* ba = a->getMeshBuffer(i);
+		scene::IMeshBuffer* bb = b->getMeshBuffer(i);
+
+		if (ba->getVertexDescriptor() != bb->getVertexDescriptor() ||
+			ba->getVertexBufferCount() != bb->getVertexBufferCount() ||
+			ba->getPrimitiveType() != bb->getPrimitiveType())
+		{
+			logTestString("Mesh buffer %d layout differs.\n", i);
+			return false;
+		}
+
+		for (u32 j=0; j<ba->getVertexBufferCount(); ++j)
+		{
+			scene::IVertexBuffer* va = ba->getVertexBuffer(j);
+			scene::IVertexBuffer* vb = bb->getVertexBuffer(j);
+
+			if (va->getVertexSize() != vb->getVertexSize() ||
+				va->getVertexCount() != vb->getVertexCount() ||
+				memcmp(va->getVertices(), vb->getVertices(), va->getVertexSize()*va->getVertexCount()))
+			{
+				logTestString("Mesh buffer %d vertices differ.\n", i);
+				return false;
+			}
+		}
+
+		scene::IIndexBuffer* ia = ba->getIndexBuffer();
+		scene::IIndexBuffer* ib = bb->getIndexBuffer();
+
+		if (ia->getType() != ib->getType() ||
+			ia->getIndexCount() != ib->getIndexCount() ||
+			memcmp(ia->getIndices(), ib->getIndices(), ia->getIndexSize()*ia->getIndexCount()))
+		{
+			logTestString("Mesh buffer %d indices differ.\n", i);
+			return false;
+		}
+
+		if (ba->getMaterial() != bb->getMaterial())
+		{
+			logTestString("Mesh buffer %d material differs.\n", i);
+			return false;
+		}
+	}
+
+	return true;
+}
+
+// Writes a static mesh with the mesh writer and loads it back
+bool writeAndReadStatic(scene::ISceneManager* smgr, io::IFileSystem* fs)
+{
+	scene::IAnimatedMesh* mesh = smgr->getMesh("../media/earth.x");
+	if (!mesh)
+		return false;
+
+	scene::IMeshWriter* writer = smgr->createMeshWriter(scene::EMWT_BINARY_MESH);
+	io::IWriteFile* file = fs->createAndWriteFile("results/binaryMesh.irrbmesh");
+	if (!writer || !file)
+	{
+		if (writer)
+			writer->drop();
+		if (file)
+			file->drop();
+		logTestString("Could not create binary mesh writer.\n");
+		return false;
+	}
+
+	bool result = writer->writeMesh(file, mesh->getMesh(0));
+	file->drop();
+	writer->drop();
+
+	scene::IAnimatedMesh* loaded = smgr->getMesh("results/binaryMesh.irrbmesh");
+	result &= (loaded != 0);
+	if (loaded)
+	{
+		result &= compareMeshes(mesh->getMesh(0), loaded->getMesh(0));
+		smgr->getMeshCache()->removeMesh(loaded);
+	}
+
+	return result;
+}
+
+// Writes an .irrmesh with base64 encoded vertex and index sections and loads it back
+bool writeAndReadIrrMeshBase64(scene::ISceneManager* smgr, io::IFileSystem* fs)
+{
+	scene::IAnimatedMesh* mesh = smgr->getMesh("../media/earth.x");
+	if (!mesh)
+		return false;
+
+	scene::IMeshWriter* writer = smgr->createMeshWriter(scene::EMWT_IRR_MESH);
+	io::IWriteFile* file = fs->createAndWriteFile("results/binaryMesh.irrmesh");
+	if (!writer || !file)
+	{
+		if (writer)
+			writer->drop();
+		if (file)
+			file->drop();
+		logTestString("Could not create irrmesh writer.\n");
+		return false;
+	}
+
+	bool result = writer->writeMesh(file, mesh->getMesh(0), scene::EMWF_WRITE_BINARY);
+	file->drop();
+	writer->drop();
+
+	scene::IAnimatedMesh* loaded = smgr->getMesh("results/binaryMesh.irrmesh");
+	result &= (loaded != 0);
+	if (loaded)
+	{
+		result &= compareMeshes(mesh->getMesh(0), loaded->getMesh(0));
+		smgr->getMeshCache()->removeMesh(loaded);
+	}
+
+	return result;
+}
+
+// Loads a skinned mesh through the binary cache and compares it to the source
+bool meshCacheHook(scene::ISceneManager* smgr, io::IFileSystem* fs)
+{
+	// copy the source, as the cache file is written next to it
+	io::IReadFile* source = fs->createAndOpenFile("../media/ninja.b3d");
+	io::IWriteFile* copy = fs->createAndWriteFile("results/binaryMesh.b3d");
+	if (!source || !copy)
+	{
+		if (source)
+			source->drop();
+		if (copy)
+			copy->drop();
+		return false;
+	}
+	core::array<c8> data;
+	data.set_used(source->getSize());
+	source->read(data.pointer(), data.size());
+	copy->write(data.pointer(), data.size());
+	source->drop();
+	copy->drop();
+
+	// truncate an old cache file
+	copy = fs->createAndWriteFile("results/binaryMesh.b3d.irrbmesh");
+	if (copy)
+		copy->drop();
+
+	scene::IMeshCache* cache = smgr->getMeshCache();
+	cache->setBinaryCacheEnabled(true);
+
+	scene::IAnimatedMesh* parsed = smgr->getMesh("results/binaryMesh.b3d");
+	if (!parsed)
+	{
+		cache->setBinaryCacheEnabled(false);
+		return false;
+	}
+	parsed->grab();
+	cache->removeMesh(parsed);
+
+	bool result = false;
+	io::IReadFile* cacheFile = fs->createAndOpenFile("results/binaryMesh.b3d.irrbmesh");
+	if (cacheFile)
+	{
+		result = (cacheFile->getSize() > 0);
+		cacheFile->drop();
+	}
+
+	// the cache is written under a temporary name and renamed
+	result &= !fs->existFile("results/binaryMesh.b3d.irrbmesh.tmp");
+
+	scene::IAnimatedMesh* cached = smgr->getMesh("results/binaryMesh.b3d");
+	cache->setBinaryCacheEnabled(false);
+
+	result &= (cached != 0 && cached != parsed);
+	if (cached)
+	{
+		result &= (cached->getMeshType() == scene::EAMT_SKINNED);
+		result &= (cached->getFrameCount() == parsed->getFrameCount());
+		result &= compareMeshes(parsed, cached);
+
+		if (cached->getMeshType() == scene::EAMT_SKINNED)
+		{
+			scene::ISkinnedMesh* a = (scene::ISkinnedMesh*)parsed;
+			scene::ISkinnedMesh* b = (scene::ISkinnedMesh*)cached;
+
+			result &= (a->getJointCount() == b->getJointCount());
+			for (u32 i=0; result && i<a->getJointCount(); ++i)
+			{
+				const scene::ISkinnedMesh::SJoint* ja = a->getAllJoints()[i];
+				const scene::ISkinnedMesh::SJoint* jb = b->getAllJoints()[i];
+
+				result &= (ja->Name == jb->Name);
+				result &= (ja->Children.size() == jb->Children.size());
+				result &= (ja->PositionKeys.size() == jb->PositionKeys.size());
+				result &= (ja->RotationKeys.size() == jb->RotationKeys.size());
+				result &= (ja->Weights.size() == jb->Weights.size());
+				result &= ja->LocalMatrix.equals(jb->LocalMatrix);
+			}
+		}
+		cache->removeMesh(cached);
+	}
+	parsed->drop();
+
+	if (!result)
+		logTestString("Mesh loaded from the binary cache differs from its source.\n");
+
+	return result;
+}
+
+// Creates a quad with a second, per instance vertex stream
+scene::IMesh* createInstancedQuad(video::IVideoDriver* driver, const core::stringc& descriptorName)
+{
+	video::IVertexDescriptor* standard = driver->getVertexDescriptor(0);
+	video::IVertexDescriptor* descriptor = driver->getVertexDescriptor(descriptorName);
+	if (!descriptor)
+	{
+		descriptor = driver->addVertexDescriptor(descriptorName);
+		for (u32 i=0; i<standard->getAttributeCount(); ++i)
+		{
+			const video::IVertexAttribute* attribute = standard->getAttribute(i);
+			descriptor->addAttribute(attribute->getName(), attribute->getElementCount(),
+				attribute->getSemantic(), attribute->getType(), attribute->getBufferID());
+		}
+		descriptor->addAttribute("InstancePosition", 3, video::EVAS_TEXCOORD1, video::EVAT_FLOAT, 1);
+		descriptor->setInstanceDataStepRate(video::EIDSR_PER_INSTANCE, 1);
+	}
+
+	scene::CMeshBuffer<video::S3DVertex>* buffer = new scene::CMeshBuffer<video::S3DVertex>(descriptor);
+	const video::S3DVertex vertices[] = {
+		video::S3DVertex(0,0,0, 0,0,-1, video::SColor(255,255,0,0), 0,1),
+		video::S3DVertex(1,0,0, 0,0,-1, video::SColor(255,0,255,0), 1,1),
+		video::S3DVertex(1,1,0, 0,0,-1, video::SColor(255,0,0,255), 1,0),
+		video::S3DVertex(0,1,0, 0,0,-1, video::SColor(255,255,255,255), 0,0) };
+	for (u32 i=0; i<4; ++i)
+		buffer->getVertexBuffer()->addVertex(&vertices[i]);
+	const u32 indices[] = { 0,2,1, 0,3,2 };
+	for (u32 i=0; i<6; ++i)
+		buffer->getIndexBuffer()->addIndex(indices[i]);
+
+	scene::CVertexBuffer<video::S3DVertex>* instances = new scene::CVertexBuffer<video::S3DVertex>();
+	instances->addVertex(video::S3DVertex(-2,0,0, 0,0,0, 0, 0,0));
+	instances->addVertex(video::S3DVertex(2,0,0, 0,0,0, 0, 0,0));
+	buffer->addVertexBuffer(instances);
+	instances->drop();
+	buffer->recalculateBoundingBox();
+
+	scene::SMesh* mesh = new scene::SMesh();
+	mesh->addMeshBuffer(buffer);
+	mesh->recalculateBoundingBox();
+	buffer->drop();
+
+	return mesh;
+}
+
+// Loads a mesh from memory through the binary mesh loader
+scene::IAnimatedMesh* loadFromMemory(scene::ISceneManager* smgr, io::IFileSystem* fs, const void* data, u32 size)
+{
+	io::IReadFile* file = fs->createMemoryReadFile(data, size, "memory.irrbmesh", false);
+	scene::IAnimatedMesh* mesh = smgr->getMesh(file);
+	file->drop();
+
+	// the caller owns the mesh, it is not kept in the mesh cache
+	if (mesh)
+	{
+		mesh->grab();
+		smgr->getMeshCache()->removeMesh(mesh);
+	}
+
+	return mesh;
+}
+
+// Step rates of vertex streams are restored, truncated writes and corrupt files fail
+bool stepRatesAndCorruptFiles(scene::ISceneManager* smgr, io::IFileSystem* fs)
+{
+	video::IVideoDriver* driver = smgr->getVideoDriver();
+	scene::IMesh* mesh = createInstancedQuad(driver, "binaryMeshInstancesA");
+	scene::IMeshWriter* writer = smgr->createMeshWriter(scene::EMWT_BINARY_MESH);
+
+	core::array<c8> data;
+	data.set_used(65536);
+	io::IWriteFile* file = fs->createMemoryWriteFile(data.pointer(), data.size(), "memory.irrbmesh", false);
+	bool result = writer->writeMesh(file, mesh);
+	const u32 size = (u32)file->getPos();
+	file->drop();
+
+	// the writer reports files which could not be written completely
+	file = fs->createMemoryWriteFile(data.pointer(), size/2, "truncated.irrbmesh", false);
+	if (writer->writeMesh(file, mesh))
+	{
+		logTestString("Writing into a too small file did not fail.\n");
+		result = false;
+	}
+	file->drop();
+	writer->drop();
+
+	// a descriptor of the same name has to use the same step rates
+	scene::IAnimatedMesh* loaded = loadFromMemory(smgr, fs, data.pointer(), size);
+	result &= (loaded != 0);
+	if (loaded)
+	{
+		result &= compareMeshes(mesh, loaded->getMesh(0));
+		loaded->drop();
+	}
+
+	driver->getVertexDescriptor("binaryMeshInstancesA")->setInstanceDataStepRate(video::EIDSR_PER_VERTEX, 1);
+	loaded = loadFromMemory(smgr, fs, data.pointer(), size);
+	if (loaded)
+	{
+		logTestString("Mesh with different step rates loaded.\n");
+		loaded->drop();
+		result = false;
+	}
+	driver->getVertexDescriptor("binaryMeshInstancesA")->setInstanceDataStepRate(video::EIDSR_PER_INSTANCE, 1);
+
+	// descriptors created by the loader get the step rates of the file
+	core::array<c8> renamed(data);
+	for (u32 i=0; i+20<size; ++i)
+	{
+		if (!memcmp(&renamed[i], "binaryMeshInstancesA", 20))
+			renamed[i+19] = 'B';
+	}
+	loaded = loadFromMemory(smgr, fs, renamed.pointer(), size);
+	const video::IVertexDescriptor* created = driver->getVertexDescriptor("binaryMeshInstancesB");
+	if (!loaded || !created || created->getInstanceDataStepRate(1) != video::EIDSR_PER_INSTANCE)
+	{
+		logTestString("Step rate of a new vertex descriptor not restored.\n");
+		result = false;
+	}
+	if (loaded)
+		loaded->drop();
+
+	// files which fail to load leave no descriptor behind, which would not
+	// match the next correct file of that name
+	for (u32 i=0; i+20<size; ++i)
+	{
+		if (!memcmp(&renamed[i], "binaryMeshInstancesB", 20))
+			renamed[i+19] = 'C';
+	}
+	bool added = false;
+	loaded = loadFromMemory(smgr, fs, renamed.pointer(), size/2);
+	if (loaded)
+		loaded->drop();
+	added |= (driver->getVertexDescriptor("binaryMeshInstancesC") != 0);
+
+	// element count, semantic and type out of range
+	for (u32 i=0; i+16+12<=size; ++i)
+	{
+		if (memcmp(&renamed[i], "InstancePosition", 16))
+			continue;
+
+		const u32 invalid[3] = { 5, video::EVAS_COUNT, video::EVAT_DOUBLE+1 };
+		for (u32 j=0; j<3; ++j)
+		{
+			core::array<c8> corrupt(renamed);
+			memcpy(&corrupt[i+16+j*4], &invalid[j], 4);
+			loaded = loadFromMemory(smgr, fs, corrupt.pointer(), size);
+			if (loaded)
+			{
+				logTestString("Mesh with an invalid vertex attribute loaded.\n");
+				loaded->drop();
+				result = false;
+			}
+			added |= (driver->getVertexDescriptor("binaryMeshInstancesC") != 0);
+		}
+	}
+	if (added)
+	{
+		logTestString("Vertex descriptor of a file which failed to load was added.\n");
+		result = false;
+	}
+
+	loaded = loadFromMemory(smgr, fs, renamed.pointer(), size);
+	if (!loaded || !driver->getVertexDescriptor("binaryMeshInstancesC"))
+	{
+		logTestString("Mesh not loaded after a failed file with the same descriptor.\n");
+		result = false;
+	}
+	if (loaded)
+	{
+		result &= (loaded->getMeshBuffer(0)->getVertexDescriptor() == driver->getVertexDescriptor("binaryMeshInstancesC"));
+		loaded->drop();
+	}
+
+	// huge counts and indices anywhere in the file are rejected without allocating for them
+	for (u32 i=0; i+4<=size; i+=4)
+	{
+		core::array<c8> corrupt(data);
+		const u32 value = 0x7ffffff0;
+		memcpy(&corrupt[i], &value, 4);
+		loaded = loadFromMemory(smgr, fs, corrupt.pointer(), size);
+		if (loaded)
+			loaded->drop();
+	}
+
+	// truncated files, the padding after the last blob is not needed
+	for (u32 i=0; i+16<size; i+=7)
+	{
+		loaded = loadFromMemory(smgr, fs, data.pointer(), i);
+		if (loaded)
+		{
+			logTestString("Truncated file of %d bytes loaded.\n", i);
+			loaded->drop();
+			result = false;
+		}
+	}
+
+	mesh->drop();
+	return result;
+}
+
+} // end anonymous namespace
+
+// Tests the binary mesh format, the binary mesh cache and binary .irrmesh sections.
+bool binaryMesh(void)
+{
+	IrrlichtDevice *device = createDevice(video::EDT_NULL, core::dimension2d<u32>(160, 120), 32);
+	assert_log(device);
+	if (!device)
+		return false;
+
+	scene::ISceneManager* smgr = device->getSceneManager();
+	io::IFileSystem* fs = device->getFileSystem();
+
+	bool result = writeAndReadStatic(smgr, fs);
+	assert_log(result);
+
+	result &= writeAndReadIrrMeshBase64(smgr, fs);
+	assert_log(result);
+
+	bool cacheResult = meshCacheHook(smgr, fs);
+	assert_log(cacheResult);
+
+	result &= stepRatesAndCorruptFiles(smgr, fs);
+	assert_log(result);
+
+	device->closeDevice();
+	device->run();
+	device->drop();
+
+	return result && cacheResult;
+}
@@ -0,0 +1,161 @@
+// Copyright (C) 2008-2012 Colin MacDonald
+// No rights reserved: this software is in the public domain.
+
+#include "testUtils.h"
+
+using namespace irr;
+using namespace core;
+using namespace scene;
+using namespace video;
+
+namespace
+{
+
+// records two cubes, the second one with a different transformation
+void record(ICommandList* list, IMeshBuffer* mb, const matrix4* world, const SMaterial& material)
+{
+	list->setMaterial(material);
+	for (u32 i = 0; i < 2; ++i)
+	{
+		list->setTransform(ETS_WORLD, world[i]);
+		list->setMaterial(material);
+		list->drawMeshBuffer(mb);
+	}
+}
+
+void draw(IVideoDriver* driver, IMeshBuffer* mb, const matrix4* world, const SMaterial& material)
+{
+	driver->setMaterial(material);
+	for (u32 i = 0; i < 2; ++i)
+	{
+		driver->setTransform(ETS_WORLD, world[i]);
+		driver->drawMeshBuffer(mb);
+	}
+}
+
+// a command list of the application, which only draws one mesh buffer
+class CDrawList : public ICommandList
+{
+public:
+	CDrawList(const IMeshBuffer* mb) : MeshBuffer(mb) {}
+
+	virtual void setTransform(E_TRANSFORMATION_STATE state, const matrix4& mat) {}
+	virtual void setMaterial(const SMaterial& material) {}
+	virtual void drawMeshBuffer(const IMeshBuffer* mb) {}
+	virtual void clear() {}
+	virtual u32 getCommandCount() const { return 1; }
+
+	virtual void replay(IVideoDriver* driver) const
+	{
+		driver->drawMeshBuffer(MeshBuffer);
+	}
+
+private:
+	const IMeshBuffer* MeshBuffer;
+};
+
+void beginScene(IVideoDriver* driver)
+{
+	driver->beginScene(true, true, SColor(255, 40, 40, 40));
+	driver->setTransform(ETS_PROJECTION, matrix4().buildProjectionMatrixPerspectiveFovLH(1.f, 4.f / 3.f, 1.f, 100.f));
+	driver->setTransform(ETS_VIEW, matrix4().buildCameraLookAtMatrixLH(vector3df(0, 10, -20), vector3df(), vector3df(0, 1, 0)));
+}
+
+//! Submitted command lists must draw like the calls they were recorded from
+bool testWithDriver(E_DRIVER_TYPE driverType)
+{
+	IrrlichtDevice* device = createDevice(driverType, dimension2d<u32>(160, 120), 32);
+	if (!device)
+		return true; // Treat a failure to create a driver as benign; this saves a lot of #ifdefs
+
+	IVideoDriver* driver = device->getVideoDriver();
+
+	logTestString("Testing driver %ls\n", driver->getName());
+
+	IMesh* cube = device->getSceneManager()->getGeometryCreator()->createCubeMesh(vector3df(6.f, 6.f, 6.f));
+	IMeshBuffer* mb = cube->getMeshBuffer(0);
+
+	matrix4 world[2];
+	world[0].setTranslation(vector3df(-5.f, 0.f, 0.f));
+	world[1].setRotationDegrees(vector3df(30.f, 45.f, 0.f));
+	world[1].setTranslation(vector3df(5.f, 0.f, 0.f));
+
+	SMaterial material;
+	material.Lighting = false;
+	material.Wireframe = true;
+
+	// recording doesn't change the driver
+	ICommandList* list = driver->createCommandList();
+	record(list, mb, world, material);
+
+	// the repeated materials are not recorded
+	bool result = list->getCommandCount() == 5 && driver->getTransform(ETS_WORLD) != world[1];
+	if (!result)
+		logTestString("Recording changed the driver or recorded %d commands\n", list->getCommandCount());
+
+	beginScene(driver);
+	draw(driver, mb, world, material);
+	driver->endScene();
+	const u32 primitives = driver->getPrimitiveCountDrawn();
+	IImage* reference = driver->createScreenShot();
+
+	driver->setTransform(ETS_WORLD, matrix4());
+
+	beginScene(driver);
+	driver->submit(list);
+	driver->endScene();
+
+	result &= driver->getPrimitiveCountDrawn() == primitives && primitives == 2 * mb->getPrimitiveCount();
+	result &= driver->getTransform(ETS_WORLD) == world[1];
+	if (!result)
+		logTestString("Submitted list drew %d instead of %d primitives\n", driver->getPrimitiveCountDrawn(), primitives);
+
+	if (reference)
+	{
+		result &= compareAndDropImages(reference, driver->createScreenShot());
+		if (!result)
+			logTestString("Submitted list differs from the immediate drawing\n");
+	}
+
+	// a list can be submitted again, until it is cleared
+	beginScene(driver);
+	driver->submit(list);
+	driver->submit(list);
+	list->clear();
+	driver->submit(list);
+	driver->endScene();
+
+	result &= driver->getPrimitiveCountDrawn() == 2 * primitives && !list->getCommandCount();
+
+	// lists not created by the driver are replayed as well
+	CDrawList* own = new CDrawList(mb);
+	beginScene(driver);
+	driver->submit(own);
+	driver->endScene();
+	own->drop();
+
+	if (driver->getPrimitiveCountDrawn() != mb->getPrimitiveCount())
+	{
+		logTestString("Submitted list of the application drew %d primitives\n", driver->getPrimitiveCountDrawn());
+		result = false;
+	}
+
+	list->drop();
+	cube->drop();
+
+	device->closeDevice();
+	device->run();
+	device->drop();
+
+	return result;
+}
+
+}
+
+bool commandList(void)
+{
+	bool result = testWithDriver(EDT_NULL);
+	result &= testWithDriver(EDT_BURNINGSVIDEO);
+	return result;
+}
+
@@ -24,29 +24,30 @@ bool testWithDriver(video::E_DRIVER_TYPE driverType)
 
 	smgr->addCameraSceneNode(0, core::vector3df(128,128,-100), core::vector3df(128,128,128));
 
-	scene::SMeshBuffer Buffer;
+	scene::CMeshBuffer<video::S3DVertex>* Buffer = new scene::CMeshBuffer<video::S3DVertex>(driver->getVertexDescriptor(0));
 
-	Buffer.Material.Wireframe = false;
-	Buffer.Material.Lighting = false;
-	Buffer.Material.FogEnable = false;
-	Buffer.Material.BackfaceCulling = false;
-	Buffer.Material.MaterialType = video::EMT_TRANSPARENT_VERTEX_ALPHA;
+	video::SMaterial& material = Buffer->getMaterial();
+	material.Wireframe = false;
+	material.Lighting = false;
+	material.FogEnable = false;
+	material.BackfaceCulling = false;
+	material.MaterialType = video::EMT_TRANSPARENT_VERTEX_ALPHA;
 
 	device->getRandomizer()->reset();
 	const u32 points=256;
-	Buffer.Vertices.reallocate(points);
 	for (u32 i=0; i<points; ++i)
 	{
 		f32 x = (f32)(1+device->getRandomizer()->rand()%points);
 		f32 y = (f32)(1+device->getRandomizer()->rand()%points);
 		f32 z = (f32)(1+device->getRandomizer()->rand()%points);
 		video::SColor color(255, device->getRandomizer()->rand()%255, device->getRandomizer()->rand()%255, device->getRandomizer()->rand()%255);
-		Buffer.Vertices.push_back( video::S3DVertex(x,y,z,0,1,0,color,0,0) );
+		video::S3DVertex vertex(x,y,z,0,1,0,color,0,0);
+		Buffer->getVertexBuffer()->addVertex(&vertex);
 	}
-	Buffer.recalculateBoundingBox();
-	for (u32 i=0; i<Buffer.Vertices.size(); ++i)
+	Buffer->recalculateBoundingBox();
+	for (u32 i=0; i<points; ++i)
 	{
-		Buffer.Indices.push_back(i);
+		Buffer->getIndexBuffer()->addIndex(i);
 	}
 
 	bool result = true;
@@ -54,40 +55,22 @@ bool testWithDriver(video::E_DRIVER_TYPE driverType)
 	{
 		driver->beginScene(true, true, video::SColor(255,100,101,140));
 		smgr->drawAll();
-		u32 primCount = 0;
-		switch (Type)
-		{
-			case scene::EPT_POINTS: primCount = Buffer.Indices.size(); break;
-			case scene::EPT_LINE_STRIP: primCount = Buffer.Indices.size()-1; break;
-			case scene::EPT_LINE_LOOP: primCount = Buffer.Indices.size()-1; break;
-			case scene::EPT_LINES: primCount = Buffer.Indices.size()/2; break;
-			case scene::EPT_TRIANGLE_STRIP: primCount = Buffer.Indices.size()-2; break;
-			case scene::EPT_TRIANGLE_FAN: primCount = Buffer.Indices.size()-2; break;
-			case scene::EPT_TRIANGLES: primCount = Buffer.Indices.size()/3; break;
-			case scene::EPT_QUAD_STRIP: primCount = (Buffer.Indices.size()-2)/4; break;
-			case scene::EPT_QUADS: primCount = Buffer.Indices.size()/4; break;
-			case scene::EPT_POLYGON: primCount = Buffer.Indices.size()-1; break;
-			case scene::EPT_POINT_SPRITES: primCount = Buffer.Indices.size(); break;
-			default: break;
-		}
- 
-		// TODO: mode is buggy, but required for skybox. So driver supports it, but would core dump here.
-		if (driverType==video::EDT_BURNINGSVIDEO && Type==scene::EPT_TRIANGLE_FAN)
-			continue;
-		driver->setMaterial(Buffer.Material);
+
+		Buffer->setPrimitiveType((scene::E_PRIMITIVE_TYPE)Type);
+		driver->setMaterial(material);
 		driver->setTransform(video::ETS_WORLD, core::IdentityMatrix);
-		driver->drawVertexPrimitiveList(Buffer.getVertices(),
-					Buffer.getVertexCount(), Buffer.getIndices(), primCount,
-					video::EVT_STANDARD, (scene::E_PRIMITIVE_TYPE)Type,
-					video::EIT_16BIT);
+		driver->drawMeshBuffer(Buffer);
 		driver->endScene();
 		core::stringc name = "-drawVPL_";
-		// we use character enumeration as we have more than 9 types
-		name.append(Type-scene::EPT_POINTS+'a');
+		// we use character enumeration of the former primitive types,
+		// which had quads and polygons before the point sprites
+		name.append(Type == scene::EPT_POINT_SPRITES ? 'k' : Type-scene::EPT_POINTS+'a');
 		name.append(".png");
 		result &= takeScreenshotAndCompareAgainstReference(driver, name.c_str());
 	}
 
+	Buffer->drop();
+
 	device->closeDevice();
 	device->run();
 	device->drop();
@@ -0,0 +1,82 @@
+// Copyright (C) 2008-2012 Colin MacDonald
+// No rights reserved: this software is in the public domain.
+
+#include "testUtils.h"
+
+using namespace irr;
+using namespace core;
+using namespace gui;
+
+static video::IImage* drawText(video::IVideoDriver* driver, IGUIFont* font, const wchar_t* text, bool center=true)
+{
+	const rect<s32> position(10, 10, 150, 110);
+	const rect<s32> clip(20, 20, 140, 100);
+
+	driver->beginScene(true, true, video::SColor(255, 40, 60, 80));
+	font->draw(text, position, video::SColor(255, 255, 255, 255), center, center, &clip);
+	driver->endScene();
+	return driver->createScreenShot();
+}
+
+//! Draws cached glyph runs, they must follow changes of the kerning and the invisible characters
+bool guiFontGlyphRuns(void)
+{
+	IrrlichtDevice *device = createDevice(video::EDT_BURNINGSVIDEO, dimension2d<u32>(160, 120), 32);
+	if (!device)
+		return true; // Treat a failure to create a driver as benign; this saves a lot of #ifdefs
+
+	video::IVideoDriver* driver = device->getVideoDriver();
+	IGUIFont* font = device->getGUIEnvironment()->getBuiltInFont();
+
+	const wchar_t* text = L"Hello\nWorld";
+	const dimension2d<u32> dimension = font->getDimension(text);
+
+	bool result = true;
+
+	video::IImage* reference = drawText(driver, font, text);
+	reference->grab();
+	if (!compareAndDropImages(reference, drawText(driver, font, text)))
+	{
+		logTestString("Drawing a cached text differs\n");
+		result = false;
+	}
+
+	font->setKerningWidth(3);
+	if (font->getDimension(text).Width != dimension.Width + 15)
+	{
+		logTestString("Kerning is not applied to the dimension\n");
+		result = false;
+	}
+	reference->grab();
+	if (compareAndDropImages(reference, drawText(driver, font, text)))
+	{
+		logTestString("Kerning is not applied to a cached text\n");
+		result = false;
+	}
+	font->setKerningWidth(0);
+	if (!compareAndDropImages(reference, drawText(driver, font, text)))
+	{
+		logTestString("Drawing a text after resetting the kerning differs\n");
+		result = false;
+	}
+
+	video::IImage* visible = drawText(driver, font, L"Hl", false);
+	font->setInvisibleCharacters(L" l");
+	if (!compareAndDropImages(drawText(driver, font, L"Hl", false), drawText(driver, font, L"H", false)))
+	{
+		logTestString("Invisible characters are drawn\n");
+		result = false;
+	}
+	font->setInvisibleCharacters(L" ");
+	if (!compareAndDropImages(visible, drawText(driver, font, L"Hl", false)))
+	{
+		logTestString("Visible characters are not drawn\n");
+		result = false;
+	}
+
+	device->closeDevice();
+	device->run();
+	device->drop();
+
+	return result;
+}
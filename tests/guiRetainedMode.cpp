@@ -0,0 +1,126 @@
+// Copyright (C) 2008-2012 Colin MacDonald
+// No rights reserved: this software is in the public domain.
+
+#include "testUtils.h"
+
+using namespace irr;
+using namespace core;
+using namespace gui;
+
+static const video::SColor Background(255, 40, 60, 80);
+
+static video::IImage* drawFrame(video::IVideoDriver* driver, IGUIEnvironment* env, bool clear)
+{
+	driver->beginScene(clear, true, Background);
+	env->drawAll();
+	driver->endScene();
+	return driver->createScreenShot();
+}
+
+static bool sameImage(video::IImage* a, video::IImage* b, const char* what)
+{
+	const bool result = compareAndDropImages(a, b);
+	if (!result)
+		logTestString("%s differs from drawing everything\n", what);
+
+	return result;
+}
+
+// Starts retained mode with a frame drawn into a cleared back buffer
+static void beginChanges(video::IVideoDriver* driver, IGUIEnvironment* env)
+{
+	env->setRetainedMode(true, Background);
+	drawFrame(driver, env, true)->drop();
+}
+
+// Draws the changes into the last frame, the result must match drawing everything
+static bool checkChanges(video::IVideoDriver* driver, IGUIEnvironment* env, const char* what)
+{
+	video::IImage* retained = drawFrame(driver, env, false);
+	env->setRetainedMode(false);
+	return sameImage(retained, drawFrame(driver, env, true), what);
+}
+
+//! Draws changes in retained mode into an uncleared back buffer, the frames must match drawing everything
+bool guiRetainedMode(void)
+{
+	IrrlichtDevice *device = createDevice(video::EDT_BURNINGSVIDEO, dimension2d<u32>(160, 120), 32);
+	if (!device)
+		return true; // Treat a failure to create a driver as benign; this saves a lot of #ifdefs
+
+	video::IVideoDriver* driver = device->getVideoDriver();
+	IGUIEnvironment* env = device->getGUIEnvironment();
+
+	IGUIButton* button = env->addButton(rect<s32>(10, 10, 70, 30), 0, -1, L"Button");
+	IGUIStaticText* text = env->addStaticText(L"Text", rect<s32>(10, 40, 150, 60), true);
+	IGUICheckBox* checkBox = env->addCheckBox(false, rect<s32>(10, 70, 150, 90), 0, -1, L"Check");
+
+	bool result = true;
+
+	env->setRetainedMode(true, Background);
+	video::IImage* retained = drawFrame(driver, env, true);
+	env->setRetainedMode(false);
+	result &= sameImage(retained, drawFrame(driver, env, true), "First frame");
+
+	// the changes of the following frames are drawn into the last frame
+	beginChanges(driver, env);
+	text->setText(L"Changed text");
+	result &= checkChanges(driver, env, "Changed text");
+
+	beginChanges(driver, env);
+	button->setRelativePosition(rect<s32>(80, 10, 150, 30));
+	drawFrame(driver, env, false)->drop();
+	result &= checkChanges(driver, env, "Moved button");
+
+	beginChanges(driver, env);
+	checkBox->setEnabled(false);
+	result &= checkChanges(driver, env, "Disabled check box");
+
+	// changes of state which is only known to the elements
+	beginChanges(driver, env);
+	checkBox->setChecked(true);
+	result &= checkChanges(driver, env, "Checked check box");
+
+	beginChanges(driver, env);
+	button->setIsPushButton(true);
+	button->setPressed(true);
+	result &= checkChanges(driver, env, "Pressed button");
+
+	text->setVisible(false);
+	checkBox->setVisible(false);
+	IGUIScrollBar* scrollBar = env->addScrollBar(true, rect<s32>(10, 40, 150, 55));
+	IGUIListBox* listBox = env->addListBox(rect<s32>(10, 60, 70, 110), 0, -1, true);
+	listBox->addItem(L"First");
+	listBox->addItem(L"Second");
+	IGUIComboBox* comboBox = env->addComboBox(rect<s32>(80, 60, 150, 80));
+	comboBox->addItem(L"First");
+	comboBox->addItem(L"Second");
+	IGUIImage* image = env->addImage(rect<s32>(80, 85, 150, 110));
+	image->setScaleImage(true);
+
+	beginChanges(driver, env);
+	scrollBar->setPos(50);
+	result &= checkChanges(driver, env, "Moved scrollbar");
+
+	beginChanges(driver, env);
+	listBox->setSelected(1);
+	result &= checkChanges(driver, env, "Selected list box item");
+
+	beginChanges(driver, env);
+	comboBox->setSelected(1);
+	result &= checkChanges(driver, env, "Selected combo box item");
+
+	beginChanges(driver, env);
+	image->setImage(driver->getTexture("../media/tools.png"));
+	result &= checkChanges(driver, env, "New image");
+
+	beginChanges(driver, env);
+	listBox->setVisible(false);
+	result &= checkChanges(driver, env, "Hidden list box");
+
+	device->closeDevice();
+	device->run();
+	device->drop();
+
+	return result;
+}
@@ -0,0 +1,198 @@
+#include "testUtils.h"
+#include <irrlicht.h>
+
+using namespace irr;
+using namespace core;
+
+// Compares the content of a hash_map with a core::map holding the same elements
+template <class KeyType, class ValueType>
+static bool compareWithMap(core::hash_map<KeyType, ValueType>& a, core::map<KeyType, ValueType>& b)
+{
+	if (a.size() != b.size())
+		return false;
+
+	u32 count = 0;
+	typename core::hash_map<KeyType, ValueType>::ConstIterator it = a.getConstIterator();
+	for (; !it.atEnd(); ++it, ++count)
+	{
+		typename core::map<KeyType, ValueType>::Node* n = b.find(it->getKey());
+		if (!n || n->getValue() != it->getValue())
+			return false;
+	}
+	return count == b.size();
+}
+
+// Random inserts, updates and removals, checked against core::map
+static bool testAgainstMap()
+{
+	core::hash_map<s32, s32> hmap;
+	core::map<s32, s32> map;
+
+	srand(4);
+	for (s32 i=0; i<20000; ++i)
+	{
+		const s32 key = rand() % 2000;
+		switch (rand() % 4)
+		{
+		case 0:
+			if (hmap.insert(key, i) != map.insert(key, i))
+				return false;
+			break;
+		case 1:
+			hmap.set(key, i);
+			map.set(key, i);
+			break;
+		case 2:
+			if (hmap.remove(key) != map.remove(key))
+				return false;
+			break;
+		default:
+			if ((hmap.find(key) != 0) != (map.find(key) != 0))
+				return false;
+			break;
+		}
+	}
+
+	bool result = compareWithMap(hmap, map);
+
+	core::hash_map<s32, s32> copy(hmap);
+	result &= compareWithMap(copy, map);
+
+	hmap.clear();
+	result &= hmap.empty() && !hmap.find(0) && hmap.getConstIterator().atEnd();
+
+	hmap.swap(copy);
+	result &= copy.empty() && compareWithMap(hmap, map);
+
+	assert_log(result);
+	return result;
+}
+
+// Keys with own hash traits
+static bool testKeyTypes()
+{
+	bool result = true;
+
+	core::hash_map<core::stringc, u32> strings;
+	strings["irr"] = 1;
+	strings["lichtt"] = 2;
+	strings["licht"] = 3;
+	strings.insert("engine", 4);
+	result &= strings.size() == 4 && strings["licht"] == 3 && !strings.find("irrlicht");
+	result &= strings.remove("irr") && !strings.find("irr") && strings.size() == 3;
+
+	core::hash_map<core::stringw, u32> wstrings;
+	wstrings[L"\x20ac"] = 1;
+	result &= wstrings.find(L"\x20ac") && !wstrings.find(L"e");
+
+	// 0 and -0 compare equal, so they have to be the same key
+	core::hash_map<core::vector3df, u32> vectors;
+	vectors[core::vector3df(0.f, 1.f, 2.f)] = 1;
+	result &= vectors.find(core::vector3df(-0.f, 1.f, 2.f)) != 0;
+	result &= !vectors.find(core::vector3df(0.f, 1.f, 2.0001f));
+
+	core::hash_set<video::S3DVertex> vertices;
+	video::S3DVertex v(1.f, 2.f, 3.f, 0.f, 1.f, 0.f, video::SColor(255,255,0,0), 0.5f, 0.5f);
+	result &= vertices.insert(v) && !vertices.insert(v) && vertices.contains(v);
+	v.TCoords.X = 0.25f;
+	result &= !vertices.contains(v) && vertices.insert(v) && vertices.size() == 2;
+
+	core::hash_set<s32*> pointers;
+	s32 values[64];
+	for (u32 i=0; i<64; ++i)
+		pointers.insert(values+i);
+	for (u32 i=0; i<64; i+=2)
+		pointers.remove(values+i);
+	for (u32 i=0; i<64; ++i)
+		result &= pointers.contains(values+i) == ((i & 1) != 0);
+
+	assert_log(result);
+	return result;
+}
+
+// Lookup speed compared to core::map, only logged as timings vary between machines
+static void benchmark()
+{
+#ifndef _DEBUG
+	IrrlichtDevice* device = createDevice(video::EDT_NULL);
+	if (!device)
+		return;
+	ITimer* timer = device->getTimer();
+
+	const s32 COUNT = 100000;
+	const s32 LOOKUPS = 2000000;
+
+	core::array<core::stringc> names;
+	names.reallocate(COUNT);
+	for (s32 i=0; i<COUNT; ++i)
+		names.push_back(core::stringc("node") + core::stringc(i*7919));
+
+	core::map<s32, s32> map;
+	core::hash_map<s32, s32> hmap;
+	core::map<core::stringc, s32> smap;
+	core::hash_map<core::stringc, s32> shmap;
+
+	u32 then = timer->getRealTime();
+	for (s32 i=0; i<COUNT; ++i)
+		map.insert(i*7919, i);
+	const u32 mapInsert = timer->getRealTime() - then;
+
+	then += mapInsert;
+	for (s32 i=0; i<COUNT; ++i)
+		hmap.insert(i*7919, i);
+	const u32 hashMapInsert = timer->getRealTime() - then;
+
+	s32 sum = 0;
+	then += hashMapInsert;
+	for (s32 i=0; i<LOOKUPS; ++i)
+		sum += map.find((i % COUNT)*7919)->getValue();
+	const u32 mapFind = timer->getRealTime() - then;
+
+	then += mapFind;
+	for (s32 i=0; i<LOOKUPS; ++i)
+		sum -= hmap.find((i % COUNT)*7919)->getValue();
+	const u32 hashMapFind = timer->getRealTime() - then;
+
+	then += hashMapFind;
+	for (s32 i=0; i<COUNT; ++i)
+		smap.insert(names[i], i);
+	for (s32 i=0; i<LOOKUPS/4; ++i)
+		sum += smap.find(names[i % COUNT])->getValue();
+	const u32 stringMap = timer->getRealTime() - then;
+
+	then += stringMap;
+	for (s32 i=0; i<COUNT; ++i)
+		shmap.insert(names[i], i);
+	for (s32 i=0; i<LOOKUPS/4; ++i)
+		sum -= shmap.find(names[i % COUNT])->getValue();
+	const u32 stringHashMap = timer->getRealTime() - then;
+
+	logTestString("Speed test (%d)\n"
+		"          map insert = %d\n     hash_map insert = %d\n"
+		"            map find = %d\n       hash_map find = %d\n"
+		"     map string keys = %d\nhash_map string keys = %d\n",
+		sum, mapInsert, hashMapInsert, mapFind, hashMapFind, stringMap, stringHashMap);
+
+	device->closeDevice();
+	device->run();
+	device->drop();
+#endif
+}
+
+// Test the functionality of core::hash_map and core::hash_set
+bool testIrrHashMap(void)
+{
+	bool success = true;
+
+	success &= testAgainstMap();
+	success &= testKeyTypes();
+	benchmark();
+
+	if(success)
+		logTestString("\nAll tests passed\n");
+	else
+		logTestString("\nFAIL!\n");
+
+	return success;
+}
+
@@ -54,6 +54,7 @@ int main(int argumentCount, char * arguments[])
 	// Now the simple tests without device
 	TEST(testIrrArray);
 	TEST(testIrrMap);
+	TEST(testIrrHashMap);
 	TEST(testIrrList);
 	TEST(exports);
 	TEST(irrCoreEquals);
@@ -83,10 +84,18 @@ int main(int argumentCount, char * arguments[])
 	TEST(sceneCollisionManager);
 	TEST(sceneNodeAnimator);
 	TEST(meshLoaders);
+	TEST(binaryMesh);
 	TEST(testTimer);
 	TEST(testCoreutil);
 	// software drivers only
 	TEST(softwareDevice);
+	TEST(vertexDescriptor);
+	TEST(commandList);
+	TEST(staticBatch);
+	TEST(multiView);
+	TEST(objectPool);
+	TEST(sceneNodeChildren);
+	TEST(meshBufferCulling);
 	TEST(b3dAnimation);
 	TEST(burningsVideo);
 	TEST(billboards);
@@ -94,6 +103,8 @@ int main(int argumentCount, char * arguments[])
 	TEST(cursorSetVisible);
 	TEST(flyCircleAnimator);
 	TEST(guiDisabledMenu);
+	TEST(guiRetainedMode);
+	TEST(guiFontGlyphRuns);
 	TEST(makeColorKeyTexture);
 	TEST(md2Animation);
 	TEST(meshTransform);
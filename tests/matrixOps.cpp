@@ -354,6 +354,180 @@ bool setRotationAxis()
 	return true;
 }
 
+// a matrix with rotation, non uniform scale and translation
+matrix4 testMatrix(f32 angle)
+{
+	matrix4 m;
+	m.setRotationDegrees(vector3df(angle, angle * 2.f, 30.f));
+	m.setTranslation(vector3df(1.f, -2.f, angle));
+	matrix4 scale;
+	scale.setScale(vector3df(2.f, .5f, 1.5f));
+	return m * scale;
+}
+
+// the array versions must give the same results as the single ones
+bool batchTransforms()
+{
+	bool result = true;
+	const matrix4 m = testMatrix(40.f);
+
+	// strided like the positions and normals of vertices
+	S3DVertex vertices[17];
+	vector3df positions[17];
+	for (u32 i = 0; i < 17; ++i)
+	{
+		vertices[i].Pos.set(i * 1.5f, -(f32)i, 3.f - i);
+		vertices[i].Normal.set(1.f, (f32)i, .5f);
+	}
+
+	m.transformVects(positions, &vertices[0].Pos, 17, sizeof(vector3df), sizeof(S3DVertex));
+	m.rotateVects(&vertices[0].Normal, &vertices[0].Normal, 17, sizeof(S3DVertex), sizeof(S3DVertex));
+
+	for (u32 i = 0; i < 17; ++i)
+	{
+		vector3df pos(vertices[i].Pos);
+		m.transformVect(pos);
+		vector3df normal(1.f, (f32)i, .5f);
+		m.rotateVect(normal);
+
+		result &= positions[i].equals(pos) && vertices[i].Normal.equals(normal);
+		result &= vertices[i].Pos.equals(vector3df(i * 1.5f, -(f32)i, 3.f - i));
+	}
+
+	// packed, which the SSE backend transforms four at once, with a remainder
+	vector3df packed[19];
+	vector3df transformed[19];
+	for (u32 i = 0; i < 19; ++i)
+		packed[i].set(i * 0.75f - 4.f, 2.f - i * 1.25f, (f32)(i * i) * 0.1f);
+
+	m.transformVects(transformed, packed, 19);
+	for (u32 i = 0; i < 19; ++i)
+	{
+		vector3df pos(packed[i]);
+		m.transformVect(pos);
+		result &= transformed[i].equals(pos);
+	}
+
+	// in place
+	m.rotateVects(transformed, transformed, 19);
+	m.transformVects(packed, packed, 19);
+	for (u32 i = 0; i < 19; ++i)
+	{
+		vector3df pos(i * 0.75f - 4.f, 2.f - i * 1.25f, (f32)(i * i) * 0.1f);
+		m.transformVect(pos);
+		result &= packed[i].equals(pos);
+
+		m.rotateVect(pos);
+		result &= transformed[i].equals(pos);
+	}
+
+	aabbox3df boxes[5];
+	for (u32 i = 0; i < 5; ++i)
+		boxes[i] = aabbox3df(-(f32)i, -1.f, 0.f, (f32)i, 2.f, i * 3.f);
+	m.transformBoxesEx(boxes, 5);
+
+	for (u32 i = 0; i < 5; ++i)
+	{
+		aabbox3df box(-(f32)i, -1.f, 0.f, (f32)i, 2.f, i * 3.f);
+		m.transformBoxEx(box);
+		result &= box.MinEdge.equals(boxes[i].MinEdge) && box.MaxEdge.equals(boxes[i].MaxEdge);
+	}
+
+	if (!result)
+		logTestString("Array transformations differ from single ones\n");
+
+	// inverse, and none for singular matrices
+	matrix4 inverse;
+	result &= m.getInverse(inverse) && (m * inverse).equals(matrix4(), 0.0001f);
+	result &= !matrix4().setScale(vector3df(1.f, 0.f, 1.f)).getInverse(inverse);
+
+	// products of several matrices
+	const matrix4 product = m * testMatrix(10.f) * testMatrix(-70.f);
+	matrix4 expected;
+	for (u32 row = 0; row < 4; ++row)
+		for (u32 col = 0; col < 4; ++col)
+		{
+			const matrix4 ab = m * testMatrix(10.f);
+			const matrix4 c = testMatrix(-70.f);
+			expected(row, col) = c(row, 0) * ab(0, col) + c(row, 1) * ab(1, col) + c(row, 2) * ab(2, col) + c(row, 3) * ab(3, col);
+		}
+	result &= product.equals(expected, 0.0001f);
+
+	if (!result)
+		logTestString("Matrix inverse or product failed\n");
+
+	return result;
+}
+
+// Speed of the matrix operations, only logged as timings vary between machines
+void benchmark()
+{
+#ifndef _DEBUG
+	IrrlichtDevice* device = createDevice(video::EDT_NULL);
+	if (!device)
+		return;
+	ITimer* timer = device->getTimer();
+
+	const u32 ITERATIONS = 200000;
+	const u32 POINTS = 1000;
+
+	matrix4 m = testMatrix(40.f);
+	matrix4 acc;
+	u32 i, j;
+
+	u32 then = timer->getRealTime();
+	for (i = 0; i < ITERATIONS; ++i)
+		acc.setbyproduct_nocheck(matrix4(acc), m);
+	const u32 multiplyTime = timer->getRealTime() - then;
+
+	then += multiplyTime;
+	for (i = 0; i < ITERATIONS; ++i)
+		m.getInverse(acc);
+	const u32 inverseTime = timer->getRealTime() - then;
+
+	core::array<vector3df> points;
+	points.set_used(POINTS);
+	for (i = 0; i < POINTS; ++i)
+		points[i].set((f32)i, 1.f, -(f32)i);
+
+	then = timer->getRealTime();
+	for (i = 0; i < ITERATIONS / POINTS * 10; ++i)
+		for (j = 0; j < POINTS; ++j)
+			m.transformVect(points[j]);
+	const u32 transformTime = timer->getRealTime() - then;
+
+	then += transformTime;
+	for (i = 0; i < ITERATIONS / POINTS * 10; ++i)
+		m.transformVects(points.pointer(), points.pointer(), POINTS);
+	const u32 batchTransformTime = timer->getRealTime() - then;
+
+	aabbox3df box(-1.f, -1.f, -1.f, 1.f, 1.f, 1.f);
+	then = timer->getRealTime();
+	for (i = 0; i < ITERATIONS; ++i)
+		m.transformBoxEx(box);
+	const u32 boxTime = timer->getRealTime() - then;
+
+#if defined(_IRR_USE_SSE_)
+	const char* backend = "SSE";
+#else
+	const char* backend = "scalar";
+#endif
+
+	logTestString("Speed test of the %s matrix4, %d iterations\n"
+		"          multiply: %d ms\n           inverse: %d ms\n"
+		"     transformVect: %d ms\n    transformVects: %d ms\n    transformBoxEx: %d ms\n",
+		backend, ITERATIONS, multiplyTime, inverseTime, transformTime, batchTransformTime, boxTime);
+
+	// keeps the results alive
+	if (acc.equals(m) && box.isEmpty() && points[0].equals(points[1]))
+		logTestString("\n");
+
+	device->closeDevice();
+	device->run();
+	device->drop();
+#endif
+}
+
 // just calling each function once to find compile problems
 void calltest()
 {
@@ -413,6 +587,9 @@ void calltest()
 	aabbox3df bb1;
 	mat.transformBox(bb1);
 	mat.transformBoxEx(bb1);
+	mat.transformVects(&v1, &v2, 1);
+	mat.rotateVects(&v1, &v2, 1);
+	mat.transformBoxesEx(&bb1, 1);
 	mat.multiplyWith1x4Matrix(fv4);
 	mat.makeInverse();
 	b = mat.getInversePrimitive(mat2);
@@ -460,6 +637,8 @@ bool matrixOps(void)
 	result &= isOrthogonal();
 	result &= transformations();
 	result &= setRotationAxis();
+	result &= batchTransforms();
+	benchmark();
 	return result;
 }
 
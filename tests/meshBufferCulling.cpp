@@ -0,0 +1,114 @@
+// Copyright (C) 2008-2012 Colin MacDonald
+// No rights reserved: this software is in the public domain.
+
+#include "testUtils.h"
+
+using namespace irr;
+using namespace core;
+using namespace scene;
+using namespace video;
+
+namespace
+{
+
+// a row of cubes along the x axis, each in its own mesh buffer
+SMesh* createRowMesh(ISceneManager* smgr, u32 count)
+{
+	SMesh* mesh = new SMesh();
+
+	for (u32 i = 0; i < count; ++i)
+	{
+		IMesh* cube = smgr->getGeometryCreator()->createCubeMesh(vector3df(6.f, 6.f, 6.f));
+		IMeshBuffer* mb = cube->getMeshBuffer(0);
+
+		matrix4 m;
+		m.setTranslation(vector3df(i * 20.f, 0.f, 0.f));
+		smgr->getMeshManipulator()->transform(mb, m);
+		mb->recalculateBoundingBox();
+		mb->getMaterial().Lighting = false;
+		mb->getMaterial().DiffuseColor = SColor(255, 255, i * 3, 0);
+		mb->getMaterial().ColorMaterial = ECM_NONE;
+
+		mesh->addMeshBuffer(mb);
+		cube->drop();
+	}
+
+	mesh->recalculateBoundingBox();
+	return mesh;
+}
+
+void drawFrame(IrrlichtDevice* device)
+{
+	device->getVideoDriver()->beginScene(true, true, SColor(255, 40, 40, 40));
+	device->getSceneManager()->drawAll();
+	device->getVideoDriver()->endScene();
+}
+
+// draws the node with and without culling its buffers
+bool compareCulling(IrrlichtDevice* device, ISceneNode* node, const c8* name)
+{
+	IVideoDriver* driver = device->getVideoDriver();
+
+	node->setAutomaticCulling(EAC_BOX);
+	drawFrame(device);
+	const u32 drawCalls = driver->getDrawCallCount();
+	IImage* reference = driver->createScreenShot();
+
+	node->setAutomaticCulling(EAC_BOX | EAC_MESH_BUFFERS);
+	drawFrame(device);
+
+	// only the first few cubes are in front of the camera
+	bool result = drawCalls == 64 && driver->getDrawCallCount() > 0 && driver->getDrawCallCount() < 8;
+	if (!result)
+		logTestString("%s drew %d of %d buffers\n", name, driver->getDrawCallCount(), drawCalls);
+
+	if (reference)
+	{
+		result &= compareAndDropImages(reference, driver->createScreenShot());
+		if (!result)
+			logTestString("%s differs with culled buffers\n", name);
+	}
+
+	node->setVisible(false);
+	return result;
+}
+
+//! Buffers outside of the view are not drawn, the image stays the same
+bool testWithDriver(E_DRIVER_TYPE driverType)
+{
+	IrrlichtDevice* device = createDevice(driverType, dimension2d<u32>(160, 120), 32);
+	if (!device)
+		return true; // Treat a failure to create a driver as benign; this saves a lot of #ifdefs
+
+	IVideoDriver* driver = device->getVideoDriver();
+	ISceneManager* smgr = device->getSceneManager();
+
+	logTestString("Testing driver %ls\n", driver->getName());
+
+	SMesh* mesh = createRowMesh(smgr, 64);
+	smgr->addCameraSceneNode(0, vector3df(10.f, 10.f, -40.f), vector3df(10.f, 0.f, 0.f))->setFOV(PI / 4.f);
+
+	bool result = compareCulling(device, smgr->addMeshSceneNode(mesh), "Mesh scene node");
+
+	SAnimatedMesh* animated = new SAnimatedMesh(mesh);
+	result &= compareCulling(device, smgr->addAnimatedMeshSceneNode(animated), "Animated mesh scene node");
+	animated->drop();
+
+	mesh->drop();
+
+	device->closeDevice();
+	device->run();
+	device->drop();
+
+	return result;
+}
+
+}
+
+bool meshBufferCulling(void)
+{
+	bool result = testWithDriver(EDT_NULL);
+	result &= testWithDriver(EDT_BURNINGSVIDEO);
+	return result;
+}
+
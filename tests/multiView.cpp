@@ -0,0 +1,200 @@
+// Copyright (C) 2008-2012 Colin MacDonald
+// No rights reserved: this software is in the public domain.
+
+#include "testUtils.h"
+
+using namespace irr;
+using namespace core;
+using namespace scene;
+using namespace video;
+
+namespace
+{
+
+// counts how often the scene is animated
+class CountingAnimator : public ISceneNodeAnimator
+{
+public:
+	CountingAnimator() : Count(0) {}
+
+	virtual void animateNode(ISceneNode* node, u32 timeMs) { ++Count; }
+
+	virtual ISceneNodeAnimator* createClone(ISceneNode* node, ISceneManager* newManager=0) { return 0; }
+
+	u32 Count;
+};
+
+void addScene(ISceneManager* smgr, array<ICameraSceneNode*>& cameras, array<rect<s32> >& viewPorts)
+{
+	for (s32 z = 0; z < 5; ++z)
+	{
+		for (s32 x = 0; x < 5; ++x)
+		{
+			IMeshSceneNode* node = smgr->addCubeSceneNode(6.f, 0, -1, vector3df(x * 20.f - 40.f, 0.f, z * 20.f - 40.f));
+			node->setMaterialFlag(EMF_LIGHTING, false);
+			node->getMaterial(0).DiffuseColor = SColor(255, x * 60, z * 60, 128);
+			node->getMaterial(0).ColorMaterial = ECM_NONE;
+
+			// a few transparent ones, sorted for each view
+			if ((x + z) % 4 == 0)
+				node->setMaterialType(EMT_TRANSPARENT_ADD_COLOR);
+		}
+	}
+
+	// the four views look at different parts of the grid
+	const vector3df from[4] = { vector3df(-60, 30, -60), vector3df(60, 30, -60), vector3df(0, 100, 0), vector3df(0, 10, 60) };
+	const vector3df to[4] = { vector3df(-40, 0, -40), vector3df(40, 0, -40), vector3df(0, 0, 1), vector3df(0, 0, 200) };
+	for (u32 i = 0; i < 4; ++i)
+	{
+		cameras.push_back(smgr->addCameraSceneNode(0, from[i], to[i], -1, false));
+		viewPorts.push_back(rect<s32>((i % 2) * 80, (i / 2) * 60, (i % 2) * 80 + 80, (i / 2) * 60 + 60));
+	}
+}
+
+//! Drawing all views at once must look like drawing them one after another
+bool testWithDriver(E_DRIVER_TYPE driverType)
+{
+	IrrlichtDevice* device = createDevice(driverType, dimension2d<u32>(160, 120), 32);
+	if (!device)
+		return true; // Treat a failure to create a driver as benign; this saves a lot of #ifdefs
+
+	IVideoDriver* driver = device->getVideoDriver();
+	ISceneManager* smgr = device->getSceneManager();
+
+	logTestString("Testing driver %ls\n", driver->getName());
+
+	array<ICameraSceneNode*> cameras;
+	array<rect<s32> > viewPorts;
+	addScene(smgr, cameras, viewPorts);
+
+	ICameraSceneNode* active = smgr->addCameraSceneNode();
+
+	CountingAnimator* animator = new CountingAnimator();
+	smgr->getRootSceneNode()->addAnimator(animator);
+	animator->drop();
+
+	const rect<s32> screen(0, 0, 160, 120);
+
+	// one view after another
+	driver->beginScene(true, true, SColor(255, 40, 40, 40));
+	for (u32 i = 0; i < cameras.size(); ++i)
+	{
+		smgr->setActiveCamera(cameras[i]);
+		driver->setViewPort(viewPorts[i]);
+		smgr->drawAll();
+	}
+	driver->endScene();
+	driver->setViewPort(screen);
+
+	const u32 drawCalls = driver->getDrawCallCount();
+	const u32 primitives = driver->getPrimitiveCountDrawn();
+	IImage* reference = driver->createScreenShot();
+
+	smgr->setActiveCamera(active);
+	animator->Count = 0;
+
+	driver->beginScene(true, true, SColor(255, 40, 40, 40));
+	smgr->drawAllViews(cameras, viewPorts);
+	driver->endScene();
+
+	// animated once, culled for each view, and the state is restored
+	bool result = animator->Count == 1;
+	result &= smgr->getActiveCamera() == active && driver->getViewPort() == screen;
+	result &= driver->getDrawCallCount() == drawCalls && driver->getPrimitiveCountDrawn() == primitives;
+	result &= drawCalls < cameras.size() * 25;
+	if (!result)
+		logTestString("Views drew %d instead of %d primitives in %d instead of %d calls, animated %d times\n",
+			driver->getPrimitiveCountDrawn(), primitives, driver->getDrawCallCount(), drawCalls, animator->Count);
+
+	if (reference)
+	{
+		result &= compareAndDropImages(reference, driver->createScreenShot());
+		if (!result)
+			logTestString("Views differ from drawing them one after another\n");
+	}
+
+	device->closeDevice();
+	device->run();
+	device->drop();
+
+	return result;
+}
+
+//! The terrain calculates its LODs for the camera of each view, also without an active camera
+bool terrainWithDriver(E_DRIVER_TYPE driverType)
+{
+	IrrlichtDevice* device = createDevice(driverType, dimension2d<u32>(160, 120), 32);
+	if (!device)
+		return true; // Treat a failure to create a driver as benign; this saves a lot of #ifdefs
+
+	IVideoDriver* driver = device->getVideoDriver();
+	ISceneManager* smgr = device->getSceneManager();
+
+	logTestString("Testing terrain with driver %ls\n", driver->getName());
+
+	ITerrainSceneNode* terrain = smgr->addTerrainSceneNode("../media/terrain-heightmap.bmp",
+		0, -1, vector3df(-512.f, -100.f, -512.f), vector3df(), vector3df(4.f, .5f, 4.f));
+	terrain->setMaterialFlag(EMF_LIGHTING, false);
+	terrain->setMaterialTexture(0, driver->getTexture("../media/terrain-texture.jpg"));
+
+	// the views look in opposite directions, each sees the patches the other can't
+	array<ICameraSceneNode*> cameras;
+	cameras.push_back(smgr->addCameraSceneNode(0, vector3df(0, 50, 0), vector3df(0, 0, 200), -1, false));
+	cameras.push_back(smgr->addCameraSceneNode(0, vector3df(0, 50, 0), vector3df(0, 0, -200), -1, false));
+	array<rect<s32> > viewPorts;
+	viewPorts.push_back(rect<s32>(0, 0, 80, 120));
+	viewPorts.push_back(rect<s32>(80, 0, 160, 120));
+	for (u32 i = 0; i < cameras.size(); ++i)
+		cameras[i]->setAspectRatio(80.f / 120.f);
+
+	const rect<s32> screen(0, 0, 160, 120);
+
+	driver->beginScene(true, true, SColor(255, 40, 40, 40));
+	for (u32 i = 0; i < cameras.size(); ++i)
+	{
+		smgr->setActiveCamera(cameras[i]);
+		driver->setViewPort(viewPorts[i]);
+		smgr->drawAll();
+	}
+	driver->endScene();
+	driver->setViewPort(screen);
+
+	const u32 primitives = driver->getPrimitiveCountDrawn();
+	IImage* reference = driver->createScreenShot();
+
+	smgr->setActiveCamera(0);
+
+	driver->beginScene(true, true, SColor(255, 40, 40, 40));
+	smgr->drawAllViews(cameras, viewPorts);
+	driver->endScene();
+
+	bool result = primitives > 0 && driver->getPrimitiveCountDrawn() == primitives;
+	result &= smgr->getActiveCamera() == 0;
+	if (!result)
+		logTestString("Terrain views drew %d instead of %d primitives\n", driver->getPrimitiveCountDrawn(), primitives);
+
+	if (reference)
+	{
+		result &= compareAndDropImages(reference, driver->createScreenShot());
+		if (!result)
+			logTestString("Terrain views differ from drawing them one after another\n");
+	}
+
+	device->closeDevice();
+	device->run();
+	device->drop();
+
+	return result;
+}
+
+}
+
+bool multiView(void)
+{
+	bool result = testWithDriver(EDT_NULL);
+	result &= testWithDriver(EDT_BURNINGSVIDEO);
+	result &= terrainWithDriver(EDT_NULL);
+	result &= terrainWithDriver(EDT_BURNINGSVIDEO);
+	return result;
+}
+
@@ -0,0 +1,132 @@
+// Copyright (C) 2008-2012 Colin MacDonald
+// No rights reserved: this software is in the public domain.
+
+#include "testUtils.h"
+
+using namespace irr;
+using namespace core;
+using namespace scene;
+
+namespace
+{
+
+// a user node, larger than the engine pools hold
+class BigSceneNode : public ISceneNode
+{
+public:
+	BigSceneNode(ISceneNode* parent, ISceneManager* mgr) : ISceneNode(parent, mgr) {}
+
+	virtual void render() {}
+	virtual const aabbox3df& getBoundingBox() const { return Box; }
+
+	aabbox3df Box;
+	u8 Data[4096];
+};
+
+//! freed blocks are handed out again before the pool grows
+bool blockReuse()
+{
+	memoryPool pool(20, 16);
+
+	bool result = pool.getBlockSize() >= 20 && pool.getBlockSize() % sizeof(void*) == 0;
+
+	array<void*> blocks;
+	for (u32 i = 0; i < 40; ++i)
+	{
+		blocks.push_back(pool.allocate());
+		memset(blocks.getLast(), (int)i, 20);
+	}
+
+	const size_t reserved = pool.getReservedSize();
+	result &= pool.getAllocatedCount() == 40 && reserved == 3 * 16 * pool.getBlockSize();
+
+	for (u32 i = 0; i < 40; i += 2)
+		pool.deallocate(blocks[i]);
+	result &= pool.getAllocatedCount() == 20;
+
+	// the odd blocks were not touched
+	for (u32 i = 1; i < 40 && result; i += 2)
+		result = ((u8*)blocks[i])[19] == i;
+
+	for (u32 i = 0; i < 20; ++i)
+	{
+		void* block = pool.allocate();
+		result &= blocks.linear_search(block) >= 0;
+	}
+	result &= pool.getReservedSize() == reserved && pool.getAllocatedCount() == 40;
+
+	if (!result)
+		logTestString("memoryPool did not reuse its blocks\n");
+
+	return result;
+}
+
+void addNodes(ISceneManager* smgr, u32 count)
+{
+	ISceneNode* parent = smgr->addEmptySceneNode();
+	for (u32 i = 0; i < count; ++i)
+	{
+		ISceneNode* node = smgr->addEmptySceneNode(parent);
+		ISceneNodeAnimator* anim = smgr->createRotationAnimator(vector3df(0.f, 1.f, 0.f));
+		node->addAnimator(anim);
+		anim->drop();
+
+		if (i % 10 == 0)
+			(new BigSceneNode(node, smgr))->drop();
+	}
+}
+
+//! nodes and animators removed in one frame make room for those of the next
+bool sceneNodes()
+{
+	IrrlichtDevice* device = createDevice(video::EDT_NULL);
+	if (!device)
+		return false;
+
+	ISceneManager* smgr = device->getSceneManager();
+
+	const SObjectPoolStatistics nodesBefore = getObjectPoolStatistics(EOP_SCENE_NODE);
+	const SObjectPoolStatistics animsBefore = getObjectPoolStatistics(EOP_SCENE_NODE_ANIMATOR);
+
+	addNodes(smgr, 500);
+	SObjectPoolStatistics nodes = getObjectPoolStatistics(EOP_SCENE_NODE);
+	SObjectPoolStatistics anims = getObjectPoolStatistics(EOP_SCENE_NODE_ANIMATOR);
+
+	bool result = nodes.Allocations - nodesBefore.Allocations == 1 + 500 + 50;
+	result &= anims.Allocations - animsBefore.Allocations == 500;
+#ifdef _IRR_USE_OBJECT_POOLS_
+	result &= anims.ReservedBytes > animsBefore.ReservedBytes;
+#endif
+
+	smgr->clear();
+	const SObjectPoolStatistics nodesCleared = getObjectPoolStatistics(EOP_SCENE_NODE);
+	const SObjectPoolStatistics animsCleared = getObjectPoolStatistics(EOP_SCENE_NODE_ANIMATOR);
+	result &= nodesCleared.Allocations - nodesCleared.Deallocations == nodesBefore.Allocations - nodesBefore.Deallocations;
+	result &= animsCleared.Allocations - animsCleared.Deallocations == animsBefore.Allocations - animsBefore.Deallocations;
+
+	// the second round fits into the blocks of the first one
+	addNodes(smgr, 500);
+	nodes = getObjectPoolStatistics(EOP_SCENE_NODE);
+	anims = getObjectPoolStatistics(EOP_SCENE_NODE_ANIMATOR);
+	result &= nodes.ReservedBytes == nodesCleared.ReservedBytes && anims.ReservedBytes == animsCleared.ReservedBytes;
+
+	if (!result)
+		logTestString("Pooled nodes: %d allocations, %d bytes; animators: %d allocations, %d bytes\n",
+			nodes.Allocations, nodes.ReservedBytes, anims.Allocations, anims.ReservedBytes);
+
+	device->closeDevice();
+	device->run();
+	device->drop();
+
+	return result;
+}
+
+}
+
+bool objectPool(void)
+{
+	bool result = blockReuse();
+	result &= sceneNodes();
+	return result;
+}
+
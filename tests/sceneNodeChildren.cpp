@@ -0,0 +1,133 @@
+// Copyright (C) 2008-2012 Colin MacDonald
+// No rights reserved: this software is in the public domain.
+
+#include "testUtils.h"
+
+using namespace irr;
+using namespace core;
+using namespace scene;
+
+namespace
+{
+
+// compares the children with the list returned by getChildren()
+bool sameChildren(ISceneNode* node, const array<ISceneNode*>& expected)
+{
+	bool result = node->getChildCount() == expected.size() && node->getChildren().size() == expected.size();
+
+	ISceneNodeList::ConstIterator it = node->getChildren().begin();
+	for (u32 i = 0; result && i < expected.size(); ++i, ++it)
+		result = node->getChild(i) == expected[i] && *it == expected[i] && expected[i]->getParent() == node;
+
+	return result;
+}
+
+//! children keep their order through adding, removing and moving them
+bool childOrder(ISceneManager* smgr)
+{
+	ISceneNode* parent = smgr->addEmptySceneNode();
+	ISceneNode* other = smgr->addEmptySceneNode();
+
+	array<ISceneNode*> expected;
+	for (s32 i = 0; i < 10; ++i)
+		expected.push_back(smgr->addEmptySceneNode(parent, i));
+
+	bool result = sameChildren(parent, expected);
+
+	// the list is updated after removing from the middle and the end
+	result &= parent->removeChild(expected[3]) && parent->removeChild(expected.getLast());
+	expected.erase(3);
+	expected.erase(expected.size() - 1);
+	result &= sameChildren(parent, expected);
+	result &= !parent->removeChild(other);
+
+	// moving a child appends it to the new parent
+	ISceneNode* moved = expected[0];
+	other->addChild(moved);
+	expected.erase(0);
+	result &= sameChildren(parent, expected) && other->getChildCount() == 1 && other->getChild(0) == moved;
+
+	// clones have their children in the same order, the clone belongs to the parent of the node
+	ISceneNode* copy = parent->clone();
+	result &= copy && copy->getChildCount() == expected.size();
+	for (u32 i = 0; result && i < expected.size(); ++i)
+		result = copy->getChild(i)->getID() == expected[i]->getID();
+	if (copy)
+		copy->remove();
+
+	parent->removeAll();
+	expected.clear();
+	result &= sameChildren(parent, expected);
+
+	if (!result)
+		logTestString("Children of scene nodes are out of order\n");
+
+	return result;
+}
+
+// counts the nodes which are animated
+class CountingAnimator : public ISceneNodeAnimator
+{
+public:
+	CountingAnimator() : Count(0) {}
+
+	virtual void animateNode(ISceneNode* node, u32 timeMs) { ++Count; }
+
+	virtual ISceneNodeAnimator* createClone(ISceneNode* node, ISceneManager* newManager=0) { return 0; }
+
+	u32 Count;
+};
+
+//! a wide node animates all its children, also while they remove themselves
+bool wideNode(IrrlichtDevice* device)
+{
+	ISceneManager* smgr = device->getSceneManager();
+	ISceneNode* parent = smgr->addEmptySceneNode();
+
+	const u32 CHILDREN = 10000;
+	CountingAnimator* animator = new CountingAnimator();
+	for (u32 i = 0; i < CHILDREN; ++i)
+		smgr->addEmptySceneNode(parent)->addAnimator(animator);
+
+	ITimer* timer = device->getTimer();
+	const u32 FRAMES = 20;
+	u32 then = timer->getRealTime();
+	for (u32 i = 0; i < FRAMES; ++i)
+		parent->OnAnimate(i);
+	logTestString("Animated %d frames of %d children in %d ms\n", FRAMES, CHILDREN, timer->getRealTime() - then);
+
+	bool result = animator->Count == FRAMES * CHILDREN;
+
+	// the deletion queue removes them after the traversal
+	animator->Count = 0;
+	for (u32 i = 0; i < parent->getChildCount(); i += 2)
+		smgr->addToDeletionQueue(parent->getChild(i));
+	smgr->drawAll();
+	result &= parent->getChildCount() == CHILDREN / 2 && animator->Count == CHILDREN;
+
+	animator->drop();
+
+	if (!result)
+		logTestString("Animated %d children, %d left\n", animator->Count, parent->getChildCount());
+
+	return result;
+}
+
+}
+
+bool sceneNodeChildren(void)
+{
+	IrrlichtDevice* device = createDevice(video::EDT_NULL);
+	if (!device)
+		return false;
+
+	bool result = childOrder(device->getSceneManager());
+	result &= wideNode(device);
+
+	device->closeDevice();
+	device->run();
+	device->drop();
+
+	return result;
+}
+
@@ -0,0 +1,199 @@
+// Copyright (C) 2008-2012 Colin MacDonald
+// No rights reserved: this software is in the public domain.
+
+#include "testUtils.h"
+
+using namespace irr;
+using namespace core;
+using namespace scene;
+using namespace video;
+
+namespace
+{
+
+// a grid of cubes with two materials, some of them rotated and scaled
+void addProps(ISceneManager* smgr, ISceneNode* parent, s32 count, f32 spacing)
+{
+	IMesh* cube = smgr->getGeometryCreator()->createCubeMesh(vector3df(4.f, 4.f, 4.f));
+
+	for (s32 z = 0; z < count; ++z)
+	{
+		for (s32 x = 0; x < count; ++x)
+		{
+			IMeshSceneNode* node = smgr->addMeshSceneNode(cube, parent, -1,
+				vector3df(5.f + x * spacing, 10.f, 5.f + z * spacing),
+				vector3df(0.f, (f32)(x * 20), (f32)(z * 10)),
+				vector3df(1.f + (x % 3) * .25f, 1.f, 1.f));
+
+			node->setMaterialFlag(EMF_LIGHTING, false);
+			node->getMaterial(0).DiffuseColor = SColor(255, (x + z) % 2 ? 255 : 0, 128, 0);
+			node->getMaterial(0).ColorMaterial = ECM_NONE;
+
+			// a child on top of some of them
+			if ((x + z) % 5 == 0)
+			{
+				IMeshSceneNode* child = smgr->addMeshSceneNode(cube, node, -1, vector3df(0.f, 4.f, 0.f),
+					vector3df(), vector3df(.5f, .5f, .5f));
+				child->setMaterialFlag(EMF_LIGHTING, false);
+			}
+		}
+	}
+
+	cube->drop();
+}
+
+void drawFrame(IrrlichtDevice* device)
+{
+	device->getVideoDriver()->beginScene(true, true, SColor(255, 40, 40, 40));
+	device->getSceneManager()->drawAll();
+	device->getVideoDriver()->endScene();
+}
+
+// counts the pixels which differ, the batches are transformed on the CPU
+bool similarImage(IImage* a, IImage* b)
+{
+	bool result = a && b && a->getDimension() == b->getDimension();
+
+	u32 differences = 0;
+	for (u32 y = 0; result && y < a->getDimension().Height; ++y)
+		for (u32 x = 0; x < a->getDimension().Width; ++x)
+			differences += a->getPixel(x, y) != b->getPixel(x, y);
+
+	if (result)
+		result = differences * 100 < a->getDimension().getArea();
+
+	if (a)
+		a->drop();
+	if (b)
+		b->drop();
+
+	return result;
+}
+
+//! Batched props must draw the same primitives in fewer calls
+bool testWithDriver(E_DRIVER_TYPE driverType)
+{
+	IrrlichtDevice* device = createDevice(driverType, dimension2d<u32>(160, 120), 32);
+	if (!device)
+		return true; // Treat a failure to create a driver as benign; this saves a lot of #ifdefs
+
+	IVideoDriver* driver = device->getVideoDriver();
+	ISceneManager* smgr = device->getSceneManager();
+
+	logTestString("Testing driver %ls\n", driver->getName());
+
+	// a transformed root, the batches must not apply it a second time
+	ISceneNode* props = smgr->addEmptySceneNode();
+	props->setPosition(vector3df(-5.f, 0.f, 5.f));
+	props->setRotation(vector3df(0.f, 5.f, 0.f));
+	addProps(smgr, props, 8, 10.f);
+
+	// moving and transparent nodes stay as they are
+	IMeshSceneNode* moving = static_cast<IMeshSceneNode*>(*props->getChildren().begin());
+	ISceneNodeAnimator* animator = smgr->createRotationAnimator(vector3df(0.f, 0.f, 0.f));
+	moving->addAnimator(animator);
+	animator->drop();
+
+	IMeshSceneNode* transparent = static_cast<IMeshSceneNode*>(*props->getChildren().getLast());
+	transparent->getMaterial(0).MaterialType = EMT_TRANSPARENT_VERTEX_ALPHA;
+	transparent->getMaterial(0).BlendOperation = EBO_ADD;
+	transparent->getMaterial(0).BlendFactor = pack_textureBlendFunc(EBF_SRC_ALPHA, EBF_ONE_MINUS_SRC_ALPHA);
+
+	smgr->addCameraSceneNode(0, vector3df(40.f, 120.f, -60.f), vector3df(40.f, 0.f, 40.f));
+
+	drawFrame(device);
+	const u32 drawCalls = driver->getDrawCallCount();
+	const u32 primitives = driver->getPrimitiveCountDrawn();
+	IImage* reference = driver->createScreenShot();
+
+	ISceneNode* batches = smgr->addStaticBatchSceneNode(props, 40.f);
+
+	bool result = batches && batches->getChildren().size() == 4 && batches->getParent() == smgr->getRootSceneNode();
+	result &= moving->isVisible() && transparent->isVisible() && !(*(++props->getChildren().begin()))->isVisible();
+	if (!result)
+		logTestString("Wrong nodes were batched\n");
+
+	drawFrame(device);
+
+	logTestString("Draw calls before batching %d, after %d\n", drawCalls, driver->getDrawCallCount());
+
+	// one batch per cell and material, at most two colors and the children per cell
+	u32 batchCount = 0;
+	if (batches)
+	{
+		ISceneNodeList::ConstIterator it = batches->getChildren().begin();
+		for (; it != batches->getChildren().end(); ++it)
+			batchCount += static_cast<IMeshSceneNode*>(*it)->getMesh()->getMeshBufferCount();
+	}
+
+	// the moving cube with its child and the transparent cube are drawn as before, if visible
+	result &= batchCount <= 4 * 3 && driver->getDrawCallCount() <= 3 + batchCount && driver->getDrawCallCount() * 4 < drawCalls;
+	result &= driver->getPrimitiveCountDrawn() == primitives;
+	if (!result)
+		logTestString("Batches drew %d instead of %d primitives in %d calls, %d batches\n", driver->getPrimitiveCountDrawn(), primitives, driver->getDrawCallCount(), batchCount);
+
+	if (reference)
+	{
+		result &= similarImage(reference, driver->createScreenShot());
+		if (!result)
+			logTestString("Batches differ from the props\n");
+	}
+
+	device->closeDevice();
+	device->run();
+	device->drop();
+
+	return result;
+}
+
+// Frame time with and without batching, only logged as timings vary between machines
+void benchmark()
+{
+#ifndef _DEBUG
+	IrrlichtDevice* device = createDevice(EDT_NULL);
+	if (!device)
+		return;
+
+	ITimer* timer = device->getTimer();
+	IVideoDriver* driver = device->getVideoDriver();
+	ISceneManager* smgr = device->getSceneManager();
+
+	ISceneNode* props = smgr->addEmptySceneNode();
+	addProps(smgr, props, 64, 10.f);
+	smgr->addCameraSceneNode(0, vector3df(320.f, 400.f, -100.f), vector3df(320.f, 0.f, 320.f))->setFarValue(5000.f);
+
+	const u32 FRAMES = 50;
+
+	u32 then = timer->getRealTime();
+	for (u32 i = 0; i < FRAMES; ++i)
+		drawFrame(device);
+	const u32 propsTime = timer->getRealTime() - then;
+	const u32 propsDrawCalls = driver->getDrawCallCount();
+
+	smgr->addStaticBatchSceneNode(props, 80.f);
+
+	then = timer->getRealTime();
+	for (u32 i = 0; i < FRAMES; ++i)
+		drawFrame(device);
+	const u32 batchTime = timer->getRealTime() - then;
+
+	logTestString("Speed test, %d frames of %d props\n"
+		"    props: %d draw calls, %d ms\n  batches: %d draw calls, %d ms\n",
+		FRAMES, props->getChildren().size(), propsDrawCalls, propsTime, driver->getDrawCallCount(), batchTime);
+
+	device->closeDevice();
+	device->run();
+	device->drop();
+#endif
+}
+
+}
+
+bool staticBatch(void)
+{
+	bool result = testWithDriver(EDT_NULL);
+	result &= testWithDriver(EDT_BURNINGSVIDEO);
+	benchmark();
+	return result;
+}
+
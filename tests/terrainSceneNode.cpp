@@ -117,12 +117,441 @@ bool terrainGaps()
 	return result;
 }
 
+// compares the triangles of the selector with the patches of the render buffer
+bool sameTriangles(scene::ITerrainSceneNode* terrain, scene::ITriangleSelector* selector, s32 LOD)
+{
+	const s32 count = selector->getTriangleCount();
+	core::array<triangle3df> triangles(count);
+	triangles.set_used(count);
+	s32 outCount = 0;
+	selector->getTriangles(triangles.pointer(), count, outCount);
+	if (outCount != count)
+		return false;
+
+	scene::IMeshBuffer* mb = terrain->getRenderBuffer();
+	const u32 vertexSize = mb->getVertexBuffer()->getVertexSize();
+	const u8* vertices = (const u8*)mb->getVertexBuffer()->getVertices() +
+		mb->getVertexDescriptor()->getAttributeBySemantic(video::EVAS_POSITION)->getOffset();
+
+	core::array<u32> indices;
+	s32 t = 0;
+	for (s32 x = 0; terrain->getIndicesForPatch(indices, x, 0, LOD) > 0; ++x)
+	{
+		s32 indexCount;
+		for (s32 z = 0; (indexCount = terrain->getIndicesForPatch(indices, x, z, LOD)) > 0; ++z)
+		{
+			for (s32 i = 0; i < indexCount; i += 3, ++t)
+			{
+				const triangle3df tri(*(const vector3df*)(vertices + indices[i] * vertexSize),
+					*(const vector3df*)(vertices + indices[i+1] * vertexSize),
+					*(const vector3df*)(vertices + indices[i+2] * vertexSize));
+				if (t >= count || !(tri == triangles[t]))
+					return false;
+			}
+		}
+	}
+
+	return t == count;
+}
+
+// returns the nearest collision of a line with some triangles
+bool collide(const core::line3df& line, const triangle3df* triangles, s32 count, f32& distance)
+{
+	bool found = false;
+	for (s32 i = 0; i < count; ++i)
+	{
+		vector3df point;
+		if (triangles[i].getIntersectionWithLimitedLine(line, point))
+		{
+			const f32 d = point.getDistanceFromSQ(line.start);
+			if (!found || d < distance)
+				distance = d;
+			found = true;
+		}
+	}
+	return found;
+}
+
+// lines and boxes must find the same triangles as tests against all triangles
+bool selectorQueries(IrrlichtDevice* device, scene::ITerrainSceneNode* terrain, s32 LOD, bool testBoxes)
+{
+	scene::ITriangleSelector* selector = device->getSceneManager()->createTerrainTriangleSelector(terrain, LOD);
+
+	const s32 count = selector->getTriangleCount();
+	core::array<triangle3df> all(count);
+	all.set_used(count);
+	core::array<triangle3df> selected(count);
+	selected.set_used(count);
+	s32 allCount = 0;
+	selector->getTriangles(all.pointer(), count, allCount);
+
+	const aabbox3df& box = terrain->getBoundingBox();
+	const vector3df extent = box.getExtent();
+	IRandomizer* random = device->getRandomizer();
+
+	bool result = true;
+	s32 selectedTotal = 0;
+
+	for (u32 i = 0; i < 100 && result; ++i)
+	{
+		const vector3df a(box.MinEdge.X + random->frand() * extent.X,
+			box.MinEdge.Y + random->frand() * extent.Y * 2.f,
+			box.MinEdge.Z + random->frand() * extent.Z);
+		const vector3df b(box.MinEdge.X + random->frand() * extent.X,
+			box.MinEdge.Y - extent.Y + random->frand() * extent.Y * 2.f,
+			box.MinEdge.Z + random->frand() * extent.Z);
+		const line3df line(a, b);
+
+		s32 selectedCount = 0;
+		selector->getTriangles(selected.pointer(), count, selectedCount, line);
+		selectedTotal += selectedCount;
+
+		f32 expected = 0.f;
+		f32 distance = 0.f;
+		const bool hit = collide(line, all.pointer(), allCount, expected);
+		if (hit != collide(line, selected.pointer(), selectedCount, distance) || (hit && expected != distance))
+		{
+			logTestString("Line %d misses triangles\n", i);
+			result = false;
+		}
+	}
+
+	if (selectedTotal >= allCount)
+	{
+		logTestString("Lines select too many triangles\n");
+		result = false;
+	}
+
+	for (u32 i = 0; i < 50 && result && testBoxes; ++i)
+	{
+		// boxes close to the surface
+		vector3df center(box.MinEdge.X + random->frand() * extent.X, 0.f,
+			box.MinEdge.Z + random->frand() * extent.Z);
+		const vector3df size(extent * 0.05f * random->frand());
+		center.Y = terrain->getHeight(center.X, center.Z) + size.Y * (random->frand() * 4.f - 2.f);
+		const aabbox3df query(center - size, center + size);
+
+		s32 selectedCount = 0;
+		selector->getTriangles(selected.pointer(), count, selectedCount, query);
+
+		for (s32 j = 0; j < allCount && result; ++j)
+		{
+			if (all[j].isTotalOutsideBox(query))
+				continue;
+
+			s32 k = 0;
+			while (k < selectedCount && !(selected[k] == all[j]))
+				++k;
+
+			if (k == selectedCount)
+			{
+				logTestString("Box %d misses triangles\n", i);
+				result = false;
+			}
+		}
+	}
+
+	selector->drop();
+	return result;
+}
+
+// queries the triangles of the terrain selector
+bool terrainSelector()
+{
+	IrrlichtDevice* device = createDevice(video::EDT_NULL, dimension2d<u32>(160, 120));
+	if (!device)
+		return true;
+
+	scene::ISceneManager* smgr = device->getSceneManager();
+	scene::ITerrainSceneNode* terrain = smgr->addTerrainSceneNode("../media/terrain-heightmap.bmp",
+		0, -1, vector3df(-100.f, -50.f, 30.f), vector3df(), vector3df(4.f, .5f, 4.f));
+
+	bool result = true;
+
+	for (s32 lod = 0; lod < 3; ++lod)
+	{
+		scene::ITriangleSelector* selector = smgr->createTerrainTriangleSelector(terrain, lod);
+		if (!sameTriangles(terrain, selector, lod))
+		{
+			logTestString("Triangles of LOD %d differ from the patches\n", lod);
+			result = false;
+		}
+		selector->drop();
+	}
+
+	result &= selectorQueries(device, terrain, 0, true);
+	result &= selectorQueries(device, terrain, 2, true);
+
+	terrain->setRotation(vector3df(0.f, 30.f, 0.f));
+	result &= selectorQueries(device, terrain, 0, false);
+
+	device->closeDevice();
+	device->run();
+	device->drop();
+	return result;
+}
+
+// the indices of the render buffer must match the indices of the patches while the camera flies
+bool terrainIndices()
+{
+	IrrlichtDevice* device = createDevice(video::EDT_NULL, dimension2d<u32>(160, 120));
+	if (!device)
+		return true;
+
+	scene::ISceneManager* smgr = device->getSceneManager();
+	scene::ITerrainSceneNode* terrain = smgr->addTerrainSceneNode("../media/terrain-heightmap.bmp",
+		0, -1, vector3df(), vector3df(), vector3df(40.f, 4.4f, 40.f));
+
+	scene::ICameraSceneNode* camera = smgr->addCameraSceneNode();
+	camera->setFarValue(20000.f);
+
+	const aabbox3df& box = terrain->getBoundingBox();
+	bool result = true;
+
+	for (u32 i = 0; i < 20 && result; ++i)
+	{
+		const f32 f = i / 19.f;
+		camera->setPosition(vector3df(box.MinEdge.X + box.getExtent().X * f, box.MaxEdge.Y, box.MinEdge.Z + box.getExtent().Z * f * .5f));
+		camera->setTarget(camera->getPosition() + vector3df(cosf(f * 6.f), -.3f, sinf(f * 6.f)) * 1000.f);
+		camera->updateAbsolutePosition();
+		smgr->drawAll();
+
+		scene::IIndexBuffer* indexBuffer = terrain->getRenderBuffer()->getIndexBuffer();
+		core::array<u32> indices;
+		u32 start = 0;
+
+		for (s32 x = 0; terrain->getIndicesForPatch(indices, x, 0, 0) > 0; ++x)
+		{
+			for (s32 z = 0; terrain->getIndicesForPatch(indices, x, z, 0) > 0; ++z)
+			{
+				const s32 indexCount = terrain->getIndicesForPatch(indices, x, z, -1);
+				for (s32 j = 0; j < indexCount && result; ++j, ++start)
+					result = start < indexBuffer->getIndexCount() && indexBuffer->getIndex(start) == indices[j];
+			}
+		}
+
+		if (!result)
+			logTestString("Indices of the render buffer differ from the patches at position %d\n", i);
+	}
+
+	device->closeDevice();
+	device->run();
+	device->drop();
+	return result;
+}
+
+// Splits a heightmap into tiles, the paged terrain must have the same heights
+// as the terrain of the whole heightmap and keep only the recently used tiles
+bool pagedTerrain()
+{
+	IrrlichtDevice* device = createDevice(video::EDT_NULL, dimension2d<u32>(160, 120));
+	if (!device)
+		return true;
+
+	video::IVideoDriver* driver = device->getVideoDriver();
+	scene::ISceneManager* smgr = device->getSceneManager();
+
+	// the terrain reads heightmap columns from right to left
+	video::IImage* heightmap = driver->createImageFromFile("../media/terrain-heightmap.bmp");
+	for (s32 z = 0; z < 2; ++z)
+	{
+		for (s32 x = 0; x < 2; ++x)
+		{
+			video::IImage* tile = driver->createImage(video::ECF_R8G8B8, dimension2d<u32>(65, 65));
+			for (u32 j = 0; j < 65; ++j)
+				for (u32 i = 0; i < 65; ++i)
+					tile->setPixel(i, j, heightmap->getPixel(191 - 64 * x + i, 64 * z + j));
+
+			driver->writeImageToFile(tile, core::stringc("results/pagedTerrain_") + core::stringc(x) + "_" + core::stringc(z) + ".bmp");
+			tile->drop();
+		}
+	}
+	heightmap->drop();
+
+	const vector3df scale(40.f, 4.4f, 40.f);
+	scene::ITerrainSceneNode* terrain = smgr->addTerrainSceneNode("../media/terrain-heightmap.bmp",
+		0, -1, vector3df(), vector3df(), scale);
+	scene::IPagedTerrainSceneNode* paged = smgr->addPagedTerrainSceneNode("results/pagedTerrain_{x}_{z}.bmp",
+		65, 0, -1, vector3df(), scale);
+
+	scene::ICameraSceneNode* camera = smgr->addCameraSceneNode();
+	camera->setFarValue(20000.f);
+
+	paged->setViewRadius(1);
+	paged->loadTilesAround(vector3df(10.f, 0.f, 10.f));
+
+	// the tiles which don't exist are cached as well
+	bool result = paged->getCachedTileCount() == 9 && paged->getTile(1, 1) && !paged->getTile(-1, 0);
+	if (!result)
+		logTestString("Paged terrain didn't load the tiles around the origin\n");
+
+	for (f32 z = 1.f; z < 128.f * scale.Z && result; z += 37.3f)
+	{
+		for (f32 x = 1.f; x < 128.f * scale.X && result; x += 41.7f)
+		{
+			result = fabsf(paged->getHeight(x, z) - terrain->getHeight(x, z)) < 0.01f;
+			if (!result)
+				logTestString("Paged terrain height differs at %f %f\n", x, z);
+		}
+	}
+
+	// only the tile below the camera, and one more in the cache
+	paged->setViewRadius(0);
+	paged->setMaxCachedTiles(2);
+
+	const vector3df extent = paged->getTileExtent();
+	const s32 path[3][2] = { { 0, 0 }, { 1, 0 }, { 1, 1 } };
+	for (u32 i = 0; i < 3 && result; ++i)
+	{
+		camera->setPosition(vector3df((path[i][0] + .5f) * extent.X, 1000.f, (path[i][1] + .5f) * extent.Z));
+		camera->updateAbsolutePosition();
+		smgr->drawAll();
+
+		scene::ITerrainSceneNode* tile = paged->getTile(path[i][0], path[i][1]);
+		result = paged->getCachedTileCount() == 2 && tile && tile->isVisible();
+
+		if (i > 0)
+		{
+			scene::ITerrainSceneNode* previous = paged->getTile(path[i-1][0], path[i-1][1]);
+			result &= previous && !previous->isVisible();
+		}
+
+		if (!result)
+			logTestString("Paged terrain cache is wrong at tile %d\n", i);
+	}
+
+	result &= !paged->getTile(0, 0);
+
+	// a missing tile is loaded once its file exists
+	remove("results/pagedTerrain_2_0.bmp");
+	paged->setRetryDelay(0);
+	camera->setPosition(vector3df(2.5f * extent.X, 1000.f, .5f * extent.Z));
+	camera->updateAbsolutePosition();
+	smgr->drawAll();
+	result &= !paged->getTile(2, 0);
+
+	video::IImage* tile = driver->createImageFromFile("results/pagedTerrain_1_0.bmp");
+	if (tile)
+	{
+		driver->writeImageToFile(tile, "results/pagedTerrain_2_0.bmp");
+		tile->drop();
+	}
+	smgr->drawAll();
+	if (!paged->getTile(2, 0))
+	{
+		logTestString("Paged terrain didn't load a tile which was missing before\n");
+		result = false;
+	}
+	remove("results/pagedTerrain_2_0.bmp");
+
+	device->closeDevice();
+	device->run();
+	device->drop();
+	return result;
+}
+
+// returns the Z coordinates of the vertices on the edges along a border at x,
+// of the patches in one row of patches
+void getBorderVertices(scene::ITerrainSceneNode* terrain, s32 patchX, f32 x, core::array<f32>& vertices)
+{
+	scene::IMeshBuffer* mb = terrain->getRenderBuffer();
+	const u32 vertexSize = mb->getVertexBuffer()->getVertexSize();
+	const u8* positions = (const u8*)mb->getVertexBuffer()->getVertices() +
+		mb->getVertexDescriptor()->getAttributeBySemantic(video::EVAS_POSITION)->getOffset();
+
+	vertices.clear();
+	core::array<u32> indices;
+	s32 indexCount;
+	for (s32 z = 0; (indexCount = terrain->getIndicesForPatch(indices, patchX, z, -1)) > 0; ++z)
+	{
+		for (s32 i = 0; i + 2 < indexCount; i += 3)
+		{
+			for (s32 j = 0; j < 3; ++j)
+			{
+				const vector3df& a = *(const vector3df*)(positions + indices[i + j] * vertexSize);
+				const vector3df& b = *(const vector3df*)(positions + indices[i + (j + 1) % 3] * vertexSize);
+				if (core::equals(a.X, x) && core::equals(b.X, x))
+				{
+					if (vertices.linear_search(a.Z) < 0)
+						vertices.push_back(a.Z);
+					if (vertices.linear_search(b.Z) < 0)
+						vertices.push_back(b.Z);
+				}
+			}
+		}
+	}
+	vertices.sort();
+}
+
+// neighbouring tiles with different LODs must use the same vertices along their border
+bool pagedTerrainBorders()
+{
+	IrrlichtDevice* device = createDevice(video::EDT_NULL, dimension2d<u32>(160, 120));
+	if (!device)
+		return true;
+
+	scene::ISceneManager* smgr = device->getSceneManager();
+
+	// the tiles written by pagedTerrain()
+	const vector3df scale(40.f, 4.4f, 40.f);
+	scene::IPagedTerrainSceneNode* paged = smgr->addPagedTerrainSceneNode("results/pagedTerrain_{x}_{z}.bmp",
+		65, 0, -1, vector3df(), scale);
+
+	const vector3df extent = paged->getTileExtent();
+	scene::ICameraSceneNode* camera = smgr->addCameraSceneNode(0,
+		vector3df(.5f * extent.X, 500.f, .5f * extent.Z), vector3df(2.f * extent.X, 0.f, .5f * extent.Z));
+	camera->setFarValue(20000.f);
+
+	paged->setViewRadius(1);
+	paged->loadTilesAround(camera->getAbsolutePosition());
+	smgr->drawAll();
+
+	scene::ITerrainSceneNode* near = paged->getTile(0, 0);
+	scene::ITerrainSceneNode* far = paged->getTile(1, 0);
+	bool result = near && far;
+
+	if (result)
+	{
+		// the far tile coarser than the near one along the whole border
+		for (s32 z = 0; z < 4; ++z)
+		{
+			for (s32 x = 0; x < 4; ++x)
+			{
+				near->setLODOfPatch(x, z, 0);
+				far->setLODOfPatch(x, z, 3);
+			}
+		}
+		smgr->drawAll();
+
+		core::array<f32> nearBorder;
+		core::array<f32> farBorder;
+		getBorderVertices(near, 3, extent.X, nearBorder);
+		getBorderVertices(far, 0, extent.X, farBorder);
+
+		result = farBorder.size() > 1 && nearBorder.size() == farBorder.size();
+		for (u32 i = 0; i < nearBorder.size() && result; ++i)
+			result = core::equals(nearBorder[i], farBorder[i]);
+
+		if (!result)
+			logTestString("Paged terrain tiles are not stitched, %u and %u border vertices\n",
+				nearBorder.size(), farBorder.size());
+	}
+
+	device->closeDevice();
+	device->run();
+	device->drop();
+	return result;
+}
+
 }
 
 bool terrainSceneNode()
 {
 	bool result = terrainRecalc();
 	result &= terrainGaps();
+	result &= terrainSelector();
+	result &= terrainIndices();
+	result &= pagedTerrain();
+	result &= pagedTerrainBorders();
 	return result;
 }
-
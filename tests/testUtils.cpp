@@ -333,6 +333,22 @@ float fuzzyCompareImages(irr::video::IVideoDriver * driver,
 	return result;
 }
 
+bool compareAndDropImages(irr::video::IImage * image1, irr::video::IImage * image2)
+{
+	bool result = image1 && image2 && image1->getDimension() == image2->getDimension();
+
+	for (u32 y = 0; result && y < image1->getDimension().Height; ++y)
+		for (u32 x = 0; result && x < image1->getDimension().Width; ++x)
+			result = image1->getPixel(x, y) == image2->getPixel(x, y);
+
+	if (image1)
+		image1->drop();
+	if (image2)
+		image2->drop();
+
+	return result;
+}
+
 void stabilizeScreenBackground(irr::video::IVideoDriver * driver,
 		irr::video::SColor color)
 {
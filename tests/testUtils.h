@@ -44,6 +44,13 @@ extern bool xmlCompareFiles(irr::io::IFileSystem * fs, const char * fileName1, c
 extern float fuzzyCompareImages(irr::video::IVideoDriver * driver,
 		const char * fileName1, const char * fileName2);
 
+//! Compare two images pixel by pixel.
+/** Both images are dropped, so screenshots can be passed directly.
+	\param image1 The first image to compare, may be 0.
+	\param image2 The second image to compare, may be 0.
+	\return true if both images exist and have the same size and pixels. */
+extern bool compareAndDropImages(irr::video::IImage * image1, irr::video::IImage * image2);
+
 //! Take a screenshot and compare it against a reference screenshot in the tests/media subdirectory
 /** \param driver The Irrlicht video driver.
 	\param fileName The unique filename suffix that will be appended to the name of the video driver.
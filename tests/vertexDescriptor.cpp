@@ -0,0 +1,230 @@
+// Copyright (C) 2008-2012 Colin MacDonald
+// No rights reserved: this software is in the public domain.
+
+#include "testUtils.h"
+
+using namespace irr;
+using namespace core;
+using namespace scene;
+using namespace video;
+
+struct SColorRGBA
+{
+	f32 R, G, B, A;
+
+	bool operator==(const SColorRGBA& other) const
+	{
+		return R == other.R && G == other.G && B == other.B && A == other.A;
+	}
+};
+
+static const SColor Colors[4] =
+{
+	SColor(255, 255, 0, 0), SColor(255, 0, 255, 0),
+	SColor(255, 0, 0, 255), SColor(255, 255, 255, 255)
+};
+
+static const f32 Corners[4][2] = { { -1.f, -1.f }, { 1.f, -1.f }, { 1.f, 1.f }, { -1.f, 1.f } };
+
+static const u16 Indices[6] = { 0, 2, 1, 0, 3, 2 };
+
+static void addIndices(IMeshBuffer* mb)
+{
+	for (u32 i = 0; i < 6; ++i)
+		mb->getIndexBuffer()->addIndex(Indices[i]);
+}
+
+// a quad of built-in vertices
+static IMeshBuffer* createStandardQuad(IVideoDriver* driver)
+{
+	CMeshBuffer<S3DVertex>* mb = new CMeshBuffer<S3DVertex>(driver->getVertexDescriptor(0));
+
+	for (u32 i = 0; i < 4; ++i)
+	{
+		S3DVertex v(Corners[i][0], Corners[i][1], 0.f, 0.f, 0.f, -1.f, Colors[i], 0.f, 0.f);
+		mb->getVertexBuffer()->addVertex(&v);
+	}
+
+	addIndices(mb);
+	return mb;
+}
+
+// the same quad with positions and float colors in separate streams
+static IMeshBuffer* createTwoStreamQuad(IVideoDriver* driver)
+{
+	IVertexDescriptor* descriptor = driver->getVertexDescriptor("PositionColorStreams");
+	if (!descriptor)
+	{
+		descriptor = driver->addVertexDescriptor("PositionColorStreams");
+		descriptor->addAttribute("inPosition", 3, EVAS_POSITION, EVAT_FLOAT, 0);
+		descriptor->addAttribute("inColor", 4, EVAS_COLOR, EVAT_FLOAT, 1);
+	}
+
+	CMeshBuffer<vector3df>* mb = new CMeshBuffer<vector3df>(descriptor);
+	IVertexBuffer* colors = new CVertexBuffer<SColorRGBA>();
+
+	for (u32 i = 0; i < 4; ++i)
+	{
+		const vector3df p(Corners[i][0], Corners[i][1], 0.f);
+		mb->getVertexBuffer()->addVertex(&p);
+
+		const SColorf c(Colors[i]);
+		const SColorRGBA color = { c.r, c.g, c.b, c.a };
+		colors->addVertex(&color);
+	}
+
+	mb->addVertexBuffer(colors);
+	colors->drop();
+
+	addIndices(mb);
+	return mb;
+}
+
+// the built-in quad with a per instance world matrix
+static IMeshBuffer* createInstancedQuad(IVideoDriver* driver, const matrix4* instances, u32 count)
+{
+	IVertexDescriptor* descriptor = driver->getVertexDescriptor("StandardInstanced");
+	if (!descriptor)
+	{
+		IVertexDescriptor* standard = driver->getVertexDescriptor(0);
+		descriptor = driver->addVertexDescriptor("StandardInstanced");
+
+		for (u32 i = 0; i < standard->getAttributeCount(); ++i)
+		{
+			const IVertexAttribute* attribute = standard->getAttribute(i);
+			descriptor->addAttribute(attribute->getName(), attribute->getElementCount(),
+				attribute->getSemantic(), attribute->getType(), attribute->getBufferID());
+		}
+
+		descriptor->addAttribute("InstancingMatrix1", 4, EVAS_TEXCOORD1, EVAT_FLOAT, 1);
+		descriptor->addAttribute("InstancingMatrix2", 4, EVAS_TEXCOORD2, EVAT_FLOAT, 1);
+		descriptor->addAttribute("InstancingMatrix3", 4, EVAS_TEXCOORD3, EVAT_FLOAT, 1);
+		descriptor->addAttribute("InstancingMatrix4", 4, EVAS_TEXCOORD4, EVAT_FLOAT, 1);
+		descriptor->setInstanceDataStepRate(EIDSR_PER_INSTANCE, 1);
+	}
+
+	IMeshBuffer* standardQuad = createStandardQuad(driver);
+
+	CMeshBuffer<S3DVertex>* mb = new CMeshBuffer<S3DVertex>(descriptor);
+	for (u32 i = 0; i < 4; ++i)
+		mb->getVertexBuffer()->addVertex(standardQuad->getVertexBuffer()->getVertex(i));
+	standardQuad->drop();
+
+	IVertexBuffer* matrices = new CVertexBuffer<matrix4>();
+	for (u32 i = 0; i < count; ++i)
+		matrices->addVertex(&instances[i]);
+
+	mb->addVertexBuffer(matrices);
+	matrices->drop();
+
+	addIndices(mb);
+	return mb;
+}
+
+static void beginScene(IVideoDriver* driver)
+{
+	driver->beginScene(true, true, SColor(255, 40, 40, 40));
+
+	SMaterial material;
+	material.Lighting = false;
+	material.BackfaceCulling = false;
+	driver->setMaterial(material);
+
+	driver->setTransform(ETS_PROJECTION, matrix4().buildProjectionMatrixOrthoLH(4.f, 3.f, -1.f, 1.f));
+	driver->setTransform(ETS_VIEW, matrix4());
+	driver->setTransform(ETS_WORLD, matrix4());
+}
+
+static IImage* endScene(IVideoDriver* driver)
+{
+	driver->endScene();
+	return driver->createScreenShot();
+}
+
+static bool sameImage(IImage* a, IImage* b, const char* what)
+{
+	const bool result = compareAndDropImages(a, b);
+	if (!result)
+		logTestString("%s differs from the built-in vertex rendering\n", what);
+
+	return result;
+}
+
+//! Renders custom vertex layouts and instances, they must match the built-in vertex rendering
+static bool testWithDriver(E_DRIVER_TYPE driverType)
+{
+	IrrlichtDevice* device = createDevice(driverType, dimension2d<u32>(160, 120), 32);
+	if (!device)
+		return true; // Treat a failure to create a driver as benign; this saves a lot of #ifdefs
+
+	IVideoDriver* driver = device->getVideoDriver();
+
+	logTestString("Testing driver %ls\n", driver->getName());
+
+	bool result = true;
+
+	IMeshBuffer* standard = createStandardQuad(driver);
+	IMeshBuffer* streams = createTwoStreamQuad(driver);
+
+	beginScene(driver);
+	driver->drawMeshBuffer(standard);
+	IImage* reference = endScene(driver);
+
+	beginScene(driver);
+	driver->drawMeshBuffer(streams);
+	result &= sameImage(reference, endScene(driver), "Two stream layout");
+
+	// instances
+	matrix4 instances[2];
+	instances[0].setTranslation(vector3df(-1.f, 0.f, 0.f));
+	instances[0].setScale(0.5f);
+	instances[1].setTranslation(vector3df(1.f, 0.5f, 0.f));
+	instances[1].setScale(0.25f);
+
+	IMeshBuffer* instanced = createInstancedQuad(driver, instances, 2);
+
+	beginScene(driver);
+	for (u32 i = 0; i < 2; ++i)
+	{
+		driver->setTransform(ETS_WORLD, instances[i]);
+		driver->drawMeshBuffer(standard);
+	}
+	reference = endScene(driver);
+
+	beginScene(driver);
+	driver->drawMeshBuffer(instanced);
+	result &= sameImage(reference, endScene(driver), "Instanced layout");
+
+	// changing only the step rate compiles the vertex fetch again, per vertex
+	// the matrices are texture coordinates which don't move the quad
+	const matrix4 perVertex[4] = { instances[0], instances[1], instances[0], instances[1] };
+	IMeshBuffer* rows = createInstancedQuad(driver, perVertex, 4);
+	rows->getVertexDescriptor()->setInstanceDataStepRate(EIDSR_PER_VERTEX, 1);
+
+	beginScene(driver);
+	driver->drawMeshBuffer(standard);
+	reference = endScene(driver);
+
+	beginScene(driver);
+	driver->drawMeshBuffer(rows);
+	result &= sameImage(reference, endScene(driver), "Per vertex step rate");
+
+	rows->getVertexDescriptor()->setInstanceDataStepRate(EIDSR_PER_INSTANCE, 1);
+	rows->drop();
+
+	standard->drop();
+	streams->drop();
+	instanced->drop();
+
+	device->closeDevice();
+	device->run();
+	device->drop();
+
+	return result;
+}
+
+bool vertexDescriptor(void)
+{
+	// the fixed function pipelines of the hardware drivers ignore instance matrices
+	return testWithDriver(EDT_BURNINGSVIDEO);
+}